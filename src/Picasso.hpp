@@ -16,10 +16,12 @@
 
 #include <Picasso_APIC.hpp>
 #include <Picasso_AdaptiveMesh.hpp>
+#include <Picasso_BatchedDenseSolver.hpp>
 #include <Picasso_BatchedLinearAlgebra.hpp>
 #include <Picasso_BilinearMeshMapping.hpp>
 #include <Picasso_CurvilinearMesh.hpp>
 #include <Picasso_FacetGeometry.hpp>
+#include <Picasso_FacetVoxelization.hpp>
 #include <Picasso_FieldManager.hpp>
 #include <Picasso_FieldTypes.hpp>
 #include <Picasso_GridOperator.hpp>
@@ -32,7 +34,9 @@
 #include <Picasso_ParticleLevelSet.hpp>
 #endif
 #include <Picasso_ParticleList.hpp>
+#include <Picasso_ParticleResample.hpp>
 #include <Picasso_PolyPIC.hpp>
+#include <Picasso_StreamCompaction.hpp>
 #include <Picasso_Types.hpp>
 #include <Picasso_UniformCartesianMeshMapping.hpp>
 #include <Picasso_UniformMesh.hpp>
@@ -13,6 +13,7 @@
 #define PICASSO_APIC_HPP
 
 #include <Picasso_BatchedLinearAlgebra.hpp>
+#include <Picasso_ParticleInterpolation.hpp>
 #include <Picasso_Types.hpp>
 
 #include <Cabana_Grid.hpp>
@@ -24,7 +25,9 @@ namespace Picasso
 {
 //---------------------------------------------------------------------------//
 // Affine Particle-in-Cell (APIC)
-// Currently only defined for uniform grids.
+// The transfers below which use spline distances are defined for uniform
+// grids. Collocated transfers on curvilinear grids are defined at the end of
+// this file in terms of the physical positions of the grid entities.
 //---------------------------------------------------------------------------//
 namespace APIC
 {
@@ -61,7 +64,8 @@ KOKKOS_INLINE_FUNCTION void p2g(
         ( ( Cabana::Grid::isNode<typename SplineDataType::entity_type>::value ||
             Cabana::Grid::isCell<
                 typename SplineDataType::entity_type>::value ) &&
-          ( SplineDataType::order == 2 || SplineDataType::order == 3 ) ),
+          ( SplineDataType::order == 2 || SplineDataType::order == 3 ) &&
+          !is_curvilinear_spline<SplineDataType>::value ),
         void*>::type = 0 )
 {
     static_assert( Cabana::Grid::P2G::is_scatter_view<GridField>::value,
@@ -117,8 +121,13 @@ KOKKOS_INLINE_FUNCTION void p2g(
                 distance( Dim::K ) = sd.d[Dim::K][k];
 
                 // Compute the action of B_p on the distance scaled by the
-                // inertial tensor scaling factor.
-                auto D_p_inv_B_p_d = D_p_inv * B_p * distance;
+                // inertial tensor scaling factor. The expression is fused to
+                // avoid copying the scaled B_p for every entity and the
+                // destination is a fresh local so it cannot alias.
+                LinearAlgebra::Vector<value_type, ncomp> D_p_inv_B_p_d;
+                LinearAlgebra::fusedAssign(
+                    LinearAlgebra::NoAlias(), D_p_inv_B_p_d,
+                    D_p_inv * LinearAlgebra::fuse( B_p ) * distance );
 
                 // Weight times mass.
                 wm_ip =
@@ -154,7 +163,8 @@ KOKKOS_INLINE_FUNCTION void p2g(
         ( ( Cabana::Grid::isEdge<typename SplineDataType::entity_type>::value ||
             Cabana::Grid::isFace<
                 typename SplineDataType::entity_type>::value ) &&
-          ( SplineDataType::order == 2 || SplineDataType::order == 3 ) ),
+          ( SplineDataType::order == 2 || SplineDataType::order == 3 ) &&
+          !is_curvilinear_spline<SplineDataType>::value ),
         void*>::type = 0 )
 {
     static_assert( Cabana::Grid::P2G::is_scatter_view<GridMomentum>::value,
@@ -246,7 +256,8 @@ KOKKOS_INLINE_FUNCTION void p2g(
         ( ( Cabana::Grid::isNode<typename SplineDataType::entity_type>::value ||
             Cabana::Grid::isCell<
                 typename SplineDataType::entity_type>::value ) &&
-          ( SplineDataType::order == 1 ) ),
+          ( SplineDataType::order == 1 ) &&
+          !is_curvilinear_spline<SplineDataType>::value ),
         void*>::type = 0 )
 {
     static_assert( Cabana::Grid::P2G::is_scatter_view<GridField>::value,
@@ -333,7 +344,8 @@ KOKKOS_INLINE_FUNCTION void p2g(
         ( ( Cabana::Grid::isEdge<typename SplineDataType::entity_type>::value ||
             Cabana::Grid::isFace<
                 typename SplineDataType::entity_type>::value ) &&
-          ( SplineDataType::order == 1 ) ),
+          ( SplineDataType::order == 1 ) &&
+          !is_curvilinear_spline<SplineDataType>::value ),
         void*>::type = 0 )
 {
     static_assert( Cabana::Grid::P2G::is_scatter_view<GridMomentum>::value,
@@ -408,8 +420,11 @@ template <class GridField, class SplineDataType, class ParticleField>
 KOKKOS_INLINE_FUNCTION void
 g2p( const GridField& u_i, ParticleField& c_p, const SplineDataType& sd,
      typename std::enable_if<
-         ( Cabana::Grid::isNode<typename SplineDataType::entity_type>::value ||
-           Cabana::Grid::isCell<typename SplineDataType::entity_type>::value ),
+         ( ( Cabana::Grid::isNode<
+                 typename SplineDataType::entity_type>::value ||
+             Cabana::Grid::isCell<
+                 typename SplineDataType::entity_type>::value ) &&
+           !is_curvilinear_spline<SplineDataType>::value ),
          void*>::type = 0 )
 {
     using value_type = typename GridField::value_type;
@@ -478,8 +493,11 @@ template <class GridMomentum, class SplineDataType, class ParticleVelocity>
 KOKKOS_INLINE_FUNCTION void
 g2p( const GridMomentum& u_i, ParticleVelocity& c_p, const SplineDataType& sd,
      typename std::enable_if<
-         ( Cabana::Grid::isEdge<typename SplineDataType::entity_type>::value ||
-           Cabana::Grid::isFace<typename SplineDataType::entity_type>::value ),
+         ( ( Cabana::Grid::isEdge<
+                 typename SplineDataType::entity_type>::value ||
+             Cabana::Grid::isFace<
+                 typename SplineDataType::entity_type>::value ) &&
+           !is_curvilinear_spline<SplineDataType>::value ),
          void*>::type = 0 )
 {
     static_assert( SplineDataType::has_weight_values,
@@ -543,6 +561,233 @@ g2p( const GridMomentum& u_i, ParticleVelocity& c_p, const SplineDataType& sd,
     }
 }
 
+//---------------------------------------------------------------------------//
+// Curvilinear grids
+//---------------------------------------------------------------------------//
+// On curvilinear grids the spline is evaluated in the reference frame (see
+// createCurvilinearSpline) and distances are taken in the physical frame
+// from the positions of the grid entities, x_i, given as a grid vector
+// field. Distances are measured from the weighted stencil center
+// x_p = sum_i w_ip x_i, which is the particle position for linear splines,
+// so that sum_i w_ip d_ip = 0 for all spline orders. The inertia tensor
+// D_p = sum_i w_ip d_ip d_ip^T is not a multiple of the identity and is
+// formed and pseudo-inverted explicitly. D_p is singular for linear splines
+// when the particle lies on an entity plane; the stencil then has no extent
+// normal to the plane and the affine velocity has no component along it.
+// Affine fields are transferred exactly.
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Stencil center and inertia tensor of a particle. The inertia tensor is
+// accumulated relative to the first stencil entity to avoid cancellation.
+template <class SplineDataType, class GridPosition, class Scalar>
+KOKKOS_INLINE_FUNCTION void stencilMoments( const SplineDataType& sd,
+                                            const GridPosition& x_i,
+                                            Vec3<Scalar>& x_p,
+                                            Mat3<Scalar>& D_p )
+{
+    Vec3<Scalar> x_0;
+    x_0 = x_i( sd.s[Dim::I][0], sd.s[Dim::J][0], sd.s[Dim::K][0] );
+    Vec3<Scalar> d;
+    Scalar w_ip;
+    x_p = 0.0;
+    D_p = 0.0;
+    for ( int i = 0; i < SplineDataType::num_knot; ++i )
+        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+            for ( int k = 0; k < SplineDataType::num_knot; ++k )
+            {
+                w_ip = sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k];
+                d = x_i( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k] ) -
+                    x_0;
+                x_p += w_ip * d;
+                D_p += w_ip * d * ~d;
+            }
+    D_p -= x_p * ~x_p;
+    x_p += x_0;
+}
+
+//---------------------------------------------------------------------------//
+// Pseudo-inverse of a stencil inertia tensor. Eigenvalues which are zero
+// relative to the largest eigenvalue are not inverted.
+template <class Scalar>
+KOKKOS_INLINE_FUNCTION Mat3<Scalar> inertiaInverse( const Mat3<Scalar>& D_p )
+{
+    Vec3<Scalar> e;
+    Mat3<Scalar> U;
+    LinearAlgebra::symmetricEigendecomposition( D_p, e, U );
+
+    Scalar tol =
+        Kokkos::sqrt( Kokkos::Experimental::epsilon<Scalar>::value ) * e( 2 );
+    Mat3<Scalar> D_p_inv = 0.0;
+    for ( int n = 0; n < 3; ++n )
+    {
+        if ( e( n ) <= tol )
+            continue;
+        Scalar e_inv = 1.0 / e( n );
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 3; ++j )
+                D_p_inv( i, j ) += U( i, n ) * e_inv * U( j, n );
+    }
+    return D_p_inv;
+}
+
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+// Interpolate particle property to a collocated grid property on a
+// curvilinear grid (any spline order). Requires SplineValue when
+// constructing the spline data. ParticleField matrix c_p (4*N matrix) is
+// composed of particle field u_p (1*N matrix) and particle affine matrix B_p
+// (3*N matrix).
+template <class ParticleMass, class ParticleField, class SplineDataType,
+          class GridMass, class GridField, class GridPosition>
+KOKKOS_INLINE_FUNCTION void p2g(
+    const ParticleMass& m_p, const ParticleField& c_p, const GridMass& m_i,
+    const GridField& mu_i, const SplineDataType& sd, const GridPosition& x_i,
+    typename std::enable_if<
+        ( Cabana::Grid::isNode<typename SplineDataType::entity_type>::value ||
+          Cabana::Grid::isCell<typename SplineDataType::entity_type>::value ),
+        void*>::type = 0 )
+{
+    static_assert( Cabana::Grid::P2G::is_scatter_view<GridField>::value,
+                   "P2G requires a Kokkos::ScatterView" );
+    auto field_access = mu_i.access();
+
+    static_assert( Cabana::Grid::P2G::is_scatter_view<GridMass>::value,
+                   "P2G requires a Kokkos::ScatterView" );
+    auto mass_access = m_i.access();
+
+    static_assert( SplineDataType::has_weight_values,
+                   "APIC::p2g requires spline weight values" );
+
+    using value_type = typename GridField::original_value_type;
+
+    static_assert( 4 == ParticleField::extent_0,
+                   "APIC requires a 4xN matrix, where N matches the dimension "
+                   "of the input field" );
+
+    // Number of field components.
+    constexpr int ncomp = ParticleField::extent_1;
+
+    // Affine Matrix
+    LinearAlgebra::Matrix<value_type, ncomp, 3> B_p;
+    for ( int d = 0; d < ncomp; ++d )
+    {
+        // B_p is sliced from c_p and is transposed.
+        B_p( d, 0 ) = c_p( 1, d );
+        B_p( d, 1 ) = c_p( 2, d );
+        B_p( d, 2 ) = c_p( 3, d );
+    }
+
+    // Affine velocity from the pseudo-inverse of the inertia tensor.
+    Vec3<value_type> x_p;
+    Mat3<value_type> D_p;
+    Impl::stencilMoments( sd, x_i, x_p, D_p );
+    LinearAlgebra::Matrix<value_type, ncomp, 3> C_p =
+        B_p * Impl::inertiaInverse( D_p );
+
+    // Project momentum.
+    Vec3<value_type> distance;
+    value_type wm_ip;
+    for ( int i = 0; i < SplineDataType::num_knot; ++i )
+        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+            for ( int k = 0; k < SplineDataType::num_knot; ++k )
+            {
+                // Physical distance to entity.
+                distance = x_i( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                                sd.s[Dim::K][k] ) -
+                           x_p;
+
+                // Affine contribution.
+                LinearAlgebra::Vector<value_type, ncomp> C_p_d =
+                    C_p * distance;
+
+                // Weight times mass.
+                wm_ip =
+                    sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k] * m_p;
+
+                // Interpolate particle momentum to the entity.
+                for ( int d = 0; d < ncomp; ++d )
+                    field_access( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                                  sd.s[Dim::K][k], d ) +=
+                        wm_ip * ( c_p( 0, d ) + C_p_d( d ) );
+
+                // Interpolate particle mass to the entity.
+                mass_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
+                             0 ) += wm_ip;
+            }
+}
+
+//---------------------------------------------------------------------------//
+// Interpolate collocated grid field to the particle on a curvilinear grid
+// (any spline order). Requires SplineValue when constructing the spline
+// data.
+template <class GridField, class SplineDataType, class ParticleField,
+          class GridPosition>
+KOKKOS_INLINE_FUNCTION void
+g2p( const GridField& u_i, ParticleField& c_p, const SplineDataType& sd,
+     const GridPosition& x_i,
+     typename std::enable_if<
+         ( Cabana::Grid::isNode<typename SplineDataType::entity_type>::value ||
+           Cabana::Grid::isCell<typename SplineDataType::entity_type>::value ),
+         void*>::type = 0 )
+{
+    using value_type = typename GridField::value_type;
+
+    static_assert( SplineDataType::has_weight_values,
+                   "APIC::g2p requires spline weight values" );
+
+    static_assert( 4 == ParticleField::extent_0, "APIC 4 modes" );
+
+    // Number of field components.
+    constexpr int ncomp = ParticleField::extent_1;
+
+    // Accumulate the field and its first moment in one pass. Positions are
+    // taken relative to the first stencil entity, x_0, to avoid cancellation
+    // as in the inertia tensor. The affine matrix about the stencil center
+    // is then
+    // B_p = sum_i w_ip u_i (x_i - x_p)^T = M_p - u_p (x_p - x_0)^T.
+    LinearAlgebra::Vector<value_type, ncomp> u_p;
+    LinearAlgebra::Matrix<value_type, ncomp, 3> M_p;
+    Vec3<value_type> x_p;
+    Vec3<value_type> x_0;
+    Vec3<value_type> d_e;
+    u_p = 0.0;
+    M_p = 0.0;
+    x_p = 0.0;
+    x_0 = x_i( sd.s[Dim::I][0], sd.s[Dim::J][0], sd.s[Dim::K][0] );
+    value_type w_ip;
+    for ( int i = 0; i < SplineDataType::num_knot; ++i )
+        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+            for ( int k = 0; k < SplineDataType::num_knot; ++k )
+            {
+                // Projection weight.
+                w_ip = sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k];
+
+                // Entity field and position.
+                auto u_e =
+                    u_i( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k] );
+                d_e = x_i( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k] ) -
+                      x_0;
+
+                // FIXME: += operator does not work for scalar field
+                u_p = u_p + w_ip * u_e;
+                x_p += w_ip * d_e;
+                M_p += w_ip * u_e * ~d_e;
+            }
+    LinearAlgebra::Matrix<value_type, ncomp, 3> B_p = M_p - u_p * ~x_p;
+
+    // update ParticleField
+    for ( int d = 0; d < ncomp; ++d )
+    {
+        // c_p is reconstructed from particle velocity and B_p^{T}
+        c_p( 0, d ) = u_p( d );
+        c_p( 1, d ) = B_p( d, 0 );
+        c_p( 2, d ) = B_p( d, 1 );
+        c_p( 3, d ) = B_p( d, 2 );
+    }
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace APIC
@@ -0,0 +1,373 @@
+/****************************************************************************
+ * Copyright (c) 2021 by the Picasso authors                                *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Picasso library. Picasso is distributed under a *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef PICASSO_BATCHEDDENSESOLVER_HPP
+#define PICASSO_BATCHEDDENSESOLVER_HPP
+
+#include <Picasso_BatchedLinearAlgebra.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <string>
+
+namespace Picasso
+{
+//---------------------------------------------------------------------------//
+// Factorization tags.
+//---------------------------------------------------------------------------//
+// General matrices. LU decomposition without pivoting.
+struct DenseLU
+{
+};
+
+// Symmetric positive definite matrices. Cholesky decomposition.
+struct DenseCholesky
+{
+};
+
+//---------------------------------------------------------------------------//
+// Factorization kernels for a single system. The value type may be a batch.
+template <class ExpressionA>
+KOKKOS_INLINE_FUNCTION auto denseFactor( DenseLU, const ExpressionA& a )
+{
+    return LinearAlgebra::LU( a );
+}
+
+template <class ExpressionA>
+KOKKOS_INLINE_FUNCTION auto denseFactor( DenseCholesky, const ExpressionA& a )
+{
+    return LinearAlgebra::Cholesky( a );
+}
+
+template <class ExpressionF, class ExpressionB>
+KOKKOS_INLINE_FUNCTION auto denseSolve( DenseLU, const ExpressionF& f,
+                                        const ExpressionB& b )
+{
+    return LinearAlgebra::luSolve( f, b );
+}
+
+template <class ExpressionF, class ExpressionB>
+KOKKOS_INLINE_FUNCTION auto denseSolve( DenseCholesky, const ExpressionF& f,
+                                        const ExpressionB& b )
+{
+    return LinearAlgebra::choleskySolve( f, b );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief A set of same-size dense linear systems A * X = B, e.g. one per
+  mesh entity, factored and solved in place.
+
+  Systems are stored interleaved in batches of W: system n is lane n % W of
+  batch n / W and the W lanes of every matrix and right hand side entry are
+  contiguous in memory, as in a member of a Cabana SoA. A thread therefore
+  loads a whole batch into LinearAlgebra::Batch registers and factors its W
+  systems at once with SIMD instructions. Team-level kernels instead factor
+  a batch with one team, distributing rows over the threads and systems
+  over the vector lanes, for cases where a batch is too large for the
+  registers of a single thread.
+
+  Factoring overwrites the matrices with their factors and solving
+  overwrites the right hand sides with the solutions, so a factorization can
+  be reused for any number of solves. Lanes of the last batch beyond the
+  number of systems are never written.
+
+  \tparam T Scalar type.
+
+  \tparam N Number of rows of each system.
+
+  \tparam NumRhs Number of right hand sides of each system.
+
+  \tparam W Number of interleaved systems in a batch. The team-level kernels
+  use W as the team vector length so it must be a power of two.
+
+  \tparam MemorySpace Memory space of the systems.
+*/
+template <class T, int N, int NumRhs, int W, class MemorySpace>
+class BatchedDenseSystems
+{
+  public:
+    using value_type = T;
+    using memory_space = MemorySpace;
+    using batch_type = LinearAlgebra::Batch<T, W>;
+
+    static constexpr int extent = N;
+    static constexpr int num_rhs = NumRhs;
+    static constexpr int vector_length = W;
+
+    using matrix_view_type =
+        Kokkos::View<T* [N][N][W], Kokkos::LayoutRight, MemorySpace>;
+    using rhs_view_type =
+        Kokkos::View<T* [N][NumRhs][W], Kokkos::LayoutRight, MemorySpace>;
+
+    /*!
+      \brief Constructor. All systems are initialized to zero.
+      \param label Label for the system data.
+      \param num_system The number of systems.
+    */
+    BatchedDenseSystems( const std::string& label, const int num_system )
+        : _num_system( num_system )
+        , _a( label + "_matrix", ( num_system + W - 1 ) / W )
+        , _b( label + "_rhs", ( num_system + W - 1 ) / W )
+    {
+    }
+
+    // Get the number of systems.
+    KOKKOS_INLINE_FUNCTION
+    int numSystem() const { return _num_system; }
+
+    // Get the number of batches.
+    KOKKOS_INLINE_FUNCTION
+    int numBatch() const { return _a.extent( 0 ); }
+
+    // Get the number of systems in a batch.
+    KOKKOS_INLINE_FUNCTION
+    int numLane( const int batch ) const
+    {
+        int num_lane = _num_system - batch * W;
+        return ( num_lane < W ) ? num_lane : W;
+    }
+
+    // Get the interleaved matrix data.
+    matrix_view_type matrixView() const { return _a; }
+
+    // Get the interleaved right hand side data.
+    rhs_view_type rhsView() const { return _b; }
+
+    // Get the matrix (or its factors) of a system.
+    KOKKOS_INLINE_FUNCTION
+    LinearAlgebra::MatrixView<T, N, N> matrix( const int n ) const
+    {
+        return LinearAlgebra::MatrixView<T, N, N>( &_a( n / W, 0, 0, n % W ),
+                                                   N * W, W );
+    }
+
+    // Get the right hand sides (or solutions) of a system.
+    KOKKOS_INLINE_FUNCTION
+    LinearAlgebra::MatrixView<T, N, NumRhs> rhs( const int n ) const
+    {
+        return LinearAlgebra::MatrixView<T, N, NumRhs>(
+            &_b( n / W, 0, 0, n % W ), NumRhs * W, W );
+    }
+
+    //-----------------------------------------------------------------------//
+    // Thread-level kernels. One thread factors or solves the W systems of a
+    // batch in batch registers.
+    //-----------------------------------------------------------------------//
+    // Factor the systems of a batch.
+    template <class Factorization>
+    KOKKOS_INLINE_FUNCTION void factor( const int batch, Factorization ) const
+    {
+        LinearAlgebra::MatrixView<T, N, N> a_v( &_a( batch, 0, 0, 0 ), N * W,
+                                                W );
+        LinearAlgebra::Matrix<batch_type, N, N> a;
+        LinearAlgebra::load( a, a_v );
+        LinearAlgebra::store( denseFactor( Factorization(), a ), a_v,
+                              numLane( batch ) );
+    }
+
+    // Solve the systems of a factored batch.
+    template <class Factorization>
+    KOKKOS_INLINE_FUNCTION void solve( const int batch, Factorization ) const
+    {
+        LinearAlgebra::MatrixView<T, N, N> f_v( &_a( batch, 0, 0, 0 ), N * W,
+                                                W );
+        LinearAlgebra::MatrixView<T, N, NumRhs> b_v( &_b( batch, 0, 0, 0 ),
+                                                     NumRhs * W, W );
+        LinearAlgebra::Matrix<batch_type, N, N> f;
+        LinearAlgebra::Matrix<batch_type, N, NumRhs> b;
+        LinearAlgebra::load( f, f_v );
+        LinearAlgebra::load( b, b_v );
+        LinearAlgebra::store( denseSolve( Factorization(), f, b ), b_v,
+                              numLane( batch ) );
+    }
+
+    //-----------------------------------------------------------------------//
+    // Team-level kernels. One team factors or solves the W systems of a
+    // batch with a vector lane per system. All threads of the team must
+    // call these.
+    //-----------------------------------------------------------------------//
+    // Factor the systems of a batch. LU decomposition.
+    template <class TeamMember>
+    KOKKOS_INLINE_FUNCTION void factor( const TeamMember& team,
+                                        const int batch, DenseLU ) const
+    {
+        const int num_lane = numLane( batch );
+        for ( int p = 0; p < N - 1; ++p )
+        {
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange( team, p + 1, N ),
+                [&]( const int i ) {
+                    Kokkos::parallel_for(
+                        Kokkos::ThreadVectorRange( team, num_lane ),
+                        [&]( const int l ) {
+                            _a( batch, i, p, l ) /= _a( batch, p, p, l );
+                            for ( int j = p + 1; j < N; ++j )
+                                _a( batch, i, j, l ) -=
+                                    _a( batch, i, p, l ) * _a( batch, p, j, l );
+                    } );
+            } );
+            team.team_barrier();
+        }
+    }
+
+    // Factor the systems of a batch. Cholesky decomposition.
+    template <class TeamMember>
+    KOKKOS_INLINE_FUNCTION void factor( const TeamMember& team,
+                                        const int batch, DenseCholesky ) const
+    {
+        using Kokkos::sqrt;
+        const int num_lane = numLane( batch );
+        for ( int p = 0; p < N; ++p )
+        {
+            // Scale the column below the diagonal and clear the row above.
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange( team, p + 1, N ),
+                [&]( const int i ) {
+                    Kokkos::parallel_for(
+                        Kokkos::ThreadVectorRange( team, num_lane ),
+                        [&]( const int l ) {
+                            _a( batch, i, p, l ) /=
+                                sqrt( _a( batch, p, p, l ) );
+                            _a( batch, p, i, l ) = 0.0;
+                    } );
+            } );
+            team.team_barrier();
+
+            // Update the trailing lower triangle and the diagonal.
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange( team, p, N ),
+                [&]( const int i ) {
+                    Kokkos::parallel_for(
+                        Kokkos::ThreadVectorRange( team, num_lane ),
+                        [&]( const int l ) {
+                            if ( i == p )
+                                _a( batch, p, p, l ) =
+                                    sqrt( _a( batch, p, p, l ) );
+                            else
+                                for ( int j = p + 1; j <= i; ++j )
+                                    _a( batch, i, j, l ) -=
+                                        _a( batch, i, p, l ) *
+                                        _a( batch, j, p, l );
+                    } );
+            } );
+            team.team_barrier();
+        }
+    }
+
+    // Solve the systems of a factored batch. Each right hand side of each
+    // system is solved independently.
+    template <class TeamMember, class Factorization>
+    KOKKOS_INLINE_FUNCTION void solve( const TeamMember& team,
+                                       const int batch, Factorization ) const
+    {
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange( team, NumRhs ),
+            [&]( const int k ) {
+                Kokkos::parallel_for(
+                    Kokkos::ThreadVectorRange( team, numLane( batch ) ),
+                    [&]( const int l ) {
+                        LinearAlgebra::MatrixView<T, N, N> f(
+                            &_a( batch, 0, 0, l ), N * W, W );
+                        LinearAlgebra::VectorView<T, N> b(
+                            &_b( batch, 0, k, l ), NumRhs * W );
+                        b = denseSolve( Factorization(), f, b );
+                } );
+        } );
+        team.team_barrier();
+    }
+
+    //-----------------------------------------------------------------------//
+    // Launch the thread-level kernels over all batches.
+    //-----------------------------------------------------------------------//
+    template <class ExecutionSpace, class Factorization>
+    void factor( const ExecutionSpace& exec_space, Factorization ) const
+    {
+        auto systems = *this;
+        Kokkos::parallel_for(
+            "Picasso::BatchedDenseSystems::factor",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, numBatch() ),
+            KOKKOS_LAMBDA( const int b ) {
+                systems.factor( b, Factorization() );
+            } );
+    }
+
+    template <class ExecutionSpace, class Factorization>
+    void solve( const ExecutionSpace& exec_space, Factorization ) const
+    {
+        auto systems = *this;
+        Kokkos::parallel_for(
+            "Picasso::BatchedDenseSystems::solve",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, numBatch() ),
+            KOKKOS_LAMBDA( const int b ) {
+                systems.solve( b, Factorization() );
+            } );
+    }
+
+    //-----------------------------------------------------------------------//
+    // Launch the team-level kernels over all batches with a team per batch.
+    // The vector length of the teams is W, which must be a power of two as
+    // required by Kokkos. It is clamped to the maximum vector length of the
+    // backend, in which case each vector lane handles several systems.
+    //-----------------------------------------------------------------------//
+    template <class ExecutionSpace, class Factorization>
+    void teamFactor( const ExecutionSpace& exec_space, Factorization ) const
+    {
+        using member_type =
+            typename Kokkos::TeamPolicy<ExecutionSpace>::member_type;
+        auto systems = *this;
+        Kokkos::parallel_for(
+            "Picasso::BatchedDenseSystems::teamFactor",
+            teamPolicy( exec_space ),
+            KOKKOS_LAMBDA( const member_type& team ) {
+                systems.factor( team, team.league_rank(), Factorization() );
+            } );
+    }
+
+    template <class ExecutionSpace, class Factorization>
+    void teamSolve( const ExecutionSpace& exec_space, Factorization ) const
+    {
+        using member_type =
+            typename Kokkos::TeamPolicy<ExecutionSpace>::member_type;
+        auto systems = *this;
+        Kokkos::parallel_for(
+            "Picasso::BatchedDenseSystems::teamSolve", teamPolicy( exec_space ),
+            KOKKOS_LAMBDA( const member_type& team ) {
+                systems.solve( team, team.league_rank(), Factorization() );
+            } );
+    }
+
+  private:
+    // Create a policy with a team per batch.
+    template <class ExecutionSpace>
+    Kokkos::TeamPolicy<ExecutionSpace>
+    teamPolicy( const ExecutionSpace& exec_space ) const
+    {
+        static_assert( W > 0 && 0 == ( W & ( W - 1 ) ),
+                       "Team vector length W must be a power of two" );
+        int vector_length = Kokkos::min(
+            W, Kokkos::TeamPolicy<ExecutionSpace>::vector_length_max() );
+        return Kokkos::TeamPolicy<ExecutionSpace>( exec_space, numBatch(),
+                                                   Kokkos::AUTO,
+                                                   vector_length );
+    }
+
+  private:
+    int _num_system;
+    matrix_view_type _a;
+    rhs_view_type _b;
+};
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Picasso
+
+#endif // end PICASSO_BATCHEDDENSESOLVER_HPP
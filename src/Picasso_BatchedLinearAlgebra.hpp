@@ -14,6 +14,7 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <cstdint>
 #include <functional>
 #include <type_traits>
 
@@ -89,11 +90,32 @@ namespace LinearAlgebra
 
   LU decomposition: A_lu = LU(A); (returns a copy of the matrix decomposed)
 
+  Cholesky decomposition (A = L * ~L): L = Cholesky(A); (A must be symmetric
+  positive definite)
+
+  Factored solves (A*x=b): x = luSolve(A_lu, b); x = choleskySolve(L, b);
+
   Matrix inverse: A_inv = inverse(A) (returns a copy of the matrix inverted)
 
   NxN linear solve (A*x=b): x = A ^ b;
 
-  General asymmetric eigendecomposition
+  Symmetric 3x3 eigendecomposition (A = U * diag(e) * ~U, ascending e):
+  symmetricEigendecomposition(A, e); symmetricEigendecomposition(A, e, U);
+
+  Symmetric matrix log and square root: L = symmetricLog(A);
+  Q = symmetricSqrt(A);
+
+  3x3 singular value decomposition (A = U * D * ~V): svd(A, U, D, V);
+  svd(SVDAccurate(), A, U, D, V); (see the SVD precision section)
+
+  Polar decomposition (F = R * S): polarDecomposition(F, R, S);
+
+  Fused assignment (no intermediate copies): fusedAssign(y, s * fuse(A) * x);
+  fusedAssign(NoAlias(), y, s * fuse(A) * x); (see the fused evaluation
+  section)
+
+  Batches: any of the above with a Batch<T,W> value type evaluates the
+  operation for W lanes at once (see the batch section below).
 
 
   We can string together multiple expressions to create a more complex
@@ -146,6 +168,14 @@ template <class T, int M, int N, int P, int Q>
 struct Tensor4View;
 template <class T, int M, int N, int P, int Q, class Func>
 struct Tensor4Expression;
+template <class T, int N>
+struct SymmetricMatrix;
+template <class T, int N>
+struct SymmetricMatrixView;
+template <class T, int N>
+struct SymmetricTensor4;
+template <class T, int N>
+struct SymmetricTensor4View;
 
 //---------------------------------------------------------------------------//
 // Type traits.
@@ -171,11 +201,44 @@ struct is_matrix_impl<MatrixView<T, M, N>> : public std::true_type
 {
 };
 
+template <class T, int N>
+struct is_matrix_impl<SymmetricMatrix<T, N>> : public std::true_type
+{
+};
+
+template <class T, int N>
+struct is_matrix_impl<SymmetricMatrixView<T, N>> : public std::true_type
+{
+};
+
 template <class T>
 struct is_matrix : public is_matrix_impl<typename std::remove_cv<T>::type>::type
 {
 };
 
+// Symmetric matrix
+template <class>
+struct is_symmetric_matrix_impl : public std::false_type
+{
+};
+
+template <class T, int N>
+struct is_symmetric_matrix_impl<SymmetricMatrix<T, N>> : public std::true_type
+{
+};
+
+template <class T, int N>
+struct is_symmetric_matrix_impl<SymmetricMatrixView<T, N>>
+    : public std::true_type
+{
+};
+
+template <class T>
+struct is_symmetric_matrix
+    : public is_symmetric_matrix_impl<typename std::remove_cv<T>::type>::type
+{
+};
+
 // Vector
 template <class>
 struct is_vector_impl : public std::false_type
@@ -279,788 +342,945 @@ struct is_tensor4_impl<Tensor4View<T, M, N, P, Q>> : public std::true_type
 {
 };
 
+template <class T, int N>
+struct is_tensor4_impl<SymmetricTensor4<T, N>> : public std::true_type
+{
+};
+
+template <class T, int N>
+struct is_tensor4_impl<SymmetricTensor4View<T, N>> : public std::true_type
+{
+};
+
 template <class T>
 struct is_tensor4
     : public is_tensor4_impl<typename std::remove_cv<T>::type>::type
 {
 };
 
-//---------------------------------------------------------------------------//
-// Expression creation functions.
-//---------------------------------------------------------------------------//
-// Tensor4
-template <class T, int M, int N, int P, int Q, class Func>
-KOKKOS_INLINE_FUNCTION Tensor4Expression<T, M, N, P, Q, Func>
-createTensor4Expression( const Func& f )
+// Symmetric tensor4
+template <class>
+struct is_symmetric_tensor4_impl : public std::false_type
 {
-    return Tensor4Expression<T, M, N, P, Q, Func>( f );
-}
+};
 
-// Tensor3
-template <class T, int M, int N, int P, class Func>
-KOKKOS_INLINE_FUNCTION Tensor3Expression<T, M, N, P, Func>
-createTensor3Expression( const Func& f )
+template <class T, int N>
+struct is_symmetric_tensor4_impl<SymmetricTensor4<T, N>>
+    : public std::true_type
 {
-    return Tensor3Expression<T, M, N, P, Func>( f );
-}
+};
 
-// Matrix
-template <class T, int M, int N, class Func>
-KOKKOS_INLINE_FUNCTION MatrixExpression<T, M, N, Func>
-createMatrixExpression( const Func& f )
+template <class T, int N>
+struct is_symmetric_tensor4_impl<SymmetricTensor4View<T, N>>
+    : public std::true_type
 {
-    return MatrixExpression<T, M, N, Func>( f );
-}
+};
 
-// Vector.
-template <class T, int N, class Func>
-KOKKOS_INLINE_FUNCTION VectorExpression<T, N, Func>
-createVectorExpression( const Func& f )
+template <class T>
+struct is_symmetric_tensor4
+    : public is_symmetric_tensor4_impl<typename std::remove_cv<T>::type>::type
 {
-    return VectorExpression<T, N, Func>( f );
-}
+};
 
-// Quaternion
-template <class T, class Func>
-KOKKOS_INLINE_FUNCTION QuaternionExpression<T, Func>
-createQuaternionExpression( const Func& f )
+// Dense copy type. General operations on a structured (e.g. symmetric)
+// matrix may produce a result without that structure and copy into this
+// type instead of the packed copy_type.
+template <class Expression>
+struct dense_copy
 {
-    return QuaternionExpression<T, Func>( f );
-}
+    using type = typename Expression::copy_type;
+};
 
-//---------------------------------------------------------------------------//
-// Expression containers.
-//---------------------------------------------------------------------------//
-// Tensor4 expression container.
-template <class T, int M, int N, int P, int Q, class Func>
-struct Tensor4Expression
+template <class T, int N>
+struct dense_copy<SymmetricMatrix<T, N>>
 {
-    static constexpr int extent_0 = M;
-    static constexpr int extent_1 = N;
-    static constexpr int extent_2 = P;
-    static constexpr int extent_3 = Q;
+    using type = Matrix<T, N, N>;
+};
 
-    using value_type = T;
-    using non_const_value_type = typename std::remove_cv<T>::type;
+template <class T, int N>
+struct dense_copy<SymmetricMatrixView<T, N>>
+{
+    using type = Matrix<T, N, N>;
+};
 
-    using eval_type = Tensor4<T, M, N, P, Q>;
-    using copy_type = Tensor4<T, M, N, P, Q>;
+template <class Expression>
+using dense_copy_t = typename dense_copy<Expression>::type;
 
-    Func _f;
+//---------------------------------------------------------------------------//
+// Batches.
+//---------------------------------------------------------------------------//
+/*
+  A batch holds one scalar per lane for N lanes and applies every operation
+  lane-wise. Using a batch as the value type of a Matrix, Vector, Tensor3, or
+  Tensor4 makes a single thread evaluate the same expression for N particles
+  at once, with each lane loop over contiguous data the compiler can map
+  onto SIMD registers. The natural width is the vector length of the
+  particle AoSoA: a member of a Cabana SoA stores each component
+  contiguously over the lanes so a batch is loaded straight from the
+  MatrixView/VectorView of the first particle in the SoA.
+
+  Branches on values become lane masks: comparisons of batches return a
+  BatchMask and select( mask, a, b ) picks lane-wise between two values. The
+  scalar overload of select allows algorithms to be written once for both
+  scalar and batched value types.
+*/
+template <int N>
+struct BatchMask
+{
+    bool _d[N];
+
+    static constexpr int size = N;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    Tensor4Expression() = default;
+    BatchMask() = default;
 
-    // Create an expression from a callable object.
+    // Broadcast constructor.
     KOKKOS_INLINE_FUNCTION
-    Tensor4Expression( const Func& f )
-        : _f( f )
+    BatchMask( const bool value )
     {
+        for ( int l = 0; l < N; ++l )
+            _d[l] = value;
     }
 
-    // Extent.
+    // Lane access.
     KOKKOS_INLINE_FUNCTION
-    constexpr int extent( const int d ) const
+    bool operator[]( const int l ) const { return _d[l]; }
+
+    KOKKOS_INLINE_FUNCTION
+    bool& operator[]( const int l ) { return _d[l]; }
+
+    // Lane-wise logic.
+    KOKKOS_INLINE_FUNCTION
+    friend BatchMask operator&&( const BatchMask& a, const BatchMask& b )
     {
-        return d == 3 ? extent_3
-                      : ( d == 2 ? extent_2
-                                 : ( d == 0 ? extent_0
-                                            : ( d == 1 ? extent_1 : 0 ) ) );
+        BatchMask c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = a._d[l] && b._d[l];
+        return c;
     }
 
-    // Evaluate the expression at an index.
     KOKKOS_INLINE_FUNCTION
-    value_type operator()( const int i, const int j, const int k,
-                           const int l ) const
+    friend BatchMask operator||( const BatchMask& a, const BatchMask& b )
     {
-        return _f( i, j, k, l );
+        BatchMask c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = a._d[l] || b._d[l];
+        return c;
     }
 
-    // Get a row as a vector exrpession.
     KOKKOS_INLINE_FUNCTION
-    auto vector( const ALL_INDEX_t, const int n, const int p,
-                 const int q ) const
+    friend BatchMask operator!( const BatchMask& a )
     {
-        return createVectorExpression<T, M>(
-            [=]( const int i ) { return ( *this )( i, n, p, q ); } );
+        BatchMask c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = !a._d[l];
+        return c;
     }
-    // Get a row as a vector view.
+};
+
+//---------------------------------------------------------------------------//
+// Mask reductions.
+template <int N>
+KOKKOS_INLINE_FUNCTION bool all( const BatchMask<N>& m )
+{
+    bool r = true;
+    for ( int l = 0; l < N; ++l )
+        r = r && m[l];
+    return r;
+}
+
+template <int N>
+KOKKOS_INLINE_FUNCTION bool any( const BatchMask<N>& m )
+{
+    bool r = false;
+    for ( int l = 0; l < N; ++l )
+        r = r || m[l];
+    return r;
+}
+
+// Scalar mask reductions. Equivalent to a batch mask with one lane.
+KOKKOS_INLINE_FUNCTION bool all( const bool m ) { return m; }
+
+KOKKOS_INLINE_FUNCTION bool any( const bool m ) { return m; }
+
+//---------------------------------------------------------------------------//
+// Batch of N scalars.
+template <class T, int N>
+struct Batch
+{
+    T _d[N];
+
+    static constexpr int size = N;
+
+    using value_type = T;
+    using mask_type = BatchMask<N>;
+
+    // Default constructor.
+    KOKKOS_DEFAULTED_FUNCTION
+    Batch() = default;
+
+    // Broadcast constructor.
     KOKKOS_INLINE_FUNCTION
-    auto vector( const int m, const ALL_INDEX_t, const int p,
-                 const int q ) const
+    Batch( const T value )
     {
-        return createVectorExpression<T, N>(
-            [=]( const int i ) { return ( *this )( m, i, p, q ); } );
+        for ( int l = 0; l < N; ++l )
+            _d[l] = value;
     }
-    // Get a row as a vector view.
+
+    // Lane access.
     KOKKOS_INLINE_FUNCTION
-    auto vector( const int m, const int n, const ALL_INDEX_t,
-                 const int q ) const
+    const T& operator[]( const int l ) const { return _d[l]; }
+
+    KOKKOS_INLINE_FUNCTION
+    T& operator[]( const int l ) { return _d[l]; }
+
+    // Load the lanes from contiguous memory.
+    KOKKOS_INLINE_FUNCTION
+    void load( const T* data )
     {
-        return createVectorExpression<T, P>(
-            [=]( const int i ) { return ( *this )( m, n, i, q ); } );
+        for ( int l = 0; l < N; ++l )
+            _d[l] = data[l];
     }
 
-    // Get a row as a vector view.
+    // Store the first num_lane lanes to contiguous memory.
     KOKKOS_INLINE_FUNCTION
-    auto vector( const int m, const int n, const int p,
-                 const ALL_INDEX_t ) const
+    void store( T* data, const int num_lane = N ) const
     {
-        return createVectorExpression<T, Q>(
-            [=]( const int i ) { return ( *this )( m, n, p, i ); } );
+        for ( int l = 0; l < num_lane; ++l )
+            data[l] = _d[l];
     }
 
-    // Get a matrix as a matrix view.
+    // Compound assignment.
     KOKKOS_INLINE_FUNCTION
-    auto matrix( const ALL_INDEX_t, const ALL_INDEX_t, const int p,
-                 const int q ) const
+    Batch& operator+=( const Batch& b )
     {
-        return createMatrixExpression<T, M, N>(
-            [=]( const int i, const int j )
-            { return ( *this )( i, j, p, q ); } );
+        for ( int l = 0; l < N; ++l )
+            _d[l] += b._d[l];
+        return *this;
     }
-    // Get a matrix as a matrix view.
+
     KOKKOS_INLINE_FUNCTION
-    auto matrix( const ALL_INDEX_t, const int n, const ALL_INDEX_t,
-                 const int q ) const
+    Batch& operator-=( const Batch& b )
     {
-        return createMatrixExpression<T, M, P>(
-            [=]( const int i, const int j )
-            { return ( *this )( i, n, j, q ); } );
+        for ( int l = 0; l < N; ++l )
+            _d[l] -= b._d[l];
+        return *this;
     }
-    // Get a matrix as a matrix view.
+
     KOKKOS_INLINE_FUNCTION
-    auto matrix( const int m, const ALL_INDEX_t, const ALL_INDEX_t,
-                 const int q ) const
+    Batch& operator*=( const Batch& b )
     {
-        return createMatrixExpression<T, N, P>(
-            [=]( const int i, const int j )
-            { return ( *this )( m, i, j, q ); } );
+        for ( int l = 0; l < N; ++l )
+            _d[l] *= b._d[l];
+        return *this;
     }
-    // Get a matrix as a matrix view.
+
     KOKKOS_INLINE_FUNCTION
-    auto matrix( const ALL_INDEX_t, const int n, const int p,
-                 const ALL_INDEX_t ) const
+    Batch& operator/=( const Batch& b )
     {
-        return createMatrixExpression<T, M, Q>(
-            [=]( const int i, const int j )
-            { return ( *this )( i, n, p, j ); } );
+        for ( int l = 0; l < N; ++l )
+            _d[l] /= b._d[l];
+        return *this;
     }
-    // Get a matrix as a matrix view.
+
+    // Arithmetic. Scalars are broadcast to all lanes.
     KOKKOS_INLINE_FUNCTION
-    auto matrix( const int m, const ALL_INDEX_t, const int p,
-                 const ALL_INDEX_t ) const
+    friend Batch operator-( const Batch& a )
     {
-        return createMatrixExpression<T, N, Q>(
-            [=]( const int i, const int j )
-            { return ( *this )( m, i, p, j ); } );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = -a._d[l];
+        return c;
     }
-    // Get a matrix as a matrix view.
+
     KOKKOS_INLINE_FUNCTION
-    auto matrix( const int m, const int n, const ALL_INDEX_t,
-                 const ALL_INDEX_t ) const
+    friend Batch operator+( const Batch& a, const Batch& b )
     {
-        return createMatrixExpression<T, P, Q>(
-            [=]( const int i, const int j )
-            { return ( *this )( m, n, i, j ); } );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = a._d[l] + b._d[l];
+        return c;
     }
 
-    // Get a tensor3 as a Tensor3 view.
     KOKKOS_INLINE_FUNCTION
-    auto tensor3( const ALL_INDEX_t, const ALL_INDEX_t, const ALL_INDEX_t,
-                  const int b )
+    friend Batch operator-( const Batch& a, const Batch& b )
     {
-        return createTensor3Expression<T, M, N, P>(
-            [=]( const int i, const int j, const int k )
-            { return ( *this )( i, j, k, b ); } );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = a._d[l] - b._d[l];
+        return c;
     }
-    // Get a tensor3 as a Tensor3 view.
+
     KOKKOS_INLINE_FUNCTION
-    auto tensor3( const ALL_INDEX_t, const ALL_INDEX_t, const int b,
-                  const ALL_INDEX_t )
+    friend Batch operator*( const Batch& a, const Batch& b )
     {
-        return createTensor3Expression<T, M, N, Q>(
-            [=]( const int i, const int j, const int k )
-            { return ( *this )( i, j, b, k ); } );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = a._d[l] * b._d[l];
+        return c;
     }
-    // Get a tensor3 as a Tensor3 view.
+
     KOKKOS_INLINE_FUNCTION
-    auto tensor3( const ALL_INDEX_t, const int b, const ALL_INDEX_t,
-                  const ALL_INDEX_t )
+    friend Batch operator/( const Batch& a, const Batch& b )
     {
-        return createTensor3Expression<T, M, P, Q>(
-            [=]( const int i, const int j, const int k )
-            { return ( *this )( i, b, j, k ); } );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = a._d[l] / b._d[l];
+        return c;
     }
-    // Get a tensor3 as a Tensor3 view.
+
+    // Comparison.
     KOKKOS_INLINE_FUNCTION
-    auto tensor3( const int b, const ALL_INDEX_t, const ALL_INDEX_t,
-                  const ALL_INDEX_t )
+    friend mask_type operator<( const Batch& a, const Batch& b )
     {
-        return createTensor3Expression<T, N, P, Q>(
-            [=]( const int i, const int j, const int k )
-            { return ( *this )( b, i, j, k ); } );
+        mask_type c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = a._d[l] < b._d[l];
+        return c;
     }
-};
 
-// Tensor3 expression container.
-template <class T, int M, int N, int P, class Func>
-struct Tensor3Expression
-{
-    static constexpr int extent_0 = M;
-    static constexpr int extent_1 = N;
-    static constexpr int extent_2 = P;
-
-    using value_type = T;
-    using non_const_value_type = typename std::remove_cv<T>::type;
-
-    using eval_type = Tensor3<T, M, N, P>;
-    using copy_type = Tensor3<T, M, N, P>;
-
-    Func _f;
-
-    // Default constructor.
-    KOKKOS_DEFAULTED_FUNCTION
-    Tensor3Expression() = default;
-
-    // Create an expression from a callable object.
     KOKKOS_INLINE_FUNCTION
-    Tensor3Expression( const Func& f )
-        : _f( f )
+    friend mask_type operator>( const Batch& a, const Batch& b )
     {
+        return b < a;
     }
 
-    // Extent.
     KOKKOS_INLINE_FUNCTION
-    constexpr int extent( const int d ) const
+    friend mask_type operator<=( const Batch& a, const Batch& b )
     {
-        return d == 2 ? extent_2
-                      : ( d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 ) );
+        return !( b < a );
     }
 
-    // Evaluate the expression at an index.
     KOKKOS_INLINE_FUNCTION
-    value_type operator()( const int i, const int j, const int k ) const
+    friend mask_type operator>=( const Batch& a, const Batch& b )
     {
-        return _f( i, j, k );
+        return !( a < b );
     }
 
-    // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    auto vector( const ALL_INDEX_t, const int n, const int p ) const
+    friend mask_type operator==( const Batch& a, const Batch& b )
     {
-        return createVectorExpression<T, M>( [=]( const int i )
-                                             { return ( *this )( i, n, p ); } );
+        mask_type c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = a._d[l] == b._d[l];
+        return c;
     }
-    // Get a row as a vector view.
+
     KOKKOS_INLINE_FUNCTION
-    auto vector( const int m, const ALL_INDEX_t, const int p ) const
+    friend mask_type operator!=( const Batch& a, const Batch& b )
     {
-        return createVectorExpression<T, N>( [=]( const int i )
-                                             { return ( *this )( m, i, p ); } );
+        return !( a == b );
     }
-    // Get a row as a vector view.
+
+    // Math functions. These are found by argument-dependent lookup so
+    // generic code calls them unqualified after a using-declaration of the
+    // Kokkos scalar version (e.g. using Kokkos::sqrt).
     KOKKOS_INLINE_FUNCTION
-    auto vector( const int m, const int n, const ALL_INDEX_t ) const
+    friend Batch sqrt( const Batch& a )
     {
-        return createVectorExpression<T, P>( [=]( const int i )
-                                             { return ( *this )( m, n, i ); } );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = Kokkos::sqrt( a._d[l] );
+        return c;
     }
 
-    // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
-    auto matrix( const ALL_INDEX_t, const ALL_INDEX_t, const int p ) const
+    friend Batch cbrt( const Batch& a )
     {
-        return createMatrixExpression<T, M, N>(
-            [=]( const int i, const int j ) { return ( *this )( i, j, p ); } );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = Kokkos::cbrt( a._d[l] );
+        return c;
     }
-    // Get a matrix as a matrix view.
+
     KOKKOS_INLINE_FUNCTION
-    auto matrix( const ALL_INDEX_t, const int n, const ALL_INDEX_t ) const
+    friend Batch fabs( const Batch& a )
     {
-        return createMatrixExpression<T, M, P>(
-            [=]( const int i, const int j ) { return ( *this )( i, n, j ); } );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = Kokkos::fabs( a._d[l] );
+        return c;
     }
-    // Get a matrix as a matrix view.
+
     KOKKOS_INLINE_FUNCTION
-    auto matrix( const int m, const ALL_INDEX_t, const ALL_INDEX_t ) const
+    friend Batch abs( const Batch& a ) { return fabs( a ); }
+
+    KOKKOS_INLINE_FUNCTION
+    friend Batch exp( const Batch& a )
     {
-        return createMatrixExpression<T, N, P>(
-            [=]( const int i, const int j ) { return ( *this )( m, i, j ); } );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = Kokkos::exp( a._d[l] );
+        return c;
     }
-};
-
-// Matrix expression container.
-template <class T, int M, int N, class Func>
-struct MatrixExpression
-{
-    static constexpr int extent_0 = M;
-    static constexpr int extent_1 = N;
-
-    using value_type = T;
-    using non_const_value_type = typename std::remove_cv<T>::type;
-
-    using eval_type = Matrix<T, M, N>;
-    using copy_type = Matrix<T, M, N>;
-
-    Func _f;
-
-    // Default constructor.
-    KOKKOS_DEFAULTED_FUNCTION
-    MatrixExpression() = default;
 
-    // Create an expression from a callable object.
     KOKKOS_INLINE_FUNCTION
-    MatrixExpression( const Func& f )
-        : _f( f )
+    friend Batch log( const Batch& a )
     {
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = Kokkos::log( a._d[l] );
+        return c;
     }
 
-    // Extent.
     KOKKOS_INLINE_FUNCTION
-    constexpr int extent( const int d ) const
+    friend Batch cos( const Batch& a )
     {
-        return d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = Kokkos::cos( a._d[l] );
+        return c;
     }
 
-    // Evaluate the expression at an index.
     KOKKOS_INLINE_FUNCTION
-    value_type operator()( const int i, const int j ) const
+    friend Batch acos( const Batch& a )
     {
-        return _f( i, j );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = Kokkos::acos( a._d[l] );
+        return c;
     }
 
-    // Get a row as a vector expression.
     KOKKOS_INLINE_FUNCTION
-    auto row( const int n ) const
+    friend Batch max( const Batch& a, const Batch& b )
     {
-        return createVectorExpression<T, N>( [=]( const int i )
-                                             { return ( *this )( n, i ); } );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = ( a._d[l] < b._d[l] ) ? b._d[l] : a._d[l];
+        return c;
     }
 
-    // Get a column as a vector expression.
     KOKKOS_INLINE_FUNCTION
-    auto column( const int n ) const
+    friend Batch min( const Batch& a, const Batch& b )
     {
-        return createVectorExpression<T, M>( [=]( const int i )
-                                             { return ( *this )( i, n ); } );
+        Batch c;
+        for ( int l = 0; l < N; ++l )
+            c._d[l] = ( b._d[l] < a._d[l] ) ? b._d[l] : a._d[l];
+        return c;
     }
 };
 
 //---------------------------------------------------------------------------//
-// Vector expression container.
-template <class T, int N, class Func>
-struct VectorExpression
+// Lane-wise selection.
+template <class T, int N>
+KOKKOS_INLINE_FUNCTION Batch<T, N>
+select( const BatchMask<N>& m, const Batch<T, N>& a, const Batch<T, N>& b )
 {
-    static constexpr int extent_0 = N;
-    static constexpr int extent_1 = 1;
+    Batch<T, N> c;
+    for ( int l = 0; l < N; ++l )
+        c[l] = m[l] ? a[l] : b[l];
+    return c;
+}
 
-    using value_type = T;
-    using non_const_value_type = typename std::remove_cv<T>::type;
+// Scalar selection. Equivalent to a batch selection with one lane.
+template <class T>
+KOKKOS_INLINE_FUNCTION T select( const bool m, const T& a, const T& b )
+{
+    return m ? a : b;
+}
 
-    using eval_type = Vector<T, N>;
-    using copy_type = Vector<T, N>;
+// Batch traits.
+template <class>
+struct is_batch_impl : public std::false_type
+{
+};
 
-    Func _f;
+template <class T, int N>
+struct is_batch_impl<Batch<T, N>> : public std::true_type
+{
+};
 
-    // Default constructor.
-    KOKKOS_DEFAULTED_FUNCTION
-    VectorExpression() = default;
+template <class T>
+struct is_batch : public is_batch_impl<typename std::remove_cv<T>::type>::type
+{
+};
 
-    // Create an expression from a callable object.
-    KOKKOS_INLINE_FUNCTION
-    VectorExpression( const Func& f )
-        : _f( f )
-    {
-    }
+// Scalar type of a value type. This is the lane type of a batch.
+template <class T>
+struct scalar_type
+{
+    using type = T;
+};
 
-    // Extent
-    KOKKOS_INLINE_FUNCTION
-    constexpr int extent( const int ) const { return N; }
+template <class T, int N>
+struct scalar_type<Batch<T, N>>
+{
+    using type = T;
+};
 
-    // Evaluate the expression at an index.
-    KOKKOS_INLINE_FUNCTION
-    value_type operator()( const int i ) const { return _f( i ); }
+template <class T>
+using scalar_type_t = typename scalar_type<T>::type;
 
-    // Evaluate the expression at an index. 2D version for vectors treated as
-    // matrices.
-    KOKKOS_INLINE_FUNCTION
-    value_type operator()( const int i, int ) const { return _f( i ); }
-};
+// Batched types.
+template <class T, int M, int N, int W>
+using BatchMatrix = Matrix<Batch<T, W>, M, N>;
+
+template <class T, int N, int W>
+using BatchVector = Vector<Batch<T, W>, N>;
+
+template <class T, int M, int N, int P, int W>
+using BatchTensor3 = Tensor3<Batch<T, W>, M, N, P>;
+
+template <class T, int M, int N, int P, int Q, int W>
+using BatchTensor4 = Tensor4<Batch<T, W>, M, N, P, Q>;
 
 //---------------------------------------------------------------------------//
-// Quaternion expression container.
+// Expression creation functions.
+//---------------------------------------------------------------------------//
+// Tensor4
+template <class T, int M, int N, int P, int Q, class Func>
+KOKKOS_INLINE_FUNCTION Tensor4Expression<T, M, N, P, Q, Func>
+createTensor4Expression( const Func& f )
+{
+    return Tensor4Expression<T, M, N, P, Q, Func>( f );
+}
+
+// Tensor3
+template <class T, int M, int N, int P, class Func>
+KOKKOS_INLINE_FUNCTION Tensor3Expression<T, M, N, P, Func>
+createTensor3Expression( const Func& f )
+{
+    return Tensor3Expression<T, M, N, P, Func>( f );
+}
+
+// Matrix
+template <class T, int M, int N, class Func>
+KOKKOS_INLINE_FUNCTION MatrixExpression<T, M, N, Func>
+createMatrixExpression( const Func& f )
+{
+    return MatrixExpression<T, M, N, Func>( f );
+}
+
+// Vector.
+template <class T, int N, class Func>
+KOKKOS_INLINE_FUNCTION VectorExpression<T, N, Func>
+createVectorExpression( const Func& f )
+{
+    return VectorExpression<T, N, Func>( f );
+}
+
+// Quaternion
 template <class T, class Func>
-struct QuaternionExpression
+KOKKOS_INLINE_FUNCTION QuaternionExpression<T, Func>
+createQuaternionExpression( const Func& f )
 {
-    static constexpr int extent_0 = 4;
-    static constexpr int extent_1 = 1;
+    return QuaternionExpression<T, Func>( f );
+}
+
+//---------------------------------------------------------------------------//
+// Expression containers.
+//---------------------------------------------------------------------------//
+// Tensor4 expression container.
+template <class T, int M, int N, int P, int Q, class Func>
+struct Tensor4Expression
+{
+    static constexpr int extent_0 = M;
+    static constexpr int extent_1 = N;
+    static constexpr int extent_2 = P;
+    static constexpr int extent_3 = Q;
 
     using value_type = T;
     using non_const_value_type = typename std::remove_cv<T>::type;
 
-    using eval_type = Quaternion<T>;
-    using copy_type = Quaternion<T>;
+    using eval_type = Tensor4<T, M, N, P, Q>;
+    using copy_type = Tensor4<T, M, N, P, Q>;
 
     Func _f;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    QuaternionExpression() = default;
+    Tensor4Expression() = default;
 
     // Create an expression from a callable object.
     KOKKOS_INLINE_FUNCTION
-    QuaternionExpression( const Func& f )
+    Tensor4Expression( const Func& f )
         : _f( f )
     {
     }
 
-    // Extent
+    // Extent.
     KOKKOS_INLINE_FUNCTION
-    constexpr int extent( const int ) const { return extent_0; }
+    constexpr int extent( const int d ) const
+    {
+        return d == 3 ? extent_3
+                      : ( d == 2 ? extent_2
+                                 : ( d == 0 ? extent_0
+                                            : ( d == 1 ? extent_1 : 0 ) ) );
+    }
 
     // Evaluate the expression at an index.
     KOKKOS_INLINE_FUNCTION
-    value_type operator()( const int i ) const { return _f( i ); }
+    value_type operator()( const int i, const int j, const int k,
+                           const int l ) const
+    {
+        return _f( i, j, k, l );
+    }
 
-    // Evaluate the expression at an index. 2D version for vectors treated as
-    // matrices.
+    // Get a row as a vector exrpession.
     KOKKOS_INLINE_FUNCTION
-    value_type operator()( const int i, int ) const { return _f( i ); }
-};
+    auto vector( const ALL_INDEX_t, const int n, const int p,
+                 const int q ) const
+    {
+        return createVectorExpression<T, M>(
+            [=]( const int i ) { return ( *this )( i, n, p, q ); } );
+    }
+    // Get a row as a vector view.
+    KOKKOS_INLINE_FUNCTION
+    auto vector( const int m, const ALL_INDEX_t, const int p,
+                 const int q ) const
+    {
+        return createVectorExpression<T, N>(
+            [=]( const int i ) { return ( *this )( m, i, p, q ); } );
+    }
+    // Get a row as a vector view.
+    KOKKOS_INLINE_FUNCTION
+    auto vector( const int m, const int n, const ALL_INDEX_t,
+                 const int q ) const
+    {
+        return createVectorExpression<T, P>(
+            [=]( const int i ) { return ( *this )( m, n, i, q ); } );
+    }
 
-//---------------------------------------------------------------------------//
-// Matrix
-//---------------------------------------------------------------------------//
-// Dense matrix.
-template <class T, int M, int N>
-struct Matrix
-{
-    T _d[M][N];
-
-    static constexpr int extent_0 = M;
-    static constexpr int extent_1 = N;
-
-    using value_type = T;
-    using non_const_value_type = typename std::remove_cv<T>::type;
-    using pointer = T*;
-    using reference = T&;
-    using const_reference = const T&;
-
-    using eval_type = MatrixView<T, M, N>;
-    using copy_type = Matrix<T, M, N>;
-
-    // Default constructor.
-    KOKKOS_DEFAULTED_FUNCTION
-    Matrix() = default;
-
-    // Initializer list constructor.
+    // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    Matrix( const std::initializer_list<std::initializer_list<T>> data )
-    {
-        int i = 0;
-        int j = 0;
-        for ( const auto& row : data )
-        {
-            j = 0;
-            for ( const auto& value : row )
-            {
-                _d[i][j] = value;
-                ++j;
-            }
-            ++i;
-        }
-    }
-
-    // Deep copy constructor. Triggers expression evaluation.
-    template <
-        class Expression,
-        typename std::enable_if<is_matrix<Expression>::value, int>::type = 0>
-    KOKKOS_INLINE_FUNCTION Matrix( const Expression& e )
+    auto vector( const int m, const int n, const int p,
+                 const ALL_INDEX_t ) const
     {
-        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
-        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
-
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-                ( *this )( i, j ) = e( i, j );
+        return createVectorExpression<T, Q>(
+            [=]( const int i ) { return ( *this )( m, n, p, i ); } );
     }
 
-    // Scalar constructor.
+    // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
-    Matrix( const T value )
+    auto matrix( const ALL_INDEX_t, const ALL_INDEX_t, const int p,
+                 const int q ) const
     {
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-                ( *this )( i, j ) = value;
+        return createMatrixExpression<T, M, N>(
+            [=]( const int i, const int j )
+            { return ( *this )( i, j, p, q ); } );
     }
-
-    // Assignment operator. Triggers expression evaluation.
-    template <class Expression>
+    // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_matrix<Expression>::value, Matrix&>::type
-        operator=( const Expression& e )
+    auto matrix( const ALL_INDEX_t, const int n, const ALL_INDEX_t,
+                 const int q ) const
     {
-        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
-        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
-
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-                ( *this )( i, j ) = e( i, j );
-        return *this;
+        return createMatrixExpression<T, M, P>(
+            [=]( const int i, const int j )
+            { return ( *this )( i, n, j, q ); } );
     }
-
-    // Addition assignment operator. Triggers expression evaluation.
-    template <class Expression>
+    // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_matrix<Expression>::value, Matrix&>::type
-        operator+=( const Expression& e )
+    auto matrix( const int m, const ALL_INDEX_t, const ALL_INDEX_t,
+                 const int q ) const
     {
-        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
-        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
-
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-                ( *this )( i, j ) += e( i, j );
-        return *this;
+        return createMatrixExpression<T, N, P>(
+            [=]( const int i, const int j )
+            { return ( *this )( m, i, j, q ); } );
     }
-
-    // Subtraction assignment operator. Triggers expression evaluation.
-    template <class Expression>
+    // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_matrix<Expression>::value, Matrix&>::type
-        operator-=( const Expression& e )
+    auto matrix( const ALL_INDEX_t, const int n, const int p,
+                 const ALL_INDEX_t ) const
     {
-        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
-        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
-
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-                ( *this )( i, j ) -= e( i, j );
-        return *this;
+        return createMatrixExpression<T, M, Q>(
+            [=]( const int i, const int j )
+            { return ( *this )( i, n, p, j ); } );
     }
-
-    // Initializer list assignment operator.
+    // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
-    Matrix&
-    operator=( const std::initializer_list<std::initializer_list<T>> data )
+    auto matrix( const int m, const ALL_INDEX_t, const int p,
+                 const ALL_INDEX_t ) const
     {
-        int i = 0;
-        int j = 0;
-        for ( const auto& row : data )
-        {
-            j = 0;
-            for ( const auto& value : row )
-            {
-                _d[i][j] = value;
-                ++j;
-            }
-            ++i;
-        }
-        return *this;
+        return createMatrixExpression<T, N, Q>(
+            [=]( const int i, const int j )
+            { return ( *this )( m, i, p, j ); } );
     }
-
-    // Scalar value assignment.
+    // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
-    Matrix& operator=( const T value )
+    auto matrix( const int m, const int n, const ALL_INDEX_t,
+                 const ALL_INDEX_t ) const
     {
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-                ( *this )( i, j ) = value;
-        return *this;
+        return createMatrixExpression<T, P, Q>(
+            [=]( const int i, const int j )
+            { return ( *this )( m, n, i, j ); } );
     }
 
-    // Strides.
-    KOKKOS_INLINE_FUNCTION
-    int stride_0() const { return N; }
-
-    KOKKOS_INLINE_FUNCTION
-    int stride_1() const { return 1; }
-
-    KOKKOS_INLINE_FUNCTION
-    int stride( const int d ) const { return ( 0 == d ) ? N : 1; }
-
-    // Extent
+    // Get a tensor3 as a Tensor3 view.
     KOKKOS_INLINE_FUNCTION
-    constexpr int extent( const int d ) const
+    auto tensor3( const ALL_INDEX_t, const ALL_INDEX_t, const ALL_INDEX_t,
+                  const int b )
     {
-        return d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 );
+        return createTensor3Expression<T, M, N, P>(
+            [=]( const int i, const int j, const int k )
+            { return ( *this )( i, j, k, b ); } );
     }
-
-    // Access an individual element.
+    // Get a tensor3 as a Tensor3 view.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i, const int j ) const
+    auto tensor3( const ALL_INDEX_t, const ALL_INDEX_t, const int b,
+                  const ALL_INDEX_t )
     {
-        return _d[i][j];
+        return createTensor3Expression<T, M, N, Q>(
+            [=]( const int i, const int j, const int k )
+            { return ( *this )( i, j, b, k ); } );
     }
-
-    KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i, const int j ) { return _d[i][j]; }
-
-    // Get the raw data.
-    KOKKOS_INLINE_FUNCTION
-    pointer data() const { return const_cast<pointer>( &_d[0][0] ); }
-
-    // Get a row as a vector view.
+    // Get a tensor3 as a Tensor3 view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, N> row( const int n ) const
+    auto tensor3( const ALL_INDEX_t, const int b, const ALL_INDEX_t,
+                  const ALL_INDEX_t )
     {
-        return VectorView<T, N>( const_cast<T*>( &_d[n][0] ), 1 );
+        return createTensor3Expression<T, M, P, Q>(
+            [=]( const int i, const int j, const int k )
+            { return ( *this )( i, b, j, k ); } );
     }
-
-    // Get a column as a vector view.
+    // Get a tensor3 as a Tensor3 view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, M> column( const int n ) const
+    auto tensor3( const int b, const ALL_INDEX_t, const ALL_INDEX_t,
+                  const ALL_INDEX_t )
     {
-        return VectorView<T, M>( const_cast<T*>( &_d[0][n] ), N );
+        return createTensor3Expression<T, N, P, Q>(
+            [=]( const int i, const int j, const int k )
+            { return ( *this )( b, i, j, k ); } );
     }
 };
 
-//---------------------------------------------------------------------------//
-// Scalar overload.
-template <class T>
-struct Matrix<T, 1, 1>
+// Tensor3 expression container.
+template <class T, int M, int N, int P, class Func>
+struct Tensor3Expression
 {
-    T _d;
-
-    static constexpr int extent_0 = 1;
-    static constexpr int extent_1 = 1;
+    static constexpr int extent_0 = M;
+    static constexpr int extent_1 = N;
+    static constexpr int extent_2 = P;
 
     using value_type = T;
     using non_const_value_type = typename std::remove_cv<T>::type;
-    using pointer = T*;
-    using reference = T&;
-    using const_reference = const T&;
 
-    using eval_type = MatrixView<T, 1, 1>;
-    using copy_type = Matrix<T, 1, 1>;
+    using eval_type = Tensor3<T, M, N, P>;
+    using copy_type = Tensor3<T, M, N, P>;
+
+    Func _f;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    Matrix() = default;
+    Tensor3Expression() = default;
 
-    // Scalar constructor.
+    // Create an expression from a callable object.
     KOKKOS_INLINE_FUNCTION
-    Matrix( const T value )
-        : _d( value )
+    Tensor3Expression( const Func& f )
+        : _f( f )
     {
     }
 
-    // Deep copy constructor. Triggers expression evaluation.
-    template <
-        class Expression,
-        typename std::enable_if<is_matrix<Expression>::value, int>::type = 0>
-    KOKKOS_INLINE_FUNCTION Matrix( const Expression& e )
+    // Extent.
+    KOKKOS_INLINE_FUNCTION
+    constexpr int extent( const int d ) const
     {
-        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
-        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+        return d == 2 ? extent_2
+                      : ( d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 ) );
+    }
 
-        _d = e( 0, 0 );
+    // Evaluate the expression at an index.
+    KOKKOS_INLINE_FUNCTION
+    value_type operator()( const int i, const int j, const int k ) const
+    {
+        return _f( i, j, k );
     }
 
-    // Assignment operator. Triggers expression evaluation.
-    template <class Expression>
+    // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_matrix<Expression>::value, Matrix&>::type
-        operator=( const Expression& e )
+    auto vector( const ALL_INDEX_t, const int n, const int p ) const
     {
-        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
-        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+        return createVectorExpression<T, M>( [=]( const int i )
+                                             { return ( *this )( i, n, p ); } );
+    }
+    // Get a row as a vector view.
+    KOKKOS_INLINE_FUNCTION
+    auto vector( const int m, const ALL_INDEX_t, const int p ) const
+    {
+        return createVectorExpression<T, N>( [=]( const int i )
+                                             { return ( *this )( m, i, p ); } );
+    }
+    // Get a row as a vector view.
+    KOKKOS_INLINE_FUNCTION
+    auto vector( const int m, const int n, const ALL_INDEX_t ) const
+    {
+        return createVectorExpression<T, P>( [=]( const int i )
+                                             { return ( *this )( m, n, i ); } );
+    }
 
-        _d = e( 0, 0 );
-        return *this;
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    auto matrix( const ALL_INDEX_t, const ALL_INDEX_t, const int p ) const
+    {
+        return createMatrixExpression<T, M, N>(
+            [=]( const int i, const int j ) { return ( *this )( i, j, p ); } );
+    }
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    auto matrix( const ALL_INDEX_t, const int n, const ALL_INDEX_t ) const
+    {
+        return createMatrixExpression<T, M, P>(
+            [=]( const int i, const int j ) { return ( *this )( i, n, j ); } );
+    }
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    auto matrix( const int m, const ALL_INDEX_t, const ALL_INDEX_t ) const
+    {
+        return createMatrixExpression<T, N, P>(
+            [=]( const int i, const int j ) { return ( *this )( m, i, j ); } );
     }
+};
 
-    // Addition assignment operator. Triggers expression evaluation.
-    template <class Expression>
+// Matrix expression container.
+template <class T, int M, int N, class Func>
+struct MatrixExpression
+{
+    static constexpr int extent_0 = M;
+    static constexpr int extent_1 = N;
+
+    using value_type = T;
+    using non_const_value_type = typename std::remove_cv<T>::type;
+
+    using eval_type = Matrix<T, M, N>;
+    using copy_type = Matrix<T, M, N>;
+
+    Func _f;
+
+    // Default constructor.
+    KOKKOS_DEFAULTED_FUNCTION
+    MatrixExpression() = default;
+
+    // Create an expression from a callable object.
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_matrix<Expression>::value, Matrix&>::type
-        operator+=( const Expression& e )
+    MatrixExpression( const Func& f )
+        : _f( f )
     {
-        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
-        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+    }
 
-        _d += e( 0, 0 );
-        return *this;
+    // Extent.
+    KOKKOS_INLINE_FUNCTION
+    constexpr int extent( const int d ) const
+    {
+        return d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 );
     }
 
-    // Subtraction assignment operator. Triggers expression evaluation.
-    template <class Expression>
+    // Evaluate the expression at an index.
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_matrix<Expression>::value, Matrix&>::type
-        operator-=( const Expression& e )
+    value_type operator()( const int i, const int j ) const
     {
-        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
-        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+        return _f( i, j );
+    }
 
-        _d -= e( 0, 0 );
-        return *this;
+    // Get a row as a vector expression.
+    KOKKOS_INLINE_FUNCTION
+    auto row( const int n ) const
+    {
+        return createVectorExpression<T, N>( [=]( const int i )
+                                             { return ( *this )( n, i ); } );
     }
 
-    // Scalar value assignment.
+    // Get a column as a vector expression.
     KOKKOS_INLINE_FUNCTION
-    Matrix& operator=( const T value )
+    auto column( const int n ) const
     {
-        _d = value;
-        return *this;
+        return createVectorExpression<T, M>( [=]( const int i )
+                                             { return ( *this )( i, n ); } );
     }
+};
 
-    // Strides.
+//---------------------------------------------------------------------------//
+// Vector expression container.
+template <class T, int N, class Func>
+struct VectorExpression
+{
+    static constexpr int extent_0 = N;
+    static constexpr int extent_1 = 1;
+
+    using value_type = T;
+    using non_const_value_type = typename std::remove_cv<T>::type;
+
+    using eval_type = Vector<T, N>;
+    using copy_type = Vector<T, N>;
+
+    Func _f;
+
+    // Default constructor.
+    KOKKOS_DEFAULTED_FUNCTION
+    VectorExpression() = default;
+
+    // Create an expression from a callable object.
     KOKKOS_INLINE_FUNCTION
-    int stride_0() const { return 1; }
+    VectorExpression( const Func& f )
+        : _f( f )
+    {
+    }
 
+    // Extent
     KOKKOS_INLINE_FUNCTION
-    int stride_1() const { return 1; }
+    constexpr int extent( const int ) const { return N; }
 
+    // Evaluate the expression at an index.
     KOKKOS_INLINE_FUNCTION
-    int stride( const int ) const { return 1; }
+    value_type operator()( const int i ) const { return _f( i ); }
 
-    // Extent
+    // Evaluate the expression at an index. 2D version for vectors treated as
+    // matrices.
     KOKKOS_INLINE_FUNCTION
-    constexpr int extent( const int ) const { return 1; }
+    value_type operator()( const int i, int ) const { return _f( i ); }
+};
 
-    // Access an individual element.
+//---------------------------------------------------------------------------//
+// Quaternion expression container.
+template <class T, class Func>
+struct QuaternionExpression
+{
+    static constexpr int extent_0 = 4;
+    static constexpr int extent_1 = 1;
+
+    using value_type = T;
+    using non_const_value_type = typename std::remove_cv<T>::type;
+
+    using eval_type = Quaternion<T>;
+    using copy_type = Quaternion<T>;
+
+    Func _f;
+
+    // Default constructor.
+    KOKKOS_DEFAULTED_FUNCTION
+    QuaternionExpression() = default;
+
+    // Create an expression from a callable object.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int, const int ) const { return _d; }
+    QuaternionExpression( const Func& f )
+        : _f( f )
+    {
+    }
 
+    // Extent
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int, const int ) { return _d; }
+    constexpr int extent( const int ) const { return extent_0; }
 
-    // Get the raw data.
+    // Evaluate the expression at an index.
     KOKKOS_INLINE_FUNCTION
-    pointer data() const { return const_cast<pointer>( &_d ); }
+    value_type operator()( const int i ) const { return _f( i ); }
 
-    // Scalar conversion operator.
+    // Evaluate the expression at an index. 2D version for vectors treated as
+    // matrices.
     KOKKOS_INLINE_FUNCTION
-    operator value_type() const { return _d; }
+    value_type operator()( const int i, int ) const { return _f( i ); }
 };
 
-template <class T>
-struct Matrix<T, 3, 3>
+//---------------------------------------------------------------------------//
+// Matrix
+//---------------------------------------------------------------------------//
+// Dense matrix.
+template <class T, int M, int N>
+struct Matrix
 {
-    T _d[3][3];
+    T _d[M][N];
 
-    static constexpr int extent_0 = 3;
-    static constexpr int extent_1 = 3;
+    static constexpr int extent_0 = M;
+    static constexpr int extent_1 = N;
 
     using value_type = T;
     using non_const_value_type = typename std::remove_cv<T>::type;
@@ -1068,8 +1288,8 @@ struct Matrix<T, 3, 3>
     using reference = T&;
     using const_reference = const T&;
 
-    using eval_type = MatrixView<T, 3, 3>;
-    using copy_type = Matrix<T, 3, 3>;
+    using eval_type = MatrixView<T, M, N>;
+    using copy_type = Matrix<T, M, N>;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
@@ -1093,24 +1313,6 @@ struct Matrix<T, 3, 3>
         }
     }
 
-    // Quaternion to matrix explicit constructor
-    explicit KOKKOS_INLINE_FUNCTION Matrix( const Quaternion<T>& q )
-    {
-        value_type n = q( 0 ) * q( 0 ) + q( 1 ) * q( 1 ) + q( 2 ) * q( 2 ) +
-                       q( 3 ) * q( 3 );
-        value_type s = n == 0 ? 0 : 2.0 / n;
-
-        _d[0][0] = 1.0 - s * ( q( 2 ) * q( 2 ) + q( 3 ) * q( 3 ) );
-        _d[0][1] = s * ( q( 1 ) * q( 2 ) - q( 0 ) * q( 3 ) );
-        _d[0][2] = s * ( q( 1 ) * q( 3 ) + q( 0 ) * q( 2 ) );
-        _d[1][0] = s * ( q( 1 ) * q( 2 ) + q( 0 ) * q( 3 ) );
-        _d[1][1] = 1.0 - s * ( q( 1 ) * q( 1 ) + q( 3 ) * q( 3 ) );
-        _d[1][2] = s * ( q( 2 ) * q( 3 ) - q( 0 ) * q( 1 ) );
-        _d[2][0] = s * ( q( 1 ) * q( 3 ) - q( 0 ) * q( 2 ) );
-        _d[2][1] = s * ( q( 2 ) * q( 3 ) + q( 0 ) * q( 1 ) );
-        _d[2][2] = 1.0 - s * ( q( 1 ) * q( 1 ) + q( 2 ) * q( 2 ) );
-    }
-
     // Deep copy constructor. Triggers expression evaluation.
     template <
         class Expression,
@@ -1120,11 +1322,11 @@ struct Matrix<T, 3, 3>
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
-        for ( int i = 0; i < extent_0; ++i )
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-            for ( int j = 0; j < extent_1; ++j )
+            for ( int j = 0; j < N; ++j )
                 ( *this )( i, j ) = e( i, j );
     }
 
@@ -1132,11 +1334,11 @@ struct Matrix<T, 3, 3>
     KOKKOS_INLINE_FUNCTION
     Matrix( const T value )
     {
-        for ( int i = 0; i < extent_0; ++i )
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-            for ( int j = 0; j < extent_1; ++j )
+            for ( int j = 0; j < N; ++j )
                 ( *this )( i, j ) = value;
     }
 
@@ -1149,11 +1351,11 @@ struct Matrix<T, 3, 3>
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
-        for ( int i = 0; i < extent_0; ++i )
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-            for ( int j = 0; j < extent_1; ++j )
+            for ( int j = 0; j < N; ++j )
                 ( *this )( i, j ) = e( i, j );
         return *this;
     }
@@ -1167,11 +1369,11 @@ struct Matrix<T, 3, 3>
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
-        for ( int i = 0; i < extent_0; ++i )
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-            for ( int j = 0; j < extent_1; ++j )
+            for ( int j = 0; j < N; ++j )
                 ( *this )( i, j ) += e( i, j );
         return *this;
     }
@@ -1185,11 +1387,11 @@ struct Matrix<T, 3, 3>
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
-        for ( int i = 0; i < extent_0; ++i )
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-            for ( int j = 0; j < extent_1; ++j )
+            for ( int j = 0; j < N; ++j )
                 ( *this )( i, j ) -= e( i, j );
         return *this;
     }
@@ -1218,24 +1420,24 @@ struct Matrix<T, 3, 3>
     KOKKOS_INLINE_FUNCTION
     Matrix& operator=( const T value )
     {
-        for ( int i = 0; i < extent_0; ++i )
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-            for ( int j = 0; j < extent_1; ++j )
+            for ( int j = 0; j < N; ++j )
                 ( *this )( i, j ) = value;
         return *this;
     }
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_0() const { return extent_1; }
+    int stride_0() const { return N; }
 
     KOKKOS_INLINE_FUNCTION
     int stride_1() const { return 1; }
 
     KOKKOS_INLINE_FUNCTION
-    int stride( const int d ) const { return ( 0 == d ) ? extent_1 : 1; }
+    int stride( const int d ) const { return ( 0 == d ) ? N : 1; }
 
     // Extent
     KOKKOS_INLINE_FUNCTION
@@ -1260,31 +1462,28 @@ struct Matrix<T, 3, 3>
 
     // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, 3> row( const int n ) const
+    VectorView<T, N> row( const int n ) const
     {
-        return VectorView<T, 3>( const_cast<T*>( &_d[n][0] ), 1 );
+        return VectorView<T, N>( const_cast<T*>( &_d[n][0] ), 1 );
     }
 
     // Get a column as a vector view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, 3> column( const int n ) const
+    VectorView<T, M> column( const int n ) const
     {
-        return VectorView<T, 3>( const_cast<T*>( &_d[0][n] ), extent_1 );
+        return VectorView<T, M>( const_cast<T*>( &_d[0][n] ), N );
     }
 };
 
 //---------------------------------------------------------------------------//
-// View for wrapping matrix data.
-//
-// NOTE: Data in this view may be non-contiguous.
-template <class T, int M, int N>
-struct MatrixView
+// Scalar overload.
+template <class T>
+struct Matrix<T, 1, 1>
 {
-    T* _d;
-    int _stride[2];
+    T _d;
 
-    static constexpr int extent_0 = M;
-    static constexpr int extent_1 = N;
+    static constexpr int extent_0 = 1;
+    static constexpr int extent_1 = 1;
 
     using value_type = T;
     using non_const_value_type = typename std::remove_cv<T>::type;
@@ -1292,181 +1491,116 @@ struct MatrixView
     using reference = T&;
     using const_reference = const T&;
 
-    using eval_type = MatrixView<T, M, N>;
-    using copy_type = Matrix<T, M, N>;
+    using eval_type = MatrixView<T, 1, 1>;
+    using copy_type = Matrix<T, 1, 1>;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    MatrixView() = default;
+    Matrix() = default;
 
-    // Matrix constructor.
+    // Scalar constructor.
     KOKKOS_INLINE_FUNCTION
-    MatrixView( const Matrix<T, M, N>& m )
-        : _d( m.data() )
+    Matrix( const T value )
+        : _d( value )
     {
-        _stride[0] = m.stride_0();
-        _stride[1] = m.stride_1();
     }
 
-    // Pointer constructor.
-    KOKKOS_INLINE_FUNCTION
-    MatrixView( T* data, const int stride_0, const int stride_1 )
-        : _d( data )
+    // Deep copy constructor. Triggers expression evaluation.
+    template <
+        class Expression,
+        typename std::enable_if<is_matrix<Expression>::value, int>::type = 0>
+    KOKKOS_INLINE_FUNCTION Matrix( const Expression& e )
     {
-        _stride[0] = stride_0;
-        _stride[1] = stride_1;
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+        _d = e( 0, 0 );
     }
 
     // Assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_matrix<Expression>::value, MatrixView&>::type
+        typename std::enable_if<is_matrix<Expression>::value, Matrix&>::type
         operator=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-                ( *this )( i, j ) = e( i, j );
+        _d = e( 0, 0 );
         return *this;
     }
 
     // Addition assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_matrix<Expression>::value, MatrixView&>::type
+        typename std::enable_if<is_matrix<Expression>::value, Matrix&>::type
         operator+=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-                ( *this )( i, j ) += e( i, j );
+        _d += e( 0, 0 );
         return *this;
     }
 
     // Subtraction assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_matrix<Expression>::value, MatrixView&>::type
+        typename std::enable_if<is_matrix<Expression>::value, Matrix&>::type
         operator-=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-                ( *this )( i, j ) -= e( i, j );
-        return *this;
-    }
-
-    // Initializer list assignment operator.
-    KOKKOS_INLINE_FUNCTION
-    MatrixView&
-    operator=( const std::initializer_list<std::initializer_list<T>> data )
-    {
-        int i = 0;
-        int j = 0;
-        for ( const auto& row : data )
-        {
-            j = 0;
-            for ( const auto& value : row )
-            {
-                ( *this )( i, j ) = value;
-                ++j;
-            }
-            ++i;
-        }
+        _d -= e( 0, 0 );
         return *this;
     }
 
     // Scalar value assignment.
     KOKKOS_INLINE_FUNCTION
-    MatrixView& operator=( const T value )
+    Matrix& operator=( const T value )
     {
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-                ( *this )( i, j ) = value;
+        _d = value;
         return *this;
     }
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_0() const { return _stride[0]; }
+    int stride_0() const { return 1; }
 
-    // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_1() const { return _stride[1]; }
+    int stride_1() const { return 1; }
 
     KOKKOS_INLINE_FUNCTION
-    int stride( const int d ) const { return _stride[d]; }
+    int stride( const int ) const { return 1; }
 
     // Extent
     KOKKOS_INLINE_FUNCTION
-    constexpr int extent( const int d ) const
-    {
-        return d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 );
-    }
+    constexpr int extent( const int ) const { return 1; }
 
     // Access an individual element.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i, const int j ) const
-    {
-        return _d[_stride[0] * i + _stride[1] * j];
-    }
-
-    KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i, const int j )
-    {
-        return _d[_stride[0] * i + _stride[1] * j];
-    }
+    const_reference operator()( const int, const int ) const { return _d; }
 
-    // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, N> row( const int n ) const
-    {
-        return VectorView<T, N>( const_cast<T*>( &_d[_stride[0] * n] ),
-                                 _stride[1] );
-    }
+    reference operator()( const int, const int ) { return _d; }
 
-    // Get a column as a vector view.
+    // Get the raw data.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, M> column( const int n ) const
-    {
-        return VectorView<T, M>( const_cast<T*>( &_d[_stride[1] * n] ),
-                                 _stride[0] );
-    }
+    pointer data() const { return const_cast<pointer>( &_d ); }
 
-    // Get the raw data.
+    // Scalar conversion operator.
     KOKKOS_INLINE_FUNCTION
-    pointer data() const { return const_cast<pointer>( _d ); }
+    operator value_type() const { return _d; }
 };
 
-//---------------------------------------------------------------------------//
-// Vector
-//---------------------------------------------------------------------------//
-// Dense vector.
-template <class T, int N>
-struct Vector
+template <class T>
+struct Matrix<T, 3, 3>
 {
-    T _d[N];
+    T _d[3][3];
 
-    static constexpr int extent_0 = N;
-    static constexpr int extent_1 = 1;
+    static constexpr int extent_0 = 3;
+    static constexpr int extent_1 = 3;
 
     using value_type = T;
     using non_const_value_type = typename std::remove_cv<T>::type;
@@ -1474,111 +1608,150 @@ struct Vector
     using reference = T&;
     using const_reference = const T&;
 
-    using eval_type = VectorView<T, N>;
-    using copy_type = Vector<T, N>;
+    using eval_type = MatrixView<T, 3, 3>;
+    using copy_type = Matrix<T, 3, 3>;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    Vector() = default;
+    Matrix() = default;
 
     // Initializer list constructor.
     KOKKOS_INLINE_FUNCTION
-    Vector( const std::initializer_list<T> data )
+    Matrix( const std::initializer_list<std::initializer_list<T>> data )
     {
         int i = 0;
-        for ( const auto& value : data )
+        int j = 0;
+        for ( const auto& row : data )
         {
-            _d[i] = value;
+            j = 0;
+            for ( const auto& value : row )
+            {
+                _d[i][j] = value;
+                ++j;
+            }
             ++i;
         }
     }
 
+    // Quaternion to matrix explicit constructor
+    explicit KOKKOS_INLINE_FUNCTION Matrix( const Quaternion<T>& q )
+    {
+        value_type n = q( 0 ) * q( 0 ) + q( 1 ) * q( 1 ) + q( 2 ) * q( 2 ) +
+                       q( 3 ) * q( 3 );
+        value_type s = select( n == static_cast<value_type>( 0 ),
+                               static_cast<value_type>( 0 ),
+                               static_cast<value_type>( 2 ) / n );
+        const value_type one = static_cast<value_type>( 1 );
+
+        _d[0][0] = one - s * ( q( 2 ) * q( 2 ) + q( 3 ) * q( 3 ) );
+        _d[0][1] = s * ( q( 1 ) * q( 2 ) - q( 0 ) * q( 3 ) );
+        _d[0][2] = s * ( q( 1 ) * q( 3 ) + q( 0 ) * q( 2 ) );
+        _d[1][0] = s * ( q( 1 ) * q( 2 ) + q( 0 ) * q( 3 ) );
+        _d[1][1] = one - s * ( q( 1 ) * q( 1 ) + q( 3 ) * q( 3 ) );
+        _d[1][2] = s * ( q( 2 ) * q( 3 ) - q( 0 ) * q( 1 ) );
+        _d[2][0] = s * ( q( 1 ) * q( 3 ) - q( 0 ) * q( 2 ) );
+        _d[2][1] = s * ( q( 2 ) * q( 3 ) + q( 0 ) * q( 1 ) );
+        _d[2][2] = one - s * ( q( 1 ) * q( 1 ) + q( 2 ) * q( 2 ) );
+    }
+
     // Deep copy constructor. Triggers expression evaluation.
     template <
         class Expression,
-        typename std::enable_if<is_vector<Expression>::value, int>::type = 0>
-    KOKKOS_INLINE_FUNCTION Vector( const Expression& e )
+        typename std::enable_if<is_matrix<Expression>::value, int>::type = 0>
+    KOKKOS_INLINE_FUNCTION Matrix( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
+        for ( int i = 0; i < extent_0; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < N; ++i )
-            ( *this )( i ) = e( i );
+            for ( int j = 0; j < extent_1; ++j )
+                ( *this )( i, j ) = e( i, j );
     }
 
     // Scalar constructor.
     KOKKOS_INLINE_FUNCTION
-    Vector( const T value )
+    Matrix( const T value )
     {
+        for ( int i = 0; i < extent_0; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < N; ++i )
-            ( *this )( i ) = value;
+            for ( int j = 0; j < extent_1; ++j )
+                ( *this )( i, j ) = value;
     }
 
-    // Deep copy assignment operator. Triggers expression evaluation.
+    // Assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_vector<Expression>::value, Vector&>::type
+        typename std::enable_if<is_matrix<Expression>::value, Matrix&>::type
         operator=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
+        for ( int i = 0; i < extent_0; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < N; ++i )
-            ( *this )( i ) = e( i );
+            for ( int j = 0; j < extent_1; ++j )
+                ( *this )( i, j ) = e( i, j );
         return *this;
     }
 
     // Addition assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_vector<Expression>::value, Vector&>::type
+        typename std::enable_if<is_matrix<Expression>::value, Matrix&>::type
         operator+=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
+        for ( int i = 0; i < extent_0; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < N; ++i )
-            ( *this )( i ) += e( i );
+            for ( int j = 0; j < extent_1; ++j )
+                ( *this )( i, j ) += e( i, j );
         return *this;
     }
 
     // Subtraction assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_vector<Expression>::value, Vector&>::type
+        typename std::enable_if<is_matrix<Expression>::value, Matrix&>::type
         operator-=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
+        for ( int i = 0; i < extent_0; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < N; ++i )
-            ( *this )( i ) -= e( i );
+            for ( int j = 0; j < extent_1; ++j )
+                ( *this )( i, j ) -= e( i, j );
         return *this;
     }
 
     // Initializer list assignment operator.
     KOKKOS_INLINE_FUNCTION
-    Vector& operator=( const std::initializer_list<T> data )
-    {
+    Matrix&
+    operator=( const std::initializer_list<std::initializer_list<T>> data )
+    {
         int i = 0;
-        for ( const auto& value : data )
+        int j = 0;
+        for ( const auto& row : data )
         {
-            _d[i] = value;
+            j = 0;
+            for ( const auto& value : row )
+            {
+                _d[i][j] = value;
+                ++j;
+            }
             ++i;
         }
         return *this;
@@ -1586,75 +1759,75 @@ struct Vector
 
     // Scalar value assignment.
     KOKKOS_INLINE_FUNCTION
-    Vector& operator=( const T value )
-    {
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-        for ( int i = 0; i < N; ++i )
-            ( *this )( i ) = value;
-        return *this;
-    }
-
-    // Normalization
-    KOKKOS_INLINE_FUNCTION
-    Vector& normalize()
+    Matrix& operator=( const T value )
     {
+        for ( int i = 0; i < extent_0; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        auto norm2 = Kokkos::sqrt( ~( *this ) * ( *this ) );
-        for ( int i = 0; i < N; ++i )
-            ( *this )( i ) /= norm2;
+            for ( int j = 0; j < extent_1; ++j )
+                ( *this )( i, j ) = value;
         return *this;
     }
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_0() const { return 1; }
+    int stride_0() const { return extent_1; }
 
-    // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_1() const { return 0; }
+    int stride_1() const { return 1; }
 
     KOKKOS_INLINE_FUNCTION
-    int stride( const int d ) const { return ( 0 == d ) ? 1 : 0; }
+    int stride( const int d ) const { return ( 0 == d ) ? extent_1 : 1; }
 
     // Extent
     KOKKOS_INLINE_FUNCTION
     constexpr int extent( const int d ) const
     {
-        return d == 0 ? extent_0 : ( d == 1 ? 1 : 0 );
+        return d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 );
     }
 
     // Access an individual element.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i ) const { return _d[i]; }
+    const_reference operator()( const int i, const int j ) const
+    {
+        return _d[i][j];
+    }
 
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i ) { return _d[i]; }
+    reference operator()( const int i, const int j ) { return _d[i][j]; }
 
-    // Access an individual element. 2D version for vectors treated as matrices.
+    // Get the raw data.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i, const int ) const { return _d[i]; }
+    pointer data() const { return const_cast<pointer>( &_d[0][0] ); }
 
+    // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i, const int ) { return _d[i]; }
+    VectorView<T, 3> row( const int n ) const
+    {
+        return VectorView<T, 3>( const_cast<T*>( &_d[n][0] ), 1 );
+    }
 
-    // Get the raw data.
+    // Get a column as a vector view.
     KOKKOS_INLINE_FUNCTION
-    pointer data() const { return const_cast<pointer>( &_d[0] ); }
+    VectorView<T, 3> column( const int n ) const
+    {
+        return VectorView<T, 3>( const_cast<T*>( &_d[0][n] ), extent_1 );
+    }
 };
 
 //---------------------------------------------------------------------------//
-// Scalar overload.
-template <class T>
-struct Vector<T, 1>
+// View for wrapping matrix data.
+//
+// NOTE: Data in this view may be non-contiguous.
+template <class T, int M, int N>
+struct MatrixView
 {
-    T _d;
+    T* _d;
+    int _stride[2];
 
-    static constexpr int extent_0 = 1;
-    static constexpr int extent_1 = 1;
+    static constexpr int extent_0 = M;
+    static constexpr int extent_1 = N;
 
     using value_type = T;
     using non_const_value_type = typename std::remove_cv<T>::type;
@@ -1662,125 +1835,178 @@ struct Vector<T, 1>
     using reference = T&;
     using const_reference = const T&;
 
-    using eval_type = VectorView<T, 1>;
-    using copy_type = Vector<T, 1>;
+    using eval_type = MatrixView<T, M, N>;
+    using copy_type = Matrix<T, M, N>;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    Vector() = default;
+    MatrixView() = default;
 
-    // Scalar constructor.
+    // Matrix constructor.
     KOKKOS_INLINE_FUNCTION
-    Vector( const T value )
-        : _d( value )
+    MatrixView( const Matrix<T, M, N>& m )
+        : _d( m.data() )
     {
+        _stride[0] = m.stride_0();
+        _stride[1] = m.stride_1();
     }
 
-    // Deep copy constructor. Triggers expression evaluation.
-    template <
-        class Expression,
-        typename std::enable_if<is_vector<Expression>::value, int>::type = 0>
-    KOKKOS_INLINE_FUNCTION Vector( const Expression& e )
+    // Pointer constructor.
+    KOKKOS_INLINE_FUNCTION
+    MatrixView( T* data, const int stride_0, const int stride_1 )
+        : _d( data )
     {
-        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
-        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
-
-        _d = e( 0 );
+        _stride[0] = stride_0;
+        _stride[1] = stride_1;
     }
 
-    // Deep copy assignment operator. Triggers expression evaluation.
+    // Assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_vector<Expression>::value, Vector&>::type
+        typename std::enable_if<is_matrix<Expression>::value, MatrixView&>::type
         operator=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
-        _d = e( 0 );
+        for ( int i = 0; i < M; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+            for ( int j = 0; j < N; ++j )
+                ( *this )( i, j ) = e( i, j );
         return *this;
     }
 
     // Addition assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_vector<Expression>::value, Vector&>::type
+        typename std::enable_if<is_matrix<Expression>::value, MatrixView&>::type
         operator+=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
-        _d += e( 0 );
+        for ( int i = 0; i < M; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+            for ( int j = 0; j < N; ++j )
+                ( *this )( i, j ) += e( i, j );
         return *this;
     }
 
     // Subtraction assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_vector<Expression>::value, Vector&>::type
+        typename std::enable_if<is_matrix<Expression>::value, MatrixView&>::type
         operator-=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
 
-        _d -= e( 0 );
+        for ( int i = 0; i < M; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+            for ( int j = 0; j < N; ++j )
+                ( *this )( i, j ) -= e( i, j );
+        return *this;
+    }
+
+    // Initializer list assignment operator.
+    KOKKOS_INLINE_FUNCTION
+    MatrixView&
+    operator=( const std::initializer_list<std::initializer_list<T>> data )
+    {
+        int i = 0;
+        int j = 0;
+        for ( const auto& row : data )
+        {
+            j = 0;
+            for ( const auto& value : row )
+            {
+                ( *this )( i, j ) = value;
+                ++j;
+            }
+            ++i;
+        }
         return *this;
     }
 
     // Scalar value assignment.
     KOKKOS_INLINE_FUNCTION
-    Vector& operator=( const T value )
+    MatrixView& operator=( const T value )
     {
-        _d = value;
+        for ( int i = 0; i < M; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+            for ( int j = 0; j < N; ++j )
+                ( *this )( i, j ) = value;
         return *this;
     }
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_0() const { return 1; }
+    int stride_0() const { return _stride[0]; }
 
+    // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_1() const { return 1; }
+    int stride_1() const { return _stride[1]; }
 
     KOKKOS_INLINE_FUNCTION
-    int stride( const int ) const { return 1; }
+    int stride( const int d ) const { return _stride[d]; }
 
     // Extent
     KOKKOS_INLINE_FUNCTION
-    constexpr int extent( const int ) const { return 1; }
+    constexpr int extent( const int d ) const
+    {
+        return d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 );
+    }
 
     // Access an individual element.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int ) const { return _d; }
+    const_reference operator()( const int i, const int j ) const
+    {
+        return _d[_stride[0] * i + _stride[1] * j];
+    }
 
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int ) { return _d; }
+    reference operator()( const int i, const int j )
+    {
+        return _d[_stride[0] * i + _stride[1] * j];
+    }
 
-    // Access an individual element. 2D version for vectors treated as matrices.
+    // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int, const int ) const { return _d; }
+    VectorView<T, N> row( const int n ) const
+    {
+        return VectorView<T, N>( const_cast<T*>( &_d[_stride[0] * n] ),
+                                 _stride[1] );
+    }
 
+    // Get a column as a vector view.
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int, const int ) { return _d; }
+    VectorView<T, M> column( const int n ) const
+    {
+        return VectorView<T, M>( const_cast<T*>( &_d[_stride[1] * n] ),
+                                 _stride[0] );
+    }
 
     // Get the raw data.
     KOKKOS_INLINE_FUNCTION
-    pointer data() const { return const_cast<pointer>( &_d ); }
-
-    // Scalar conversion operator.
-    KOKKOS_INLINE_FUNCTION
-    operator value_type() const { return _d; }
+    pointer data() const { return const_cast<pointer>( _d ); }
 };
 
 //---------------------------------------------------------------------------//
-// View for wrapping vector data.
-//
-// NOTE: Data in this view may be non-contiguous.
+// Vector
+//---------------------------------------------------------------------------//
+// Dense vector.
 template <class T, int N>
-struct VectorView
+struct Vector
 {
-    T* _d;
-    int _stride;
+    T _d[N];
 
     static constexpr int extent_0 = N;
     static constexpr int extent_1 = 1;
@@ -1796,29 +2022,25 @@ struct VectorView
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    VectorView() = default;
-
-    // Vector constructor.
-    KOKKOS_INLINE_FUNCTION
-    VectorView( const Vector<T, N>& v )
-        : _d( v.data() )
-        , _stride( v.stride_0() )
-    {
-    }
+    Vector() = default;
 
-    // Pointer constructor.
+    // Initializer list constructor.
     KOKKOS_INLINE_FUNCTION
-    VectorView( T* data, const int stride )
-        : _d( data )
-        , _stride( stride )
+    Vector( const std::initializer_list<T> data )
     {
+        int i = 0;
+        for ( const auto& value : data )
+        {
+            _d[i] = value;
+            ++i;
+        }
     }
 
-    // Assignment operator. Triggers expression evaluation.
-    template <class Expression>
-    KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_vector<Expression>::value, VectorView&>::type
-        operator=( const Expression& e )
+    // Deep copy constructor. Triggers expression evaluation.
+    template <
+        class Expression,
+        typename std::enable_if<is_vector<Expression>::value, int>::type = 0>
+    KOKKOS_INLINE_FUNCTION Vector( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
@@ -1828,13 +2050,40 @@ struct VectorView
 #endif
         for ( int i = 0; i < N; ++i )
             ( *this )( i ) = e( i );
-        return *this;
     }
 
-    // Addition assignment operator. Triggers expression evaluation.
+    // Scalar constructor.
+    KOKKOS_INLINE_FUNCTION
+    Vector( const T value )
+    {
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 0; i < N; ++i )
+            ( *this )( i ) = value;
+    }
+
+    // Deep copy assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_vector<Expression>::value, VectorView&>::type
+        typename std::enable_if<is_vector<Expression>::value, Vector&>::type
+        operator=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 0; i < N; ++i )
+            ( *this )( i ) = e( i );
+        return *this;
+    }
+
+    // Addition assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION
+        typename std::enable_if<is_vector<Expression>::value, Vector&>::type
         operator+=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
@@ -1851,7 +2100,7 @@ struct VectorView
     // Subtraction assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_vector<Expression>::value, VectorView&>::type
+        typename std::enable_if<is_vector<Expression>::value, Vector&>::type
         operator-=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
@@ -1867,12 +2116,12 @@ struct VectorView
 
     // Initializer list assignment operator.
     KOKKOS_INLINE_FUNCTION
-    VectorView& operator=( const std::initializer_list<T> data )
+    Vector& operator=( const std::initializer_list<T> data )
     {
         int i = 0;
         for ( const auto& value : data )
         {
-            ( *this )( i ) = value;
+            _d[i] = value;
             ++i;
         }
         return *this;
@@ -1880,7 +2129,7 @@ struct VectorView
 
     // Scalar value assignment.
     KOKKOS_INLINE_FUNCTION
-    VectorView& operator=( const T value )
+    Vector& operator=( const T value )
     {
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
@@ -1892,7 +2141,7 @@ struct VectorView
 
     // Normalization
     KOKKOS_INLINE_FUNCTION
-    VectorView& normalize()
+    Vector& normalize()
     {
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
@@ -1905,14 +2154,14 @@ struct VectorView
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_0() const { return _stride; }
+    int stride_0() const { return 1; }
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
     int stride_1() const { return 0; }
 
     KOKKOS_INLINE_FUNCTION
-    int stride( const int d ) const { return ( 0 == d ) ? _stride : 0; }
+    int stride( const int d ) const { return ( 0 == d ) ? 1 : 0; }
 
     // Extent
     KOKKOS_INLINE_FUNCTION
@@ -1923,38 +2172,32 @@ struct VectorView
 
     // Access an individual element.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i ) const { return _d[_stride * i]; }
+    const_reference operator()( const int i ) const { return _d[i]; }
 
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i ) { return _d[_stride * i]; }
+    reference operator()( const int i ) { return _d[i]; }
 
     // Access an individual element. 2D version for vectors treated as matrices.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i, const int ) const
-    {
-        return _d[_stride * i];
-    }
+    const_reference operator()( const int i, const int ) const { return _d[i]; }
 
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i, const int ) { return _d[_stride * i]; }
+    reference operator()( const int i, const int ) { return _d[i]; }
 
     // Get the raw data.
     KOKKOS_INLINE_FUNCTION
-    pointer data() const { return const_cast<pointer>( _d ); }
+    pointer data() const { return const_cast<pointer>( &_d[0] ); }
 };
 
 //---------------------------------------------------------------------------//
-// Tensor3
-//---------------------------------------------------------------------------//
-// Dense 3-dimensional tensor.
-template <class T, int M, int N, int P>
-struct Tensor3
+// Scalar overload.
+template <class T>
+struct Vector<T, 1>
 {
-    T _d[M][N][P];
+    T _d;
 
-    static constexpr int extent_0 = M;
-    static constexpr int extent_1 = N;
-    static constexpr int extent_2 = P;
+    static constexpr int extent_0 = 1;
+    static constexpr int extent_1 = 1;
 
     using value_type = T;
     using non_const_value_type = typename std::remove_cv<T>::type;
@@ -1962,281 +2205,128 @@ struct Tensor3
     using reference = T&;
     using const_reference = const T&;
 
-    using eval_type = Tensor3View<T, M, N, P>;
-    using copy_type = Tensor3<T, M, N, P>;
+    using eval_type = VectorView<T, 1>;
+    using copy_type = Vector<T, 1>;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    Tensor3() = default;
+    Vector() = default;
 
-    // Initializer list constructor.
+    // Scalar constructor.
     KOKKOS_INLINE_FUNCTION
-    Tensor3( const std::initializer_list<
-             std::initializer_list<std::initializer_list<T>>>
-                 data )
+    Vector( const T value )
+        : _d( value )
     {
-        int i = 0;
-        int j = 0;
-        int k = 0;
-        for ( const auto& slice : data )
-        {
-            j = 0;
-            for ( const auto& row : slice )
-            {
-                k = 0;
-                for ( const auto& value : row )
-                {
-                    _d[i][j][k] = value;
-                    ++k;
-                }
-                ++j;
-            }
-            ++i;
-        }
     }
 
     // Deep copy constructor. Triggers expression evaluation.
     template <
         class Expression,
-        typename std::enable_if<is_tensor3<Expression>::value, int>::type = 0>
-    KOKKOS_INLINE_FUNCTION Tensor3( const Expression& e )
+        typename std::enable_if<is_vector<Expression>::value, int>::type = 0>
+    KOKKOS_INLINE_FUNCTION Vector( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
-        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
-
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-            {
-                for ( int k = 0; k < P; ++k )
-                    ( *this )( i, j, k ) = e( i, j, k );
-            }
-    }
 
-    // Scalar constructor.
-    KOKKOS_INLINE_FUNCTION
-    Tensor3( const T value )
-    {
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-            {
-                for ( int k = 0; k < P; ++k )
-                    ( *this )( i, j, k ) = value;
-            }
+        _d = e( 0 );
     }
 
-    // Assignment operator. Triggers expression evaluation.
+    // Deep copy assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_tensor3<Expression>::value, Tensor3&>::type
+        typename std::enable_if<is_vector<Expression>::value, Vector&>::type
         operator=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
-        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
 
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-            {
-                for ( int k = 0; k < P; ++k )
-                    ( *this )( i, j, k ) = e( i, j, k );
-            }
+        _d = e( 0 );
         return *this;
     }
 
     // Addition assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_tensor3<Expression>::value, Tensor3&>::type
+        typename std::enable_if<is_vector<Expression>::value, Vector&>::type
         operator+=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
-        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
 
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-            {
-                for ( int k = 0; k < P; ++k )
-                    ( *this )( i, j, k ) += e( i, j, k );
-            }
+        _d += e( 0 );
         return *this;
     }
 
     // Subtraction assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_tensor3<Expression>::value, Tensor3&>::type
+        typename std::enable_if<is_vector<Expression>::value, Vector&>::type
         operator-=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
-        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
-
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-            {
-                for ( int k = 0; k < P; ++k )
-                    ( *this )( i, j, k ) -= e( i, j, k );
-            }
-        return *this;
-    }
-
-    // Initializer list assignment operator.
-    KOKKOS_INLINE_FUNCTION
-    Tensor3& operator=( const std::initializer_list<
-                        std::initializer_list<std::initializer_list<T>>>
-                            data )
-    {
-        int i = 0;
-        int j = 0;
-        int k = 0;
-        for ( const auto& slice : data )
-        {
-            j = 0;
-            for ( const auto& row : slice )
-            {
-                k = 0;
-                for ( const auto& value : row )
-                {
-                    _d[i][j][k] = value;
-                    ++k;
-                }
-                ++j;
-            }
-            ++i;
-        }
 
+        _d -= e( 0 );
         return *this;
     }
 
     // Scalar value assignment.
     KOKKOS_INLINE_FUNCTION
-    Tensor3& operator=( const T value )
+    Vector& operator=( const T value )
     {
-        for ( int i = 0; i < M; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < N; ++j )
-            {
-                for ( int k = 0; k < P; ++k )
-                    ( *this )( i, j, k ) = value;
-            }
+        _d = value;
         return *this;
     }
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_0() const { return N * P; }
-
-    KOKKOS_INLINE_FUNCTION
-    int stride_1() const { return P; }
+    int stride_0() const { return 1; }
 
     KOKKOS_INLINE_FUNCTION
-    int stride_2() const { return 1; }
+    int stride_1() const { return 1; }
 
     KOKKOS_INLINE_FUNCTION
-    int stride( const int d ) const
-    {
-        return ( 0 == d ) ? N * P : ( 1 == d ? P : 1 );
-    }
+    int stride( const int ) const { return 1; }
 
     // Extent
     KOKKOS_INLINE_FUNCTION
-    constexpr int extent( const int d ) const
-    {
-        return d == 2 ? extent_2
-                      : ( d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 ) );
-    }
+    constexpr int extent( const int ) const { return 1; }
 
     // Access an individual element.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i, const int j, const int k ) const
-    {
-        return _d[i][j][k];
-    }
+    const_reference operator()( const int ) const { return _d; }
 
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i, const int j, const int k )
-    {
-        return _d[i][j][k];
-    }
+    reference operator()( const int ) { return _d; }
 
-    // Get the raw data.
+    // Access an individual element. 2D version for vectors treated as matrices.
     KOKKOS_INLINE_FUNCTION
-    pointer data() const { return const_cast<pointer>( &_d[0][0][0] ); }
+    const_reference operator()( const int, const int ) const { return _d; }
 
-    // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, M> vector( const ALL_INDEX_t, const int n, const int p ) const
-    {
-        return VectorView<T, M>( const_cast<T*>( &_d[0][n][p] ), N * P );
-    }
-    // Get a row as a vector view.
+    reference operator()( const int, const int ) { return _d; }
+
+    // Get the raw data.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, N> vector( const int m, const ALL_INDEX_t, const int p ) const
-    {
-        return VectorView<T, N>( const_cast<T*>( &_d[m][0][p] ), P );
-    }
-    // Get a row as a vector view.
-    KOKKOS_INLINE_FUNCTION
-    VectorView<T, P> vector( const int m, const int n, const ALL_INDEX_t ) const
-    {
-        return VectorView<T, P>( const_cast<T*>( &_d[m][n][0] ), 1 );
-    }
+    pointer data() const { return const_cast<pointer>( &_d ); }
 
-    // Get a matrix as a matrix view.
-    KOKKOS_INLINE_FUNCTION
-    MatrixView<T, M, N> matrix( const ALL_INDEX_t, const ALL_INDEX_t,
-                                const int p ) const
-    {
-        return MatrixView<T, M, N>( const_cast<T*>( &_d[0][0][p] ), N * P, P );
-    }
-    // Get a matrix as a matrix view.
-    KOKKOS_INLINE_FUNCTION
-    MatrixView<T, M, P> matrix( const ALL_INDEX_t, const int n,
-                                const ALL_INDEX_t ) const
-    {
-        return MatrixView<T, M, P>( const_cast<T*>( &_d[0][n][0] ), N * P, 1 );
-    }
-    // Get a matrix as a matrix view.
+    // Scalar conversion operator.
     KOKKOS_INLINE_FUNCTION
-    MatrixView<T, N, P> matrix( const int m, const ALL_INDEX_t,
-                                const ALL_INDEX_t ) const
-    {
-        return MatrixView<T, N, P>( const_cast<T*>( &_d[m][0][0] ), P, 1 );
-    }
+    operator value_type() const { return _d; }
 };
 
 //---------------------------------------------------------------------------//
-// View for wrapping Tensor3 data.
+// View for wrapping vector data.
 //
 // NOTE: Data in this view may be non-contiguous.
-template <class T, int M, int N, int P>
-struct Tensor3View
+template <class T, int N>
+struct VectorView
 {
     T* _d;
-    int _stride[3];
+    int _stride;
 
-    static constexpr int extent_0 = M;
-    static constexpr int extent_1 = N;
-    static constexpr int extent_2 = P;
+    static constexpr int extent_0 = N;
+    static constexpr int extent_1 = 1;
 
     using value_type = T;
     using non_const_value_type = typename std::remove_cv<T>::type;
@@ -2244,229 +2334,152 @@ struct Tensor3View
     using reference = T&;
     using const_reference = const T&;
 
-    using eval_type = Tensor3View<T, M, N, P>;
-    using copy_type = Tensor3<T, M, N, P>;
+    using eval_type = VectorView<T, N>;
+    using copy_type = Vector<T, N>;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    Tensor3View() = default;
+    VectorView() = default;
 
-    // Tensor3View constructor.
+    // Vector constructor.
     KOKKOS_INLINE_FUNCTION
-    Tensor3View( const Tensor3<T, M, N, P>& t )
-        : _d( t.data() )
+    VectorView( const Vector<T, N>& v )
+        : _d( v.data() )
+        , _stride( v.stride_0() )
     {
-        _stride[0] = t.stride_0();
-        _stride[1] = t.stride_1();
-        _stride[2] = t.stride_2();
     }
 
     // Pointer constructor.
     KOKKOS_INLINE_FUNCTION
-    Tensor3View( T* data, const int stride_0, const int stride_1,
-                 const int stride_2 )
+    VectorView( T* data, const int stride )
         : _d( data )
+        , _stride( stride )
     {
-        _stride[0] = stride_0;
-        _stride[1] = stride_1;
-        _stride[2] = stride_2;
     }
 
     // Assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_tensor3<Expression>::value,
-                                Tensor3View&>::type
+        typename std::enable_if<is_vector<Expression>::value, VectorView&>::type
         operator=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
-        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
 
-        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-            for ( int j = 0; j < N; ++j )
-            {
-                for ( int k = 0; k < P; ++k )
-                    ( *this )( i, j, k ) = e( i, j, k );
-            }
+        for ( int i = 0; i < N; ++i )
+            ( *this )( i ) = e( i );
         return *this;
     }
 
     // Addition assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_tensor3<Expression>::value,
-                                Tensor3View&>::type
+        typename std::enable_if<is_vector<Expression>::value, VectorView&>::type
         operator+=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
-        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
 
-        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-            for ( int j = 0; j < N; ++j )
-            {
-                for ( int k = 0; k < P; ++k )
-                    ( *this )( i, j, k ) += e( i, j, k );
-            }
+        for ( int i = 0; i < N; ++i )
+            ( *this )( i ) += e( i );
         return *this;
     }
 
     // Subtraction assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_tensor3<Expression>::value,
-                                Tensor3View&>::type
+        typename std::enable_if<is_vector<Expression>::value, VectorView&>::type
         operator-=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
-        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
 
-        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-            for ( int j = 0; j < N; ++j )
-            {
-                for ( int k = 0; k < P; ++k )
-                    ( *this )( i, j, k ) -= e( i, j, k );
-            }
+        for ( int i = 0; i < N; ++i )
+            ( *this )( i ) -= e( i );
         return *this;
     }
 
     // Initializer list assignment operator.
     KOKKOS_INLINE_FUNCTION
-    Tensor3View& operator=( const std::initializer_list<
-                            std::initializer_list<std::initializer_list<T>>>
-                                data )
+    VectorView& operator=( const std::initializer_list<T> data )
     {
         int i = 0;
-        int j = 0;
-        int k = 0;
-        for ( const auto& slice : data )
+        for ( const auto& value : data )
         {
-            j = 0;
-            for ( const auto& row : slice )
-            {
-                k = 0;
-                for ( const auto& value : row )
-                {
-                    ( *this )( i, j, k ) = value;
-                    ++k;
-                }
-                ++j;
-            }
+            ( *this )( i ) = value;
             ++i;
         }
-
         return *this;
     }
 
     // Scalar value assignment.
     KOKKOS_INLINE_FUNCTION
-    Tensor3View& operator=( const T value )
+    VectorView& operator=( const T value )
     {
-        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-            for ( int j = 0; j < N; ++j )
-            {
-                for ( int k = 0; k < P; ++k )
-                    ( *this )( i, j, k ) = value;
-            }
+        for ( int i = 0; i < N; ++i )
+            ( *this )( i ) = value;
         return *this;
     }
 
-    // Strides.
+    // Normalization
     KOKKOS_INLINE_FUNCTION
-    int stride_0() const { return _stride[0]; }
+    VectorView& normalize()
+    {
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        auto norm2 = Kokkos::sqrt( ~( *this ) * ( *this ) );
+        for ( int i = 0; i < N; ++i )
+            ( *this )( i ) /= norm2;
+        return *this;
+    }
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_1() const { return _stride[1]; }
+    int stride_0() const { return _stride; }
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_2() const { return _stride[2]; }
+    int stride_1() const { return 0; }
 
     KOKKOS_INLINE_FUNCTION
-    int stride( const int d ) const { return _stride[d]; }
+    int stride( const int d ) const { return ( 0 == d ) ? _stride : 0; }
 
     // Extent
     KOKKOS_INLINE_FUNCTION
     constexpr int extent( const int d ) const
     {
-        return d == 2 ? extent_2
-                      : ( d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 ) );
+        return d == 0 ? extent_0 : ( d == 1 ? 1 : 0 );
     }
 
     // Access an individual element.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i, const int j, const int k ) const
-    {
-        return _d[_stride[0] * i + _stride[1] * j + _stride[2] * k];
-    }
+    const_reference operator()( const int i ) const { return _d[_stride * i]; }
 
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i, const int j, const int k )
-    {
-        return _d[_stride[0] * i + _stride[1] * j + _stride[2] * k];
-    }
+    reference operator()( const int i ) { return _d[_stride * i]; }
 
-    // Get a row as a vector view.
-    KOKKOS_INLINE_FUNCTION
-    VectorView<T, M> vector( const ALL_INDEX_t, const int n, const int p ) const
-    {
-        return VectorView<T, M>(
-            const_cast<T*>( &_d[_stride[1] * n + _stride[2] * p] ), N * P );
-    }
-    // Get a row as a vector view.
-    KOKKOS_INLINE_FUNCTION
-    VectorView<T, N> vector( const int m, const ALL_INDEX_t, const int p ) const
-    {
-        return VectorView<T, N>(
-            const_cast<T*>( &_d[_stride[0] * m + _stride[2] * p] ), P );
-    }
-    // Get a row as a vector view.
+    // Access an individual element. 2D version for vectors treated as matrices.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, P> vector( const int m, const int n, const ALL_INDEX_t ) const
+    const_reference operator()( const int i, const int ) const
     {
-        return VectorView<T, P>(
-            const_cast<T*>( &_d[_stride[0] * m + _stride[1] * n] ), 1 );
+        return _d[_stride * i];
     }
 
-    // Get a matrix as a matrix view.
-    KOKKOS_INLINE_FUNCTION
-    MatrixView<T, M, N> matrix( const ALL_INDEX_t, const ALL_INDEX_t,
-                                const int p ) const
-    {
-        return MatrixView<T, M, N>( const_cast<T*>( &_d[_stride[2] * p] ),
-                                    N * P, P );
-    }
-    // Get a matrix as a matrix view.
-    KOKKOS_INLINE_FUNCTION
-    MatrixView<T, M, P> matrix( const ALL_INDEX_t, const int n,
-                                const ALL_INDEX_t ) const
-    {
-        return MatrixView<T, M, P>( const_cast<T*>( &_d[_stride[1] * n] ),
-                                    N * P, 1 );
-    }
-    // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
-    MatrixView<T, N, P> matrix( const int m, const ALL_INDEX_t,
-                                const ALL_INDEX_t ) const
-    {
-        return MatrixView<T, N, P>( const_cast<T*>( &_d[_stride[0] * m] ), P,
-                                    1 );
-    }
+    reference operator()( const int i, const int ) { return _d[_stride * i]; }
 
     // Get the raw data.
     KOKKOS_INLINE_FUNCTION
@@ -2474,18 +2487,17 @@ struct Tensor3View
 };
 
 //---------------------------------------------------------------------------//
-// Tensor4
+// Tensor3
 //---------------------------------------------------------------------------//
-// Dense rank-4 tensor.
-template <class T, int M, int N, int P, int Q>
-struct Tensor4
+// Dense 3-dimensional tensor.
+template <class T, int M, int N, int P>
+struct Tensor3
 {
-    T _d[M][N][P][Q];
+    T _d[M][N][P];
 
     static constexpr int extent_0 = M;
     static constexpr int extent_1 = N;
     static constexpr int extent_2 = P;
-    static constexpr int extent_3 = Q;
 
     using value_type = T;
     using non_const_value_type = typename std::remove_cv<T>::type;
@@ -2493,38 +2505,31 @@ struct Tensor4
     using reference = T&;
     using const_reference = const T&;
 
-    using eval_type = Tensor4View<T, M, N, P, Q>;
-    using copy_type = Tensor4<T, M, N, P, Q>;
+    using eval_type = Tensor3View<T, M, N, P>;
+    using copy_type = Tensor3<T, M, N, P>;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    Tensor4() = default;
+    Tensor3() = default;
 
     // Initializer list constructor.
     KOKKOS_INLINE_FUNCTION
-    Tensor4( const std::initializer_list<std::initializer_list<
-                 std::initializer_list<std::initializer_list<T>>>>
+    Tensor3( const std::initializer_list<
+             std::initializer_list<std::initializer_list<T>>>
                  data )
     {
         int i = 0;
         int j = 0;
         int k = 0;
-        int l = 0;
-
-        for ( const auto& block : data )
+        for ( const auto& slice : data )
         {
             j = 0;
-            for ( const auto& slice : block )
+            for ( const auto& row : slice )
             {
                 k = 0;
-                for ( const auto& row : slice )
+                for ( const auto& value : row )
                 {
-                    l = 0;
-                    for ( const auto& value : row )
-                    {
-                        _d[i][j][k][l] = value;
-                        ++l;
-                    }
+                    _d[i][j][k] = value;
                     ++k;
                 }
                 ++j;
@@ -2536,13 +2541,12 @@ struct Tensor4
     // Deep copy constructor. Triggers expression evaluation.
     template <
         class Expression,
-        typename std::enable_if<is_tensor4<Expression>::value, int>::type = 0>
-    KOKKOS_INLINE_FUNCTION Tensor4( const Expression& e )
+        typename std::enable_if<is_tensor3<Expression>::value, int>::type = 0>
+    KOKKOS_INLINE_FUNCTION Tensor3( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
         static_assert( Expression::extent_2 == extent_2, "Extents must match" );
-        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
         for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
@@ -2551,16 +2555,13 @@ struct Tensor4
             for ( int j = 0; j < N; ++j )
             {
                 for ( int k = 0; k < P; ++k )
-                {
-                    for ( int l = 0; l < Q; ++l )
-                        ( *this )( i, j, k, l ) = e( i, j, k, l );
-                }
+                    ( *this )( i, j, k ) = e( i, j, k );
             }
     }
 
     // Scalar constructor.
     KOKKOS_INLINE_FUNCTION
-    Tensor4( const T value )
+    Tensor3( const T value )
     {
         for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
@@ -2569,23 +2570,19 @@ struct Tensor4
             for ( int j = 0; j < N; ++j )
             {
                 for ( int k = 0; k < P; ++k )
-                {
-                    for ( int l = 0; l < Q; ++l )
-                        ( *this )( i, j, k, l ) = value;
-                }
+                    ( *this )( i, j, k ) = value;
             }
     }
 
     // Assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_tensor4<Expression>::value, Tensor4&>::type
+        typename std::enable_if<is_tensor3<Expression>::value, Tensor3&>::type
         operator=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
         static_assert( Expression::extent_2 == extent_2, "Extents must match" );
-        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
         for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
@@ -2594,10 +2591,7 @@ struct Tensor4
             for ( int j = 0; j < N; ++j )
             {
                 for ( int k = 0; k < P; ++k )
-                {
-                    for ( int l = 0; l < Q; ++l )
-                        ( *this )( i, j, k, l ) = e( i, j, k, l );
-                }
+                    ( *this )( i, j, k ) = e( i, j, k );
             }
         return *this;
     }
@@ -2605,13 +2599,12 @@ struct Tensor4
     // Addition assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_tensor4<Expression>::value, Tensor4&>::type
+        typename std::enable_if<is_tensor3<Expression>::value, Tensor3&>::type
         operator+=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
         static_assert( Expression::extent_2 == extent_2, "Extents must match" );
-        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
         for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
@@ -2620,10 +2613,7 @@ struct Tensor4
             for ( int j = 0; j < N; ++j )
             {
                 for ( int k = 0; k < P; ++k )
-                {
-                    for ( int l = 0; l < Q; ++l )
-                        ( *this )( i, j, k, l ) += e( i, j, k, l );
-                }
+                    ( *this )( i, j, k ) += e( i, j, k );
             }
         return *this;
     }
@@ -2631,13 +2621,12 @@ struct Tensor4
     // Subtraction assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_tensor4<Expression>::value, Tensor4&>::type
+        typename std::enable_if<is_tensor3<Expression>::value, Tensor3&>::type
         operator-=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
         static_assert( Expression::extent_2 == extent_2, "Extents must match" );
-        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
         for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
@@ -2646,38 +2635,29 @@ struct Tensor4
             for ( int j = 0; j < N; ++j )
             {
                 for ( int k = 0; k < P; ++k )
-                {
-                    for ( int l = 0; l < Q; ++l )
-                        ( *this )( i, j, k, l ) -= e( i, j, k, l );
-                }
+                    ( *this )( i, j, k ) -= e( i, j, k );
             }
         return *this;
     }
 
     // Initializer list assignment operator.
     KOKKOS_INLINE_FUNCTION
-    Tensor4& operator=( const std::initializer_list<std::initializer_list<
-                            std::initializer_list<std::initializer_list<T>>>>
+    Tensor3& operator=( const std::initializer_list<
+                        std::initializer_list<std::initializer_list<T>>>
                             data )
     {
         int i = 0;
         int j = 0;
         int k = 0;
-        int l = 0;
-        for ( const auto& block : data )
+        for ( const auto& slice : data )
         {
             j = 0;
-            for ( const auto& slice : block )
+            for ( const auto& row : slice )
             {
                 k = 0;
-                for ( const auto& row : slice )
+                for ( const auto& value : row )
                 {
-                    l = 0;
-                    for ( const auto& value : row )
-                    {
-                        _d[i][j][k][l] = value;
-                        ++l;
-                    }
+                    _d[i][j][k] = value;
                     ++k;
                 }
                 ++j;
@@ -2690,7 +2670,7 @@ struct Tensor4
 
     // Scalar value assignment.
     KOKKOS_INLINE_FUNCTION
-    Tensor4& operator=( const T value )
+    Tensor3& operator=( const T value )
     {
         for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
@@ -2699,184 +2679,107 @@ struct Tensor4
             for ( int j = 0; j < N; ++j )
             {
                 for ( int k = 0; k < P; ++k )
-                {
-                    for ( int l = 0; l < Q; ++l )
-                        ( *this )( i, j, k, l ) = value;
-                }
+                    ( *this )( i, j, k ) = value;
             }
         return *this;
     }
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_0() const { return N * P * Q; }
-
-    KOKKOS_INLINE_FUNCTION
-    int stride_1() const { return P * Q; }
+    int stride_0() const { return N * P; }
 
     KOKKOS_INLINE_FUNCTION
-    int stride_2() const { return Q; }
+    int stride_1() const { return P; }
 
     KOKKOS_INLINE_FUNCTION
-    int stride_3() const { return 1; }
+    int stride_2() const { return 1; }
 
     KOKKOS_INLINE_FUNCTION
     int stride( const int d ) const
     {
-        return 2 == d ? Q : ( ( 0 == d ) ? N * P * Q : ( 1 == d ? P * Q : 1 ) );
+        return ( 0 == d ) ? N * P : ( 1 == d ? P : 1 );
     }
 
     // Extent
     KOKKOS_INLINE_FUNCTION
     constexpr int extent( const int d ) const
     {
-        return d == 3 ? extent_3
-                      : ( d == 2 ? extent_2
-                                 : ( d == 0 ? extent_0
-                                            : ( d == 1 ? extent_1 : 0 ) ) );
+        return d == 2 ? extent_2
+                      : ( d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 ) );
     }
 
     // Access an individual element.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i, const int j, const int k,
-                                const int l ) const
+    const_reference operator()( const int i, const int j, const int k ) const
     {
-        return _d[i][j][k][l];
+        return _d[i][j][k];
     }
 
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i, const int j, const int k, const int l )
+    reference operator()( const int i, const int j, const int k )
     {
-        return _d[i][j][k][l];
+        return _d[i][j][k];
     }
 
     // Get the raw data.
     KOKKOS_INLINE_FUNCTION
-    pointer data() const { return const_cast<pointer>( &_d[0][0][0][0] ); }
+    pointer data() const { return const_cast<pointer>( &_d[0][0][0] ); }
 
     // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, M> vector( const ALL_INDEX_t, const int n, const int p,
-                             const int q ) const
+    VectorView<T, M> vector( const ALL_INDEX_t, const int n, const int p ) const
     {
-        return VectorView<T, M>( const_cast<T*>( &_d[0][n][p][q] ), N * P * Q );
+        return VectorView<T, M>( const_cast<T*>( &_d[0][n][p] ), N * P );
     }
     // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, N> vector( const int m, const ALL_INDEX_t, const int p,
-                             const int q ) const
-    {
-        return VectorView<T, N>( const_cast<T*>( &_d[m][0][p][q] ), P * Q );
-    } // Get a row as a vector view.
-    KOKKOS_INLINE_FUNCTION
-    VectorView<T, P> vector( const int m, const int n, const ALL_INDEX_t,
-                             const int q ) const
+    VectorView<T, N> vector( const int m, const ALL_INDEX_t, const int p ) const
     {
-        return VectorView<T, P>( const_cast<T*>( &_d[m][n][0][q] ), Q );
-    } // Get a row as a vector view.
+        return VectorView<T, N>( const_cast<T*>( &_d[m][0][p] ), P );
+    }
+    // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, Q> vector( const int m, const int n, const int p,
-                             const ALL_INDEX_t ) const
+    VectorView<T, P> vector( const int m, const int n, const ALL_INDEX_t ) const
     {
-        return VectorView<T, Q>( const_cast<T*>( &_d[m][n][p][0] ), 1 );
+        return VectorView<T, P>( const_cast<T*>( &_d[m][n][0] ), 1 );
     }
 
     // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
     MatrixView<T, M, N> matrix( const ALL_INDEX_t, const ALL_INDEX_t,
-                                const int p, const int q ) const
+                                const int p ) const
     {
-        return MatrixView<T, M, N>( const_cast<T*>( &_d[0][0][p][q] ),
-                                    N * P * Q, P * Q );
+        return MatrixView<T, M, N>( const_cast<T*>( &_d[0][0][p] ), N * P, P );
     }
     // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
     MatrixView<T, M, P> matrix( const ALL_INDEX_t, const int n,
-                                const ALL_INDEX_t, const int q ) const
-    {
-        return MatrixView<T, M, P>( const_cast<T*>( &_d[0][n][0][q] ),
-                                    N * P * Q, Q );
-    }
-    // Get a matrix as a matrix view.
-    KOKKOS_INLINE_FUNCTION
-    MatrixView<T, N, P> matrix( const int m, const ALL_INDEX_t,
-                                const ALL_INDEX_t, const int q ) const
-    {
-        return MatrixView<T, N, P>( const_cast<T*>( &_d[m][0][0][q] ), P * Q,
-                                    Q );
-    }
-    // Get a matrix as a matrix view.
-    KOKKOS_INLINE_FUNCTION
-    MatrixView<T, M, Q> matrix( const ALL_INDEX_t, const int n, const int p,
-                                const ALL_INDEX_t ) const
-    {
-        return MatrixView<T, M, Q>( const_cast<T*>( &_d[0][n][p][0] ),
-                                    N * P * Q, 1 );
-    }
-    // Get a matrix as a matrix view.
-    KOKKOS_INLINE_FUNCTION
-    MatrixView<T, N, Q> matrix( const int m, const ALL_INDEX_t, const int p,
                                 const ALL_INDEX_t ) const
     {
-        return MatrixView<T, N, Q>( const_cast<T*>( &_d[m][0][p][0] ), P * Q,
-                                    1 );
+        return MatrixView<T, M, P>( const_cast<T*>( &_d[0][n][0] ), N * P, 1 );
     }
     // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
-    MatrixView<T, P, Q> matrix( const int m, const int n, const ALL_INDEX_t,
+    MatrixView<T, N, P> matrix( const int m, const ALL_INDEX_t,
                                 const ALL_INDEX_t ) const
     {
-        return MatrixView<T, P, Q>( const_cast<T*>( &_d[m][n][0][0] ), Q, 1 );
-    }
-
-    // Get a tensor3 as a Tensor3 view.
-    KOKKOS_INLINE_FUNCTION
-    Tensor3View<T, M, N, P> tensor3( const ALL_INDEX_t, const ALL_INDEX_t,
-                                     const ALL_INDEX_t, const int b )
-    {
-        return Tensor3View<T, M, N, P>( const_cast<T*>( &_d[0][0][0][b] ),
-                                        N * P * Q, P * Q, Q );
-    }
-    // Get a tensor3 as a Tensor3 view.
-    KOKKOS_INLINE_FUNCTION
-    Tensor3View<T, M, N, Q> tensor3( const ALL_INDEX_t, const ALL_INDEX_t,
-                                     const int b, const ALL_INDEX_t )
-    {
-        return Tensor3View<T, M, N, Q>( const_cast<T*>( &_d[0][0][b][0] ),
-                                        N * P * Q, P * Q, 1 );
-    }
-    // Get a tensor3 as a Tensor3 view.
-    KOKKOS_INLINE_FUNCTION
-    Tensor3View<T, M, P, Q> tensor3( const ALL_INDEX_t, const int b,
-                                     const ALL_INDEX_t, const ALL_INDEX_t )
-    {
-        return Tensor3View<T, M, P, Q>( const_cast<T*>( &_d[0][b][0][0] ),
-                                        N * P * Q, Q, 1 );
-    }
-    // Get a tensor3 as a Tensor3 view.
-    KOKKOS_INLINE_FUNCTION
-    Tensor3View<T, N, P, Q> tensor3( const int b, const ALL_INDEX_t,
-                                     const ALL_INDEX_t, const ALL_INDEX_t )
-    {
-        return Tensor3View<T, N, P, Q>( const_cast<T*>( &_d[b][0][0][0] ),
-                                        P * Q, Q, 1 );
+        return MatrixView<T, N, P>( const_cast<T*>( &_d[m][0][0] ), P, 1 );
     }
 };
 
 //---------------------------------------------------------------------------//
-// View for wrapping Tensor4 data.
+// View for wrapping Tensor3 data.
 //
 // NOTE: Data in this view may be non-contiguous.
-template <class T, int M, int N, int P, int Q>
-struct Tensor4View
+template <class T, int M, int N, int P>
+struct Tensor3View
 {
     T* _d;
-    int _stride[4];
+    int _stride[3];
 
     static constexpr int extent_0 = M;
     static constexpr int extent_1 = N;
     static constexpr int extent_2 = P;
-    static constexpr int extent_3 = Q;
 
     using value_type = T;
     using non_const_value_type = typename std::remove_cv<T>::type;
@@ -2884,47 +2787,44 @@ struct Tensor4View
     using reference = T&;
     using const_reference = const T&;
 
-    using eval_type = Tensor4View<T, M, N, P, Q>;
-    using copy_type = Tensor4<T, M, N, P, Q>;
+    using eval_type = Tensor3View<T, M, N, P>;
+    using copy_type = Tensor3<T, M, N, P>;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    Tensor4View() = default;
+    Tensor3View() = default;
 
     // Tensor3View constructor.
     KOKKOS_INLINE_FUNCTION
-    Tensor4View( const Tensor4<T, M, N, P, Q>& t )
+    Tensor3View( const Tensor3<T, M, N, P>& t )
         : _d( t.data() )
     {
         _stride[0] = t.stride_0();
         _stride[1] = t.stride_1();
         _stride[2] = t.stride_2();
-        _stride[3] = t.stride_3();
     }
 
     // Pointer constructor.
     KOKKOS_INLINE_FUNCTION
-    Tensor4View( T* data, const int stride_0, const int stride_1,
-                 const int stride_2, const int stride_3 )
+    Tensor3View( T* data, const int stride_0, const int stride_1,
+                 const int stride_2 )
         : _d( data )
     {
         _stride[0] = stride_0;
         _stride[1] = stride_1;
         _stride[2] = stride_2;
-        _stride[3] = stride_3;
     }
 
     // Assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_tensor4<Expression>::value,
-                                Tensor4View&>::type
+        typename std::enable_if<is_tensor3<Expression>::value,
+                                Tensor3View&>::type
         operator=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
         static_assert( Expression::extent_2 == extent_2, "Extents must match" );
-        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
         for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
@@ -2933,10 +2833,7 @@ struct Tensor4View
             for ( int j = 0; j < N; ++j )
             {
                 for ( int k = 0; k < P; ++k )
-                {
-                    for ( int l = 0; l < Q; ++l )
-                        ( *this )( i, j, k, l ) = e( i, j, k, l );
-                }
+                    ( *this )( i, j, k ) = e( i, j, k );
             }
         return *this;
     }
@@ -2944,14 +2841,13 @@ struct Tensor4View
     // Addition assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_tensor4<Expression>::value,
-                                Tensor4View&>::type
+        typename std::enable_if<is_tensor3<Expression>::value,
+                                Tensor3View&>::type
         operator+=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
         static_assert( Expression::extent_2 == extent_2, "Extents must match" );
-        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
         for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
@@ -2960,10 +2856,7 @@ struct Tensor4View
             for ( int j = 0; j < N; ++j )
             {
                 for ( int k = 0; k < P; ++k )
-                {
-                    for ( int l = 0; l < Q; ++l )
-                        ( *this )( i, j, k, l ) += e( i, j, k, l );
-                }
+                    ( *this )( i, j, k ) += e( i, j, k );
             }
         return *this;
     }
@@ -2971,14 +2864,13 @@ struct Tensor4View
     // Subtraction assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_tensor4<Expression>::value,
-                                Tensor4View&>::type
+        typename std::enable_if<is_tensor3<Expression>::value,
+                                Tensor3View&>::type
         operator-=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
         static_assert( Expression::extent_2 == extent_2, "Extents must match" );
-        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
         for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
@@ -2987,39 +2879,29 @@ struct Tensor4View
             for ( int j = 0; j < N; ++j )
             {
                 for ( int k = 0; k < P; ++k )
-                {
-                    for ( int l = 0; l < Q; ++l )
-                        ( *this )( i, j, k, l ) -= e( i, j, k, l );
-                }
+                    ( *this )( i, j, k ) -= e( i, j, k );
             }
         return *this;
     }
 
     // Initializer list assignment operator.
     KOKKOS_INLINE_FUNCTION
-    Tensor4View&
-    operator=( const std::initializer_list<std::initializer_list<
-                   std::initializer_list<std::initializer_list<T>>>>
-                   data )
+    Tensor3View& operator=( const std::initializer_list<
+                            std::initializer_list<std::initializer_list<T>>>
+                                data )
     {
         int i = 0;
         int j = 0;
         int k = 0;
-        int l = 0;
-        for ( const auto& block : data )
+        for ( const auto& slice : data )
         {
             j = 0;
-            for ( const auto& slice : block )
+            for ( const auto& row : slice )
             {
                 k = 0;
-                for ( const auto& row : slice )
+                for ( const auto& value : row )
                 {
-                    l = 0;
-                    for ( const auto& value : row )
-                    {
-                        ( *this )( i, j, k, l ) = value;
-                        ++l;
-                    }
+                    ( *this )( i, j, k ) = value;
                     ++k;
                 }
                 ++j;
@@ -3032,7 +2914,7 @@ struct Tensor4View
 
     // Scalar value assignment.
     KOKKOS_INLINE_FUNCTION
-    Tensor4View& operator=( const T value )
+    Tensor3View& operator=( const T value )
     {
         for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
@@ -3041,10 +2923,7 @@ struct Tensor4View
             for ( int j = 0; j < N; ++j )
             {
                 for ( int k = 0; k < P; ++k )
-                {
-                    for ( int l = 0; l < Q; ++l )
-                        ( *this )( i, j, k, l ) = value;
-                }
+                    ( *this )( i, j, k ) = value;
             }
         return *this;
     }
@@ -3061,10 +2940,6 @@ struct Tensor4View
     KOKKOS_INLINE_FUNCTION
     int stride_2() const { return _stride[2]; }
 
-    // Strides.
-    KOKKOS_INLINE_FUNCTION
-    int stride_3() const { return _stride[3]; }
-
     KOKKOS_INLINE_FUNCTION
     int stride( const int d ) const { return _stride[d]; }
 
@@ -3072,152 +2947,71 @@ struct Tensor4View
     KOKKOS_INLINE_FUNCTION
     constexpr int extent( const int d ) const
     {
-        return d == 3 ? extent_3
-                      : ( d == 2 ? extent_2
-                                 : ( d == 0 ? extent_0
-                                            : ( d == 1 ? extent_1 : 0 ) ) );
+        return d == 2 ? extent_2
+                      : ( d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 ) );
     }
 
     // Access an individual element.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i, const int j, const int k,
-                                const int l ) const
+    const_reference operator()( const int i, const int j, const int k ) const
     {
-        return _d[_stride[0] * i + _stride[1] * j + _stride[2] * k +
-                  _stride[3] * l];
+        return _d[_stride[0] * i + _stride[1] * j + _stride[2] * k];
     }
 
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i, const int j, const int k, const int l )
+    reference operator()( const int i, const int j, const int k )
     {
-        return _d[_stride[0] * i + _stride[1] * j + _stride[2] * k +
-                  _stride[3] * l];
+        return _d[_stride[0] * i + _stride[1] * j + _stride[2] * k];
     }
 
     // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, M> vector( const ALL_INDEX_t, const int n, const int p,
-                             const int q ) const
+    VectorView<T, M> vector( const ALL_INDEX_t, const int n, const int p ) const
     {
         return VectorView<T, M>(
-            const_cast<T*>(
-                &_d[_stride[1] * n + _stride[2] * p + _stride[3] * q] ),
-            N * P * Q );
+            const_cast<T*>( &_d[_stride[1] * n + _stride[2] * p] ),
+            _stride[0] );
     }
     // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, N> vector( const int m, const ALL_INDEX_t, const int p,
-                             const int q ) const
+    VectorView<T, N> vector( const int m, const ALL_INDEX_t, const int p ) const
     {
         return VectorView<T, N>(
-            const_cast<T*>(
-                &_d[_stride[0] * m + _stride[2] * p + _stride[3] * q] ),
-            P * Q );
+            const_cast<T*>( &_d[_stride[0] * m + _stride[2] * p] ),
+            _stride[1] );
     }
     // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, P> vector( const int m, const int n, const ALL_INDEX_t,
-                             const int q ) const
+    VectorView<T, P> vector( const int m, const int n, const ALL_INDEX_t ) const
     {
         return VectorView<T, P>(
-            const_cast<T*>(
-                &_d[_stride[0] * m + _stride[1] * n + _stride[3] * q] ),
-            Q );
-    }
-    // Get a row as a vector view.
-    KOKKOS_INLINE_FUNCTION
-    VectorView<T, Q> vector( const int m, const int n, const int p,
-                             const ALL_INDEX_t ) const
-    {
-        return VectorView<T, Q>(
-            const_cast<T*>(
-                &_d[_stride[0] * m + _stride[1] * n + _stride[2] * p] ),
-            1 );
+            const_cast<T*>( &_d[_stride[0] * m + _stride[1] * n] ),
+            _stride[2] );
     }
 
     // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
     MatrixView<T, M, N> matrix( const ALL_INDEX_t, const ALL_INDEX_t,
-                                const int p, const int q ) const
+                                const int p ) const
     {
-        return MatrixView<T, M, N>(
-            const_cast<T*>( &_d[_stride[2] * p + _stride[3] * q] ), N * P * Q,
-            P * Q );
+        return MatrixView<T, M, N>( const_cast<T*>( &_d[_stride[2] * p] ),
+                                    _stride[0], _stride[1] );
     }
     // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
     MatrixView<T, M, P> matrix( const ALL_INDEX_t, const int n,
-                                const ALL_INDEX_t, const int q ) const
-    {
-        return MatrixView<T, M, P>(
-            const_cast<T*>( &_d[_stride[1] * n + _stride[3] * q] ), N * P * Q,
-            Q );
-    }
-    // Get a matrix as a matrix view.
-    KOKKOS_INLINE_FUNCTION
-    MatrixView<T, N, P> matrix( const int m, const ALL_INDEX_t,
-                                const ALL_INDEX_t, const int q ) const
-    {
-        return MatrixView<T, N, P>(
-            const_cast<T*>( &_d[_stride[0] * m + _stride[3] * q] ), P * Q, Q );
-    }
-    // Get a matrix as a matrix view.
-    KOKKOS_INLINE_FUNCTION
-    MatrixView<T, M, Q> matrix( const ALL_INDEX_t, const int n, const int p,
-                                const ALL_INDEX_t ) const
-    {
-        return MatrixView<T, M, Q>(
-            const_cast<T*>( &_d[_stride[1] * n + _stride[2] * p] ), N * P * Q,
-            1 );
-    }
-    // Get a matrix as a matrix view.
-    KOKKOS_INLINE_FUNCTION
-    MatrixView<T, N, Q> matrix( const int m, const ALL_INDEX_t, const int p,
                                 const ALL_INDEX_t ) const
     {
-        return MatrixView<T, N, Q>(
-            const_cast<T*>( &_d[_stride[0] * m + _stride[2] * p] ), P * Q, 1 );
+        return MatrixView<T, M, P>( const_cast<T*>( &_d[_stride[1] * n] ),
+                                    _stride[0], _stride[2] );
     }
     // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
-    MatrixView<T, P, Q> matrix( const int m, const int n, const ALL_INDEX_t,
+    MatrixView<T, N, P> matrix( const int m, const ALL_INDEX_t,
                                 const ALL_INDEX_t ) const
     {
-        return MatrixView<T, P, Q>(
-            const_cast<T*>( &_d[_stride[0] * m + _stride[1] * n] ), Q, 1 );
-    }
-
-    // Get a tensor3 as a Tensor3 view.
-    KOKKOS_INLINE_FUNCTION
-    Tensor3View<T, M, N, P> tensor3( const ALL_INDEX_t, const ALL_INDEX_t,
-                                     const ALL_INDEX_t, const int b )
-    {
-        return Tensor3View<T, M, N, P>( const_cast<T*>( &_d[_stride[3] * b] ),
-                                        N * P * Q, P * Q, Q );
-    }
-    // Get a tensor3 as a Tensor3 view.
-    KOKKOS_INLINE_FUNCTION
-    Tensor3View<T, M, N, Q> tensor3( const ALL_INDEX_t, const ALL_INDEX_t,
-                                     const int b, const ALL_INDEX_t )
-    {
-        return Tensor3View<T, M, N, Q>( const_cast<T*>( &_d[_stride[2] * b] ),
-                                        N * P * Q, P * Q, 1 );
-    }
-    // Get a tensor3 as a Tensor3 view.
-    KOKKOS_INLINE_FUNCTION
-    Tensor3View<T, M, P, Q> tensor3( const ALL_INDEX_t, const int b,
-                                     const ALL_INDEX_t, const ALL_INDEX_t )
-    {
-        return Tensor3View<T, M, P, Q>( const_cast<T*>( &_d[_stride[1] * b] ),
-                                        N * P * Q, Q, 1 );
-    }
-    // Get a tensor3 as a Tensor3 view.
-    KOKKOS_INLINE_FUNCTION
-    Tensor3View<T, N, P, Q> tensor3( const int b, const ALL_INDEX_t,
-                                     const ALL_INDEX_t, const ALL_INDEX_t )
-    {
-        return Tensor3View<T, N, P, Q>( const_cast<T*>( &_d[_stride[0] * b] ),
-                                        P * Q, Q, 1 );
+        return MatrixView<T, N, P>( const_cast<T*>( &_d[_stride[0] * m] ),
+                                    _stride[1], _stride[2] );
     }
 
     // Get the raw data.
@@ -3226,16 +3020,18 @@ struct Tensor4View
 };
 
 //---------------------------------------------------------------------------//
-// Quaternion
+// Tensor4
 //---------------------------------------------------------------------------//
-// Quaternion.
-template <class T>
-struct Quaternion
+// Dense rank-4 tensor.
+template <class T, int M, int N, int P, int Q>
+struct Tensor4
 {
-    T _d[4];
+    T _d[M][N][P][Q];
 
-    static constexpr int extent_0 = 4;
-    static constexpr int extent_1 = 1;
+    static constexpr int extent_0 = M;
+    static constexpr int extent_1 = N;
+    static constexpr int extent_2 = P;
+    static constexpr int extent_3 = Q;
 
     using value_type = T;
     using non_const_value_type = typename std::remove_cv<T>::type;
@@ -3243,213 +3039,390 @@ struct Quaternion
     using reference = T&;
     using const_reference = const T&;
 
-    using eval_type = QuaternionView<T>;
-    using copy_type = Quaternion<T>;
+    using eval_type = Tensor4View<T, M, N, P, Q>;
+    using copy_type = Tensor4<T, M, N, P, Q>;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    Quaternion() = default;
+    Tensor4() = default;
 
     // Initializer list constructor.
     KOKKOS_INLINE_FUNCTION
-    Quaternion( const std::initializer_list<T> data )
+    Tensor4( const std::initializer_list<std::initializer_list<
+                 std::initializer_list<std::initializer_list<T>>>>
+                 data )
     {
         int i = 0;
-        for ( const auto& value : data )
+        int j = 0;
+        int k = 0;
+        int l = 0;
+
+        for ( const auto& block : data )
         {
-            _d[i] = value;
+            j = 0;
+            for ( const auto& slice : block )
+            {
+                k = 0;
+                for ( const auto& row : slice )
+                {
+                    l = 0;
+                    for ( const auto& value : row )
+                    {
+                        _d[i][j][k][l] = value;
+                        ++l;
+                    }
+                    ++k;
+                }
+                ++j;
+            }
             ++i;
         }
     }
 
     // Deep copy constructor. Triggers expression evaluation.
-    template <class Expression,
-              typename std::enable_if<is_quaternion<Expression>::value,
-                                      int>::type = 0>
-    KOKKOS_INLINE_FUNCTION Quaternion( const Expression& e )
+    template <
+        class Expression,
+        typename std::enable_if<is_tensor4<Expression>::value, int>::type = 0>
+    KOKKOS_INLINE_FUNCTION Tensor4( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
+        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < extent_0; ++i )
-            ( *this )( i ) = e( i );
+            for ( int j = 0; j < N; ++j )
+            {
+                for ( int k = 0; k < P; ++k )
+                {
+                    for ( int l = 0; l < Q; ++l )
+                        ( *this )( i, j, k, l ) = e( i, j, k, l );
+                }
+            }
     }
 
     // Scalar constructor.
     KOKKOS_INLINE_FUNCTION
-    Quaternion( const T value )
-    {
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-        for ( int i = 0; i < extent_0; ++i )
-            ( *this )( i ) = value;
-    }
-
-    // Scalar + vector constructor.
-    KOKKOS_INLINE_FUNCTION
-    Quaternion( const T value, const VectorView<T, 3> vec )
+    Tensor4( const T value )
     {
-        ( *this )( 0 ) = value;
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 1; i < extent_0; ++i )
-            ( *this )( i ) = vec( i - 1 );
+            for ( int j = 0; j < N; ++j )
+            {
+                for ( int k = 0; k < P; ++k )
+                {
+                    for ( int l = 0; l < Q; ++l )
+                        ( *this )( i, j, k, l ) = value;
+                }
+            }
     }
 
-    // Deep copy assignment operator. Triggers expression evaluation.
+    // Assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_quaternion<Expression>::value,
-                                Quaternion&>::type
+        typename std::enable_if<is_tensor4<Expression>::value, Tensor4&>::type
         operator=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
+        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < extent_0; ++i )
-            ( *this )( i ) = e( i );
+            for ( int j = 0; j < N; ++j )
+            {
+                for ( int k = 0; k < P; ++k )
+                {
+                    for ( int l = 0; l < Q; ++l )
+                        ( *this )( i, j, k, l ) = e( i, j, k, l );
+                }
+            }
         return *this;
     }
 
     // Addition assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_quaternion<Expression>::value,
-                                Quaternion&>::type
+        typename std::enable_if<is_tensor4<Expression>::value, Tensor4&>::type
         operator+=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
+        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < extent_0; ++i )
-            ( *this )( i ) += e( i );
+            for ( int j = 0; j < N; ++j )
+            {
+                for ( int k = 0; k < P; ++k )
+                {
+                    for ( int l = 0; l < Q; ++l )
+                        ( *this )( i, j, k, l ) += e( i, j, k, l );
+                }
+            }
         return *this;
     }
 
     // Subtraction assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_quaternion<Expression>::value,
-                                Quaternion&>::type
+        typename std::enable_if<is_tensor4<Expression>::value, Tensor4&>::type
         operator-=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
+        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < extent_0; ++i )
-            ( *this )( i ) -= e( i );
+            for ( int j = 0; j < N; ++j )
+            {
+                for ( int k = 0; k < P; ++k )
+                {
+                    for ( int l = 0; l < Q; ++l )
+                        ( *this )( i, j, k, l ) -= e( i, j, k, l );
+                }
+            }
         return *this;
     }
 
     // Initializer list assignment operator.
     KOKKOS_INLINE_FUNCTION
-    Quaternion& operator=( const std::initializer_list<T> data )
+    Tensor4& operator=( const std::initializer_list<std::initializer_list<
+                            std::initializer_list<std::initializer_list<T>>>>
+                            data )
     {
         int i = 0;
-        for ( const auto& value : data )
+        int j = 0;
+        int k = 0;
+        int l = 0;
+        for ( const auto& block : data )
         {
-            _d[i] = value;
+            j = 0;
+            for ( const auto& slice : block )
+            {
+                k = 0;
+                for ( const auto& row : slice )
+                {
+                    l = 0;
+                    for ( const auto& value : row )
+                    {
+                        _d[i][j][k][l] = value;
+                        ++l;
+                    }
+                    ++k;
+                }
+                ++j;
+            }
             ++i;
         }
+
         return *this;
     }
 
     // Scalar value assignment.
     KOKKOS_INLINE_FUNCTION
-    Quaternion& operator=( const T value )
+    Tensor4& operator=( const T value )
     {
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < extent_0; ++i )
-            ( *this )( i ) = value;
+            for ( int j = 0; j < N; ++j )
+            {
+                for ( int k = 0; k < P; ++k )
+                {
+                    for ( int l = 0; l < Q; ++l )
+                        ( *this )( i, j, k, l ) = value;
+                }
+            }
         return *this;
     }
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_0() const { return 1; }
+    int stride_0() const { return N * P * Q; }
 
-    // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_1() const { return 0; }
+    int stride_1() const { return P * Q; }
 
     KOKKOS_INLINE_FUNCTION
-    int stride( const int d ) const { return ( 0 == d ) ? 1 : 0; }
+    int stride_2() const { return Q; }
+
+    KOKKOS_INLINE_FUNCTION
+    int stride_3() const { return 1; }
+
+    KOKKOS_INLINE_FUNCTION
+    int stride( const int d ) const
+    {
+        return 2 == d ? Q : ( ( 0 == d ) ? N * P * Q : ( 1 == d ? P * Q : 1 ) );
+    }
 
     // Extent
     KOKKOS_INLINE_FUNCTION
     constexpr int extent( const int d ) const
     {
-        return d == 0 ? extent_0 : ( d == 1 ? 1 : 0 );
+        return d == 3 ? extent_3
+                      : ( d == 2 ? extent_2
+                                 : ( d == 0 ? extent_0
+                                            : ( d == 1 ? extent_1 : 0 ) ) );
     }
 
     // Access an individual element.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i ) const { return _d[i]; }
+    const_reference operator()( const int i, const int j, const int k,
+                                const int l ) const
+    {
+        return _d[i][j][k][l];
+    }
 
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i ) { return _d[i]; }
+    reference operator()( const int i, const int j, const int k, const int l )
+    {
+        return _d[i][j][k][l];
+    }
 
-    // Access an individual element. 2D version for vectors treated as matrices.
+    // Get the raw data.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i, const int ) const { return _d[i]; }
+    pointer data() const { return const_cast<pointer>( &_d[0][0][0][0] ); }
 
+    // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i, const int ) { return _d[i]; }
-
-    // Get the raw data.
+    VectorView<T, M> vector( const ALL_INDEX_t, const int n, const int p,
+                             const int q ) const
+    {
+        return VectorView<T, M>( const_cast<T*>( &_d[0][n][p][q] ), N * P * Q );
+    }
+    // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    pointer data() const { return const_cast<pointer>( &_d[0] ); }
-
-    // Get the scalar part
+    VectorView<T, N> vector( const int m, const ALL_INDEX_t, const int p,
+                             const int q ) const
+    {
+        return VectorView<T, N>( const_cast<T*>( &_d[m][0][p][q] ), P * Q );
+    } // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    const_reference scalar() const { return _d[0]; }
-
+    VectorView<T, P> vector( const int m, const int n, const ALL_INDEX_t,
+                             const int q ) const
+    {
+        return VectorView<T, P>( const_cast<T*>( &_d[m][n][0][q] ), Q );
+    } // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    reference scalar() { return _d[0]; }
+    VectorView<T, Q> vector( const int m, const int n, const int p,
+                             const ALL_INDEX_t ) const
+    {
+        return VectorView<T, Q>( const_cast<T*>( &_d[m][n][p][0] ), 1 );
+    }
 
-    // Get the vector part
+    // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, 3> vector() const
+    MatrixView<T, M, N> matrix( const ALL_INDEX_t, const ALL_INDEX_t,
+                                const int p, const int q ) const
     {
-        return VectorView<T, 3>( const_cast<T*>( &_d[1] ), 1 );
+        return MatrixView<T, M, N>( const_cast<T*>( &_d[0][0][p][q] ),
+                                    N * P * Q, P * Q );
+    }
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    MatrixView<T, M, P> matrix( const ALL_INDEX_t, const int n,
+                                const ALL_INDEX_t, const int q ) const
+    {
+        return MatrixView<T, M, P>( const_cast<T*>( &_d[0][n][0][q] ),
+                                    N * P * Q, Q );
+    }
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    MatrixView<T, N, P> matrix( const int m, const ALL_INDEX_t,
+                                const ALL_INDEX_t, const int q ) const
+    {
+        return MatrixView<T, N, P>( const_cast<T*>( &_d[m][0][0][q] ), P * Q,
+                                    Q );
+    }
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    MatrixView<T, M, Q> matrix( const ALL_INDEX_t, const int n, const int p,
+                                const ALL_INDEX_t ) const
+    {
+        return MatrixView<T, M, Q>( const_cast<T*>( &_d[0][n][p][0] ),
+                                    N * P * Q, 1 );
+    }
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    MatrixView<T, N, Q> matrix( const int m, const ALL_INDEX_t, const int p,
+                                const ALL_INDEX_t ) const
+    {
+        return MatrixView<T, N, Q>( const_cast<T*>( &_d[m][0][p][0] ), P * Q,
+                                    1 );
+    }
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    MatrixView<T, P, Q> matrix( const int m, const int n, const ALL_INDEX_t,
+                                const ALL_INDEX_t ) const
+    {
+        return MatrixView<T, P, Q>( const_cast<T*>( &_d[m][n][0][0] ), Q, 1 );
     }
 
-    // Get the vector part
+    // Get a tensor3 as a Tensor3 view.
     KOKKOS_INLINE_FUNCTION
-    VectorView<T, 3> vector()
+    Tensor3View<T, M, N, P> tensor3( const ALL_INDEX_t, const ALL_INDEX_t,
+                                     const ALL_INDEX_t, const int b )
     {
-        return VectorView<T, 3>( const_cast<T*>( &_d[1] ), 1 );
+        return Tensor3View<T, M, N, P>( const_cast<T*>( &_d[0][0][0][b] ),
+                                        N * P * Q, P * Q, Q );
+    }
+    // Get a tensor3 as a Tensor3 view.
+    KOKKOS_INLINE_FUNCTION
+    Tensor3View<T, M, N, Q> tensor3( const ALL_INDEX_t, const ALL_INDEX_t,
+                                     const int b, const ALL_INDEX_t )
+    {
+        return Tensor3View<T, M, N, Q>( const_cast<T*>( &_d[0][0][b][0] ),
+                                        N * P * Q, P * Q, 1 );
+    }
+    // Get a tensor3 as a Tensor3 view.
+    KOKKOS_INLINE_FUNCTION
+    Tensor3View<T, M, P, Q> tensor3( const ALL_INDEX_t, const int b,
+                                     const ALL_INDEX_t, const ALL_INDEX_t )
+    {
+        return Tensor3View<T, M, P, Q>( const_cast<T*>( &_d[0][b][0][0] ),
+                                        N * P * Q, Q, 1 );
+    }
+    // Get a tensor3 as a Tensor3 view.
+    KOKKOS_INLINE_FUNCTION
+    Tensor3View<T, N, P, Q> tensor3( const int b, const ALL_INDEX_t,
+                                     const ALL_INDEX_t, const ALL_INDEX_t )
+    {
+        return Tensor3View<T, N, P, Q>( const_cast<T*>( &_d[b][0][0][0] ),
+                                        P * Q, Q, 1 );
     }
 };
 
 //---------------------------------------------------------------------------//
-// View for wrapping quaternion data.
+// View for wrapping Tensor4 data.
 //
 // NOTE: Data in this view may be non-contiguous.
-template <class T>
-struct QuaternionView
+template <class T, int M, int N, int P, int Q>
+struct Tensor4View
 {
     T* _d;
-    int _stride;
+    int _stride[4];
 
-    static constexpr int extent_0 = 4;
-    static constexpr int extent_1 = 1;
+    static constexpr int extent_0 = M;
+    static constexpr int extent_1 = N;
+    static constexpr int extent_2 = P;
+    static constexpr int extent_3 = Q;
 
     using value_type = T;
     using non_const_value_type = typename std::remove_cv<T>::type;
@@ -3457,142 +3430,344 @@ struct QuaternionView
     using reference = T&;
     using const_reference = const T&;
 
-    using eval_type = QuaternionView<T>;
-    using copy_type = Quaternion<T>;
+    using eval_type = Tensor4View<T, M, N, P, Q>;
+    using copy_type = Tensor4<T, M, N, P, Q>;
 
     // Default constructor.
     KOKKOS_DEFAULTED_FUNCTION
-    QuaternionView() = default;
+    Tensor4View() = default;
 
-    // Vector constructor.
+    // Tensor3View constructor.
     KOKKOS_INLINE_FUNCTION
-    QuaternionView( const Quaternion<T>& q )
-        : _d( q.data() )
-        , _stride( q.stride_0() )
+    Tensor4View( const Tensor4<T, M, N, P, Q>& t )
+        : _d( t.data() )
     {
+        _stride[0] = t.stride_0();
+        _stride[1] = t.stride_1();
+        _stride[2] = t.stride_2();
+        _stride[3] = t.stride_3();
     }
 
     // Pointer constructor.
     KOKKOS_INLINE_FUNCTION
-    QuaternionView( T* data, const int stride )
+    Tensor4View( T* data, const int stride_0, const int stride_1,
+                 const int stride_2, const int stride_3 )
         : _d( data )
-        , _stride( stride )
     {
+        _stride[0] = stride_0;
+        _stride[1] = stride_1;
+        _stride[2] = stride_2;
+        _stride[3] = stride_3;
     }
 
     // Assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_quaternion<Expression>::value,
-                                QuaternionView&>::type
+        typename std::enable_if<is_tensor4<Expression>::value,
+                                Tensor4View&>::type
         operator=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
+        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < extent_0; ++i )
-            ( *this )( i ) = e( i );
+            for ( int j = 0; j < N; ++j )
+            {
+                for ( int k = 0; k < P; ++k )
+                {
+                    for ( int l = 0; l < Q; ++l )
+                        ( *this )( i, j, k, l ) = e( i, j, k, l );
+                }
+            }
         return *this;
     }
 
     // Addition assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_quaternion<Expression>::value,
-                                QuaternionView&>::type
+        typename std::enable_if<is_tensor4<Expression>::value,
+                                Tensor4View&>::type
         operator+=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
+        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < extent_0; ++i )
-            ( *this )( i ) += e( i );
+            for ( int j = 0; j < N; ++j )
+            {
+                for ( int k = 0; k < P; ++k )
+                {
+                    for ( int l = 0; l < Q; ++l )
+                        ( *this )( i, j, k, l ) += e( i, j, k, l );
+                }
+            }
         return *this;
     }
 
     // Subtraction assignment operator. Triggers expression evaluation.
     template <class Expression>
     KOKKOS_INLINE_FUNCTION
-        typename std::enable_if<is_quaternion<Expression>::value,
-                                QuaternionView&>::type
+        typename std::enable_if<is_tensor4<Expression>::value,
+                                Tensor4View&>::type
         operator-=( const Expression& e )
     {
         static_assert( Expression::extent_0 == extent_0, "Extents must match" );
         static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
+        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
 
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < extent_0; ++i )
-            ( *this )( i ) -= e( i );
+            for ( int j = 0; j < N; ++j )
+            {
+                for ( int k = 0; k < P; ++k )
+                {
+                    for ( int l = 0; l < Q; ++l )
+                        ( *this )( i, j, k, l ) -= e( i, j, k, l );
+                }
+            }
         return *this;
     }
 
     // Initializer list assignment operator.
     KOKKOS_INLINE_FUNCTION
-    QuaternionView& operator=( const std::initializer_list<T> data )
+    Tensor4View&
+    operator=( const std::initializer_list<std::initializer_list<
+                   std::initializer_list<std::initializer_list<T>>>>
+                   data )
     {
         int i = 0;
-        for ( const auto& value : data )
+        int j = 0;
+        int k = 0;
+        int l = 0;
+        for ( const auto& block : data )
         {
-            ( *this )( i ) = value;
+            j = 0;
+            for ( const auto& slice : block )
+            {
+                k = 0;
+                for ( const auto& row : slice )
+                {
+                    l = 0;
+                    for ( const auto& value : row )
+                    {
+                        ( *this )( i, j, k, l ) = value;
+                        ++l;
+                    }
+                    ++k;
+                }
+                ++j;
+            }
             ++i;
         }
+
         return *this;
     }
 
     // Scalar value assignment.
     KOKKOS_INLINE_FUNCTION
-    QuaternionView& operator=( const T value )
+    Tensor4View& operator=( const T value )
     {
+        for ( int i = 0; i < M; ++i )
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-        for ( int i = 0; i < extent_0; ++i )
-            ( *this )( i ) = value;
+            for ( int j = 0; j < N; ++j )
+            {
+                for ( int k = 0; k < P; ++k )
+                {
+                    for ( int l = 0; l < Q; ++l )
+                        ( *this )( i, j, k, l ) = value;
+                }
+            }
         return *this;
     }
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_0() const { return _stride; }
+    int stride_0() const { return _stride[0]; }
 
     // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride_1() const { return 0; }
+    int stride_1() const { return _stride[1]; }
 
+    // Strides.
     KOKKOS_INLINE_FUNCTION
-    int stride( const int d ) const { return ( 0 == d ) ? _stride : 0; }
+    int stride_2() const { return _stride[2]; }
+
+    // Strides.
+    KOKKOS_INLINE_FUNCTION
+    int stride_3() const { return _stride[3]; }
+
+    KOKKOS_INLINE_FUNCTION
+    int stride( const int d ) const { return _stride[d]; }
 
     // Extent
     KOKKOS_INLINE_FUNCTION
     constexpr int extent( const int d ) const
     {
-        return d == 0 ? extent_0 : ( d == 1 ? 1 : 0 );
+        return d == 3 ? extent_3
+                      : ( d == 2 ? extent_2
+                                 : ( d == 0 ? extent_0
+                                            : ( d == 1 ? extent_1 : 0 ) ) );
     }
 
     // Access an individual element.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i ) const { return _d[_stride * i]; }
+    const_reference operator()( const int i, const int j, const int k,
+                                const int l ) const
+    {
+        return _d[_stride[0] * i + _stride[1] * j + _stride[2] * k +
+                  _stride[3] * l];
+    }
 
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i ) { return _d[_stride * i]; }
+    reference operator()( const int i, const int j, const int k, const int l )
+    {
+        return _d[_stride[0] * i + _stride[1] * j + _stride[2] * k +
+                  _stride[3] * l];
+    }
 
-    // Access an individual element. 2D version for vectors treated as matrices.
+    // Get a row as a vector view.
     KOKKOS_INLINE_FUNCTION
-    const_reference operator()( const int i, const int ) const
+    VectorView<T, M> vector( const ALL_INDEX_t, const int n, const int p,
+                             const int q ) const
     {
-        return _d[_stride * i];
+        return VectorView<T, M>(
+            const_cast<T*>(
+                &_d[_stride[1] * n + _stride[2] * p + _stride[3] * q] ),
+            _stride[0] );
+    }
+    // Get a row as a vector view.
+    KOKKOS_INLINE_FUNCTION
+    VectorView<T, N> vector( const int m, const ALL_INDEX_t, const int p,
+                             const int q ) const
+    {
+        return VectorView<T, N>(
+            const_cast<T*>(
+                &_d[_stride[0] * m + _stride[2] * p + _stride[3] * q] ),
+            _stride[1] );
+    }
+    // Get a row as a vector view.
+    KOKKOS_INLINE_FUNCTION
+    VectorView<T, P> vector( const int m, const int n, const ALL_INDEX_t,
+                             const int q ) const
+    {
+        return VectorView<T, P>(
+            const_cast<T*>(
+                &_d[_stride[0] * m + _stride[1] * n + _stride[3] * q] ),
+            _stride[2] );
+    }
+    // Get a row as a vector view.
+    KOKKOS_INLINE_FUNCTION
+    VectorView<T, Q> vector( const int m, const int n, const int p,
+                             const ALL_INDEX_t ) const
+    {
+        return VectorView<T, Q>(
+            const_cast<T*>(
+                &_d[_stride[0] * m + _stride[1] * n + _stride[2] * p] ),
+            _stride[3] );
     }
 
+    // Get a matrix as a matrix view.
     KOKKOS_INLINE_FUNCTION
-    reference operator()( const int i, const int ) { return _d[_stride * i]; }
+    MatrixView<T, M, N> matrix( const ALL_INDEX_t, const ALL_INDEX_t,
+                                const int p, const int q ) const
+    {
+        return MatrixView<T, M, N>(
+            const_cast<T*>( &_d[_stride[2] * p + _stride[3] * q] ),
+            _stride[0], _stride[1] );
+    }
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    MatrixView<T, M, P> matrix( const ALL_INDEX_t, const int n,
+                                const ALL_INDEX_t, const int q ) const
+    {
+        return MatrixView<T, M, P>(
+            const_cast<T*>( &_d[_stride[1] * n + _stride[3] * q] ),
+            _stride[0], _stride[2] );
+    }
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    MatrixView<T, N, P> matrix( const int m, const ALL_INDEX_t,
+                                const ALL_INDEX_t, const int q ) const
+    {
+        return MatrixView<T, N, P>(
+            const_cast<T*>( &_d[_stride[0] * m + _stride[3] * q] ),
+            _stride[1], _stride[2] );
+    }
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    MatrixView<T, M, Q> matrix( const ALL_INDEX_t, const int n, const int p,
+                                const ALL_INDEX_t ) const
+    {
+        return MatrixView<T, M, Q>(
+            const_cast<T*>( &_d[_stride[1] * n + _stride[2] * p] ),
+            _stride[0], _stride[3] );
+    }
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    MatrixView<T, N, Q> matrix( const int m, const ALL_INDEX_t, const int p,
+                                const ALL_INDEX_t ) const
+    {
+        return MatrixView<T, N, Q>(
+            const_cast<T*>( &_d[_stride[0] * m + _stride[2] * p] ),
+            _stride[1], _stride[3] );
+    }
+    // Get a matrix as a matrix view.
+    KOKKOS_INLINE_FUNCTION
+    MatrixView<T, P, Q> matrix( const int m, const int n, const ALL_INDEX_t,
+                                const ALL_INDEX_t ) const
+    {
+        return MatrixView<T, P, Q>(
+            const_cast<T*>( &_d[_stride[0] * m + _stride[1] * n] ),
+            _stride[2], _stride[3] );
+    }
+
+    // Get a tensor3 as a Tensor3 view.
+    KOKKOS_INLINE_FUNCTION
+    Tensor3View<T, M, N, P> tensor3( const ALL_INDEX_t, const ALL_INDEX_t,
+                                     const ALL_INDEX_t, const int b )
+    {
+        return Tensor3View<T, M, N, P>( const_cast<T*>( &_d[_stride[3] * b] ),
+                                        _stride[0], _stride[1], _stride[2] );
+    }
+    // Get a tensor3 as a Tensor3 view.
+    KOKKOS_INLINE_FUNCTION
+    Tensor3View<T, M, N, Q> tensor3( const ALL_INDEX_t, const ALL_INDEX_t,
+                                     const int b, const ALL_INDEX_t )
+    {
+        return Tensor3View<T, M, N, Q>( const_cast<T*>( &_d[_stride[2] * b] ),
+                                        _stride[0], _stride[1], _stride[3] );
+    }
+    // Get a tensor3 as a Tensor3 view.
+    KOKKOS_INLINE_FUNCTION
+    Tensor3View<T, M, P, Q> tensor3( const ALL_INDEX_t, const int b,
+                                     const ALL_INDEX_t, const ALL_INDEX_t )
+    {
+        return Tensor3View<T, M, P, Q>( const_cast<T*>( &_d[_stride[1] * b] ),
+                                        _stride[0], _stride[2], _stride[3] );
+    }
+    // Get a tensor3 as a Tensor3 view.
+    KOKKOS_INLINE_FUNCTION
+    Tensor3View<T, N, P, Q> tensor3( const int b, const ALL_INDEX_t,
+                                     const ALL_INDEX_t, const ALL_INDEX_t )
+    {
+        return Tensor3View<T, N, P, Q>( const_cast<T*>( &_d[_stride[0] * b] ),
+                                        _stride[1], _stride[2], _stride[3] );
+    }
 
     // Get the raw data.
     KOKKOS_INLINE_FUNCTION
@@ -3600,63 +3775,1054 @@ struct QuaternionView
 };
 
 //---------------------------------------------------------------------------//
-// Tensor4-tensor4 deep copy.
+// Quaternion
 //---------------------------------------------------------------------------//
-template <
-    class Tensor4A, class ExpressionB,
-    typename std::enable_if_t<
-        is_tensor4<Tensor4A>::value && is_tensor4<ExpressionB>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION void deepCopy( Tensor4A& a, const ExpressionB& b )
+// Quaternion.
+template <class T>
+struct Quaternion
 {
-    static_assert( std::is_same<typename Tensor4A::value_type,
-                                typename ExpressionB::value_type>::value,
-                   "value_type must match" );
-    static_assert( Tensor4A::extent_0 == ExpressionB::extent_0,
-                   "extent_0 must match" );
-    static_assert( Tensor4A::extent_1 == ExpressionB::extent_1,
-                   "extent_1 must match" );
-    static_assert( Tensor4A::extent_2 == ExpressionB::extent_2,
-                   "extent_2 must match" );
-    static_assert( Tensor4A::extent_3 == ExpressionB::extent_3,
-                   "extent_3 must match" );
-    for ( int i = 0; i < Tensor4A::extent_0; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-        for ( int j = 0; j < Tensor4A::extent_1; ++j )
-            for ( int k = 0; k < Tensor4A::extent_2; ++k )
-                for ( int l = 0; l < Tensor4A::extent_3; ++l )
-                    a( i, j, k, l ) = b( i, j, k, l );
-}
+    T _d[4];
 
-//---------------------------------------------------------------------------//
-// Tensor3-tensor3 deep copy.
-//---------------------------------------------------------------------------//
-template <
-    class Tensor3A, class ExpressionB,
-    typename std::enable_if_t<
-        is_tensor3<Tensor3A>::value && is_tensor3<ExpressionB>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION void deepCopy( Tensor3A& a, const ExpressionB& b )
-{
-    static_assert( std::is_same<typename Tensor3A::value_type,
-                                typename ExpressionB::value_type>::value,
-                   "value_type must match" );
-    static_assert( Tensor3A::extent_0 == ExpressionB::extent_0,
-                   "extent_0 must match" );
-    static_assert( Tensor3A::extent_1 == ExpressionB::extent_1,
-                   "extent_1 must match" );
-    static_assert( Tensor3A::extent_2 == ExpressionB::extent_2,
-                   "extent_2 must match" );
-    for ( int i = 0; i < Tensor3A::extent_0; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-        for ( int j = 0; j < Tensor3A::extent_1; ++j )
-            for ( int k = 0; k < Tensor3A::extent_2; ++k )
-                a( i, j, k ) = b( i, j, k );
-}
+    static constexpr int extent_0 = 4;
+    static constexpr int extent_1 = 1;
 
-//---------------------------------------------------------------------------//
+    using value_type = T;
+    using non_const_value_type = typename std::remove_cv<T>::type;
+    using pointer = T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    using eval_type = QuaternionView<T>;
+    using copy_type = Quaternion<T>;
+
+    // Default constructor.
+    KOKKOS_DEFAULTED_FUNCTION
+    Quaternion() = default;
+
+    // Initializer list constructor.
+    KOKKOS_INLINE_FUNCTION
+    Quaternion( const std::initializer_list<T> data )
+    {
+        int i = 0;
+        for ( const auto& value : data )
+        {
+            _d[i] = value;
+            ++i;
+        }
+    }
+
+    // Deep copy constructor. Triggers expression evaluation.
+    template <class Expression,
+              typename std::enable_if<is_quaternion<Expression>::value,
+                                      int>::type = 0>
+    KOKKOS_INLINE_FUNCTION Quaternion( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 0; i < extent_0; ++i )
+            ( *this )( i ) = e( i );
+    }
+
+    // Scalar constructor.
+    KOKKOS_INLINE_FUNCTION
+    Quaternion( const T value )
+    {
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 0; i < extent_0; ++i )
+            ( *this )( i ) = value;
+    }
+
+    // Scalar + vector constructor.
+    KOKKOS_INLINE_FUNCTION
+    Quaternion( const T value, const VectorView<T, 3> vec )
+    {
+        ( *this )( 0 ) = value;
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 1; i < extent_0; ++i )
+            ( *this )( i ) = vec( i - 1 );
+    }
+
+    // Deep copy assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION
+        typename std::enable_if<is_quaternion<Expression>::value,
+                                Quaternion&>::type
+        operator=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 0; i < extent_0; ++i )
+            ( *this )( i ) = e( i );
+        return *this;
+    }
+
+    // Addition assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION
+        typename std::enable_if<is_quaternion<Expression>::value,
+                                Quaternion&>::type
+        operator+=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 0; i < extent_0; ++i )
+            ( *this )( i ) += e( i );
+        return *this;
+    }
+
+    // Subtraction assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION
+        typename std::enable_if<is_quaternion<Expression>::value,
+                                Quaternion&>::type
+        operator-=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 0; i < extent_0; ++i )
+            ( *this )( i ) -= e( i );
+        return *this;
+    }
+
+    // Initializer list assignment operator.
+    KOKKOS_INLINE_FUNCTION
+    Quaternion& operator=( const std::initializer_list<T> data )
+    {
+        int i = 0;
+        for ( const auto& value : data )
+        {
+            _d[i] = value;
+            ++i;
+        }
+        return *this;
+    }
+
+    // Scalar value assignment.
+    KOKKOS_INLINE_FUNCTION
+    Quaternion& operator=( const T value )
+    {
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 0; i < extent_0; ++i )
+            ( *this )( i ) = value;
+        return *this;
+    }
+
+    // Strides.
+    KOKKOS_INLINE_FUNCTION
+    int stride_0() const { return 1; }
+
+    // Strides.
+    KOKKOS_INLINE_FUNCTION
+    int stride_1() const { return 0; }
+
+    KOKKOS_INLINE_FUNCTION
+    int stride( const int d ) const { return ( 0 == d ) ? 1 : 0; }
+
+    // Extent
+    KOKKOS_INLINE_FUNCTION
+    constexpr int extent( const int d ) const
+    {
+        return d == 0 ? extent_0 : ( d == 1 ? 1 : 0 );
+    }
+
+    // Access an individual element.
+    KOKKOS_INLINE_FUNCTION
+    const_reference operator()( const int i ) const { return _d[i]; }
+
+    KOKKOS_INLINE_FUNCTION
+    reference operator()( const int i ) { return _d[i]; }
+
+    // Access an individual element. 2D version for vectors treated as matrices.
+    KOKKOS_INLINE_FUNCTION
+    const_reference operator()( const int i, const int ) const { return _d[i]; }
+
+    KOKKOS_INLINE_FUNCTION
+    reference operator()( const int i, const int ) { return _d[i]; }
+
+    // Get the raw data.
+    KOKKOS_INLINE_FUNCTION
+    pointer data() const { return const_cast<pointer>( &_d[0] ); }
+
+    // Get the scalar part
+    KOKKOS_INLINE_FUNCTION
+    const_reference scalar() const { return _d[0]; }
+
+    KOKKOS_INLINE_FUNCTION
+    reference scalar() { return _d[0]; }
+
+    // Get the vector part
+    KOKKOS_INLINE_FUNCTION
+    VectorView<T, 3> vector() const
+    {
+        return VectorView<T, 3>( const_cast<T*>( &_d[1] ), 1 );
+    }
+
+    // Get the vector part
+    KOKKOS_INLINE_FUNCTION
+    VectorView<T, 3> vector()
+    {
+        return VectorView<T, 3>( const_cast<T*>( &_d[1] ), 1 );
+    }
+};
+
+//---------------------------------------------------------------------------//
+// View for wrapping quaternion data.
+//
+// NOTE: Data in this view may be non-contiguous.
+template <class T>
+struct QuaternionView
+{
+    T* _d;
+    int _stride;
+
+    static constexpr int extent_0 = 4;
+    static constexpr int extent_1 = 1;
+
+    using value_type = T;
+    using non_const_value_type = typename std::remove_cv<T>::type;
+    using pointer = T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    using eval_type = QuaternionView<T>;
+    using copy_type = Quaternion<T>;
+
+    // Default constructor.
+    KOKKOS_DEFAULTED_FUNCTION
+    QuaternionView() = default;
+
+    // Vector constructor.
+    KOKKOS_INLINE_FUNCTION
+    QuaternionView( const Quaternion<T>& q )
+        : _d( q.data() )
+        , _stride( q.stride_0() )
+    {
+    }
+
+    // Pointer constructor.
+    KOKKOS_INLINE_FUNCTION
+    QuaternionView( T* data, const int stride )
+        : _d( data )
+        , _stride( stride )
+    {
+    }
+
+    // Assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION
+        typename std::enable_if<is_quaternion<Expression>::value,
+                                QuaternionView&>::type
+        operator=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 0; i < extent_0; ++i )
+            ( *this )( i ) = e( i );
+        return *this;
+    }
+
+    // Addition assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION
+        typename std::enable_if<is_quaternion<Expression>::value,
+                                QuaternionView&>::type
+        operator+=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 0; i < extent_0; ++i )
+            ( *this )( i ) += e( i );
+        return *this;
+    }
+
+    // Subtraction assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION
+        typename std::enable_if<is_quaternion<Expression>::value,
+                                QuaternionView&>::type
+        operator-=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 0; i < extent_0; ++i )
+            ( *this )( i ) -= e( i );
+        return *this;
+    }
+
+    // Initializer list assignment operator.
+    KOKKOS_INLINE_FUNCTION
+    QuaternionView& operator=( const std::initializer_list<T> data )
+    {
+        int i = 0;
+        for ( const auto& value : data )
+        {
+            ( *this )( i ) = value;
+            ++i;
+        }
+        return *this;
+    }
+
+    // Scalar value assignment.
+    KOKKOS_INLINE_FUNCTION
+    QuaternionView& operator=( const T value )
+    {
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int i = 0; i < extent_0; ++i )
+            ( *this )( i ) = value;
+        return *this;
+    }
+
+    // Strides.
+    KOKKOS_INLINE_FUNCTION
+    int stride_0() const { return _stride; }
+
+    // Strides.
+    KOKKOS_INLINE_FUNCTION
+    int stride_1() const { return 0; }
+
+    KOKKOS_INLINE_FUNCTION
+    int stride( const int d ) const { return ( 0 == d ) ? _stride : 0; }
+
+    // Extent
+    KOKKOS_INLINE_FUNCTION
+    constexpr int extent( const int d ) const
+    {
+        return d == 0 ? extent_0 : ( d == 1 ? 1 : 0 );
+    }
+
+    // Access an individual element.
+    KOKKOS_INLINE_FUNCTION
+    const_reference operator()( const int i ) const { return _d[_stride * i]; }
+
+    KOKKOS_INLINE_FUNCTION
+    reference operator()( const int i ) { return _d[_stride * i]; }
+
+    // Access an individual element. 2D version for vectors treated as matrices.
+    KOKKOS_INLINE_FUNCTION
+    const_reference operator()( const int i, const int ) const
+    {
+        return _d[_stride * i];
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    reference operator()( const int i, const int ) { return _d[_stride * i]; }
+
+    // Get the raw data.
+    KOKKOS_INLINE_FUNCTION
+    pointer data() const { return const_cast<pointer>( _d ); }
+};
+
+//---------------------------------------------------------------------------//
+// Symmetric matrix
+//---------------------------------------------------------------------------//
+// Index of the (i,j) component of a symmetric NxN matrix in packed
+// storage. Matrices up to 3x3 use Voigt ordering (e.g. xx, yy, zz, yz, xz,
+// xy). Larger matrices store the diagonal followed by the strict upper
+// triangle by rows.
+template <int N>
+KOKKOS_INLINE_FUNCTION constexpr int symmetricIndex( const int i, const int j )
+{
+    return ( i == j )
+               ? i
+               : ( ( N <= 3 ) ? N * ( N + 1 ) / 2 - i - j
+                              : N + ( i < j ? i : j ) *
+                                            ( 2 * N - ( i < j ? i : j ) - 1 ) /
+                                            2 +
+                                    ( i < j ? j - i : i - j ) - 1 );
+}
+
+//---------------------------------------------------------------------------//
+// Symmetric matrix with packed storage of the N(N+1)/2 unique
+// components. The (i,j) and (j,i) components share storage. Evaluating an
+// expression into a symmetric matrix only evaluates its upper triangle.
+template <class T, int N>
+struct SymmetricMatrix
+{
+    static constexpr int size = N * ( N + 1 ) / 2;
+
+    T _d[size];
+
+    static constexpr int extent_0 = N;
+    static constexpr int extent_1 = N;
+
+    using value_type = T;
+    using non_const_value_type = typename std::remove_cv<T>::type;
+    using pointer = T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    using eval_type = SymmetricMatrixView<T, N>;
+    using copy_type = SymmetricMatrix<T, N>;
+
+    // Default constructor.
+    KOKKOS_DEFAULTED_FUNCTION
+    SymmetricMatrix() = default;
+
+    // Deep copy constructor. Triggers expression evaluation.
+    template <
+        class Expression,
+        typename std::enable_if<is_matrix<Expression>::value, int>::type = 0>
+    KOKKOS_INLINE_FUNCTION SymmetricMatrix( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+        for ( int i = 0; i < N; ++i )
+            for ( int j = i; j < N; ++j )
+                ( *this )( i, j ) = e( i, j );
+    }
+
+    // Scalar constructor.
+    KOKKOS_INLINE_FUNCTION
+    SymmetricMatrix( const T value )
+    {
+        for ( int n = 0; n < size; ++n )
+            _d[n] = value;
+    }
+
+    // Assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION typename std::enable_if<is_matrix<Expression>::value,
+                                                   SymmetricMatrix&>::type
+    operator=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+        for ( int i = 0; i < N; ++i )
+            for ( int j = i; j < N; ++j )
+                ( *this )( i, j ) = e( i, j );
+        return *this;
+    }
+
+    // Addition assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION typename std::enable_if<is_matrix<Expression>::value,
+                                                   SymmetricMatrix&>::type
+    operator+=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+        for ( int i = 0; i < N; ++i )
+            for ( int j = i; j < N; ++j )
+                ( *this )( i, j ) += e( i, j );
+        return *this;
+    }
+
+    // Subtraction assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION typename std::enable_if<is_matrix<Expression>::value,
+                                                   SymmetricMatrix&>::type
+    operator-=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+        for ( int i = 0; i < N; ++i )
+            for ( int j = i; j < N; ++j )
+                ( *this )( i, j ) -= e( i, j );
+        return *this;
+    }
+
+    // Scalar value assignment.
+    KOKKOS_INLINE_FUNCTION
+    SymmetricMatrix& operator=( const T value )
+    {
+        for ( int n = 0; n < size; ++n )
+            _d[n] = value;
+        return *this;
+    }
+
+    // Stride between packed components.
+    KOKKOS_INLINE_FUNCTION
+    int stride() const { return 1; }
+
+    // Extent
+    KOKKOS_INLINE_FUNCTION
+    constexpr int extent( const int d ) const
+    {
+        return d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 );
+    }
+
+    // Access an individual element.
+    KOKKOS_INLINE_FUNCTION
+    const_reference operator()( const int i, const int j ) const
+    {
+        return _d[symmetricIndex<N>( i, j )];
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    reference operator()( const int i, const int j )
+    {
+        return _d[symmetricIndex<N>( i, j )];
+    }
+
+    // Access a packed component.
+    KOKKOS_INLINE_FUNCTION
+    const_reference operator[]( const int n ) const { return _d[n]; }
+
+    KOKKOS_INLINE_FUNCTION
+    reference operator[]( const int n ) { return _d[n]; }
+
+    // Get the raw data.
+    KOKKOS_INLINE_FUNCTION
+    pointer data() const { return const_cast<pointer>( &_d[0] ); }
+};
+
+//---------------------------------------------------------------------------//
+// View for wrapping packed symmetric matrix data.
+//
+// NOTE: Data in this view may be non-contiguous.
+template <class T, int N>
+struct SymmetricMatrixView
+{
+    static constexpr int size = N * ( N + 1 ) / 2;
+
+    T* _d;
+    int _stride;
+
+    static constexpr int extent_0 = N;
+    static constexpr int extent_1 = N;
+
+    using value_type = T;
+    using non_const_value_type = typename std::remove_cv<T>::type;
+    using pointer = T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    using eval_type = SymmetricMatrixView<T, N>;
+    using copy_type = SymmetricMatrix<T, N>;
+
+    // Default constructor.
+    KOKKOS_DEFAULTED_FUNCTION
+    SymmetricMatrixView() = default;
+
+    // Matrix constructor.
+    KOKKOS_INLINE_FUNCTION
+    SymmetricMatrixView( const SymmetricMatrix<T, N>& m )
+        : _d( m.data() )
+        , _stride( m.stride() )
+    {
+    }
+
+    // Pointer constructor.
+    KOKKOS_INLINE_FUNCTION
+    SymmetricMatrixView( T* data, const int stride )
+        : _d( data )
+        , _stride( stride )
+    {
+    }
+
+    // Assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION typename std::enable_if<is_matrix<Expression>::value,
+                                                   SymmetricMatrixView&>::type
+    operator=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+        for ( int i = 0; i < N; ++i )
+            for ( int j = i; j < N; ++j )
+                ( *this )( i, j ) = e( i, j );
+        return *this;
+    }
+
+    // Addition assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION typename std::enable_if<is_matrix<Expression>::value,
+                                                   SymmetricMatrixView&>::type
+    operator+=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+        for ( int i = 0; i < N; ++i )
+            for ( int j = i; j < N; ++j )
+                ( *this )( i, j ) += e( i, j );
+        return *this;
+    }
+
+    // Subtraction assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION typename std::enable_if<is_matrix<Expression>::value,
+                                                   SymmetricMatrixView&>::type
+    operator-=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+
+        for ( int i = 0; i < N; ++i )
+            for ( int j = i; j < N; ++j )
+                ( *this )( i, j ) -= e( i, j );
+        return *this;
+    }
+
+    // Scalar value assignment.
+    KOKKOS_INLINE_FUNCTION
+    SymmetricMatrixView& operator=( const T value )
+    {
+        for ( int n = 0; n < size; ++n )
+            ( *this )[n] = value;
+        return *this;
+    }
+
+    // Stride between packed components.
+    KOKKOS_INLINE_FUNCTION
+    int stride() const { return _stride; }
+
+    // Extent
+    KOKKOS_INLINE_FUNCTION
+    constexpr int extent( const int d ) const
+    {
+        return d == 0 ? extent_0 : ( d == 1 ? extent_1 : 0 );
+    }
+
+    // Access an individual element.
+    KOKKOS_INLINE_FUNCTION
+    const_reference operator()( const int i, const int j ) const
+    {
+        return _d[_stride * symmetricIndex<N>( i, j )];
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    reference operator()( const int i, const int j )
+    {
+        return _d[_stride * symmetricIndex<N>( i, j )];
+    }
+
+    // Access a packed component.
+    KOKKOS_INLINE_FUNCTION
+    const_reference operator[]( const int n ) const { return _d[_stride * n]; }
+
+    KOKKOS_INLINE_FUNCTION
+    reference operator[]( const int n ) { return _d[_stride * n]; }
+
+    // Get the raw data.
+    KOKKOS_INLINE_FUNCTION
+    pointer data() const { return const_cast<pointer>( _d ); }
+};
+
+//---------------------------------------------------------------------------//
+// Symmetric tensor4
+//---------------------------------------------------------------------------//
+// Tensor4 with both minor symmetries (ijkl = jikl = ijlk) and the major
+// symmetry (ijkl = klij), e.g. an elasticity tensor. The NxNxNxN tensor is
+// stored as a packed symmetric matrix over Voigt index pairs: 21 components
+// for N = 3 and 6 for N = 2. Evaluating an expression into a symmetric
+// tensor4 only evaluates one representative of each component.
+template <class T, int N>
+struct SymmetricTensor4
+{
+    static constexpr int voigt_size = N * ( N + 1 ) / 2;
+    static constexpr int size = voigt_size * ( voigt_size + 1 ) / 2;
+
+    T _d[size];
+
+    static constexpr int extent_0 = N;
+    static constexpr int extent_1 = N;
+    static constexpr int extent_2 = N;
+    static constexpr int extent_3 = N;
+
+    using value_type = T;
+    using non_const_value_type = typename std::remove_cv<T>::type;
+    using pointer = T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    using eval_type = SymmetricTensor4View<T, N>;
+    using copy_type = SymmetricTensor4<T, N>;
+
+    // Packed index of a component.
+    KOKKOS_INLINE_FUNCTION
+    static constexpr int index( const int i, const int j, const int k,
+                                const int l )
+    {
+        return symmetricIndex<voigt_size>( symmetricIndex<N>( i, j ),
+                                           symmetricIndex<N>( k, l ) );
+    }
+
+    // Default constructor.
+    KOKKOS_DEFAULTED_FUNCTION
+    SymmetricTensor4() = default;
+
+    // Deep copy constructor. Triggers expression evaluation.
+    template <
+        class Expression,
+        typename std::enable_if<is_tensor4<Expression>::value, int>::type = 0>
+    KOKKOS_INLINE_FUNCTION SymmetricTensor4( const Expression& e )
+    {
+        *this = e;
+    }
+
+    // Scalar constructor.
+    KOKKOS_INLINE_FUNCTION
+    SymmetricTensor4( const T value )
+    {
+        for ( int n = 0; n < size; ++n )
+            _d[n] = value;
+    }
+
+    // Assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION typename std::enable_if<
+        is_tensor4<Expression>::value, SymmetricTensor4&>::type
+    operator=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
+        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
+
+        for ( int i = 0; i < N; ++i )
+            for ( int j = i; j < N; ++j )
+                for ( int k = 0; k < N; ++k )
+                    for ( int l = k; l < N; ++l )
+                        _d[index( i, j, k, l )] = e( i, j, k, l );
+        return *this;
+    }
+
+    // Scalar value assignment.
+    KOKKOS_INLINE_FUNCTION
+    SymmetricTensor4& operator=( const T value )
+    {
+        for ( int n = 0; n < size; ++n )
+            _d[n] = value;
+        return *this;
+    }
+
+    // Stride between packed components.
+    KOKKOS_INLINE_FUNCTION
+    int stride() const { return 1; }
+
+    // Extent
+    KOKKOS_INLINE_FUNCTION
+    constexpr int extent( const int d ) const { return ( d < 4 ) ? N : 0; }
+
+    // Access an individual element.
+    KOKKOS_INLINE_FUNCTION
+    const_reference operator()( const int i, const int j, const int k,
+                                const int l ) const
+    {
+        return _d[index( i, j, k, l )];
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    reference operator()( const int i, const int j, const int k, const int l )
+    {
+        return _d[index( i, j, k, l )];
+    }
+
+    // Access a packed component.
+    KOKKOS_INLINE_FUNCTION
+    const_reference operator[]( const int n ) const { return _d[n]; }
+
+    KOKKOS_INLINE_FUNCTION
+    reference operator[]( const int n ) { return _d[n]; }
+
+    // Get the raw data.
+    KOKKOS_INLINE_FUNCTION
+    pointer data() const { return const_cast<pointer>( &_d[0] ); }
+};
+
+//---------------------------------------------------------------------------//
+// View for wrapping packed symmetric tensor4 data.
+//
+// NOTE: Data in this view may be non-contiguous.
+template <class T, int N>
+struct SymmetricTensor4View
+{
+    static constexpr int voigt_size = N * ( N + 1 ) / 2;
+    static constexpr int size = voigt_size * ( voigt_size + 1 ) / 2;
+
+    T* _d;
+    int _stride;
+
+    static constexpr int extent_0 = N;
+    static constexpr int extent_1 = N;
+    static constexpr int extent_2 = N;
+    static constexpr int extent_3 = N;
+
+    using value_type = T;
+    using non_const_value_type = typename std::remove_cv<T>::type;
+    using pointer = T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    using eval_type = SymmetricTensor4View<T, N>;
+    using copy_type = SymmetricTensor4<T, N>;
+
+    // Default constructor.
+    KOKKOS_DEFAULTED_FUNCTION
+    SymmetricTensor4View() = default;
+
+    // Tensor constructor.
+    KOKKOS_INLINE_FUNCTION
+    SymmetricTensor4View( const SymmetricTensor4<T, N>& t )
+        : _d( t.data() )
+        , _stride( t.stride() )
+    {
+    }
+
+    // Pointer constructor.
+    KOKKOS_INLINE_FUNCTION
+    SymmetricTensor4View( T* data, const int stride )
+        : _d( data )
+        , _stride( stride )
+    {
+    }
+
+    // Assignment operator. Triggers expression evaluation.
+    template <class Expression>
+    KOKKOS_INLINE_FUNCTION typename std::enable_if<
+        is_tensor4<Expression>::value, SymmetricTensor4View&>::type
+    operator=( const Expression& e )
+    {
+        static_assert( Expression::extent_0 == extent_0, "Extents must match" );
+        static_assert( Expression::extent_1 == extent_1, "Extents must match" );
+        static_assert( Expression::extent_2 == extent_2, "Extents must match" );
+        static_assert( Expression::extent_3 == extent_3, "Extents must match" );
+
+        for ( int i = 0; i < N; ++i )
+            for ( int j = i; j < N; ++j )
+                for ( int k = 0; k < N; ++k )
+                    for ( int l = k; l < N; ++l )
+                        ( *this )( i, j, k, l ) = e( i, j, k, l );
+        return *this;
+    }
+
+    // Scalar value assignment.
+    KOKKOS_INLINE_FUNCTION
+    SymmetricTensor4View& operator=( const T value )
+    {
+        for ( int n = 0; n < size; ++n )
+            ( *this )[n] = value;
+        return *this;
+    }
+
+    // Stride between packed components.
+    KOKKOS_INLINE_FUNCTION
+    int stride() const { return _stride; }
+
+    // Extent
+    KOKKOS_INLINE_FUNCTION
+    constexpr int extent( const int d ) const { return ( d < 4 ) ? N : 0; }
+
+    // Access an individual element.
+    KOKKOS_INLINE_FUNCTION
+    const_reference operator()( const int i, const int j, const int k,
+                                const int l ) const
+    {
+        return _d[_stride * SymmetricTensor4<T, N>::index( i, j, k, l )];
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    reference operator()( const int i, const int j, const int k, const int l )
+    {
+        return _d[_stride * SymmetricTensor4<T, N>::index( i, j, k, l )];
+    }
+
+    // Access a packed component.
+    KOKKOS_INLINE_FUNCTION
+    const_reference operator[]( const int n ) const { return _d[_stride * n]; }
+
+    KOKKOS_INLINE_FUNCTION
+    reference operator[]( const int n ) { return _d[_stride * n]; }
+
+    // Get the raw data.
+    KOKKOS_INLINE_FUNCTION
+    pointer data() const { return const_cast<pointer>( _d ); }
+};
+
+//---------------------------------------------------------------------------//
+// Batch load and store.
+//---------------------------------------------------------------------------//
+// The view describes the first lane of the batch and the lanes of each
+// component are contiguous in memory, as in a member of a Cabana SoA. Stores
+// may be limited to the first num_lane lanes for partially filled SoAs.
+//---------------------------------------------------------------------------//
+// Tensor4.
+template <class T, int M, int N, int P, int Q, int W>
+KOKKOS_INLINE_FUNCTION void load( Tensor4<Batch<T, W>, M, N, P, Q>& a,
+                                  const Tensor4View<T, M, N, P, Q>& v )
+{
+    for ( int i = 0; i < M; ++i )
+        for ( int j = 0; j < N; ++j )
+            for ( int k = 0; k < P; ++k )
+                for ( int l = 0; l < Q; ++l )
+                    a( i, j, k, l ).load( &v( i, j, k, l ) );
+}
+
+template <class T, int M, int N, int P, int Q, int W>
+KOKKOS_INLINE_FUNCTION void store( const Tensor4<Batch<T, W>, M, N, P, Q>& a,
+                                   Tensor4View<T, M, N, P, Q> v,
+                                   const int num_lane = W )
+{
+    for ( int i = 0; i < M; ++i )
+        for ( int j = 0; j < N; ++j )
+            for ( int k = 0; k < P; ++k )
+                for ( int l = 0; l < Q; ++l )
+                    a( i, j, k, l ).store( &v( i, j, k, l ), num_lane );
+}
+
+//---------------------------------------------------------------------------//
+// Tensor3.
+template <class T, int M, int N, int P, int W>
+KOKKOS_INLINE_FUNCTION void load( Tensor3<Batch<T, W>, M, N, P>& a,
+                                  const Tensor3View<T, M, N, P>& v )
+{
+    for ( int i = 0; i < M; ++i )
+        for ( int j = 0; j < N; ++j )
+            for ( int k = 0; k < P; ++k )
+                a( i, j, k ).load( &v( i, j, k ) );
+}
+
+template <class T, int M, int N, int P, int W>
+KOKKOS_INLINE_FUNCTION void store( const Tensor3<Batch<T, W>, M, N, P>& a,
+                                   Tensor3View<T, M, N, P> v,
+                                   const int num_lane = W )
+{
+    for ( int i = 0; i < M; ++i )
+        for ( int j = 0; j < N; ++j )
+            for ( int k = 0; k < P; ++k )
+                a( i, j, k ).store( &v( i, j, k ), num_lane );
+}
+
+//---------------------------------------------------------------------------//
+// Matrix.
+template <class T, int M, int N, int W>
+KOKKOS_INLINE_FUNCTION void load( Matrix<Batch<T, W>, M, N>& a,
+                                  const MatrixView<T, M, N>& v )
+{
+    for ( int i = 0; i < M; ++i )
+        for ( int j = 0; j < N; ++j )
+            a( i, j ).load( &v( i, j ) );
+}
+
+template <class T, int M, int N, int W>
+KOKKOS_INLINE_FUNCTION void store( const Matrix<Batch<T, W>, M, N>& a,
+                                   MatrixView<T, M, N> v,
+                                   const int num_lane = W )
+{
+    for ( int i = 0; i < M; ++i )
+        for ( int j = 0; j < N; ++j )
+            a( i, j ).store( &v( i, j ), num_lane );
+}
+
+//---------------------------------------------------------------------------//
+// Vector.
+template <class T, int N, int W>
+KOKKOS_INLINE_FUNCTION void load( Vector<Batch<T, W>, N>& a,
+                                  const VectorView<T, N>& v )
+{
+    for ( int i = 0; i < N; ++i )
+        a( i ).load( &v( i ) );
+}
+
+template <class T, int N, int W>
+KOKKOS_INLINE_FUNCTION void store( const Vector<Batch<T, W>, N>& a,
+                                   VectorView<T, N> v,
+                                   const int num_lane = W )
+{
+    for ( int i = 0; i < N; ++i )
+        a( i ).store( &v( i ), num_lane );
+}
+
+//---------------------------------------------------------------------------//
+// Tensor4-tensor4 deep copy.
+//---------------------------------------------------------------------------//
+template <
+    class Tensor4A, class ExpressionB,
+    typename std::enable_if_t<
+        is_tensor4<Tensor4A>::value && is_tensor4<ExpressionB>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION void deepCopy( Tensor4A& a, const ExpressionB& b )
+{
+    static_assert( std::is_same<typename Tensor4A::value_type,
+                                typename ExpressionB::value_type>::value,
+                   "value_type must match" );
+    static_assert( Tensor4A::extent_0 == ExpressionB::extent_0,
+                   "extent_0 must match" );
+    static_assert( Tensor4A::extent_1 == ExpressionB::extent_1,
+                   "extent_1 must match" );
+    static_assert( Tensor4A::extent_2 == ExpressionB::extent_2,
+                   "extent_2 must match" );
+    static_assert( Tensor4A::extent_3 == ExpressionB::extent_3,
+                   "extent_3 must match" );
+    for ( int i = 0; i < Tensor4A::extent_0; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int j = 0; j < Tensor4A::extent_1; ++j )
+            for ( int k = 0; k < Tensor4A::extent_2; ++k )
+                for ( int l = 0; l < Tensor4A::extent_3; ++l )
+                    a( i, j, k, l ) = b( i, j, k, l );
+}
+
+//---------------------------------------------------------------------------//
+// Tensor3-tensor3 deep copy.
+//---------------------------------------------------------------------------//
+template <
+    class Tensor3A, class ExpressionB,
+    typename std::enable_if_t<
+        is_tensor3<Tensor3A>::value && is_tensor3<ExpressionB>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION void deepCopy( Tensor3A& a, const ExpressionB& b )
+{
+    static_assert( std::is_same<typename Tensor3A::value_type,
+                                typename ExpressionB::value_type>::value,
+                   "value_type must match" );
+    static_assert( Tensor3A::extent_0 == ExpressionB::extent_0,
+                   "extent_0 must match" );
+    static_assert( Tensor3A::extent_1 == ExpressionB::extent_1,
+                   "extent_1 must match" );
+    static_assert( Tensor3A::extent_2 == ExpressionB::extent_2,
+                   "extent_2 must match" );
+    for ( int i = 0; i < Tensor3A::extent_0; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int j = 0; j < Tensor3A::extent_1; ++j )
+            for ( int k = 0; k < Tensor3A::extent_2; ++k )
+                a( i, j, k ) = b( i, j, k );
+}
+
+//---------------------------------------------------------------------------//
 // Matrix-matrix deep copy.
 //---------------------------------------------------------------------------//
 template <
@@ -3866,64 +5032,286 @@ operator*( const ExpressionA& a, const ExpressionX& x )
 }
 
 //---------------------------------------------------------------------------//
-// Vector-matrix multiplication. (i.e. vector-vector transpose multiplication)
+// Vector-matrix multiplication. (i.e. vector-vector transpose multiplication)
+//---------------------------------------------------------------------------//
+template <class ExpressionA, class ExpressionX>
+KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
+    is_matrix<ExpressionA>::value && is_vector<ExpressionX>::value,
+    Matrix<typename ExpressionA::value_type, ExpressionX::extent_0,
+           ExpressionA::extent_1>>
+operator*( const ExpressionX& x, const ExpressionA& a )
+{
+    static_assert( std::is_same<typename ExpressionA::value_type,
+                                typename ExpressionX::value_type>::value,
+                   "value_type must match" );
+    static_assert( 1 == ExpressionA::extent_0, "inner extent must match" );
+
+    typename ExpressionA::eval_type a_eval = a;
+    typename ExpressionX::eval_type x_eval = x;
+    Matrix<typename ExpressionA::value_type, ExpressionX::extent_0,
+           ExpressionA::extent_1>
+        y;
+
+    for ( int i = 0; i < ExpressionX::extent_0; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int j = 0; j < ExpressionA::extent_1; ++j )
+            y( i, j ) = x_eval( i ) * a_eval( 0, j );
+
+    return y;
+}
+
+//---------------------------------------------------------------------------//
+// Vector-vector addition.
+//---------------------------------------------------------------------------//
+template <class ExpressionX, class ExpressionY,
+          typename std::enable_if_t<is_vector<ExpressionX>::value &&
+                                        is_vector<ExpressionY>::value,
+                                    int> = 0>
+KOKKOS_INLINE_FUNCTION auto operator+( const ExpressionX& x,
+                                       const ExpressionY& y )
+{
+    static_assert( std::is_same<typename ExpressionX::value_type,
+                                typename ExpressionY::value_type>::value,
+                   "value_type must match" );
+    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
+                   "extent must match" );
+    return createVectorExpression<typename ExpressionX::value_type,
+                                  ExpressionX::extent_0>(
+        [=]( const int i ) { return x( i ) + y( i ); } );
+}
+
+//---------------------------------------------------------------------------//
+// Vector-vector subtraction.
+//---------------------------------------------------------------------------//
+template <class ExpressionX, class ExpressionY,
+          typename std::enable_if_t<is_vector<ExpressionX>::value &&
+                                        is_vector<ExpressionY>::value,
+                                    int> = 0>
+KOKKOS_INLINE_FUNCTION auto operator-( const ExpressionX& x,
+                                       const ExpressionY& y )
+{
+    static_assert( std::is_same<typename ExpressionX::value_type,
+                                typename ExpressionY::value_type>::value,
+                   "value_type must match" );
+    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
+                   "extent must match" );
+    return createVectorExpression<typename ExpressionX::value_type,
+                                  ExpressionX::extent_0>(
+        [=]( const int i ) { return x( i ) - y( i ); } );
+}
+
+//---------------------------------------------------------------------------//
+// Quaternion-quaternion addition.
+//---------------------------------------------------------------------------//
+template <class ExpressionX, class ExpressionY,
+          typename std::enable_if_t<is_quaternion<ExpressionX>::value &&
+                                        is_quaternion<ExpressionY>::value,
+                                    int> = 0>
+KOKKOS_INLINE_FUNCTION auto operator+( const ExpressionX& x,
+                                       const ExpressionY& y )
+{
+    static_assert( std::is_same<typename ExpressionX::value_type,
+                                typename ExpressionY::value_type>::value,
+                   "value_type must match" );
+    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
+                   "extent must match" );
+    return createQuaternionExpression<typename ExpressionX::value_type,
+                                      ExpressionX::extent_0>(
+        [=]( const int i ) { return x( i ) + y( i ); } );
+}
+
+//---------------------------------------------------------------------------//
+// Quaternion-quaternion subtraction.
+//---------------------------------------------------------------------------//
+template <class ExpressionX, class ExpressionY,
+          typename std::enable_if_t<is_quaternion<ExpressionX>::value &&
+                                        is_quaternion<ExpressionY>::value,
+                                    int> = 0>
+KOKKOS_INLINE_FUNCTION auto operator-( const ExpressionX& x,
+                                       const ExpressionY& y )
+{
+    static_assert( std::is_same<typename ExpressionX::value_type,
+                                typename ExpressionY::value_type>::value,
+                   "value_type must match" );
+    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
+                   "extent must match" );
+    return createQuaternionExpression<typename ExpressionX::value_type,
+                                      ExpressionX::extent_0>(
+        [=]( const int i ) { return x( i ) - y( i ); } );
+}
+
+//---------------------------------------------------------------------------//
+// Quaternion-quaternion multiplication
+//---------------------------------------------------------------------------//
+template <class ExpressionX, class ExpressionY,
+          typename std::enable_if_t<is_quaternion<ExpressionX>::value &&
+                                        is_quaternion<ExpressionY>::value,
+                                    int> = 0>
+KOKKOS_INLINE_FUNCTION auto operator&( const ExpressionX& x,
+                                       const ExpressionY& y )
+{
+    static_assert( std::is_same<typename ExpressionX::value_type,
+                                typename ExpressionY::value_type>::value,
+                   "value_type must match" );
+    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
+                   "extent_0 must match" );
+
+    typename ExpressionX::eval_type x_eval = x;
+    typename ExpressionY::eval_type y_eval = y;
+
+    // Hamilton product of two quaternions
+    return Quaternion<typename ExpressionX::value_type>{
+        x_eval( 0 ) * y_eval( 0 ) - x_eval( 1 ) * y_eval( 1 ) -
+            x_eval( 2 ) * y_eval( 2 ) - x_eval( 3 ) * y_eval( 3 ),
+        x_eval( 0 ) * y_eval( 1 ) + x_eval( 1 ) * y_eval( 0 ) +
+            x_eval( 2 ) * y_eval( 3 ) - x_eval( 3 ) * y_eval( 2 ),
+        x_eval( 0 ) * y_eval( 2 ) - x_eval( 1 ) * y_eval( 3 ) +
+            x_eval( 2 ) * y_eval( 0 ) + x_eval( 3 ) * y_eval( 1 ),
+        x_eval( 0 ) * y_eval( 3 ) + x_eval( 1 ) * y_eval( 2 ) -
+            x_eval( 2 ) * y_eval( 1 ) + x_eval( 3 ) * y_eval( 0 ) };
+}
+
+//---------------------------------------------------------------------------//
+// Quaternion-matrix conjugation
+//---------------------------------------------------------------------------//
+template <class ExpressionX, class ExpressionY,
+          typename std::enable_if_t<is_matrix<ExpressionX>::value &&
+                                        is_quaternion<ExpressionY>::value,
+                                    int> = 0>
+KOKKOS_INLINE_FUNCTION auto operator&( const ExpressionX& X,
+                                       const ExpressionY& q )
+{
+    static_assert( std::is_same<typename ExpressionX::value_type,
+                                typename ExpressionY::value_type>::value,
+                   "value_type must match" );
+    static_assert( ExpressionX::extent_0 == 3 && ExpressionX::extent_1 == 3,
+                   "matrix must be 3x3" );
+
+    typename ExpressionX::eval_type X_eval = X;
+    typename ExpressionY::eval_type q_eval = q;
+
+    ExpressionX X_res;
+
+    for ( int n = 0; n < 3; n++ )
+    {
+        LinearAlgebra::Quaternion<double> p = { 0.0, X_eval.row( n ) };
+        auto p_rot = ( q_eval & p ) & ~q_eval;
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int d = 0; d < 3; d++ )
+            X_res.row( n )( d ) = p_rot.vector()( d );
+    }
+
+    return X_res;
+}
+
+template <class ExpressionX, class ExpressionY,
+          typename std::enable_if_t<is_quaternion<ExpressionX>::value &&
+                                        is_quaternion<ExpressionY>::value,
+                                    int> = 0>
+KOKKOS_INLINE_FUNCTION auto operator&=( const ExpressionX& x,
+                                        const ExpressionY& y )
+{
+    static_assert( std::is_same<typename ExpressionX::value_type,
+                                typename ExpressionY::value_type>::value,
+                   "value_type must match" );
+    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
+                   "extent_0 must match" );
+
+    typename ExpressionX::eval_type x_eval = x;
+    typename ExpressionY::eval_type y_eval = y;
+
+    return Quaternion<typename ExpressionX::value_type>{
+        x_eval( 0 ) * y_eval( 0 ) - x_eval( 1 ) * y_eval( 1 ) -
+            x_eval( 2 ) * y_eval( 2 ) - x_eval( 3 ) * y_eval( 3 ),
+        x_eval( 0 ) * y_eval( 1 ) + x_eval( 1 ) * y_eval( 0 ) +
+            x_eval( 2 ) * y_eval( 3 ) - x_eval( 3 ) * y_eval( 2 ),
+        x_eval( 0 ) * y_eval( 2 ) - x_eval( 1 ) * y_eval( 3 ) +
+            x_eval( 2 ) * y_eval( 0 ) + x_eval( 3 ) * y_eval( 1 ),
+        x_eval( 0 ) * y_eval( 3 ) + x_eval( 1 ) * y_eval( 2 ) -
+            x_eval( 2 ) * y_eval( 1 ) + x_eval( 3 ) * y_eval( 0 ) };
+}
+
+//---------------------------------------------------------------------------//
+// Quaternion-quaternion division
+template <class ExpressionX, class ExpressionY,
+          typename std::enable_if_t<is_quaternion<ExpressionX>::value &&
+                                        is_quaternion<ExpressionY>::value,
+                                    int> = 0>
+KOKKOS_INLINE_FUNCTION auto operator|( const ExpressionX& x,
+                                       const ExpressionY& y )
+{
+    static_assert( std::is_same<typename ExpressionX::value_type,
+                                typename ExpressionY::value_type>::value,
+                   "value_type must match" );
+    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
+                   "extent must match" );
+
+    typename ExpressionX::eval_type x_eval = x;
+    typename ExpressionY::eval_type y_eval = y;
+
+    auto y_norm_2 = y_eval( 0 ) * y_eval( 0 ) + y_eval( 1 ) * y_eval( 1 ) +
+                    y_eval( 2 ) * y_eval( 2 ) + y_eval( 3 ) * y_eval( 3 );
+    auto y_inv = ~y_eval / y_norm_2;
+
+    return x_eval & y_inv;
+}
+
+//---------------------------------------------------------------------------//
+// Vector products.
 //---------------------------------------------------------------------------//
-template <class ExpressionA, class ExpressionX>
-KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
-    is_matrix<ExpressionA>::value && is_vector<ExpressionX>::value,
-    Matrix<typename ExpressionA::value_type, ExpressionX::extent_0,
-           ExpressionA::extent_1>>
-operator*( const ExpressionX& x, const ExpressionA& a )
+// Cross product
+template <class ExpressionX, class ExpressionY>
+KOKKOS_INLINE_FUNCTION
+    typename std::enable_if_t<is_vector<ExpressionX>::value &&
+                                  is_vector<ExpressionY>::value,
+                              Vector<typename ExpressionX::value_type, 3>>
+    operator%( const ExpressionX& x, const ExpressionY& y )
 {
-    static_assert( std::is_same<typename ExpressionA::value_type,
-                                typename ExpressionX::value_type>::value,
+    static_assert( std::is_same<typename ExpressionX::value_type,
+                                typename ExpressionY::value_type>::value,
                    "value_type must match" );
-    static_assert( 1 == ExpressionA::extent_0, "inner extent must match" );
-
-    typename ExpressionA::eval_type a_eval = a;
+    static_assert( ExpressionX::extent_0 == 3,
+                   "cross product is for 3-vectors" );
+    static_assert( ExpressionY::extent_0 == 3,
+                   "cross product is for 3-vectors" );
     typename ExpressionX::eval_type x_eval = x;
-    Matrix<typename ExpressionA::value_type, ExpressionX::extent_0,
-           ExpressionA::extent_1>
-        y;
-
-    for ( int i = 0; i < ExpressionX::extent_0; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-        for ( int j = 0; j < ExpressionA::extent_1; ++j )
-            y( i, j ) = x_eval( i ) * a_eval( 0, j );
-
-    return y;
+    typename ExpressionY::eval_type y_eval = y;
+    return Vector<typename ExpressionX::value_type, 3>{
+        x_eval( 1 ) * y_eval( 2 ) - x_eval( 2 ) * y_eval( 1 ),
+        x_eval( 2 ) * y_eval( 0 ) - x_eval( 0 ) * y_eval( 2 ),
+        x_eval( 0 ) * y_eval( 1 ) - x_eval( 1 ) * y_eval( 0 ) };
 }
 
 //---------------------------------------------------------------------------//
-// Vector-vector addition.
-//---------------------------------------------------------------------------//
+// Element-wise multiplication.
 template <class ExpressionX, class ExpressionY,
           typename std::enable_if_t<is_vector<ExpressionX>::value &&
                                         is_vector<ExpressionY>::value,
                                     int> = 0>
-KOKKOS_INLINE_FUNCTION auto operator+( const ExpressionX& x,
+KOKKOS_INLINE_FUNCTION auto operator&( const ExpressionX& x,
                                        const ExpressionY& y )
 {
     static_assert( std::is_same<typename ExpressionX::value_type,
                                 typename ExpressionY::value_type>::value,
                    "value_type must match" );
     static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
-                   "extent must match" );
+                   "extent_0 must match" );
     return createVectorExpression<typename ExpressionX::value_type,
                                   ExpressionX::extent_0>(
-        [=]( const int i ) { return x( i ) + y( i ); } );
+        [=]( const int i ) { return x( i ) * y( i ); } );
 }
 
 //---------------------------------------------------------------------------//
-// Vector-vector subtraction.
-//---------------------------------------------------------------------------//
+// Element-wise division.
 template <class ExpressionX, class ExpressionY,
           typename std::enable_if_t<is_vector<ExpressionX>::value &&
                                         is_vector<ExpressionY>::value,
                                     int> = 0>
-KOKKOS_INLINE_FUNCTION auto operator-( const ExpressionX& x,
+KOKKOS_INLINE_FUNCTION auto operator|( const ExpressionX& x,
                                        const ExpressionY& y )
 {
     static_assert( std::is_same<typename ExpressionX::value_type,
@@ -3933,387 +5321,665 @@ KOKKOS_INLINE_FUNCTION auto operator-( const ExpressionX& x,
                    "extent must match" );
     return createVectorExpression<typename ExpressionX::value_type,
                                   ExpressionX::extent_0>(
-        [=]( const int i ) { return x( i ) - y( i ); } );
+        [=]( const int i ) { return x( i ) / y( i ); } );
 }
 
 //---------------------------------------------------------------------------//
-// Quaternion-quaternion addition.
+// Scalar multiplication.
 //---------------------------------------------------------------------------//
-template <class ExpressionX, class ExpressionY,
-          typename std::enable_if_t<is_quaternion<ExpressionX>::value &&
-                                        is_quaternion<ExpressionY>::value,
-                                    int> = 0>
-KOKKOS_INLINE_FUNCTION auto operator+( const ExpressionX& x,
-                                       const ExpressionY& y )
+// Tensor4.
+template <class ExpressionA,
+          typename std::enable_if_t<is_tensor4<ExpressionA>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator*( const typename ExpressionA::value_type& s, const ExpressionA& a )
 {
-    static_assert( std::is_same<typename ExpressionX::value_type,
-                                typename ExpressionY::value_type>::value,
-                   "value_type must match" );
-    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
-                   "extent must match" );
-    return createQuaternionExpression<typename ExpressionX::value_type,
-                                      ExpressionX::extent_0>(
-        [=]( const int i ) { return x( i ) + y( i ); } );
+    return createTensor4Expression<
+        typename ExpressionA::value_type, ExpressionA::extent_0,
+        ExpressionA::extent_1, ExpressionA::extent_2, ExpressionA::extent_3>(
+        [=]( const int i, const int j, const int k, const int l )
+        { return s * a( i, j, k, l ); } );
+}
+
+template <class ExpressionA,
+          typename std::enable_if_t<is_tensor4<ExpressionA>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator*( const ExpressionA& a, const typename ExpressionA::value_type& s )
+{
+    return s * a;
+}
+
+// Tensor3.
+template <class ExpressionA,
+          typename std::enable_if_t<is_tensor3<ExpressionA>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator*( const typename ExpressionA::value_type& s, const ExpressionA& a )
+{
+    return createTensor3Expression<typename ExpressionA::value_type,
+                                   ExpressionA::extent_0, ExpressionA::extent_1,
+                                   ExpressionA::extent_2>(
+        [=]( const int i, const int j, const int k )
+        { return s * a( i, j, k ); } );
+}
+
+template <class ExpressionA,
+          typename std::enable_if_t<is_tensor3<ExpressionA>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator*( const ExpressionA& a, const typename ExpressionA::value_type& s )
+{
+    return s * a;
+}
+
+// Matrix.
+template <class ExpressionA,
+          typename std::enable_if_t<is_matrix<ExpressionA>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator*( const typename ExpressionA::value_type& s, const ExpressionA& a )
+{
+    return createMatrixExpression<typename ExpressionA::value_type,
+                                  ExpressionA::extent_0, ExpressionA::extent_1>(
+        [=]( const int i, const int j ) { return s * a( i, j ); } );
+}
+
+template <class ExpressionA,
+          typename std::enable_if_t<is_matrix<ExpressionA>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator*( const ExpressionA& a, const typename ExpressionA::value_type& s )
+{
+    return s * a;
+}
+
+//---------------------------------------------------------------------------//
+// Vector.
+template <class ExpressionX,
+          typename std::enable_if_t<is_vector<ExpressionX>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator*( const typename ExpressionX::value_type& s, const ExpressionX& x )
+{
+    return createVectorExpression<typename ExpressionX::value_type,
+                                  ExpressionX::extent_0>(
+        [=]( const int i ) { return s * x( i ); } );
+}
+
+template <class ExpressionX,
+          typename std::enable_if_t<is_vector<ExpressionX>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator*( const ExpressionX& x, const typename ExpressionX::value_type& s )
+{
+    return s * x;
+}
+
+//---------------------------------------------------------------------------//
+// Quaternion.
+template <class ExpressionX,
+          typename std::enable_if_t<is_quaternion<ExpressionX>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator*( const typename ExpressionX::value_type& s, const ExpressionX& x )
+{
+    return createQuaternionExpression<typename ExpressionX::value_type>(
+        [=]( const int i ) { return s * x( i ); } );
+}
+
+template <class ExpressionX,
+          typename std::enable_if_t<is_quaternion<ExpressionX>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator*( const ExpressionX& x, const typename ExpressionX::value_type& s )
+{
+    return s * x;
+}
+
+//---------------------------------------------------------------------------//
+// Scalar division.
+//---------------------------------------------------------------------------//
+// Tensor4.
+template <class ExpressionA,
+          typename std::enable_if_t<is_tensor4<ExpressionA>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator/( const ExpressionA& a, const typename ExpressionA::value_type& s )
+{
+    auto s_inv = static_cast<typename ExpressionA::value_type>( 1 ) / s;
+    return s_inv * a;
+}
+
+// Tensor3.
+template <class ExpressionA,
+          typename std::enable_if_t<is_tensor3<ExpressionA>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator/( const ExpressionA& a, const typename ExpressionA::value_type& s )
+{
+    auto s_inv = static_cast<typename ExpressionA::value_type>( 1 ) / s;
+    return s_inv * a;
+}
+
+// Matrix.
+template <class ExpressionA,
+          typename std::enable_if_t<is_matrix<ExpressionA>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator/( const ExpressionA& a, const typename ExpressionA::value_type& s )
+{
+    auto s_inv = static_cast<typename ExpressionA::value_type>( 1 ) / s;
+    return s_inv * a;
+}
+
+//---------------------------------------------------------------------------//
+// Vector.
+template <class ExpressionX,
+          typename std::enable_if_t<is_vector<ExpressionX>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator/( const ExpressionX& x, const typename ExpressionX::value_type& s )
+{
+    auto s_inv = static_cast<typename ExpressionX::value_type>( 1 ) / s;
+    return s_inv * x;
+}
+
+//---------------------------------------------------------------------------//
+// Quaternion.
+template <class ExpressionX,
+          typename std::enable_if_t<is_quaternion<ExpressionX>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION auto
+operator/( const ExpressionX& x, const typename ExpressionX::value_type& s )
+{
+    auto s_inv = static_cast<typename ExpressionX::value_type>( 1 ) / s;
+    return s_inv * x;
+}
+
+//---------------------------------------------------------------------------//
+// Fused evaluation.
+//---------------------------------------------------------------------------//
+// Products normally evaluate their operands into copies and return a copy
+// (see the overview). Wrapping an operand with fuse() instead builds an
+// expression in which products are also evaluated lazily, element by
+// element, and fusedAssign() writes the result directly into a (possibly
+// strided) matrix or vector view without any intermediate matrices:
+//
+//   fusedAssign( y, s * fuse( A ) * x );
+//
+// If the destination is known not to be read by the expression, e.g. it is a
+// fresh local, the run-time aliasing check can be skipped:
+//
+//   fusedAssign( NoAlias(), y, s * fuse( A ) * x );
+//
+// Fusion trades temporaries for recomputation as every element of a fused
+// product re-evaluates a row of its left operand and a column of its right
+// operand. FusedCost reports the flop and temporary counts of both strategies
+// at compile time so the choice can be checked where it matters. Within a
+// fused expression vectors are treated as Nx1 matrices.
+
+// Element access treating vectors as Nx1 matrices.
+template <class Expression>
+KOKKOS_INLINE_FUNCTION auto fusedElement( Expression& e, const int i,
+                                          const int j )
+    -> std::enable_if_t<is_matrix<Expression>::value, decltype( e( i, j ) )>
+{
+    return e( i, j );
+}
+
+template <class Expression>
+KOKKOS_INLINE_FUNCTION auto fusedElement( Expression& e, const int i,
+                                          const int )
+    -> std::enable_if_t<is_vector<Expression>::value, decltype( e( i ) )>
+{
+    return e( i );
+}
+
+// Expressions whose elements are stored in memory (i.e. not lambdas).
+template <class Expression>
+struct has_lvalue_access
+    : public std::is_lvalue_reference<decltype( fusedElement(
+          std::declval<const Expression&>(), 0, 0 ) )>::type
+{
+};
+
+// Half-open address range spanned by the elements of an expression with
+// lvalue access.
+template <class Expression>
+KOKKOS_INLINE_FUNCTION void fusedAddressRange( Expression& e,
+                                               std::uintptr_t& lo,
+                                               std::uintptr_t& hi )
+{
+    lo = reinterpret_cast<std::uintptr_t>( &fusedElement( e, 0, 0 ) );
+    hi = lo;
+    for ( int i = 0; i < Expression::extent_0; ++i )
+        for ( int j = 0; j < Expression::extent_1; ++j )
+        {
+            auto a =
+                reinterpret_cast<std::uintptr_t>( &fusedElement( e, i, j ) );
+            lo = ( a < lo ) ? a : lo;
+            hi = ( a > hi ) ? a : hi;
+        }
+    hi += sizeof( fusedElement( e, 0, 0 ) );
+}
+
+// Check if the elements of an expression overlap an address range. Lambda
+// expressions may capture anything and are conservatively assumed to.
+template <class Expression>
+KOKKOS_INLINE_FUNCTION bool fusedOverlap( const Expression& e,
+                                          const std::uintptr_t lo,
+                                          const std::uintptr_t hi,
+                                          std::true_type )
+{
+    std::uintptr_t e_lo;
+    std::uintptr_t e_hi;
+    fusedAddressRange( e, e_lo, e_hi );
+    return ( e_lo < hi ) && ( lo < e_hi );
 }
 
-//---------------------------------------------------------------------------//
-// Quaternion-quaternion subtraction.
-//---------------------------------------------------------------------------//
-template <class ExpressionX, class ExpressionY,
-          typename std::enable_if_t<is_quaternion<ExpressionX>::value &&
-                                        is_quaternion<ExpressionY>::value,
-                                    int> = 0>
-KOKKOS_INLINE_FUNCTION auto operator-( const ExpressionX& x,
-                                       const ExpressionY& y )
+template <class Expression>
+KOKKOS_INLINE_FUNCTION bool fusedOverlap( const Expression&,
+                                          const std::uintptr_t,
+                                          const std::uintptr_t,
+                                          std::false_type )
 {
-    static_assert( std::is_same<typename ExpressionX::value_type,
-                                typename ExpressionY::value_type>::value,
-                   "value_type must match" );
-    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
-                   "extent must match" );
-    return createQuaternionExpression<typename ExpressionX::value_type,
-                                      ExpressionX::extent_0>(
-        [=]( const int i ) { return x( i ) - y( i ); } );
+    return true;
 }
 
 //---------------------------------------------------------------------------//
-// Quaternion-quaternion multiplication
-//---------------------------------------------------------------------------//
-template <class ExpressionX, class ExpressionY,
-          typename std::enable_if_t<is_quaternion<ExpressionX>::value &&
-                                        is_quaternion<ExpressionY>::value,
-                                    int> = 0>
-KOKKOS_INLINE_FUNCTION auto operator&( const ExpressionX& x,
-                                       const ExpressionY& y )
+// Leaf. Lvalues with elements in memory are referenced through their view
+// type; everything else is held by value.
+template <class Expression, bool Reference>
+struct FusedLeaf
 {
-    static_assert( std::is_same<typename ExpressionX::value_type,
-                                typename ExpressionY::value_type>::value,
-                   "value_type must match" );
-    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
-                   "extent_0 must match" );
+    using storage_type =
+        typename std::conditional<Reference, typename Expression::eval_type,
+                                  Expression>::type;
+    using value_type =
+        typename std::remove_cv<typename Expression::value_type>::type;
 
-    typename ExpressionX::eval_type x_eval = x;
-    typename ExpressionY::eval_type y_eval = y;
+    static constexpr int extent_0 = Expression::extent_0;
+    static constexpr int extent_1 = Expression::extent_1;
 
-    // Hamilton product of two quaternions
-    return Quaternion<typename ExpressionX::value_type>{
-        x_eval( 0 ) * y_eval( 0 ) - x_eval( 1 ) * y_eval( 1 ) -
-            x_eval( 2 ) * y_eval( 2 ) - x_eval( 3 ) * y_eval( 3 ),
-        x_eval( 0 ) * y_eval( 1 ) + x_eval( 1 ) * y_eval( 0 ) +
-            x_eval( 2 ) * y_eval( 3 ) - x_eval( 3 ) * y_eval( 2 ),
-        x_eval( 0 ) * y_eval( 2 ) - x_eval( 1 ) * y_eval( 3 ) +
-            x_eval( 2 ) * y_eval( 0 ) + x_eval( 3 ) * y_eval( 1 ),
-        x_eval( 0 ) * y_eval( 3 ) + x_eval( 1 ) * y_eval( 2 ) -
-            x_eval( 2 ) * y_eval( 1 ) + x_eval( 3 ) * y_eval( 0 ) };
-}
+    static constexpr bool is_view = has_lvalue_access<Expression>::value;
+    static constexpr int element_flops = 0;
+    static constexpr int eager_flops = 0;
+    static constexpr int eager_temporaries = 0;
+
+    storage_type _e;
+
+    KOKKOS_INLINE_FUNCTION
+    value_type operator()( const int i, const int j ) const
+    {
+        return fusedElement( _e, i, j );
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    bool aliases( const std::uintptr_t lo, const std::uintptr_t hi ) const
+    {
+        return fusedOverlap( _e, lo, hi,
+                             std::integral_constant<bool, is_view>() );
+    }
+};
 
 //---------------------------------------------------------------------------//
-// Quaternion-matrix conjugation
-//---------------------------------------------------------------------------//
-template <class ExpressionX, class ExpressionY,
-          typename std::enable_if_t<is_matrix<ExpressionX>::value &&
-                                        is_quaternion<ExpressionY>::value,
-                                    int> = 0>
-KOKKOS_INLINE_FUNCTION auto operator&( const ExpressionX& X,
-                                       const ExpressionY& q )
+// Scalar multiplication.
+template <class ExpressionA>
+struct FusedScale
 {
-    static_assert( std::is_same<typename ExpressionX::value_type,
-                                typename ExpressionY::value_type>::value,
-                   "value_type must match" );
-    static_assert( ExpressionX::extent_0 == 3 && ExpressionX::extent_1 == 3,
-                   "matrix must be 3x3" );
+    using value_type = typename ExpressionA::value_type;
 
-    typename ExpressionX::eval_type X_eval = X;
-    typename ExpressionY::eval_type q_eval = q;
+    static constexpr int extent_0 = ExpressionA::extent_0;
+    static constexpr int extent_1 = ExpressionA::extent_1;
 
-    ExpressionX X_res;
+    static constexpr bool is_view = false;
+    static constexpr int element_flops = 1 + ExpressionA::element_flops;
+    static constexpr int eager_flops =
+        extent_0 * extent_1 + ExpressionA::eager_flops;
+    static constexpr int eager_temporaries = ExpressionA::eager_temporaries;
 
-    for ( int n = 0; n < 3; n++ )
+    value_type _s;
+    ExpressionA _a;
+
+    KOKKOS_INLINE_FUNCTION
+    value_type operator()( const int i, const int j ) const
     {
-        LinearAlgebra::Quaternion<double> p = { 0.0, X_eval.row( n ) };
-        auto p_rot = ( q_eval & p ) & ~q_eval;
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-        for ( int d = 0; d < 3; d++ )
-            X_res.row( n )( d ) = p_rot.vector()( d );
+        return _s * _a( i, j );
     }
 
-    return X_res;
-}
+    KOKKOS_INLINE_FUNCTION
+    bool aliases( const std::uintptr_t lo, const std::uintptr_t hi ) const
+    {
+        return _a.aliases( lo, hi );
+    }
+};
 
-template <class ExpressionX, class ExpressionY,
-          typename std::enable_if_t<is_quaternion<ExpressionX>::value &&
-                                        is_quaternion<ExpressionY>::value,
-                                    int> = 0>
-KOKKOS_INLINE_FUNCTION auto operator&=( const ExpressionX& x,
-                                        const ExpressionY& y )
+//---------------------------------------------------------------------------//
+// Addition and subtraction.
+template <class ExpressionA, class ExpressionB, bool Subtract>
+struct FusedSum
 {
-    static_assert( std::is_same<typename ExpressionX::value_type,
-                                typename ExpressionY::value_type>::value,
+    static_assert( std::is_same<typename ExpressionA::value_type,
+                                typename ExpressionB::value_type>::value,
                    "value_type must match" );
-    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
+    static_assert( ExpressionA::extent_0 == ExpressionB::extent_0,
                    "extent_0 must match" );
+    static_assert( ExpressionA::extent_1 == ExpressionB::extent_1,
+                   "extent_1 must match" );
 
-    typename ExpressionX::eval_type x_eval = x;
-    typename ExpressionY::eval_type y_eval = y;
+    using value_type = typename ExpressionA::value_type;
 
-    return Quaternion<typename ExpressionX::value_type>{
-        x_eval( 0 ) * y_eval( 0 ) - x_eval( 1 ) * y_eval( 1 ) -
-            x_eval( 2 ) * y_eval( 2 ) - x_eval( 3 ) * y_eval( 3 ),
-        x_eval( 0 ) * y_eval( 1 ) + x_eval( 1 ) * y_eval( 0 ) +
-            x_eval( 2 ) * y_eval( 3 ) - x_eval( 3 ) * y_eval( 2 ),
-        x_eval( 0 ) * y_eval( 2 ) - x_eval( 1 ) * y_eval( 3 ) +
-            x_eval( 2 ) * y_eval( 0 ) + x_eval( 3 ) * y_eval( 1 ),
-        x_eval( 0 ) * y_eval( 3 ) + x_eval( 1 ) * y_eval( 2 ) -
-            x_eval( 2 ) * y_eval( 1 ) + x_eval( 3 ) * y_eval( 0 ) };
-}
+    static constexpr int extent_0 = ExpressionA::extent_0;
+    static constexpr int extent_1 = ExpressionA::extent_1;
+
+    static constexpr bool is_view = false;
+    static constexpr int element_flops =
+        1 + ExpressionA::element_flops + ExpressionB::element_flops;
+    static constexpr int eager_flops = extent_0 * extent_1 +
+                                       ExpressionA::eager_flops +
+                                       ExpressionB::eager_flops;
+    static constexpr int eager_temporaries =
+        ExpressionA::eager_temporaries + ExpressionB::eager_temporaries;
+
+    ExpressionA _a;
+    ExpressionB _b;
+
+    KOKKOS_INLINE_FUNCTION
+    value_type operator()( const int i, const int j ) const
+    {
+        return Subtract ? _a( i, j ) - _b( i, j ) : _a( i, j ) + _b( i, j );
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    bool aliases( const std::uintptr_t lo, const std::uintptr_t hi ) const
+    {
+        return _a.aliases( lo, hi ) || _b.aliases( lo, hi );
+    }
+};
 
 //---------------------------------------------------------------------------//
-// Quaternion-quaternion division
-template <class ExpressionX, class ExpressionY,
-          typename std::enable_if_t<is_quaternion<ExpressionX>::value &&
-                                        is_quaternion<ExpressionY>::value,
-                                    int> = 0>
-KOKKOS_INLINE_FUNCTION auto operator|( const ExpressionX& x,
-                                       const ExpressionY& y )
+// Multiplication. The eager equivalent copies any operand which is not
+// already stored in memory and returns a copy.
+template <class ExpressionA, class ExpressionB>
+struct FusedProduct
 {
-    static_assert( std::is_same<typename ExpressionX::value_type,
-                                typename ExpressionY::value_type>::value,
+    static_assert( std::is_same<typename ExpressionA::value_type,
+                                typename ExpressionB::value_type>::value,
                    "value_type must match" );
-    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
-                   "extent must match" );
+    static_assert( ExpressionA::extent_1 == ExpressionB::extent_0,
+                   "inner extent must match" );
 
-    typename ExpressionX::eval_type x_eval = x;
-    typename ExpressionY::eval_type y_eval = y;
+    using value_type = typename ExpressionA::value_type;
 
-    auto y_norm_2 = y_eval( 0 ) * y_eval( 0 ) + y_eval( 1 ) * y_eval( 1 ) +
-                    y_eval( 2 ) * y_eval( 2 ) + y_eval( 3 ) * y_eval( 3 );
-    auto y_inv = ~y_eval / y_norm_2;
+    static constexpr int extent_0 = ExpressionA::extent_0;
+    static constexpr int extent_1 = ExpressionB::extent_1;
+    static constexpr int inner_extent = ExpressionA::extent_1;
 
-    return x_eval & y_inv;
-}
+    static constexpr bool is_view = true;
+    static constexpr int element_flops =
+        2 * inner_extent - 1 +
+        inner_extent *
+            ( ExpressionA::element_flops + ExpressionB::element_flops );
+    static constexpr int eager_flops =
+        extent_0 * extent_1 * ( 2 * inner_extent - 1 ) +
+        ExpressionA::eager_flops + ExpressionB::eager_flops;
+    static constexpr int eager_temporaries =
+        extent_0 * extent_1 +
+        ( ExpressionA::is_view ? 0 : extent_0 * inner_extent ) +
+        ( ExpressionB::is_view ? 0 : inner_extent * extent_1 ) +
+        ExpressionA::eager_temporaries + ExpressionB::eager_temporaries;
+
+    ExpressionA _a;
+    ExpressionB _b;
+
+    KOKKOS_INLINE_FUNCTION
+    value_type operator()( const int i, const int j ) const
+    {
+        value_type c = _a( i, 0 ) * _b( 0, j );
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int k = 1; k < inner_extent; ++k )
+            c += _a( i, k ) * _b( k, j );
+        return c;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    bool aliases( const std::uintptr_t lo, const std::uintptr_t hi ) const
+    {
+        return _a.aliases( lo, hi ) || _b.aliases( lo, hi );
+    }
+};
 
 //---------------------------------------------------------------------------//
-// Vector products.
-//---------------------------------------------------------------------------//
-// Cross product
-template <class ExpressionX, class ExpressionY>
-KOKKOS_INLINE_FUNCTION
-    typename std::enable_if_t<is_vector<ExpressionX>::value &&
-                                  is_vector<ExpressionY>::value,
-                              Vector<typename ExpressionX::value_type, 3>>
-    operator%( const ExpressionX& x, const ExpressionY& y )
+// Fused expression traits.
+template <class>
+struct is_fused_impl : public std::false_type
 {
-    static_assert( std::is_same<typename ExpressionX::value_type,
-                                typename ExpressionY::value_type>::value,
-                   "value_type must match" );
-    static_assert( ExpressionX::extent_0 == 3,
-                   "cross product is for 3-vectors" );
-    static_assert( ExpressionY::extent_0 == 3,
-                   "cross product is for 3-vectors" );
-    typename ExpressionX::eval_type x_eval = x;
-    typename ExpressionY::eval_type y_eval = y;
-    return Vector<typename ExpressionX::value_type, 3>{
-        x_eval( 1 ) * y_eval( 2 ) - x_eval( 2 ) * y_eval( 1 ),
-        x_eval( 2 ) * y_eval( 0 ) - x_eval( 0 ) * y_eval( 2 ),
-        x_eval( 0 ) * y_eval( 1 ) - x_eval( 1 ) * y_eval( 0 ) };
-}
+};
 
-//---------------------------------------------------------------------------//
-// Element-wise multiplication.
-template <class ExpressionX, class ExpressionY,
-          typename std::enable_if_t<is_vector<ExpressionX>::value &&
-                                        is_vector<ExpressionY>::value,
-                                    int> = 0>
-KOKKOS_INLINE_FUNCTION auto operator&( const ExpressionX& x,
-                                       const ExpressionY& y )
+template <class Expression, bool Reference>
+struct is_fused_impl<FusedLeaf<Expression, Reference>> : public std::true_type
 {
-    static_assert( std::is_same<typename ExpressionX::value_type,
-                                typename ExpressionY::value_type>::value,
-                   "value_type must match" );
-    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
-                   "extent_0 must match" );
-    return createVectorExpression<typename ExpressionX::value_type,
-                                  ExpressionX::extent_0>(
-        [=]( const int i ) { return x( i ) * y( i ); } );
-}
+};
 
-//---------------------------------------------------------------------------//
-// Element-wise division.
-template <class ExpressionX, class ExpressionY,
-          typename std::enable_if_t<is_vector<ExpressionX>::value &&
-                                        is_vector<ExpressionY>::value,
-                                    int> = 0>
-KOKKOS_INLINE_FUNCTION auto operator|( const ExpressionX& x,
-                                       const ExpressionY& y )
+template <class ExpressionA>
+struct is_fused_impl<FusedScale<ExpressionA>> : public std::true_type
 {
-    static_assert( std::is_same<typename ExpressionX::value_type,
-                                typename ExpressionY::value_type>::value,
-                   "value_type must match" );
-    static_assert( ExpressionX::extent_0 == ExpressionY::extent_0,
-                   "extent must match" );
-    return createVectorExpression<typename ExpressionX::value_type,
-                                  ExpressionX::extent_0>(
-        [=]( const int i ) { return x( i ) / y( i ); } );
-}
+};
 
-//---------------------------------------------------------------------------//
-// Scalar multiplication.
-//---------------------------------------------------------------------------//
-// Tensor4.
-template <class ExpressionA,
-          typename std::enable_if_t<is_tensor4<ExpressionA>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator*( const typename ExpressionA::value_type& s, const ExpressionA& a )
+template <class ExpressionA, class ExpressionB, bool Subtract>
+struct is_fused_impl<FusedSum<ExpressionA, ExpressionB, Subtract>>
+    : public std::true_type
 {
-    return createTensor4Expression<
-        typename ExpressionA::value_type, ExpressionA::extent_0,
-        ExpressionA::extent_1, ExpressionA::extent_2, ExpressionA::extent_3>(
-        [=]( const int i, const int j, const int k, const int l )
-        { return s * a( i, j, k, l ); } );
-}
+};
 
-template <class ExpressionA,
-          typename std::enable_if_t<is_tensor4<ExpressionA>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator*( const ExpressionA& a, const typename ExpressionA::value_type& s )
+template <class ExpressionA, class ExpressionB>
+struct is_fused_impl<FusedProduct<ExpressionA, ExpressionB>>
+    : public std::true_type
 {
-    return s * a;
-}
+};
 
-// Tensor3.
-template <class ExpressionA,
-          typename std::enable_if_t<is_tensor3<ExpressionA>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator*( const typename ExpressionA::value_type& s, const ExpressionA& a )
+template <class T>
+struct is_fused : public is_fused_impl<typename std::decay<T>::type>::type
 {
-    return createTensor3Expression<typename ExpressionA::value_type,
-                                   ExpressionA::extent_0, ExpressionA::extent_1,
-                                   ExpressionA::extent_2>(
-        [=]( const int i, const int j, const int k )
-        { return s * a( i, j, k ); } );
-}
+};
 
-template <class ExpressionA,
-          typename std::enable_if_t<is_tensor3<ExpressionA>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator*( const ExpressionA& a, const typename ExpressionA::value_type& s )
+// Operands which may be combined with a fused expression.
+template <class T>
+struct is_fusable
+    : public std::integral_constant<
+          bool, is_fused<T>::value ||
+                    is_matrix<typename std::decay<T>::type>::value ||
+                    is_vector<typename std::decay<T>::type>::value>
 {
-    return s * a;
-}
+};
 
-// Matrix.
-template <class ExpressionA,
-          typename std::enable_if_t<is_matrix<ExpressionA>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator*( const typename ExpressionA::value_type& s, const ExpressionA& a )
+// Convert an operand to a fused expression. Matrices and vectors are wrapped
+// in a leaf and fused expressions are used as is.
+template <class Expression, class = void>
+struct FusedOperand
 {
-    return createMatrixExpression<typename ExpressionA::value_type,
-                                  ExpressionA::extent_0, ExpressionA::extent_1>(
-        [=]( const int i, const int j ) { return s * a( i, j ); } );
-}
+    using expression_type = typename std::decay<Expression>::type;
+    using type = FusedLeaf<expression_type,
+                           std::is_lvalue_reference<Expression>::value &&
+                               has_lvalue_access<expression_type>::value>;
 
-template <class ExpressionA,
-          typename std::enable_if_t<is_matrix<ExpressionA>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator*( const ExpressionA& a, const typename ExpressionA::value_type& s )
+    KOKKOS_INLINE_FUNCTION
+    static type create( const expression_type& e )
+    {
+        return type{ typename type::storage_type( e ) };
+    }
+};
+
+template <class Expression>
+struct FusedOperand<Expression,
+                    typename std::enable_if<is_fused<Expression>::value>::type>
 {
-    return s * a;
-}
+    using type = typename std::decay<Expression>::type;
+
+    KOKKOS_INLINE_FUNCTION
+    static const type& create( const type& e ) { return e; }
+};
 
 //---------------------------------------------------------------------------//
-// Vector.
-template <class ExpressionX,
-          typename std::enable_if_t<is_vector<ExpressionX>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator*( const typename ExpressionX::value_type& s, const ExpressionX& x )
+// Begin a fused expression.
+template <class Expression>
+KOKKOS_INLINE_FUNCTION
+    typename std::enable_if<is_fusable<Expression>::value &&
+                                !is_fused<Expression>::value,
+                            typename FusedOperand<Expression>::type>::type
+    fuse( Expression&& e )
 {
-    return createVectorExpression<typename ExpressionX::value_type,
-                                  ExpressionX::extent_0>(
-        [=]( const int i ) { return s * x( i ); } );
+    return FusedOperand<Expression>::create( e );
 }
 
-template <class ExpressionX,
-          typename std::enable_if_t<is_vector<ExpressionX>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator*( const ExpressionX& x, const typename ExpressionX::value_type& s )
+// Fused multiplication.
+template <class ExpressionA, class ExpressionB,
+          typename std::enable_if_t<( is_fused<ExpressionA>::value ||
+                                      is_fused<ExpressionB>::value ) &&
+                                        is_fusable<ExpressionA>::value &&
+                                        is_fusable<ExpressionB>::value,
+                                    int> = 0>
+KOKKOS_INLINE_FUNCTION auto operator*( ExpressionA&& a, ExpressionB&& b )
 {
-    return s * x;
+    return FusedProduct<typename FusedOperand<ExpressionA>::type,
+                        typename FusedOperand<ExpressionB>::type>{
+        FusedOperand<ExpressionA>::create( a ),
+        FusedOperand<ExpressionB>::create( b ) };
 }
 
-//---------------------------------------------------------------------------//
-// Quaternion.
-template <class ExpressionX,
-          typename std::enable_if_t<is_quaternion<ExpressionX>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator*( const typename ExpressionX::value_type& s, const ExpressionX& x )
+// Fused addition.
+template <class ExpressionA, class ExpressionB,
+          typename std::enable_if_t<( is_fused<ExpressionA>::value ||
+                                      is_fused<ExpressionB>::value ) &&
+                                        is_fusable<ExpressionA>::value &&
+                                        is_fusable<ExpressionB>::value,
+                                    int> = 0>
+KOKKOS_INLINE_FUNCTION auto operator+( ExpressionA&& a, ExpressionB&& b )
 {
-    return createQuaternionExpression<typename ExpressionX::value_type>(
-        [=]( const int i ) { return s * x( i ); } );
+    return FusedSum<typename FusedOperand<ExpressionA>::type,
+                    typename FusedOperand<ExpressionB>::type, false>{
+        FusedOperand<ExpressionA>::create( a ),
+        FusedOperand<ExpressionB>::create( b ) };
 }
 
-template <class ExpressionX,
-          typename std::enable_if_t<is_quaternion<ExpressionX>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator*( const ExpressionX& x, const typename ExpressionX::value_type& s )
+// Fused subtraction.
+template <class ExpressionA, class ExpressionB,
+          typename std::enable_if_t<( is_fused<ExpressionA>::value ||
+                                      is_fused<ExpressionB>::value ) &&
+                                        is_fusable<ExpressionA>::value &&
+                                        is_fusable<ExpressionB>::value,
+                                    int> = 0>
+KOKKOS_INLINE_FUNCTION auto operator-( ExpressionA&& a, ExpressionB&& b )
 {
-    return s * x;
+    return FusedSum<typename FusedOperand<ExpressionA>::type,
+                    typename FusedOperand<ExpressionB>::type, true>{
+        FusedOperand<ExpressionA>::create( a ),
+        FusedOperand<ExpressionB>::create( b ) };
 }
 
-//---------------------------------------------------------------------------//
-// Scalar division.
-//---------------------------------------------------------------------------//
-// Tensor4.
-template <class ExpressionA,
-          typename std::enable_if_t<is_tensor4<ExpressionA>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator/( const ExpressionA& a, const typename ExpressionA::value_type& s )
+// Fused scalar multiplication.
+template <class ExpressionA>
+KOKKOS_INLINE_FUNCTION
+    typename std::enable_if<is_fused<ExpressionA>::value,
+                            FusedScale<ExpressionA>>::type
+    operator*( const typename ExpressionA::value_type& s,
+               const ExpressionA& a )
 {
-    auto s_inv = static_cast<typename ExpressionA::value_type>( 1 ) / s;
-    return s_inv * a;
+    return { s, a };
 }
 
-// Tensor3.
-template <class ExpressionA,
-          typename std::enable_if_t<is_tensor3<ExpressionA>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator/( const ExpressionA& a, const typename ExpressionA::value_type& s )
+template <class ExpressionA>
+KOKKOS_INLINE_FUNCTION
+    typename std::enable_if<is_fused<ExpressionA>::value,
+                            FusedScale<ExpressionA>>::type
+    operator*( const ExpressionA& a,
+               const typename ExpressionA::value_type& s )
 {
-    auto s_inv = static_cast<typename ExpressionA::value_type>( 1 ) / s;
-    return s_inv * a;
+    return { s, a };
 }
 
-// Matrix.
-template <class ExpressionA,
-          typename std::enable_if_t<is_matrix<ExpressionA>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator/( const ExpressionA& a, const typename ExpressionA::value_type& s )
+//---------------------------------------------------------------------------//
+// Compile-time cost of evaluating a fused expression directly (flops,
+// temporaries) and of evaluating the equivalent unfused expression
+// (eager_flops, eager_temporaries). Temporaries are counted in scalars.
+template <class Expression>
+struct FusedCost
 {
-    auto s_inv = static_cast<typename ExpressionA::value_type>( 1 ) / s;
-    return s_inv * a;
-}
+    static_assert( is_fused<Expression>::value,
+                   "FusedCost requires a fused expression" );
+
+    static constexpr int flops =
+        Expression::extent_0 * Expression::extent_1 * Expression::element_flops;
+    static constexpr int temporaries = 0;
+    static constexpr int eager_flops = Expression::eager_flops;
+    static constexpr int eager_temporaries = Expression::eager_temporaries;
+};
 
 //---------------------------------------------------------------------------//
-// Vector.
-template <class ExpressionX,
-          typename std::enable_if_t<is_vector<ExpressionX>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator/( const ExpressionX& x, const typename ExpressionX::value_type& s )
+// Tag asserting that a fused expression does not read the memory of its
+// destination, e.g. when the destination is a fresh local.
+struct NoAlias
 {
-    auto s_inv = static_cast<typename ExpressionX::value_type>( 1 ) / s;
-    return s_inv * x;
+};
+
+//---------------------------------------------------------------------------//
+// Assign a fused expression to a matrix or vector which it does not alias.
+// The expression is evaluated directly into the destination without any
+// aliasing check.
+template <class Destination, class Expression>
+KOKKOS_INLINE_FUNCTION typename std::enable_if<
+    ( is_matrix<typename std::decay<Destination>::type>::value ||
+      is_vector<typename std::decay<Destination>::type>::value ) &&
+    is_fused<Expression>::value>::type
+fusedAssign( NoAlias, Destination&& dst, const Expression& e )
+{
+    using destination_type = typename std::decay<Destination>::type;
+    static_assert( destination_type::extent_0 == Expression::extent_0,
+                   "Extents must match" );
+    static_assert( destination_type::extent_1 == Expression::extent_1,
+                   "Extents must match" );
+
+    for ( int i = 0; i < Expression::extent_0; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int j = 0; j < Expression::extent_1; ++j )
+            fusedElement( dst, i, j ) = e( i, j );
 }
 
 //---------------------------------------------------------------------------//
-// Quaternion.
-template <class ExpressionX,
-          typename std::enable_if_t<is_quaternion<ExpressionX>::value, int> = 0>
-KOKKOS_INLINE_FUNCTION auto
-operator/( const ExpressionX& x, const typename ExpressionX::value_type& s )
+// Assign a fused expression to a matrix or vector. The expression is
+// evaluated directly into the destination unless it reads the destination
+// memory, in which case it is first evaluated into a temporary. The aliasing
+// check takes the address of every element so use the NoAlias overload when
+// the destination is known to be distinct.
+template <class Destination, class Expression>
+KOKKOS_INLINE_FUNCTION typename std::enable_if<
+    ( is_matrix<typename std::decay<Destination>::type>::value ||
+      is_vector<typename std::decay<Destination>::type>::value ) &&
+    is_fused<Expression>::value>::type
+fusedAssign( Destination&& dst, const Expression& e )
 {
-    auto s_inv = static_cast<typename ExpressionX::value_type>( 1 ) / s;
-    return s_inv * x;
+    using destination_type = typename std::decay<Destination>::type;
+    static_assert( destination_type::extent_0 == Expression::extent_0,
+                   "Extents must match" );
+    static_assert( destination_type::extent_1 == Expression::extent_1,
+                   "Extents must match" );
+
+    std::uintptr_t lo;
+    std::uintptr_t hi;
+    fusedAddressRange( dst, lo, hi );
+
+    if ( e.aliases( lo, hi ) )
+    {
+        Matrix<typename Expression::value_type, Expression::extent_0,
+               Expression::extent_1>
+            tmp;
+        for ( int i = 0; i < Expression::extent_0; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+            for ( int j = 0; j < Expression::extent_1; ++j )
+                tmp( i, j ) = e( i, j );
+        for ( int i = 0; i < Expression::extent_0; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+            for ( int j = 0; j < Expression::extent_1; ++j )
+                fusedElement( dst, i, j ) = tmp( i, j );
+    }
+    else
+    {
+        fusedAssign( NoAlias(), dst, e );
+    }
 }
 
 //---------------------------------------------------------------------------//
@@ -4355,7 +6021,7 @@ KOKKOS_INLINE_FUNCTION
 template <class ExpressionA>
 KOKKOS_INLINE_FUNCTION
     typename std::enable_if_t<is_matrix<ExpressionA>::value,
-                              typename ExpressionA::copy_type>
+                              dense_copy_t<ExpressionA>>
     LU( const ExpressionA& a )
 {
     using value_type = typename ExpressionA::value_type;
@@ -4363,27 +6029,193 @@ KOKKOS_INLINE_FUNCTION
     constexpr int n = ExpressionA::extent_1;
     constexpr int k = ( m < n ? m : n );
 
-    typename ExpressionA::copy_type lu = a;
+    dense_copy_t<ExpressionA> lu = a;
 
     for ( int p = 0; p < k; ++p )
     {
         const int iend = m - p;
         const int jend = n - p;
 
-        const value_type diag = lu( p, p );
+        const value_type diag = lu( p, p );
+
+        for ( int i = 1; i < iend; ++i )
+        {
+            lu( i + p, p ) /= diag;
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+            for ( int j = 1; j < jend; ++j )
+                lu( i + p, j + p ) -= lu( i + p, p ) * lu( p, j + p );
+        }
+    }
+
+    return lu;
+}
+
+//---------------------------------------------------------------------------//
+// Cholesky decomposition. Returns the lower triangular factor L of a
+// symmetric positive definite matrix (A = L * ~L) with zeros above the
+// diagonal. Only the lower triangle of A is read.
+//---------------------------------------------------------------------------//
+template <class ExpressionA>
+KOKKOS_INLINE_FUNCTION
+    typename std::enable_if_t<is_matrix<ExpressionA>::value,
+                              dense_copy_t<ExpressionA>>
+    Cholesky( const ExpressionA& a )
+{
+    static_assert( ExpressionA::extent_1 == ExpressionA::extent_0,
+                   "matrix must be square" );
+
+    using Kokkos::sqrt;
+    using value_type = typename ExpressionA::value_type;
+    constexpr int m = ExpressionA::extent_0;
+
+    dense_copy_t<ExpressionA> l = a;
+
+    for ( int p = 0; p < m; ++p )
+    {
+        for ( int k = 0; k < p; ++k )
+            l( p, p ) -= l( p, k ) * l( p, k );
+        l( p, p ) = sqrt( l( p, p ) );
+
+        for ( int i = p + 1; i < m; ++i )
+        {
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+            for ( int k = 0; k < p; ++k )
+                l( i, p ) -= l( i, k ) * l( p, k );
+            l( i, p ) /= l( p, p );
+            l( p, i ) = static_cast<value_type>( 0 );
+        }
+    }
+
+    return l;
+}
+
+//---------------------------------------------------------------------------//
+// Factored solves. These reuse a factorization from LU() or Cholesky() for
+// any number of right hand sides. Single and multiple RHS supported.
+//---------------------------------------------------------------------------//
+// Solve A*x = b given a_lu = LU(A).
+template <class ExpressionA, class ExpressionB>
+KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
+    is_matrix<ExpressionA>::value &&
+        ( is_matrix<ExpressionB>::value || is_vector<ExpressionB>::value ),
+    dense_copy_t<ExpressionB>>
+luSolve( const ExpressionA& a_lu, const ExpressionB& b )
+{
+    static_assert( std::is_same<typename ExpressionA::value_type,
+                                typename ExpressionB::value_type>::value,
+                   "value_type must be the same" );
+    static_assert( ExpressionA::extent_1 == ExpressionB::extent_0,
+                   "Inner extent must match" );
+    static_assert( ExpressionA::extent_1 == ExpressionA::extent_0,
+                   "matrix must be square" );
+
+    using value_type = typename ExpressionA::value_type;
+    constexpr int m = ExpressionB::extent_0;
+    constexpr int n = ExpressionB::extent_1;
+
+    // Create RHS/LHS
+    dense_copy_t<ExpressionB> x = b;
+
+    // Solve Ly = b for y where y = Ux
+    for ( int p = 0; p < m; ++p )
+    {
+        const int iend = m - p;
+        const int jend = n;
+
+        for ( int i = 1; i < iend; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+            for ( int j = 0; j < jend; ++j )
+                x( i + p, j ) -= a_lu( i + p, p ) * x( p, j );
+    }
+
+    // Solve Ux = y for x.
+    for ( int p = ( m - 1 ); p >= 0; --p )
+    {
+        const int iend = p;
+        const int jend = n;
+
+        const value_type diag = a_lu( p, p );
+
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int j = 0; j < n; ++j )
+            x( p, j ) /= diag;
+
+        if ( p > 0 )
+        {
+            for ( int i = 0; i < iend; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+                for ( int j = 0; j < jend; ++j )
+                    x( i, j ) -= a_lu( i, p ) * x( p, j );
+        }
+    }
+
+    return x;
+}
+
+// Solve A*x = b given l = Cholesky(A).
+template <class ExpressionL, class ExpressionB>
+KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
+    is_matrix<ExpressionL>::value &&
+        ( is_matrix<ExpressionB>::value || is_vector<ExpressionB>::value ),
+    dense_copy_t<ExpressionB>>
+choleskySolve( const ExpressionL& l, const ExpressionB& b )
+{
+    static_assert( std::is_same<typename ExpressionL::value_type,
+                                typename ExpressionB::value_type>::value,
+                   "value_type must be the same" );
+    static_assert( ExpressionL::extent_1 == ExpressionB::extent_0,
+                   "Inner extent must match" );
+    static_assert( ExpressionL::extent_1 == ExpressionL::extent_0,
+                   "matrix must be square" );
+
+    constexpr int m = ExpressionB::extent_0;
+    constexpr int n = ExpressionB::extent_1;
+
+    dense_copy_t<ExpressionB> x = b;
 
-        for ( int i = 1; i < iend; ++i )
-        {
-            lu( i + p, p ) /= diag;
+    // Solve Ly = b for y where y = ~Lx
+    for ( int p = 0; p < m; ++p )
+    {
 #if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
 #pragma unroll
 #endif
-            for ( int j = 1; j < jend; ++j )
-                lu( i + p, j + p ) -= lu( i + p, p ) * lu( p, j + p );
-        }
+        for ( int j = 0; j < n; ++j )
+            x( p, j ) /= l( p, p );
+        for ( int i = p + 1; i < m; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+            for ( int j = 0; j < n; ++j )
+                x( i, j ) -= l( i, p ) * x( p, j );
     }
 
-    return lu;
+    // Solve ~Lx = y for x.
+    for ( int p = ( m - 1 ); p >= 0; --p )
+    {
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+        for ( int j = 0; j < n; ++j )
+            x( p, j ) /= l( p, p );
+        for ( int i = 0; i < p; ++i )
+#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
+#pragma unroll
+#endif
+            for ( int j = 0; j < n; ++j )
+                x( i, j ) -= l( p, i ) * x( p, j );
+    }
+
+    return x;
 }
 
 //---------------------------------------------------------------------------//
@@ -4695,7 +6527,7 @@ KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
 inverse( const ExpressionA& a )
 {
     Matrix<typename ExpressionA::value_type, ExpressionA::extent_0,
-           ExpressionA::extent1>
+           ExpressionA::extent_1>
         ident;
     identity( ident );
     return a ^ ident;
@@ -4761,7 +6593,7 @@ KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
     is_matrix<ExpressionA>::value &&
         ( is_matrix<ExpressionB>::value || is_vector<ExpressionB>::value ) &&
         ExpressionA::extent_0 == 2 && ExpressionA::extent_1 == 2,
-    typename ExpressionB::copy_type>
+    dense_copy_t<ExpressionB>>
 operator^( const ExpressionA& a, const ExpressionB& b )
 {
     return inverse( a ) * b;
@@ -4774,7 +6606,7 @@ KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
     is_matrix<ExpressionA>::value &&
         ( is_matrix<ExpressionB>::value || is_vector<ExpressionB>::value ) &&
         ExpressionA::extent_0 == 3 && ExpressionA::extent_1 == 3,
-    typename ExpressionB::copy_type>
+    dense_copy_t<ExpressionB>>
 operator^( const ExpressionA& a, const ExpressionB& b )
 {
     return inverse( a ) * b;
@@ -4788,7 +6620,7 @@ KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
         ( is_matrix<ExpressionB>::value || is_vector<ExpressionB>::value ) &&
         !( ExpressionA::extent_0 == 2 && ExpressionA::extent_1 == 2 ) &&
         !( ExpressionA::extent_0 == 3 && ExpressionA::extent_1 == 3 ),
-    typename ExpressionB::copy_type>
+    dense_copy_t<ExpressionB>>
 operator^( const ExpressionA& a, const ExpressionB& b )
 {
     static_assert( std::is_same<typename ExpressionA::value_type,
@@ -4799,163 +6631,122 @@ operator^( const ExpressionA& a, const ExpressionB& b )
     static_assert( ExpressionA::extent_1 == ExpressionA::extent_0,
                    "matrix must be square" );
 
-    using value_type = typename ExpressionA::value_type;
-    constexpr int m = ExpressionB::extent_0;
-    constexpr int n = ExpressionB::extent_1;
-
-    // Compute LU decomposition.
-    auto a_lu = LU( a );
-
-    // Create RHS/LHS
-    typename ExpressionB::copy_type x = b;
-
-    // Solve Ly = b for y where y = Ux
-    for ( int p = 0; p < m; ++p )
-    {
-        const int iend = m - p;
-        const int jend = n;
-
-        for ( int i = 1; i < iend; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-            for ( int j = 0; j < jend; ++j )
-                x( i + p, j ) -= a_lu( i + p, p ) * x( p, j );
-    }
-
-    // Solve Ux = y for x.
-    for ( int p = ( m - 1 ); p >= 0; --p )
-    {
-        const int iend = p;
-        const int jend = n;
-
-        const value_type diag = a_lu( p, p );
-
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-        for ( int j = 0; j < n; ++j )
-            x( p, j ) /= diag;
-
-        if ( p > 0 )
-        {
-            for ( int i = 0; i < iend; ++i )
-#if defined( KOKKOS_ENABLE_PRAGMA_UNROLL )
-#pragma unroll
-#endif
-                for ( int j = 0; j < jend; ++j )
-                    x( i, j ) -= a_lu( i, p ) * x( p, j );
-        }
-    }
-
-    return x;
+    return luSolve( LU( a ), b );
 }
 
-template <typename ValueType>
-KOKKOS_INLINE_FUNCTION void condSwap( bool b, ValueType& lv, ValueType& rv )
+//---------------------------------------------------------------------------//
+// Conditional swaps. The condition is a bool for scalars and a lane mask for
+// batches.
+template <class MaskType, class ValueType>
+KOKKOS_INLINE_FUNCTION void condSwap( const MaskType& b, ValueType& lv,
+                                      ValueType& rv )
 {
-    auto tmpv = lv;
-    lv = b ? rv : lv;
-    rv = b ? tmpv : rv;
+    ValueType tmpv = lv;
+    lv = select( b, rv, lv );
+    rv = select( b, tmpv, rv );
 }
 
-template <typename ValueType>
-KOKKOS_INLINE_FUNCTION void condNegSwap( bool b, ValueType& lv, ValueType& rv )
+template <class MaskType, class ValueType>
+KOKKOS_INLINE_FUNCTION void condNegSwap( const MaskType& b, ValueType& lv,
+                                         ValueType& rv )
 {
-    auto tmpv = -1.0 * lv;
-    lv = b ? rv : lv;
-    rv = b ? tmpv : rv;
+    ValueType tmpv = -lv;
+    lv = select( b, rv, lv );
+    rv = select( b, tmpv, rv );
 }
 
-template <>
-KOKKOS_INLINE_FUNCTION void
-condNegSwap<VectorView<double, 3>>( bool b, VectorView<double, 3>& lv,
-                                    VectorView<double, 3>& rv )
+template <class MaskType, class T, int N>
+KOKKOS_INLINE_FUNCTION void condNegSwap( const MaskType& b,
+                                         VectorView<T, N>& lv,
+                                         VectorView<T, N>& rv )
 {
-    using vector_type = typename VectorView<double, 3>::copy_type;
-    vector_type tmpv;
-
-    if ( b )
-    {
-        for ( int d = 0; d < 3; d++ )
-        {
-            tmpv( d ) = -1.0 * lv( d );
-            lv( d ) = rv( d );
-            rv( d ) = tmpv( d );
-        }
-    }
+    for ( int d = 0; d < N; d++ )
+        condNegSwap( b, lv( d ), rv( d ) );
 }
 
-KOKKOS_INLINE_FUNCTION
-Quaternion<double> givensQuaternion( double a11, double a12, double a22,
-                                     Kokkos::Array<std::size_t, 2> ij )
+template <class T>
+KOKKOS_INLINE_FUNCTION Quaternion<T>
+givensQuaternion( const T& a11, const T& a12, const T& a22,
+                  Kokkos::Array<std::size_t, 2> ij )
 {
-    const double gamma = 3.0 + 2.0 * Kokkos::sqrt( 2.0 );
-    const double pi = 4.0 * Kokkos::atan( 1.0 );
+    using Kokkos::sqrt;
+    using scalar_type = scalar_type_t<T>;
 
-    const double cs = Kokkos::cos( pi / 8.0 );
-    const double ss = Kokkos::sin( pi / 8.0 );
+    // Constants in the working precision: 3 + 2 * sqrt(2), cos(pi/8), and
+    // sin(pi/8).
+    const scalar_type gamma = 5.8284271247461903;
+    const T cs = static_cast<scalar_type>( 0.92387953251128674 );
+    const T ss = static_cast<scalar_type>( 0.38268343236508977 );
+    const T zero = static_cast<scalar_type>( 0.0 );
 
-    double ch = 2.0 * ( a11 - a22 );
-    double sh = a12;
+    T ch = static_cast<scalar_type>( 2.0 ) * ( a11 - a22 );
+    T sh = a12;
 
-    bool b = ( gamma * sh * sh ) < ( ch * ch );
+    auto b = ( gamma * sh * sh ) < ( ch * ch );
 
-    double ome = 1.0 / Kokkos::sqrt( ch * ch + sh * sh );
-    ch = b ? ome * ch : cs;
-    sh = b ? ome * sh : ss;
+    T ome = static_cast<scalar_type>( 1.0 ) / sqrt( ch * ch + sh * sh );
+    ch = select( b, ome * ch, cs );
+    sh = select( b, ome * sh, ss );
 
-    Quaternion<double> q = 0.0;
+    Quaternion<T> q = zero;
 
     // The ordering of the quaternion is different
     // according to the element indices
     if ( ij[0] == 0 && ij[1] == 1 )
     {
-        q = { ch, 0.0, 0.0, sh };
+        q = { ch, zero, zero, sh };
     }
     else if ( ij[0] == 0 && ij[1] == 2 )
     {
-        q = { ch, 0.0, -sh, 0.0 };
+        q = { ch, zero, -sh, zero };
     }
     else if ( ij[0] == 1 && ij[1] == 2 )
     {
-        q = { ch, sh, 0.0, 0.0 };
+        q = { ch, sh, zero, zero };
     }
 
     return q;
 }
 
-KOKKOS_INLINE_FUNCTION
-Quaternion<double> givensQR( double a1, double a2, double tol,
-                             Kokkos::Array<std::size_t, 2> ij )
+template <class T>
+KOKKOS_INLINE_FUNCTION Quaternion<T>
+givensQR( const T& a1, const T& a2, const scalar_type_t<T> tol,
+          Kokkos::Array<std::size_t, 2> ij )
 {
-    double rho = Kokkos::sqrt( a1 * a1 + a2 * a2 );
+    using Kokkos::fabs;
+    using Kokkos::max;
+    using Kokkos::sqrt;
+    using scalar_type = scalar_type_t<T>;
+
+    const T zero = static_cast<scalar_type>( 0.0 );
 
-    double sh = rho > tol ? a2 : 0.0;
-    double ch = Kokkos::fabs( a1 ) + Kokkos::max( rho, tol );
+    T rho = sqrt( a1 * a1 + a2 * a2 );
 
-    condSwap( a1 < 0, sh, ch );
+    T sh = select( rho > static_cast<T>( tol ), a2, zero );
+    T ch = fabs( a1 ) + max( rho, static_cast<T>( tol ) );
 
-    double ome = 1.0 / Kokkos::sqrt( ch * ch + sh * sh );
+    condSwap( a1 < zero, sh, ch );
+
+    T ome = static_cast<scalar_type>( 1.0 ) / sqrt( ch * ch + sh * sh );
 
     ch = ome * ch;
     sh = ome * sh;
 
-    Quaternion<double> q = 0.0;
+    Quaternion<T> q = zero;
 
     // The ordering of the quaternion is different
     // according to the element indices
     if ( ij[0] == 2 && ij[1] == 0 )
     {
-        q = { ch, 0.0, -sh, 0.0 };
+        q = { ch, zero, -sh, zero };
     }
     else if ( ij[0] == 1 && ij[1] == 0 )
     {
-        q = { ch, 0.0, 0.0, sh };
+        q = { ch, zero, zero, sh };
     }
     else if ( ij[0] == 2 && ij[1] == 1 )
     {
-        q = { ch, sh, 0.0, 0.0 };
+        q = { ch, sh, zero, zero };
     }
 
     return q;
@@ -4969,6 +6760,8 @@ KOKKOS_INLINE_FUNCTION
                               Quaternion<typename ExpressionA::value_type>>
     cyclicJacobi( const ExpressionA& A, const int max_iter )
 {
+    using value_type = typename ExpressionA::value_type;
+
     // Form the symmetric positive-definite matrix from A
     auto S = ~A * A;
 
@@ -4982,14 +6775,14 @@ KOKKOS_INLINE_FUNCTION
     auto pq = diag_inds[0];
 
     // Construct the 2x2 submatrix from the (pq)-entries of the 3x3 matrix
-    double s_pp = S( pq[0], pq[0] );
-    double s_pq = S( pq[0], pq[1] );
-    double s_qq = S( pq[1], pq[1] );
+    value_type s_pp = S( pq[0], pq[0] );
+    value_type s_pq = S( pq[0], pq[1] );
+    value_type s_qq = S( pq[1], pq[1] );
 
-    Quaternion<double> q_total = givensQuaternion( s_pp, s_pq, s_qq, pq );
+    Quaternion<value_type> q_total = givensQuaternion( s_pp, s_pq, s_qq, pq );
 
     // Convert to rotation matrix for conjugation
-    Matrix<double, 3, 3> Q_1{ q_total };
+    Matrix<value_type, 3, 3> Q_1{ q_total };
 
     S = ~Q_1 * S * Q_1;
 
@@ -5007,7 +6800,7 @@ KOKKOS_INLINE_FUNCTION
         auto q = givensQuaternion( s_pp, s_pq, s_qq, pq );
 
         // Convert to rotation matrix for conjugation
-        Matrix<double, 3, 3> Q{ q };
+        Matrix<value_type, 3, 3> Q{ q };
 
         S = ~Q * S * Q; // Update to (k+1)
         q_total = q_total & q;
@@ -5019,8 +6812,10 @@ KOKKOS_INLINE_FUNCTION
 template <class MatrixType>
 KOKKOS_INLINE_FUNCTION void sortSingularValues( MatrixType& B, MatrixType& V )
 {
+    using value_type = typename MatrixType::value_type;
+
     // Array of singular values
-    Kokkos::Array<double, 3> rho = { 0.0 };
+    Kokkos::Array<value_type, 3> rho;
 
     for ( int d = 0; d < 3; d++ )
     {
@@ -5037,20 +6832,122 @@ KOKKOS_INLINE_FUNCTION void sortSingularValues( MatrixType& B, MatrixType& V )
     auto v2 = V.column( 2 );
 
     // Perform column swaps based on the ordering of the singular values
-    condNegSwap( rho[0] < rho[1], b0, b1 );
-    condNegSwap( rho[0] < rho[1], v0, v1 );
+    auto swap_01 = rho[0] < rho[1];
+    condNegSwap( swap_01, b0, b1 );
+    condNegSwap( swap_01, v0, v1 );
+
+    condSwap( swap_01, rho[0], rho[1] );
+
+    auto swap_02 = rho[0] < rho[2];
+    condNegSwap( swap_02, b0, b2 );
+    condNegSwap( swap_02, v0, v2 );
+
+    condSwap( swap_02, rho[0], rho[2] );
+
+    auto swap_12 = rho[1] < rho[2];
+    condNegSwap( swap_12, b1, b2 );
+    condNegSwap( swap_12, v1, v2 );
+}
+
+//---------------------------------------------------------------------------//
+// One-sided Jacobi sweeps on the columns of B = A * V. Each rotation makes a
+// pair of columns of B orthogonal and is also applied to V. Unlike the
+// rotations of ~A * A this works on A itself and so keeps the relative
+// accuracy of the small singular values of ill-conditioned matrices.
+template <class T>
+KOKKOS_INLINE_FUNCTION void oneSidedJacobi( Matrix<T, 3, 3>& B,
+                                            Matrix<T, 3, 3>& V,
+                                            const int num_sweep )
+{
+    using Kokkos::fabs;
+    using Kokkos::sqrt;
+    using scalar_type = scalar_type_t<T>;
+
+    const T zero = static_cast<scalar_type>( 0.0 );
+    const T one = static_cast<scalar_type>( 1.0 );
 
-    condSwap( rho[0] < rho[1], rho[0], rho[1] );
+    for ( int sweep = 0; sweep < num_sweep; ++sweep )
+        for ( int n = 0; n < 3; ++n )
+        {
+            const int p = ( n == 2 ) ? 1 : 0;
+            const int q = ( n == 0 ) ? 1 : 2;
 
-    condNegSwap( rho[0] < rho[2], b0, b2 );
-    condNegSwap( rho[0] < rho[2], v0, v2 );
+            T alpha = zero;
+            T beta = zero;
+            T gamma = zero;
+            for ( int k = 0; k < 3; ++k )
+            {
+                alpha += B( k, p ) * B( k, p );
+                beta += B( k, q ) * B( k, q );
+                gamma += B( k, p ) * B( k, q );
+            }
 
-    condSwap( rho[0] < rho[2], rho[0], rho[2] );
+            auto skip = ( gamma == zero );
+            T two_gamma = static_cast<scalar_type>( 2.0 ) * gamma;
+            T zeta = ( beta - alpha ) / select( skip, one, two_gamma );
+            T t = select( zeta < zero, -one, one ) /
+                  ( fabs( zeta ) + sqrt( zeta * zeta + one ) );
+            t = select( skip, zero, t );
+            T c = one / sqrt( t * t + one );
+            T sn = t * c;
 
-    condNegSwap( rho[1] < rho[2], b1, b2 );
-    condNegSwap( rho[1] < rho[2], v1, v2 );
+            for ( int k = 0; k < 3; ++k )
+            {
+                T b_kp = B( k, p );
+                T b_kq = B( k, q );
+                B( k, p ) = c * b_kp - sn * b_kq;
+                B( k, q ) = sn * b_kp + c * b_kq;
+
+                T v_kp = V( k, p );
+                T v_kq = V( k, q );
+                V( k, p ) = c * v_kp - sn * v_kq;
+                V( k, q ) = sn * v_kp + c * v_kq;
+            }
+        }
 }
 
+//---------------------------------------------------------------------------//
+// Singular value decomposition precision.
+//---------------------------------------------------------------------------//
+// Tags selecting the SVD algorithm.
+//
+// SVDFast: approximate Givens rotations of ~A * A with a fixed number of
+// Jacobi iterations tuned for the scalar type followed by a Givens QR.
+//
+// SVDAccurate: additionally refines V with one-sided Jacobi sweeps on A * V
+// before the QR. Use this for ill-conditioned matrices where the small
+// singular values of SVDFast lose relative accuracy.
+struct SVDFast
+{
+};
+
+struct SVDAccurate
+{
+};
+
+// Parameters of the SVD for a scalar type: the number of Jacobi iterations
+// on ~A * A (3 per sweep), the QR tolerance, and the number of one-sided
+// Jacobi sweeps of SVDAccurate. Single precision uses the 4 sweeps of
+// McAdams et al.
+template <class T>
+struct SVDTraits;
+
+template <>
+struct SVDTraits<float>
+{
+    static constexpr int num_iter = 12;
+    static constexpr float tol = 1.0e-6f;
+    static constexpr int num_refine = 2;
+};
+
+template <>
+struct SVDTraits<double>
+{
+    static constexpr int num_iter = 15;
+    static constexpr double tol = 1.0e-14;
+    static constexpr int num_refine = 2;
+};
+
 //---------------------------------------------------------------------------//
 // Matrix Singular Value Decomposition
 // Implementation based on McAdams, Selle, et al.,
@@ -5059,58 +6956,469 @@ KOKKOS_INLINE_FUNCTION void sortSingularValues( MatrixType& B, MatrixType& V )
 // Computes the singular value decomposition of the matrix A
 // A = U * Σ * V^T
 //
+// The decomposition is branch-free so a batch value type computes the
+// decomposition of every lane at once. All arithmetic is done in the scalar
+// type of A so single precision matrices take the cheaper float path.
 //---------------------------------------------------------------------------//
 
-template <class ExpressionA, class EigenU, class Diagonal, class EigenV>
+template <class Precision, class ExpressionA, class EigenU, class Diagonal,
+          class EigenV>
 KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
-    is_matrix<ExpressionA>::value && is_matrix<EigenU>::value &&
+    ( std::is_same<Precision, SVDFast>::value ||
+      std::is_same<Precision, SVDAccurate>::value ) &&
+        is_matrix<ExpressionA>::value && is_matrix<EigenU>::value &&
         is_matrix<Diagonal>::value && is_matrix<EigenV>::value,
     void>
-svd( const ExpressionA& A, EigenU& U, Diagonal& D, EigenV& V )
+svd( Precision, const ExpressionA& A, EigenU& U, Diagonal& D, EigenV& V )
 {
-    constexpr int num_iter = 15;
-    constexpr double tol = 1e-14;
+    using Kokkos::sqrt;
+    using value_type = typename ExpressionA::value_type;
+    using traits = SVDTraits<scalar_type_t<value_type>>;
+
+    constexpr int num_iter = traits::num_iter;
+    constexpr auto tol = traits::tol;
 
     // Perform modified cyclic Jacobi iterations to calculate V
     auto q = cyclicJacobi( A, num_iter );
 
     // Normalize the quaternion and convert to the orthogonal matrix V
-    double q_mag = Kokkos::sqrt( q( 0 ) * q( 0 ) + q( 1 ) * q( 1 ) +
-                                 q( 2 ) * q( 2 ) + q( 3 ) * q( 3 ) );
+    value_type q_mag = sqrt( q( 0 ) * q( 0 ) + q( 1 ) * q( 1 ) +
+                             q( 2 ) * q( 2 ) + q( 3 ) * q( 3 ) );
 
-    Matrix<double, 3, 3> V_rot{ q / q_mag };
+    Matrix<value_type, 3, 3> V_rot{ q / q_mag };
 
-    Matrix<double, 3, 3> Q = 0.0;
+    Matrix<value_type, 3, 3> Q;
 
     // Perform a QR factorization of the matrix B = AV
-    auto B = A * V_rot;
+    Matrix<value_type, 3, 3> B = A * V_rot;
+
+    if ( std::is_same<Precision, SVDAccurate>::value )
+        oneSidedJacobi( B, V_rot, traits::num_refine );
 
     sortSingularValues( B, V_rot );
 
     auto q21 = givensQR( B( 0, 0 ), B( 1, 0 ), tol, { 1, 0 } );
-    auto Q1 = static_cast<Matrix<double, 3, 3>>( q21 );
+    auto Q1 = static_cast<Matrix<value_type, 3, 3>>( q21 );
 
     auto B1 = ~Q1 * B;
 
     auto q31 = givensQR( B1( 0, 0 ), B1( 2, 0 ), tol, { 2, 0 } );
-    auto Q2 = static_cast<Matrix<double, 3, 3>>( q31 );
+    auto Q2 = static_cast<Matrix<value_type, 3, 3>>( q31 );
 
     auto B2 = ~Q2 * B1;
 
     auto q32 = givensQR( B2( 1, 1 ), B2( 2, 1 ), tol, { 2, 1 } );
-    auto Q3 = static_cast<Matrix<double, 3, 3>>( q32 );
+    auto Q3 = static_cast<Matrix<value_type, 3, 3>>( q32 );
 
     auto B3 = ~Q3 * B2;
 
-    Q = static_cast<Matrix<double, 3, 3>>( q21 & q31 & q32 );
+    Q = static_cast<Matrix<value_type, 3, 3>>( q21 & q31 & q32 );
 
     U = Q;
     D = B3;
     V = V_rot;
 }
 
+// Default to the fast path.
+template <class ExpressionA, class EigenU, class Diagonal, class EigenV>
+KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
+    is_matrix<ExpressionA>::value && is_matrix<EigenU>::value &&
+        is_matrix<Diagonal>::value && is_matrix<EigenV>::value,
+    void>
+svd( const ExpressionA& A, EigenU& U, Diagonal& D, EigenV& V )
+{
+    svd( SVDFast(), A, U, D, V );
+}
+
+//---------------------------------------------------------------------------//
+// Symmetric 3x3 eigendecomposition
+//---------------------------------------------------------------------------//
+// Eigenvalues of a symmetric 3x3 matrix in ascending order from the
+// trigonometric solution of the characteristic cubic (Smith, Comm. ACM 4(4),
+// 1961). Only the upper triangle of the matrix is read.
+template <class ExpressionA, class Eigenvalues>
+KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
+    is_matrix<ExpressionA>::value && is_vector<Eigenvalues>::value &&
+        ExpressionA::extent_0 == 3 && ExpressionA::extent_1 == 3,
+    void>
+symmetricEigendecomposition( const ExpressionA& A, Eigenvalues& e )
+{
+    static_assert( Eigenvalues::extent_0 == 3, "Dimensions must match" );
+
+    using Kokkos::acos;
+    using Kokkos::cos;
+    using Kokkos::max;
+    using Kokkos::min;
+    using Kokkos::sqrt;
+    using value_type = typename ExpressionA::value_type;
+
+    typename ExpressionA::eval_type a = A;
+
+    // Shift by the mean eigenvalue and scale the deviator to unit size. The
+    // deviator of a multiple of the identity vanishes.
+    value_type q = ( a( 0, 0 ) + a( 1, 1 ) + a( 2, 2 ) ) / 3.0;
+    value_type b00 = a( 0, 0 ) - q;
+    value_type b11 = a( 1, 1 ) - q;
+    value_type b22 = a( 2, 2 ) - q;
+    value_type b01 = a( 0, 1 );
+    value_type b02 = a( 0, 2 );
+    value_type b12 = a( 1, 2 );
+    value_type p = sqrt( ( b00 * b00 + b11 * b11 + b22 * b22 +
+                           2.0 * ( b01 * b01 + b02 * b02 + b12 * b12 ) ) /
+                         6.0 );
+    value_type zero = static_cast<value_type>( 0.0 );
+    value_type p_inv = select( p > zero, 1.0 / p, zero );
+
+    // Half the determinant of the scaled deviator is the cosine of three
+    // times the angle of the largest eigenvalue.
+    value_type r = 0.5 * p_inv * p_inv * p_inv *
+                   ( b00 * ( b11 * b22 - b12 * b12 ) -
+                     b01 * ( b01 * b22 - b12 * b02 ) +
+                     b02 * ( b01 * b12 - b11 * b02 ) );
+    r = min( max( r, static_cast<value_type>( -1.0 ) ),
+             static_cast<value_type>( 1.0 ) );
+    value_type phi = acos( r ) / 3.0;
+
+    constexpr double two_pi_3 = 2.0943951023931954923;
+    e( 2 ) = q + 2.0 * p * cos( phi );
+    e( 0 ) = q + 2.0 * p * cos( phi + two_pi_3 );
+    e( 1 ) = 3.0 * q - e( 0 ) - e( 2 );
+}
+
+//---------------------------------------------------------------------------//
+// Unit eigenvector of a symmetric 3x3 matrix for the given eigenvalue from
+// the largest cross product of two rows of A - e * I. Only accurate if the
+// eigenvalue is well separated from the other two.
+template <class ExpressionA>
+KOKKOS_INLINE_FUNCTION Vector<typename ExpressionA::value_type, 3>
+symmetricEigenvector( const ExpressionA& a,
+                      const typename ExpressionA::value_type& e )
+{
+    using Kokkos::sqrt;
+    using value_type = typename ExpressionA::value_type;
+
+    Vector<value_type, 3> r0 = { a( 0, 0 ) - e, a( 0, 1 ), a( 0, 2 ) };
+    Vector<value_type, 3> r1 = { a( 0, 1 ), a( 1, 1 ) - e, a( 1, 2 ) };
+    Vector<value_type, 3> r2 = { a( 0, 2 ), a( 1, 2 ), a( 2, 2 ) - e };
+
+    Vector<value_type, 3> x = r0 % r1;
+    Vector<value_type, 3> x1 = r0 % r2;
+    Vector<value_type, 3> x2 = r1 % r2;
+    value_type n = ~x * x;
+    value_type n1 = ~x1 * x1;
+    value_type n2 = ~x2 * x2;
+
+    auto use_1 = n < n1;
+    for ( int d = 0; d < 3; ++d )
+        x( d ) = select( use_1, x1( d ), x( d ) );
+    n = select( use_1, n1, n );
+
+    auto use_2 = n < n2;
+    for ( int d = 0; d < 3; ++d )
+        x( d ) = select( use_2, x2( d ), x( d ) );
+    n = select( use_2, n2, n );
+
+    return x / sqrt( n );
+}
+
+//---------------------------------------------------------------------------//
+// Cyclic Jacobi eigendecomposition of a symmetric 3x3 matrix. On output S is
+// diagonal with ascending eigenvalues and V is the rotation of eigenvectors
+// such that S_in = V * S * ~V. The sweeps stop once the off-diagonal of
+// every lane is negligible.
+template <class T>
+KOKKOS_INLINE_FUNCTION void symmetricJacobi( Matrix<T, 3, 3>& S,
+                                             Matrix<T, 3, 3>& V,
+                                             const int max_sweep )
+{
+    using Kokkos::fabs;
+    using Kokkos::sqrt;
+    using scalar_type = scalar_type_t<T>;
+
+    const scalar_type eps = Kokkos::Experimental::epsilon<scalar_type>::value;
+    const T zero = static_cast<T>( 0.0 );
+    const T one = static_cast<T>( 1.0 );
+
+    identity( V );
+
+    for ( int sweep = 0; sweep < max_sweep; ++sweep )
+    {
+        T off = S( 0, 1 ) * S( 0, 1 ) + S( 0, 2 ) * S( 0, 2 ) +
+                S( 1, 2 ) * S( 1, 2 );
+        T diag = S( 0, 0 ) * S( 0, 0 ) + S( 1, 1 ) * S( 1, 1 ) +
+                 S( 2, 2 ) * S( 2, 2 );
+        if ( !any( off > eps * eps * diag ) )
+            break;
+
+        // Rotate away the (0,1), (0,2), and (1,2) entries in turn.
+        for ( int n = 0; n < 3; ++n )
+        {
+            const int p = ( n == 2 ) ? 1 : 0;
+            const int q = ( n == 0 ) ? 1 : 2;
+            const int r = 3 - p - q;
+
+            T s_pq = S( p, q );
+            auto skip = ( s_pq == zero );
+            T theta =
+                ( S( q, q ) - S( p, p ) ) / select( skip, one, 2.0 * s_pq );
+            T t = select( theta < zero, -one, one ) /
+                  ( fabs( theta ) + sqrt( theta * theta + 1.0 ) );
+            t = select( skip, zero, t );
+            T c = 1.0 / sqrt( t * t + 1.0 );
+            T s = t * c;
+
+            S( p, p ) -= t * s_pq;
+            S( q, q ) += t * s_pq;
+            S( p, q ) = zero;
+            S( q, p ) = zero;
+
+            T s_rp = S( r, p );
+            T s_rq = S( r, q );
+            S( r, p ) = c * s_rp - s * s_rq;
+            S( p, r ) = S( r, p );
+            S( r, q ) = s * s_rp + c * s_rq;
+            S( q, r ) = S( r, q );
+
+            for ( int k = 0; k < 3; ++k )
+            {
+                T v_kp = V( k, p );
+                T v_kq = V( k, q );
+                V( k, p ) = c * v_kp - s * v_kq;
+                V( k, q ) = s * v_kp + c * v_kq;
+            }
+        }
+    }
+
+    // Sort in ascending order. Negating the swapped columns keeps V a
+    // rotation.
+    auto v0 = V.column( 0 );
+    auto v1 = V.column( 1 );
+    auto v2 = V.column( 2 );
+
+    auto swap_01 = S( 1, 1 ) < S( 0, 0 );
+    condSwap( swap_01, S( 0, 0 ), S( 1, 1 ) );
+    condNegSwap( swap_01, v0, v1 );
+
+    auto swap_02 = S( 2, 2 ) < S( 0, 0 );
+    condSwap( swap_02, S( 0, 0 ), S( 2, 2 ) );
+    condNegSwap( swap_02, v0, v2 );
+
+    auto swap_12 = S( 2, 2 ) < S( 1, 1 );
+    condSwap( swap_12, S( 1, 1 ), S( 2, 2 ) );
+    condNegSwap( swap_12, v1, v2 );
+}
+
+//---------------------------------------------------------------------------//
+// Eigenvalues and eigenvectors of a symmetric 3x3 matrix such that
+// A = U * diag(e) * ~U with the eigenvalues in ascending order and U a
+// rotation. Only the upper triangle of the matrix is read.
+//
+// The eigenvalues come from the closed-form cubic solution and the
+// eigenvectors of the smallest and largest eigenvalues from cross products
+// of rows. When two eigenvalues are too close for the closed form to be
+// accurate the decomposition falls back to cyclic Jacobi rotations. A batch
+// value type only runs the fallback if one of its lanes needs it.
+template <class ExpressionA, class Eigenvalues, class Eigenvectors>
+KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
+    is_matrix<ExpressionA>::value && is_vector<Eigenvalues>::value &&
+        is_matrix<Eigenvectors>::value && ExpressionA::extent_0 == 3 &&
+        ExpressionA::extent_1 == 3,
+    void>
+symmetricEigendecomposition( const ExpressionA& A, Eigenvalues& e,
+                             Eigenvectors& U )
+{
+    static_assert( Eigenvectors::extent_0 == 3, "Dimensions must match" );
+    static_assert( Eigenvectors::extent_1 == 3, "Dimensions must match" );
+
+    using Kokkos::fabs;
+    using Kokkos::max;
+    using Kokkos::min;
+    using Kokkos::sqrt;
+    using value_type = typename ExpressionA::value_type;
+    using scalar_type = scalar_type_t<value_type>;
+
+    constexpr int max_sweep = 10;
+
+    typename ExpressionA::eval_type a = A;
+
+    symmetricEigendecomposition( a, e );
+
+    // Closed-form eigenvectors. The middle eigenvector completes the
+    // rotation.
+    auto v2 = symmetricEigenvector( a, e( 2 ) );
+    auto v0 = symmetricEigenvector( a, e( 0 ) );
+    v0 = v0 - ( ~v2 * v0 ) * v2;
+    v0 = v0 / sqrt( ~v0 * v0 );
+    Vector<value_type, 3> v1 = v2 % v0;
+    for ( int i = 0; i < 3; ++i )
+    {
+        U( i, 0 ) = v0( i );
+        U( i, 1 ) = v1( i );
+        U( i, 2 ) = v2( i );
+    }
+
+    // Use Jacobi rotations for nearly repeated eigenvalues.
+    const scalar_type eps = Kokkos::Experimental::epsilon<scalar_type>::value;
+    value_type gap = min( e( 1 ) - e( 0 ), e( 2 ) - e( 1 ) );
+    value_type scale = max( fabs( e( 0 ) ), fabs( e( 2 ) ) );
+    auto fallback = ( gap <= Kokkos::cbrt( eps ) * scale );
+    if ( any( fallback ) )
+    {
+        Matrix<value_type, 3, 3> S;
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = i; j < 3; ++j )
+            {
+                S( i, j ) = a( i, j );
+                S( j, i ) = a( i, j );
+            }
+        Matrix<value_type, 3, 3> V;
+        symmetricJacobi( S, V, max_sweep );
+
+        for ( int i = 0; i < 3; ++i )
+        {
+            e( i ) = select( fallback, S( i, i ), e( i ) );
+            for ( int j = 0; j < 3; ++j )
+                U( i, j ) = select( fallback, V( i, j ), U( i, j ) );
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Symmetric matrix functions
+//---------------------------------------------------------------------------//
+// Compose the symmetric matrix U * diag(f) * ~U from an eigensystem.
+template <class Eigenvalues, class Eigenvectors>
+KOKKOS_INLINE_FUNCTION
+    SymmetricMatrix<typename Eigenvectors::value_type, Eigenvectors::extent_0>
+    composeSymmetric( const Eigenvalues& f, const Eigenvectors& U )
+{
+    constexpr int n = Eigenvectors::extent_0;
+    SymmetricMatrix<typename Eigenvectors::value_type, n> a = 0.0;
+    for ( int i = 0; i < n; ++i )
+        for ( int j = i; j < n; ++j )
+            for ( int k = 0; k < n; ++k )
+                a( i, j ) += U( i, k ) * f( k ) * U( j, k );
+    return a;
+}
+
+//---------------------------------------------------------------------------//
+// Logarithm of a symmetric positive definite 3x3 matrix through its
+// eigensystem (e.g. the Hencky strain 0.5 * log(~F * F)). Only the upper
+// triangle of the matrix is read.
+template <class ExpressionA>
+KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
+    is_matrix<ExpressionA>::value && ExpressionA::extent_0 == 3 &&
+        ExpressionA::extent_1 == 3,
+    SymmetricMatrix<typename ExpressionA::value_type, 3>>
+symmetricLog( const ExpressionA& A )
+{
+    using Kokkos::log;
+    using value_type = typename ExpressionA::value_type;
+
+    Vector<value_type, 3> e;
+    Matrix<value_type, 3, 3> U;
+    symmetricEigendecomposition( A, e, U );
+    for ( int i = 0; i < 3; ++i )
+        e( i ) = log( e( i ) );
+    return composeSymmetric( e, U );
+}
+
 //---------------------------------------------------------------------------//
-// Eigendecomposition
+// Square root of a symmetric positive semi-definite 3x3 matrix through its
+// eigensystem (e.g. the right stretch sqrt(~F * F)). Eigenvalues that are
+// negative from roundoff are treated as zero. Only the upper triangle of the
+// matrix is read.
+template <class ExpressionA>
+KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
+    is_matrix<ExpressionA>::value && ExpressionA::extent_0 == 3 &&
+        ExpressionA::extent_1 == 3,
+    SymmetricMatrix<typename ExpressionA::value_type, 3>>
+symmetricSqrt( const ExpressionA& A )
+{
+    using Kokkos::max;
+    using Kokkos::sqrt;
+    using value_type = typename ExpressionA::value_type;
+
+    Vector<value_type, 3> e;
+    Matrix<value_type, 3, 3> U;
+    symmetricEigendecomposition( A, e, U );
+    for ( int i = 0; i < 3; ++i )
+        e( i ) = sqrt( max( e( i ), static_cast<value_type>( 0.0 ) ) );
+    return composeSymmetric( e, U );
+}
+
+//---------------------------------------------------------------------------//
+// Polar decomposition
+//---------------------------------------------------------------------------//
+// Computes the polar decomposition F = R * S of a nonsingular square matrix
+// with R orthogonal (a rotation if det(F) > 0) and S the symmetric positive
+// definite right stretch. R is found with the Newton iteration
+// X <- 0.5 * (z * X + ~X^-1 / z) of Higham (SIAM J. Sci. Stat. Comput. 7(4),
+// 1986). The Frobenius-norm scaling z makes a handful of iterations enough
+// even for large stretches and is switched off near convergence where the
+// unscaled iteration converges quadratically. S may be a Matrix or a
+// SymmetricMatrix.
+template <class ExpressionF, class Rotation, class Stretch>
+KOKKOS_INLINE_FUNCTION typename std::enable_if_t<
+    is_matrix<ExpressionF>::value && is_matrix<Rotation>::value &&
+        is_matrix<Stretch>::value,
+    void>
+polarDecomposition( const ExpressionF& F, Rotation& R, Stretch& S )
+{
+    static_assert( ExpressionF::extent_0 == ExpressionF::extent_1,
+                   "Matrix must be square" );
+
+    using Kokkos::sqrt;
+    using value_type = typename ExpressionF::value_type;
+    using scalar_type = scalar_type_t<value_type>;
+    constexpr int n = ExpressionF::extent_0;
+
+    constexpr int max_iter = 20;
+    const scalar_type eps = Kokkos::Experimental::epsilon<scalar_type>::value;
+    const value_type one = static_cast<value_type>( 1.0 );
+
+    typename ExpressionF::eval_type f = F;
+    Matrix<value_type, n, n> X = f;
+
+    decltype( one < one ) scaled = true;
+    for ( int k = 0; k < max_iter; ++k )
+    {
+        Matrix<value_type, n, n> X_inv_t = ~inverse( X );
+
+        value_type x_norm = 0.0;
+        value_type x_inv_norm = 0.0;
+        for ( int i = 0; i < n; ++i )
+            for ( int j = 0; j < n; ++j )
+            {
+                x_norm += X( i, j ) * X( i, j );
+                x_inv_norm += X_inv_t( i, j ) * X_inv_t( i, j );
+            }
+        value_type z =
+            select( scaled, sqrt( sqrt( x_inv_norm / x_norm ) ), one );
+
+        Matrix<value_type, n, n> X_next = 0.5 * ( z * X + X_inv_t / z );
+
+        value_type change = 0.0;
+        for ( int i = 0; i < n; ++i )
+            for ( int j = 0; j < n; ++j )
+                change += ( X_next( i, j ) - X( i, j ) ) *
+                          ( X_next( i, j ) - X( i, j ) );
+        X = X_next;
+
+        // With quadratic convergence a relative change of sqrt(eps) leaves
+        // the new iterate accurate to roundoff.
+        scaled = scaled && ( 1.0e-4 * x_norm < change );
+        if ( all( change <= eps * x_norm ) )
+            break;
+    }
+
+    R = X;
+    Matrix<value_type, n, n> RtF = ~X * f;
+    S = 0.5 * ( RtF + ~RtF );
+}
+
+//---------------------------------------------------------------------------//
+// General eigendecomposition
 //---------------------------------------------------------------------------//
 // template <class ExpressionA, class Eigenvalues, class Eigenvectors>
 // KOKKOS_INLINE_FUNCTION
@@ -5156,6 +7464,10 @@ template <class T>
 using Vec2 = LinearAlgebra::Vector<T, 2>;
 template <class T>
 using VecView2 = LinearAlgebra::VectorView<T, 2>;
+template <class T>
+using SymMat2 = LinearAlgebra::SymmetricMatrix<T, 2>;
+template <class T>
+using SymMatView2 = LinearAlgebra::SymmetricMatrixView<T, 2>;
 
 template <class T>
 using Mat3 = LinearAlgebra::Matrix<T, 3, 3>;
@@ -5165,6 +7477,10 @@ template <class T>
 using Vec3 = LinearAlgebra::Vector<T, 3>;
 template <class T>
 using VecView3 = LinearAlgebra::VectorView<T, 3>;
+template <class T>
+using SymMat3 = LinearAlgebra::SymmetricMatrix<T, 3>;
+template <class T>
+using SymMatView3 = LinearAlgebra::SymmetricMatrixView<T, 3>;
 
 //---------------------------------------------------------------------------//
 
@@ -71,6 +71,253 @@ struct BilinearMeshMapping
     coord_view_type _local_node_coords;
 };
 
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Cell-local inversion of the bilinear mapping. Given a local cell and
+// physical coordinates compute the cell coordinates, which lie outside of
+// [0,1] if the point is not in the cell. The cell coordinates passed in are
+// used as the initial guess where an iteration is required. Return whether
+// or not the solve succeeded.
+//---------------------------------------------------------------------------//
+// 2D specialization. The inverse of a bilinear quadrilateral is computed in
+// closed form by eliminating one coordinate and solving the resulting
+// quadratic (Brackbill and Ruppel, J. Comput. Phys. 65, 1986).
+template <class MemorySpace, class PhysicalCoords, class CellCoords>
+KOKKOS_INLINE_FUNCTION bool
+solveBilinearCell( const BilinearMeshMapping<MemorySpace, 2>& mapping,
+                   const Kokkos::Array<int, 2>& cell,
+                   const PhysicalCoords& physical_coords,
+                   CellCoords& cell_coords )
+{
+    using value_type = typename CellCoords::value_type;
+
+    const auto& nodes = mapping._local_node_coords;
+    int i = cell[Dim::I];
+    int j = cell[Dim::J];
+
+    // Write the cell as x = a + b * xi + c * eta + d * xi * eta.
+    LinearAlgebra::Vector<value_type, 2> r;
+    LinearAlgebra::Vector<value_type, 2> b;
+    LinearAlgebra::Vector<value_type, 2> c;
+    LinearAlgebra::Vector<value_type, 2> d;
+    for ( int n = 0; n < 2; ++n )
+    {
+        r( n ) = physical_coords( n ) - nodes( i, j, n );
+        b( n ) = nodes( i + 1, j, n ) - nodes( i, j, n );
+        c( n ) = nodes( i, j + 1, n ) - nodes( i, j, n );
+        d( n ) = nodes( i + 1, j + 1, n ) - nodes( i + 1, j, n ) -
+                 nodes( i, j + 1, n ) + nodes( i, j, n );
+    }
+
+    // Crossing r - c * eta = xi * ( b + d * eta ) with b + d * eta gives
+    // qa * eta^2 + qb * eta + qc = 0.
+    auto cross = []( const LinearAlgebra::Vector<value_type, 2>& u,
+                     const LinearAlgebra::Vector<value_type, 2>& v ) {
+        return u( Dim::I ) * v( Dim::J ) - u( Dim::J ) * v( Dim::I );
+    };
+    value_type qa = cross( c, d );
+    value_type qb = cross( c, b ) - cross( r, d );
+    value_type qc = -cross( r, b );
+
+    // Take the root closest to the cell using the numerically stable form.
+    // The second root reduces to the linear solution for parallelograms.
+    value_type disc = qb * qb - 4.0 * qa * qc;
+    if ( disc < 0.0 )
+        return false;
+    value_type q = -0.5 * ( qb + Kokkos::copysign( Kokkos::sqrt( disc ), qb ) );
+    auto distance = []( const value_type x ) {
+        return Kokkos::fmax( Kokkos::fmax( -x, x - 1.0 ), 0.0 );
+    };
+    bool found = false;
+    value_type eta = 0.0;
+    if ( q != 0.0 )
+    {
+        eta = qc / q;
+        found = true;
+    }
+    if ( qa != 0.0 )
+    {
+        value_type eta_1 = q / qa;
+        if ( !found || distance( eta_1 ) < distance( eta ) )
+            eta = eta_1;
+        found = true;
+    }
+    if ( !found )
+        return false;
+
+    // Back substitute for xi.
+    LinearAlgebra::Vector<value_type, 2> e = b + eta * d;
+    value_type e2 = ~e * e;
+    if ( e2 == 0.0 )
+        return false;
+    cell_coords( Dim::I ) = ( ~( r - eta * c ) * e ) / e2;
+    cell_coords( Dim::J ) = eta;
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+// 3D specialization. The trilinear inverse has no closed form so Newton
+// iterations are performed with the cell-local map, which is extended
+// smoothly outside of the cell.
+template <class MemorySpace, class PhysicalCoords, class CellCoords>
+KOKKOS_INLINE_FUNCTION bool
+solveBilinearCell( const BilinearMeshMapping<MemorySpace, 3>& mapping,
+                   const Kokkos::Array<int, 3>& cell,
+                   const PhysicalCoords& physical_coords,
+                   CellCoords& cell_coords )
+{
+    using value_type = typename CellCoords::value_type;
+
+    // Newton iteration tolerance.
+    double tol = 1.0e-12;
+    double tol2 = tol * tol;
+
+    // Maximum number of Newton iterations.
+    int max_iter = 15;
+
+    const auto& nodes = mapping._local_node_coords;
+    int i = cell[Dim::I];
+    int j = cell[Dim::J];
+    int k = cell[Dim::K];
+
+    LinearAlgebra::Vector<value_type, 3> residual;
+    LinearAlgebra::Matrix<value_type, 3, 3> jacobian;
+    for ( int n = 0; n < max_iter; ++n )
+    {
+        value_type w[3][2] = {
+            { 1.0 - cell_coords( Dim::I ), cell_coords( Dim::I ) },
+            { 1.0 - cell_coords( Dim::J ), cell_coords( Dim::J ) },
+            { 1.0 - cell_coords( Dim::K ), cell_coords( Dim::K ) } };
+        value_type g[2] = { -1.0, 1.0 };
+
+        residual = physical_coords;
+        jacobian = 0.0;
+        for ( int ni = 0; ni < 2; ++ni )
+            for ( int nj = 0; nj < 2; ++nj )
+                for ( int nk = 0; nk < 2; ++nk )
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        value_type x = nodes( i + ni, j + nj, k + nk, d );
+                        residual( d ) -= w[Dim::I][ni] * w[Dim::J][nj] *
+                                         w[Dim::K][nk] * x;
+                        jacobian( d, Dim::I ) +=
+                            g[ni] * w[Dim::J][nj] * w[Dim::K][nk] * x;
+                        jacobian( d, Dim::J ) +=
+                            w[Dim::I][ni] * g[nj] * w[Dim::K][nk] * x;
+                        jacobian( d, Dim::K ) +=
+                            w[Dim::I][ni] * w[Dim::J][nj] * g[nk] * x;
+                    }
+
+        value_type jacobian_det = !jacobian;
+        if ( jacobian_det == 0.0 )
+            return false;
+        LinearAlgebra::Vector<value_type, 3> delta =
+            LinearAlgebra::inverse( jacobian, jacobian_det ) * residual;
+        cell_coords += delta;
+        if ( ~delta * delta < tol2 )
+            return true;
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------//
+// Relocate a point in the local mesh. The cell of the given reference
+// coordinates (clamped to the local mesh) is used as the initial cell. If
+// the point is not in the cell its neighbor in the direction of the point is
+// tried next. If the cell-local solve fails the general Newton inversion is
+// used instead. Return false if the point is not found within the local mesh
+// (including the halo) or within the given number of cell steps.
+template <class MemorySpace, std::size_t NumSpaceDim, class PhysicalCoords,
+          class ReferenceCoords>
+KOKKOS_INLINE_FUNCTION bool
+relocateBilinear( const BilinearMeshMapping<MemorySpace, NumSpaceDim>& mapping,
+                  const PhysicalCoords& physical_coords,
+                  ReferenceCoords& reference_coords, const int max_walk )
+{
+    using value_type = typename ReferenceCoords::value_type;
+    using default_mapping = DefaultCurvilinearMeshMapping<
+        BilinearMeshMapping<MemorySpace, NumSpaceDim>>;
+
+    // Tolerance for accepting points on cell faces.
+    value_type tol = 1.0e-10;
+
+    // Start from the previous cell and cell coordinates.
+    Kokkos::Array<int, NumSpaceDim> cell;
+    Kokkos::Array<int, NumSpaceDim> num_cell;
+    LinearAlgebra::Vector<value_type, NumSpaceDim> cell_coords;
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        num_cell[d] = mapping._local_node_coords.extent( d ) - 1;
+        value_type x = reference_coords( d ) - mapping._global_offset[d];
+        cell[d] = static_cast<int>( Kokkos::floor( x ) );
+        cell[d] = Kokkos::min( Kokkos::max( cell[d], 0 ), num_cell[d] - 1 );
+        cell_coords( d ) = Kokkos::fmin(
+            Kokkos::fmax( x - cell[d], value_type( 0.0 ) ), value_type( 1.0 ) );
+    }
+
+    for ( int n = 0; n <= max_walk; ++n )
+    {
+        bool solved =
+            solveBilinearCell( mapping, cell, physical_coords, cell_coords );
+
+        // If the cell-local solve failed fall back to Newton iterations with
+        // the full mapping started from the center of the current cell.
+        if ( !solved )
+        {
+            LinearAlgebra::Vector<value_type, NumSpaceDim> x_ref;
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+                x_ref( d ) = mapping._global_offset[d] + cell[d] + 0.5;
+            if ( !default_mapping::mapToReferenceFrame(
+                     mapping, physical_coords, x_ref ) )
+                return false;
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                value_type x = x_ref( d ) - mapping._global_offset[d];
+                if ( x < -tol || x > num_cell[d] + tol )
+                    return false;
+            }
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+                reference_coords( d ) = x_ref( d );
+            return true;
+        }
+
+        // Accept the cell if the point is in it.
+        bool inside = true;
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            if ( cell_coords( d ) < -tol || cell_coords( d ) > 1.0 + tol )
+                inside = false;
+        if ( inside )
+        {
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+                reference_coords( d ) =
+                    mapping._global_offset[d] + cell[d] + cell_coords( d );
+            return true;
+        }
+
+        // Otherwise step to the neighbor in the direction of the point and
+        // start from the nearest point of that cell.
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        {
+            int step = ( cell_coords( d ) < -tol )
+                           ? -1
+                           : ( ( cell_coords( d ) > 1.0 + tol ) ? 1 : 0 );
+            cell[d] += step;
+            if ( cell[d] < 0 || cell[d] >= num_cell[d] )
+                return false;
+            cell_coords( d ) =
+                Kokkos::fmin( Kokkos::fmax( cell_coords( d ) - step,
+                                            value_type( 0.0 ) ),
+                              value_type( 1.0 ) );
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+
 //---------------------------------------------------------------------------//
 // Template interface implementation. 3D specialization
 template <class MemorySpace>
@@ -201,6 +448,20 @@ class CurvilinearMeshMapping<BilinearMeshMapping<MemorySpace, 3>>
         return DefaultCurvilinearMeshMapping<mesh_mapping>::mapToReferenceFrame(
             mapping, physical_coords, reference_coords );
     }
+
+    // Relocate a point after it has moved. The given reference coordinates
+    // are the previous location of the point and are used as the initial
+    // guess. Neighbor cells are searched if the point left its cell. Return
+    // false if the point was not found in the local mesh.
+    template <class PhysicalCoords, class ReferenceCoords>
+    static KOKKOS_INLINE_FUNCTION bool
+    relocate( const mesh_mapping& mapping,
+              const PhysicalCoords& physical_coords,
+              ReferenceCoords& reference_coords, const int max_walk = 4 )
+    {
+        return Impl::relocateBilinear( mapping, physical_coords,
+                                       reference_coords, max_walk );
+    }
 };
 
 //---------------------------------------------------------------------------//
@@ -311,15 +572,75 @@ struct CurvilinearMeshMapping<BilinearMeshMapping<MemorySpace, 2>>
                          const PhysicalCoords& physical_coords,
                          ReferenceCoords& reference_coords )
     {
-        // NOTE: I am using the default procedure here but it is possible that
-        // the procedure outlined on page 329 of the 1986 Brackbill FLIP paper
-        // could be more efficient here as it is a direct solve. This default
-        // version could be used if that one fails.
+        // NOTE: The default procedure is used here as it converges across
+        // cells from an arbitrary guess. Use relocate() for the direct
+        // solve from page 329 of the 1986 Brackbill FLIP paper when the
+        // guess is the previous location of a moving point.
         return DefaultCurvilinearMeshMapping<mesh_mapping>::mapToReferenceFrame(
             mapping, physical_coords, reference_coords );
     }
+
+    // Relocate a point after it has moved. The given reference coordinates
+    // are the previous location of the point and are used as the initial
+    // guess. Neighbor cells are searched if the point left its cell. Return
+    // false if the point was not found in the local mesh.
+    template <class PhysicalCoords, class ReferenceCoords>
+    static KOKKOS_INLINE_FUNCTION bool
+    relocate( const mesh_mapping& mapping,
+              const PhysicalCoords& physical_coords,
+              ReferenceCoords& reference_coords, const int max_walk = 4 )
+    {
+        return Impl::relocateBilinear( mapping, physical_coords,
+                                       reference_coords, max_walk );
+    }
 };
 
+//---------------------------------------------------------------------------//
+// Relocate particles after they have moved. The reference coordinates of
+// each particle are updated in place using their previous values as the
+// initial guess. Particles which could not be found in the local mesh
+// (including the halo) keep their previous reference coordinates and are
+// flagged in the failure mask so they may be migrated. Returns the number of
+// failed particles.
+template <class ExecutionSpace, class MemorySpace, std::size_t NumSpaceDim,
+          class PhysicalCoordSlice, class ReferenceCoordSlice,
+          class FailureMask>
+int relocateParticles(
+    const ExecutionSpace& exec_space,
+    const BilinearMeshMapping<MemorySpace, NumSpaceDim>& mapping,
+    const PhysicalCoordSlice& physical_coords,
+    const ReferenceCoordSlice& reference_coords, const FailureMask& failed,
+    const int max_walk = 4 )
+{
+    using mapping_type = BilinearMeshMapping<MemorySpace, NumSpaceDim>;
+
+    int num_failed = 0;
+    Kokkos::parallel_reduce(
+        "picasso_relocate_particles",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                             failed.extent( 0 ) ),
+        KOKKOS_LAMBDA( const int p, int& result ) {
+            LinearAlgebra::Vector<double, NumSpaceDim> x_p;
+            LinearAlgebra::Vector<double, NumSpaceDim> x_ref;
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                x_p( d ) = physical_coords( p, d );
+                x_ref( d ) = reference_coords( p, d );
+            }
+
+            bool found = CurvilinearMeshMapping<mapping_type>::relocate(
+                mapping, x_p, x_ref, max_walk );
+
+            if ( found )
+                for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+                    reference_coords( p, d ) = x_ref( d );
+            failed( p ) = !found;
+            result += !found;
+        },
+        num_failed );
+    return num_failed;
+}
+
 //---------------------------------------------------------------------------//
 // Bilinear mesh generator template interface.
 template <class Generator>
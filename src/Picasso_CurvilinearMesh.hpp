@@ -13,6 +13,8 @@
 #define PICASSO_CURVILINEARMESH_HPP
 
 #include <Picasso_BatchedLinearAlgebra.hpp>
+#include <Picasso_FieldManager.hpp>
+#include <Picasso_FieldTypes.hpp>
 #include <Picasso_Types.hpp>
 
 #include <Cabana_Grid.hpp>
@@ -275,6 +277,338 @@ auto createCurvilinearMesh(
                                                        comm, ranks_per_dim );
 }
 
+//---------------------------------------------------------------------------//
+// Cached transformation metrics.
+//---------------------------------------------------------------------------//
+// Evaluating the transformation metrics through the mapping may be
+// expensive (the bilinear mapping gathers the cell nodes and inverts the
+// jacobian on every call). The metrics may instead be evaluated once at a
+// fixed set of points in each cell and stored as cell fields in the field
+// manager of the mesh. They must be updated whenever the mapping changes.
+//---------------------------------------------------------------------------//
+// Metric point sets. Points are given in the unit reference cell.
+
+// One point at the cell center. For cells which are parallelepipeds (the
+// mapping is affine in the cell) the cell center metrics are exact
+// everywhere in the cell.
+template <std::size_t NumSpaceDim>
+struct CellCenterQuadrature
+{
+    static constexpr std::size_t num_space_dim = NumSpaceDim;
+    static constexpr int num_point = 1;
+
+    KOKKOS_INLINE_FUNCTION
+    static double coordinate( const int, const int ) { return 0.5; }
+
+    KOKKOS_INLINE_FUNCTION
+    static double weight( const int ) { return 1.0; }
+};
+
+// Tensor product two-point Gauss-Legendre rule. Bit d of the point index
+// selects the lower or upper Gauss point in dimension d.
+template <std::size_t NumSpaceDim>
+struct GaussQuadrature
+{
+    static constexpr std::size_t num_space_dim = NumSpaceDim;
+    static constexpr int num_point = 1 << NumSpaceDim;
+
+    KOKKOS_INLINE_FUNCTION
+    static double coordinate( const int point, const int dim )
+    {
+        double offset = 0.5 / Kokkos::sqrt( 3.0 );
+        return ( ( point >> dim ) & 1 ) ? 0.5 + offset : 0.5 - offset;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    static double weight( const int ) { return 1.0 / num_point; }
+};
+
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Access a metric field component in a local cell.
+template <class View, std::size_t NumSpaceDim>
+KOKKOS_FORCEINLINE_FUNCTION std::enable_if_t<4 == View::rank, double*>
+metricData( const View& v, const Kokkos::Array<int, NumSpaceDim>& cell,
+            const int n )
+{
+    return &v( cell[Dim::I], cell[Dim::J], cell[Dim::K], n );
+}
+
+template <class View, std::size_t NumSpaceDim>
+KOKKOS_FORCEINLINE_FUNCTION std::enable_if_t<3 == View::rank, double*>
+metricData( const View& v, const Kokkos::Array<int, NumSpaceDim>& cell,
+            const int n )
+{
+    return &v( cell[Dim::I], cell[Dim::J], n );
+}
+
+//---------------------------------------------------------------------------//
+// Evaluate the transformation metrics at the quadrature points of a cell.
+template <class Mapping, class Quadrature, class View>
+struct MetricFieldFunctor
+{
+    static constexpr std::size_t num_space_dim = Mapping::num_space_dim;
+    static constexpr int num_point = Quadrature::num_point;
+
+    Mapping mapping;
+    Kokkos::Array<int, num_space_dim> local_offset;
+    View jacobian;
+    View jacobian_det;
+    View jacobian_inv;
+
+    KOKKOS_INLINE_FUNCTION
+    void evaluate( const Kokkos::Array<int, num_space_dim>& cell ) const
+    {
+        LinearAlgebra::Vector<double, num_space_dim> x_ref;
+        LinearAlgebra::Matrix<double, num_space_dim, num_space_dim> jac;
+        LinearAlgebra::Matrix<double, num_space_dim, num_space_dim> jac_inv;
+        double jac_det;
+        for ( int p = 0; p < num_point; ++p )
+        {
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+                x_ref( d ) = local_offset[d] + cell[d] +
+                             Quadrature::coordinate( p, d );
+
+            CurvilinearMeshMapping<Mapping>::transformationMetrics(
+                mapping, x_ref, jac, jac_det, jac_inv );
+
+            int n = p * num_space_dim * num_space_dim;
+            for ( std::size_t a = 0; a < num_space_dim; ++a )
+                for ( std::size_t b = 0; b < num_space_dim; ++b, ++n )
+                {
+                    *metricData( jacobian, cell, n ) = jac( a, b );
+                    *metricData( jacobian_inv, cell, n ) = jac_inv( a, b );
+                }
+            *metricData( jacobian_det, cell, p ) = jac_det;
+        }
+    }
+
+    template <std::size_t NSD = num_space_dim>
+    KOKKOS_INLINE_FUNCTION std::enable_if_t<3 == NSD, void>
+    operator()( const int i, const int j, const int k ) const
+    {
+        evaluate( { i, j, k } );
+    }
+
+    template <std::size_t NSD = num_space_dim>
+    KOKKOS_INLINE_FUNCTION std::enable_if_t<2 == NSD, void>
+    operator()( const int i, const int j ) const
+    {
+        evaluate( { i, j } );
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Global reference frame index of the first local cell, including the halo.
+template <class LocalGrid>
+auto localCellOffset( const LocalGrid& local_grid )
+{
+    Kokkos::Array<int, LocalGrid::num_space_dim> offset;
+    for ( std::size_t d = 0; d < LocalGrid::num_space_dim; ++d )
+        offset[d] = local_grid.globalGrid().globalOffset( d ) -
+                    local_grid.haloCellWidth();
+    return offset;
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+// Evaluate the cached metrics at the quadrature points of the owned cells
+// and gather them into the halo. Call this after the mapping changes.
+template <class Quadrature, class ExecutionSpace, class Mapping>
+void updateMetricFields(
+    Quadrature, const ExecutionSpace& exec_space,
+    const FieldManager<CurvilinearMesh<Mapping>>& fm )
+{
+    static constexpr std::size_t num_space_dim = Mapping::num_space_dim;
+    static constexpr int num_point = Quadrature::num_point;
+    static_assert( Quadrature::num_space_dim == num_space_dim,
+                   "Quadrature and mesh dimensions must match" );
+
+    auto jacobian = fm.view( FieldLocation::Cell(),
+                             Field::Jacobian<num_space_dim, num_point>() );
+    auto jacobian_det = fm.view( FieldLocation::Cell(),
+                                 Field::JacobianDeterminant<num_point>() );
+    auto jacobian_inv = fm.view(
+        FieldLocation::Cell(),
+        Field::InverseJacobian<num_space_dim, num_point>() );
+
+    const auto& local_grid = *( fm.mesh()->localGrid() );
+    Impl::MetricFieldFunctor<Mapping, Quadrature, decltype( jacobian )>
+        functor{ fm.mesh()->mapping(), Impl::localCellOffset( local_grid ),
+                 jacobian, jacobian_det, jacobian_inv };
+    Cabana::Grid::grid_parallel_for( "picasso_update_metric_fields",
+                                     exec_space, local_grid,
+                                     Cabana::Grid::Own(), Cabana::Grid::Cell(),
+                                     functor );
+
+    fm.gather( FieldLocation::Cell(),
+               Field::Jacobian<num_space_dim, num_point>() );
+    fm.gather( FieldLocation::Cell(), Field::JacobianDeterminant<num_point>() );
+    fm.gather( FieldLocation::Cell(),
+               Field::InverseJacobian<num_space_dim, num_point>() );
+}
+
+//---------------------------------------------------------------------------//
+// Add cached metric fields for the given quadrature rule to the field manager
+// of a curvilinear mesh and evaluate them.
+template <class Quadrature, class ExecutionSpace, class Mapping>
+void addMetricFields( Quadrature quadrature, const ExecutionSpace& exec_space,
+                      FieldManager<CurvilinearMesh<Mapping>>& fm )
+{
+    static constexpr std::size_t num_space_dim = Mapping::num_space_dim;
+    static constexpr int num_point = Quadrature::num_point;
+
+    fm.add( FieldLocation::Cell(),
+            Field::Jacobian<num_space_dim, num_point>() );
+    fm.add( FieldLocation::Cell(), Field::JacobianDeterminant<num_point>() );
+    fm.add( FieldLocation::Cell(),
+            Field::InverseJacobian<num_space_dim, num_point>() );
+
+    updateMetricFields( quadrature, exec_space, fm );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \class CachedMetrics
+  \brief Device accessor for cached transformation metrics.
+
+  Cells are indexed locally (including the halo) as in the field views. The
+  accessor shares the field data so it sees metric updates but must be
+  recreated if the fields are reallocated.
+ */
+template <class MemorySpace, std::size_t NumSpaceDim, class Quadrature>
+class CachedMetrics
+{
+  public:
+    using memory_space = MemorySpace;
+
+    static constexpr std::size_t num_space_dim = NumSpaceDim;
+
+    static constexpr int num_point = Quadrature::num_point;
+
+    using view_type = std::conditional_t<
+        3 == num_space_dim, Kokkos::View<double****, MemorySpace>,
+        std::conditional_t<2 == num_space_dim,
+                           Kokkos::View<double***, MemorySpace>, void>>;
+
+    using matrix_view_type =
+        LinearAlgebra::MatrixView<double, num_space_dim, num_space_dim>;
+
+    using cell_type = Kokkos::Array<int, num_space_dim>;
+
+    // Default constructor.
+    CachedMetrics() = default;
+
+    // Create from the metric field views and the global reference frame
+    // index of the first local cell.
+    CachedMetrics( const view_type& jacobian, const view_type& jacobian_det,
+                   const view_type& jacobian_inv,
+                   const cell_type& local_offset )
+        : _jacobian( jacobian )
+        , _jacobian_det( jacobian_det )
+        , _jacobian_inv( jacobian_inv )
+        , _local_offset( local_offset )
+    {
+    }
+
+    // Get the local cell containing the given reference frame coordinates.
+    template <class ReferenceCoords>
+    KOKKOS_INLINE_FUNCTION cell_type
+    locateCell( const ReferenceCoords& reference_coords ) const
+    {
+        cell_type cell;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            cell[d] =
+                static_cast<int>( Kokkos::floor( reference_coords( d ) ) ) -
+                _local_offset[d];
+        return cell;
+    }
+
+    // Get the jacobian at a point in a local cell.
+    KOKKOS_INLINE_FUNCTION matrix_view_type jacobian( const cell_type& cell,
+                                                      const int point ) const
+    {
+        return matrixView( _jacobian, cell, point );
+    }
+
+    // Get the jacobian determinant at a point in a local cell.
+    KOKKOS_INLINE_FUNCTION double
+    jacobianDeterminant( const cell_type& cell, const int point ) const
+    {
+        return *Impl::metricData( _jacobian_det, cell, point );
+    }
+
+    // Get the inverse jacobian at a point in a local cell.
+    KOKKOS_INLINE_FUNCTION matrix_view_type
+    inverseJacobian( const cell_type& cell, const int point ) const
+    {
+        return matrixView( _jacobian_inv, cell, point );
+    }
+
+    // Given coordinates in the reference frame get the cached metrics of the
+    // cell containing them. This replaces the mapping evaluation of the
+    // metrics and is only available for one-point caches.
+    template <class ReferenceCoords>
+    KOKKOS_INLINE_FUNCTION void transformationMetrics(
+        const ReferenceCoords& reference_coords,
+        LinearAlgebra::Matrix<double, num_space_dim, num_space_dim>& jacobian,
+        double& jacobian_det,
+        LinearAlgebra::Matrix<double, num_space_dim, num_space_dim>&
+            jacobian_inv ) const
+    {
+        static_assert( 1 == num_point,
+                       "Point lookup requires one point per cell" );
+        auto cell = locateCell( reference_coords );
+        jacobian = matrixView( _jacobian, cell, 0 );
+        jacobian_det = *Impl::metricData( _jacobian_det, cell, 0 );
+        jacobian_inv = matrixView( _jacobian_inv, cell, 0 );
+    }
+
+  private:
+    KOKKOS_FORCEINLINE_FUNCTION
+    static matrix_view_type matrixView( const view_type& v,
+                                        const cell_type& cell,
+                                        const int point )
+    {
+        int stride = v.stride( view_type::rank - 1 );
+        return matrix_view_type(
+            Impl::metricData( v, cell,
+                              point * num_space_dim * num_space_dim ),
+            num_space_dim * stride, stride );
+    }
+
+  private:
+    view_type _jacobian;
+    view_type _jacobian_det;
+    view_type _jacobian_inv;
+    cell_type _local_offset;
+};
+
+//---------------------------------------------------------------------------//
+// Create a device accessor for metric fields previously added to the field
+// manager of a curvilinear mesh.
+template <class Quadrature, class Mapping>
+auto createCachedMetrics( Quadrature,
+                          const FieldManager<CurvilinearMesh<Mapping>>& fm )
+{
+    static constexpr std::size_t num_space_dim = Mapping::num_space_dim;
+    static constexpr int num_point = Quadrature::num_point;
+
+    return CachedMetrics<typename Mapping::memory_space, num_space_dim,
+                         Quadrature>(
+        fm.view( FieldLocation::Cell(),
+                 Field::Jacobian<num_space_dim, num_point>() ),
+        fm.view( FieldLocation::Cell(),
+                 Field::JacobianDeterminant<num_point>() ),
+        fm.view( FieldLocation::Cell(),
+                 Field::InverseJacobian<num_space_dim, num_point>() ),
+        Impl::localCellOffset( *( fm.mesh()->localGrid() ) ) );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Picasso
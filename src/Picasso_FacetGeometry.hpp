@@ -19,11 +19,30 @@
 
 #include <nlohmann/json.hpp>
 
+#include <mpi.h>
+
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PICASSO_FACETGEOMETRY_HAVE_MMAP
+#endif
+
 namespace Picasso
 {
 //---------------------------------------------------------------------------//
@@ -86,282 +105,654 @@ struct FacetGeometryData
 
     // Axis aligned bounding box for all volumes.
     Kokkos::View<float* [6], MemorySpace> volume_bounding_boxes;
+
+    // Check if the volumes have facet bins.
+    KOKKOS_FUNCTION
+    bool hasVolumeBins() const { return volume_bin_offsets.extent( 0 ) > 0; }
+
+    // Uniform grid of facet bins for each volume. The bin grid of a volume
+    // covers its facets and is ordered as (x_min,y_min,z_min,x_max,y_max,
+    // z_max).
+    Kokkos::View<float* [6], MemorySpace> volume_bin_boxes;
+
+    // Number of bins in each dimension of the bin grid of each volume.
+    Kokkos::View<int* [3], MemorySpace> volume_bin_dims;
+
+    // Volume bin offsets. Exclusive scan of the number of bins in each volume
+    // giving the first bin of the volume. Has one more entry than the number
+    // of volumes.
+    Kokkos::View<int*, MemorySpace> volume_bin_offsets;
+
+    // Bin facet offsets. Exclusive scan of the number of facets in each bin
+    // giving the first facet of the bin. Bins are ordered with the i index
+    // varying slowest. Has one more entry than the number of bins.
+    Kokkos::View<int*, MemorySpace> bin_offsets;
+
+    // Facets in each bin given as indices into the facets of the volume. A
+    // facet is in every bin its bounding box overlaps.
+    Kokkos::View<int*, MemorySpace> bin_facets;
 };
 
 //---------------------------------------------------------------------------//
-template <class MemorySpace>
-class FacetGeometry
+// STL file reading.
+//---------------------------------------------------------------------------//
+namespace STLReader
+{
+//---------------------------------------------------------------------------//
+// Host facet data read from a file. Facets are stored as 9 floats (3
+// vertices) per facet in the order of the solids.
+struct FileData
+{
+    std::vector<int> volume_ids;
+    std::vector<int> surface_ids;
+    std::vector<int> volume_facet_count;
+    std::vector<int> surface_facet_count;
+    std::vector<float> volume_facets;
+    std::vector<float> surface_facets;
+};
+
+//---------------------------------------------------------------------------//
+// Read-only view of the contents of a file. The file is memory mapped when
+// available and otherwise read into memory.
+class MappedFile
 {
   public:
-    // Compute the axis-aligned bounding box of a volume.
-    struct BoundingBoxReduce
-    {
-        typedef float value_type[];
-        typedef Kokkos::View<float* [4][3], MemorySpace> facet_view_type;
-        typedef Kokkos::View<int*, MemorySpace> offset_view_type;
-        typedef typename facet_view_type::size_type size_type;
-        size_type value_count;
-
-        facet_view_type facets;
-        offset_view_type offsets;
-        int volume_id;
-
-        BoundingBoxReduce( const facet_view_type& f, const offset_view_type& o,
-                           int v )
-            : value_count( 6 )
-            , facets( f )
-            , offsets( o )
-            , volume_id( v )
+    explicit MappedFile( const std::string& filename )
+    {
+#ifdef PICASSO_FACETGEOMETRY_HAVE_MMAP
+        int fd = ::open( filename.c_str(), O_RDONLY );
+        if ( fd < 0 )
+            throw std::runtime_error( "Unable to open STL file " + filename );
+        struct stat file_stat;
+        if ( ::fstat( fd, &file_stat ) != 0 )
         {
+            ::close( fd );
+            throw std::runtime_error( "Unable to stat STL file " + filename );
         }
-
-        KOKKOS_FUNCTION
-        void operator()( const size_type facet_id, value_type result ) const
+        _size = file_stat.st_size;
+        if ( _size > 0 )
         {
-            using Kokkos::fmax;
-            using Kokkos::fmin;
-
-            auto f_start = ( volume_id == 0 ) ? 0 : offsets( volume_id - 1 );
-            auto f = f_start + facet_id;
-            result[0] =
-                fmin( result[0],
-                      fmin( facets( f, 0, 0 ),
-                            fmin( facets( f, 1, 0 ), facets( f, 2, 0 ) ) ) );
-            result[1] =
-                fmin( result[1],
-                      fmin( facets( f, 0, 1 ),
-                            fmin( facets( f, 1, 1 ), facets( f, 2, 1 ) ) ) );
-            result[2] =
-                fmin( result[2],
-                      fmin( facets( f, 0, 2 ),
-                            fmin( facets( f, 1, 2 ), facets( f, 2, 2 ) ) ) );
-            result[3] =
-                fmax( result[3],
-                      fmax( facets( f, 0, 0 ),
-                            fmax( facets( f, 1, 0 ), facets( f, 2, 0 ) ) ) );
-            result[4] =
-                fmax( result[4],
-                      fmax( facets( f, 0, 1 ),
-                            fmax( facets( f, 1, 1 ), facets( f, 2, 1 ) ) ) );
-            result[5] =
-                fmax( result[5],
-                      fmax( facets( f, 0, 2 ),
-                            fmax( facets( f, 1, 2 ), facets( f, 2, 2 ) ) ) );
+            void* map = ::mmap( nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if ( MAP_FAILED != map )
+            {
+                ::madvise( map, _size, MADV_SEQUENTIAL );
+                _data = static_cast<const char*>( map );
+                _mapped = true;
+            }
         }
+        ::close( fd );
+        if ( _mapped || 0 == _size )
+            return;
+#endif
+        // Fall back to reading the file.
+        std::ifstream file( filename, std::ios::binary | std::ios::ate );
+        if ( !file.is_open() )
+            throw std::runtime_error( "Unable to open STL file " + filename );
+        _buffer.resize( file.tellg() );
+        file.seekg( 0 );
+        file.read( _buffer.data(), _buffer.size() );
+        _data = _buffer.data();
+        _size = _buffer.size();
+    }
 
-        KOKKOS_FUNCTION
-        void join( value_type dst, const value_type src ) const
-        {
-            dst[0] = Kokkos::fmin( dst[0], src[0] );
-            dst[1] = Kokkos::fmin( dst[1], src[1] );
-            dst[2] = Kokkos::fmin( dst[2], src[2] );
-            dst[3] = Kokkos::fmax( dst[3], src[3] );
-            dst[4] = Kokkos::fmax( dst[4], src[4] );
-            dst[5] = Kokkos::fmax( dst[5], src[5] );
-        }
+    ~MappedFile()
+    {
+#ifdef PICASSO_FACETGEOMETRY_HAVE_MMAP
+        if ( _mapped )
+            ::munmap( const_cast<char*>( _data ), _size );
+#endif
+    }
 
-        KOKKOS_FUNCTION
-        void init( value_type v ) const
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    const char* data() const { return _data; }
+    std::size_t size() const { return _size; }
+
+  private:
+    const char* _data = nullptr;
+    std::size_t _size = 0;
+    bool _mapped = false;
+    std::vector<char> _buffer;
+};
+
+//---------------------------------------------------------------------------//
+// Start a new solid given its name and global id.
+inline void addSolid( const std::string& name, const int id, FileData& data,
+                      bool& read_volume, bool& read_surface )
+{
+    // New volume.
+    if ( name.compare( "Volume" ) == 0 || name.compare( "Body" ) == 0 )
+    {
+        data.volume_ids.push_back( id );
+        data.volume_facet_count.push_back( 0 );
+        read_volume = true;
+        read_surface = false;
+    }
+
+    // New surface.
+    else if ( name.compare( "Surface" ) == 0 )
+    {
+        data.surface_ids.push_back( id );
+        data.surface_facet_count.push_back( 0 );
+        read_volume = false;
+        read_surface = true;
+    }
+
+    else
+    {
+        throw std::runtime_error(
+            "STL READER: Solids execpted to be Volume/Body or Surface" );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Binary STL files are one or more concatenated solids, each with an 80
+// byte header, a facet count, and 50 bytes per facet. Check that the file
+// is exactly composed of such solids.
+inline bool isBinary( const char* data, const std::size_t size )
+{
+    std::size_t offset = 0;
+    while ( offset + 84 <= size )
+    {
+        std::uint32_t num_facet;
+        std::memcpy( &num_facet, data + offset + 80, sizeof( num_facet ) );
+        offset += 84 + 50 * static_cast<std::size_t>( num_facet );
+    }
+    return ( size > 0 && offset == size );
+}
+
+//---------------------------------------------------------------------------//
+// Read binary STL data. The header of each solid names it in the same way as
+// an ASCII solid, optionally preceded by "solid" (e.g. "solid Volume 1").
+inline void readBinary( const char* data, const std::size_t size,
+                        FileData& file_data )
+{
+    std::size_t offset = 0;
+    bool read_volume = false;
+    bool read_surface = false;
+    while ( offset + 84 <= size )
+    {
+        // Parse the solid name from the header.
+        std::string header( data + offset, 80 );
+        header = header.substr( 0, header.find( '\0' ) );
+        std::istringstream header_stream( header );
+        std::string name;
+        header_stream >> name;
+        if ( name.compare( "solid" ) == 0 )
+            header_stream >> name;
+        int id;
+        if ( !( header_stream >> id ) )
+            throw std::runtime_error(
+                "STL READER: Expected binary solid header with name and id" );
+        addSolid( name, id, file_data, read_volume, read_surface );
+
+        // Get the facets.
+        std::uint32_t num_facet;
+        std::memcpy( &num_facet, data + offset + 80, sizeof( num_facet ) );
+        offset += 84;
+        if ( 50 * static_cast<std::size_t>( num_facet ) > size - offset )
+            throw std::runtime_error(
+                "STL READER: Binary solid facet count exceeds file size" );
+        auto& facets =
+            read_volume ? file_data.volume_facets : file_data.surface_facets;
+        auto& count = read_volume ? file_data.volume_facet_count.back()
+                                  : file_data.surface_facet_count.back();
+        count = num_facet;
+        std::size_t start = facets.size();
+        facets.resize( start + 9 * static_cast<std::size_t>( num_facet ) );
+        for ( std::uint32_t f = 0; f < num_facet; ++f )
         {
-            v[0] = FLT_MAX;
-            v[1] = FLT_MAX;
-            v[2] = FLT_MAX;
-            v[3] = -FLT_MAX;
-            v[4] = -FLT_MAX;
-            v[5] = -FLT_MAX;
+            // Skip the normal and the attribute count.
+            std::memcpy( facets.data() + start + 9 * f,
+                         data + offset + 3 * sizeof( float ),
+                         9 * sizeof( float ) );
+            offset += 50;
         }
-    };
+    }
+}
 
+//---------------------------------------------------------------------------//
+// Tokenizer for ASCII STL data. Tokens are separated by whitespace and
+// lines are separated by newlines.
+class AsciiTokenizer
+{
   public:
-    using memory_space = MemorySpace;
+    AsciiTokenizer( const char* data, const std::size_t size )
+        : _pos( data )
+        , _end( data + size )
+    {
+    }
 
-    // Default constructor.
-    FacetGeometry() = default;
+    // Go to the start of the next token on any line. Returns false at the
+    // end of the data.
+    bool nextLine()
+    {
+        while ( _pos < _end && isSpace( *_pos ) )
+            ++_pos;
+        return _pos < _end;
+    }
 
-    // Create the geometry from an ASCII STL file.
-    template <class ExecutionSpace>
-    FacetGeometry( const nlohmann::json& inputs,
-                   const ExecutionSpace& exec_space )
+    // Get the next token on the current line. Returns false if there are no
+    // more tokens on the line.
+    bool token( const char*& begin, std::size_t& length )
     {
-        Kokkos::Profiling::pushRegion( "Picasso::FacetGeoemtry::create" );
+        while ( _pos < _end && isSpace( *_pos ) && '\n' != *_pos )
+            ++_pos;
+        if ( _pos == _end || '\n' == *_pos )
+            return false;
+        begin = _pos;
+        while ( _pos < _end && !isSpace( *_pos ) )
+            ++_pos;
+        length = _pos - begin;
+        return true;
+    }
 
-        // Get the geometry parameters.
-        auto params = inputs["geometry"];
+    // Skip the rest of the current line.
+    void skipLine()
+    {
+        while ( _pos < _end && '\n' != *_pos )
+            ++_pos;
+    }
 
-        // Read the stl file and create the facet geometry.
-        std::string stl_ascii_filename = params["stl_file"];
+  private:
+    static bool isSpace( const char c )
+    {
+        return ' ' == c || '\n' == c || '\t' == c || '\r' == c || '\v' == c ||
+               '\f' == c;
+    }
 
-        // Containers.
-        std::vector<int> volume_ids;
-        std::vector<int> surface_ids;
-        std::vector<float> volume_facets;
-        std::vector<float> surface_facets;
+    const char* _pos;
+    const char* _end;
+};
 
-        // Load the file.
-        std::ifstream file( stl_ascii_filename );
-        if ( !file.is_open() )
-            throw std::runtime_error( "Unable to open STL ASCII file" );
-
-        // Read the file.
-        std::string buffer;
-        std::vector<std::string> tokens;
-        tokens.reserve( 10 );
-        bool read_volume = false;
-        bool read_surface = false;
-        while ( !file.eof() )
-        {
-            // Get the current line.
-            std::getline( file, buffer );
+//---------------------------------------------------------------------------//
+// Check if a token matches a keyword.
+inline bool tokenIs( const char* token, const std::size_t length,
+                     const char* keyword )
+{
+    return ( std::strlen( keyword ) == length ) &&
+           ( std::strncmp( token, keyword, length ) == 0 );
+}
 
-            // Break the line up into tokens.
-            std::istringstream line( buffer );
-            tokens.resize( 0 );
-            while ( !line.eof() )
+//---------------------------------------------------------------------------//
+// Parse a number from a token.
+inline float tokenToFloat( const char* token, const std::size_t length )
+{
+    char buffer[64];
+    if ( length >= sizeof( buffer ) )
+        throw std::runtime_error( "STL READER: Invalid number" );
+    std::memcpy( buffer, token, length );
+    buffer[length] = '\0';
+    char* end;
+    float value = std::strtof( buffer, &end );
+    if ( end != buffer + length )
+        throw std::runtime_error( "STL READER: Invalid number" );
+    return value;
+}
+
+//---------------------------------------------------------------------------//
+// Read ASCII STL data.
+inline void readAscii( const char* data, const std::size_t size,
+                       FileData& file_data )
+{
+    AsciiTokenizer tokenizer( data, size );
+    bool read_volume = false;
+    bool read_surface = false;
+    const char* tokens[5];
+    std::size_t lengths[5];
+    while ( tokenizer.nextLine() )
+    {
+        // Break the line up into tokens.
+        int num_token = 0;
+        const char* token;
+        std::size_t length;
+        while ( tokenizer.token( token, length ) )
+        {
+            if ( num_token < 5 )
             {
-                tokens.push_back( std::string() );
-                line >> tokens.back();
+                tokens[num_token] = token;
+                lengths[num_token] = length;
             }
+            ++num_token;
+        }
 
-            // Parse the line.
-            if ( tokens.size() > 0 )
-            {
-                // New solid.
-                if ( tokens[0].compare( "solid" ) == 0 )
-                {
-                    if ( tokens.size() != 3 )
-                        throw std::runtime_error(
-                            "STL READER: Expected 3 solid line entries" );
+        // New solid.
+        if ( tokenIs( tokens[0], lengths[0], "solid" ) )
+        {
+            if ( num_token != 3 )
+                throw std::runtime_error(
+                    "STL READER: Expected 3 solid line entries" );
+            addSolid( std::string( tokens[1], lengths[1] ),
+                      std::atoi( std::string( tokens[2], lengths[2] ).c_str() ),
+                      file_data, read_volume, read_surface );
+        }
 
-                    // New volume.
-                    if ( tokens[1].compare( "Volume" ) == 0 ||
-                         tokens[1].compare( "Body" ) == 0 )
-                    {
-                        volume_ids.push_back( std::atoi( tokens[2].c_str() ) );
-                        _volume_facet_count.push_back( 0 );
-                        read_volume = true;
-                    }
+        // Read facet.
+        else if ( tokenIs( tokens[0], lengths[0], "facet" ) )
+        {
+            if ( num_token != 5 )
+                throw std::runtime_error(
+                    "STL READER: Expected 5 facet line entries" );
 
-                    // New surface.
-                    else if ( tokens[1].compare( "Surface" ) == 0 )
-                    {
-                        surface_ids.push_back( std::atoi( tokens[2].c_str() ) );
-                        _surface_facet_count.push_back( 0 );
-                        read_surface = true;
-                    }
+            // Volume facet.
+            if ( read_volume )
+                ++file_data.volume_facet_count.back();
 
-                    else
-                    {
-                        throw std::runtime_error(
-                            "STL READER: Solids execpted to be Volume/Body or "
-                            "Surface" );
-                    }
-                }
+            // Surface facet.
+            else if ( read_surface )
+                ++file_data.surface_facet_count.back();
+        }
 
-                // Read facet.
-                else if ( tokens[0].compare( "facet" ) == 0 )
-                {
-                    if ( tokens.size() != 5 )
-                        throw std::runtime_error(
-                            "STL READER: Expected 5 facet line entries" );
+        // Read vertex.
+        else if ( tokenIs( tokens[0], lengths[0], "vertex" ) )
+        {
+            if ( num_token != 4 )
+                throw std::runtime_error(
+                    "STL READER: Expected 4 vertex line entries" );
+
+            auto* facets = read_volume    ? &file_data.volume_facets
+                           : read_surface ? &file_data.surface_facets
+                                          : nullptr;
+            if ( facets )
+                for ( int d = 1; d < 4; ++d )
+                    facets->push_back( tokenToFloat( tokens[d], lengths[d] ) );
+        }
 
-                    // Volume facet.
-                    if ( read_volume )
-                    {
-                        ++_volume_facet_count.back();
-                    }
+        // Finish reading a solid.
+        else if ( tokenIs( tokens[0], lengths[0], "endsolid" ) )
+        {
+            read_volume = false;
+            read_surface = false;
+        }
+    }
+}
 
-                    // Surface facet.
-                    else if ( read_surface )
-                    {
-                        ++_surface_facet_count.back();
-                    }
-                }
+//---------------------------------------------------------------------------//
+/*!
+  \brief Read an STL file.
+  \param filename The STL file name.
+  \param format The file format: "ascii", "binary", or "auto" to detect the
+  format from the file contents.
+*/
+inline FileData read( const std::string& filename,
+                      const std::string& format = "auto" )
+{
+    MappedFile file( filename );
+    FileData file_data;
+    bool binary = false;
+    if ( format.compare( "binary" ) == 0 )
+        binary = true;
+    else if ( format.compare( "auto" ) == 0 )
+        binary = isBinary( file.data(), file.size() );
+    else if ( format.compare( "ascii" ) != 0 )
+        throw std::runtime_error( "STL READER: Unknown format " + format );
+
+    if ( binary )
+        readBinary( file.data(), file.size(), file_data );
+    else
+        readAscii( file.data(), file.size(), file_data );
+    return file_data;
+}
 
-                // Read vertex.
-                else if ( tokens[0].compare( "vertex" ) == 0 )
-                {
-                    if ( tokens.size() != 4 )
-                        throw std::runtime_error(
-                            "STL READER: Expected 4 vertex line entries" );
+//---------------------------------------------------------------------------//
+// Broadcast a vector in chunks that fit in an MPI count.
+template <class T>
+void broadcastVector( std::vector<T>& values, MPI_Comm comm, const int root )
+{
+    unsigned long long size = values.size();
+    MPI_Bcast( &size, 1, MPI_UNSIGNED_LONG_LONG, root, comm );
+    values.resize( size );
+    const std::size_t max_bytes = std::numeric_limits<int>::max();
+    char* bytes = reinterpret_cast<char*>( values.data() );
+    std::size_t num_bytes = size * sizeof( T );
+    for ( std::size_t offset = 0; offset < num_bytes; offset += max_bytes )
+    {
+        int count =
+            static_cast<int>( std::min( max_bytes, num_bytes - offset ) );
+        MPI_Bcast( bytes + offset, count, MPI_BYTE, root, comm );
+    }
+}
 
-                    // Volume vertex coordinates.
-                    if ( read_volume )
-                    {
-                        volume_facets.push_back(
-                            std::atof( tokens[1].c_str() ) );
-                        volume_facets.push_back(
-                            std::atof( tokens[2].c_str() ) );
-                        volume_facets.push_back(
-                            std::atof( tokens[3].c_str() ) );
-                    }
+//---------------------------------------------------------------------------//
+// Broadcast file data from the root rank to all ranks.
+inline void broadcast( FileData& file_data, MPI_Comm comm, const int root = 0 )
+{
+    broadcastVector( file_data.volume_ids, comm, root );
+    broadcastVector( file_data.surface_ids, comm, root );
+    broadcastVector( file_data.volume_facet_count, comm, root );
+    broadcastVector( file_data.surface_facet_count, comm, root );
+    broadcastVector( file_data.volume_facets, comm, root );
+    broadcastVector( file_data.surface_facets, comm, root );
+}
 
-                    // Surface vertex coordinates.
-                    if ( read_surface )
-                    {
-                        surface_facets.push_back(
-                            std::atof( tokens[1].c_str() ) );
-                        surface_facets.push_back(
-                            std::atof( tokens[2].c_str() ) );
-                        surface_facets.push_back(
-                            std::atof( tokens[3].c_str() ) );
-                    }
-                }
+//---------------------------------------------------------------------------//
+/*!
+  \brief Read an STL file on one rank and broadcast it to all ranks.
+  \param filename The STL file name.
+  \param comm The communicator over which to share the file data.
+  \param format The file format: "ascii", "binary", or "auto".
+*/
+inline FileData readAndBroadcast( const std::string& filename, MPI_Comm comm,
+                                  const std::string& format = "auto" )
+{
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    // Read on the root rank. Share any error so all ranks throw.
+    FileData file_data;
+    std::string error;
+    if ( 0 == comm_rank )
+    {
+        try
+        {
+            file_data = read( filename, format );
+        }
+        catch ( const std::exception& e )
+        {
+            error = e.what();
+        }
+    }
+    int has_error = !error.empty();
+    MPI_Bcast( &has_error, 1, MPI_INT, 0, comm );
+    if ( has_error )
+    {
+        std::vector<char> message( error.begin(), error.end() );
+        broadcastVector( message, comm, 0 );
+        throw std::runtime_error( std::string( message.begin(),
+                                               message.end() ) );
+    }
+
+    broadcast( file_data, comm, 0 );
+    return file_data;
+}
+
+//---------------------------------------------------------------------------//
+// Compute the axis-aligned bounding box of a range of facets.
+inline void boundingBox( const std::vector<float>& facets,
+                         const std::size_t begin, const std::size_t end,
+                         float box[6] )
+{
+    for ( int d = 0; d < 3; ++d )
+    {
+        box[d] = FLT_MAX;
+        box[d + 3] = -FLT_MAX;
+    }
+    for ( std::size_t f = begin; f < end; ++f )
+        for ( int v = 0; v < 3; ++v )
+            for ( int d = 0; d < 3; ++d )
+            {
+                box[d] = std::min( box[d], facets[9 * f + 3 * v + d] );
+                box[d + 3] = std::max( box[d + 3], facets[9 * f + 3 * v + d] );
+            }
+}
+
+//---------------------------------------------------------------------------//
+// Check if two axis-aligned bounding boxes overlap.
+template <class BoxA, class BoxB>
+bool boxesOverlap( const BoxA& a, const BoxB& b )
+{
+    for ( int d = 0; d < 3; ++d )
+        if ( a[d] > b[d + 3] || b[d] > a[d + 3] )
+            return false;
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Remove facets that can't affect geometric queries in a local box.
+  Volumes whose bounding box does not overlap the local box are emptied as
+  no point in the box can be in them, except for the global bounding volume.
+  Volumes that overlap the box keep all of their facets as rays from points
+  in the box may cross any of them. Surface facets are kept only if their
+  bounding box overlaps the local box.
+  \param file_data The file data to cull.
+  \param local_box The local box as (x_min,y_min,z_min,x_max,y_max,z_max).
+  \param global_bounding_volume The local id of the global bounding volume.
+*/
+inline void cull( FileData& file_data,
+                  const Kokkos::Array<double, 6>& local_box,
+                  const int global_bounding_volume )
+{
+    // Cull volumes.
+    {
+        std::vector<float> facets;
+        std::size_t offset = 0;
+        for ( std::size_t v = 0; v < file_data.volume_ids.size(); ++v )
+        {
+            std::size_t count = file_data.volume_facet_count[v];
+            float box[6];
+            boundingBox( file_data.volume_facets, offset, offset + count,
+                         box );
+            if ( static_cast<int>( v ) == global_bounding_volume ||
+                 boxesOverlap( box, local_box ) )
+                facets.insert( facets.end(),
+                               file_data.volume_facets.begin() + 9 * offset,
+                               file_data.volume_facets.begin() +
+                                   9 * ( offset + count ) );
+            else
+                file_data.volume_facet_count[v] = 0;
+            offset += count;
+        }
+        file_data.volume_facets.swap( facets );
+    }
 
-                // Finish reading a solid.
-                else if ( tokens[0].compare( "endsolid" ) == 0 )
+    // Cull surface facets.
+    {
+        std::vector<float> facets;
+        std::size_t offset = 0;
+        for ( std::size_t s = 0; s < file_data.surface_ids.size(); ++s )
+        {
+            std::size_t count = file_data.surface_facet_count[s];
+            int kept = 0;
+            for ( std::size_t f = offset; f < offset + count; ++f )
+            {
+                float box[6];
+                boundingBox( file_data.surface_facets, f, f + 1, box );
+                if ( boxesOverlap( box, local_box ) )
                 {
-                    read_volume = false;
-                    read_surface = false;
+                    facets.insert( facets.end(),
+                                   file_data.surface_facets.begin() + 9 * f,
+                                   file_data.surface_facets.begin() +
+                                       9 * ( f + 1 ) );
+                    ++kept;
                 }
             }
+            file_data.surface_facet_count[s] = kept;
+            offset += count;
         }
+        file_data.surface_facets.swap( facets );
+    }
+}
 
-        // Close the file.
-        file.close();
+//---------------------------------------------------------------------------//
 
-        // Put volume data on device.
-        putFileDataOnDevice( volume_ids, _volume_facet_count, volume_facets,
-                             _volume_ids, _data.volume_facets,
-                             _data.volume_offsets );
+} // end namespace STLReader
 
-        // Put surface data on device.
-        putFileDataOnDevice( surface_ids, _surface_facet_count, surface_facets,
-                             _surface_ids, _data.surface_facets,
-                             _data.surface_offsets );
+//---------------------------------------------------------------------------//
+template <class MemorySpace>
+class FacetGeometry
+{
+  public:
+    using memory_space = MemorySpace;
 
-        // Get the volume id of the global bounding box. The user is required
-        // to make an axis-aligned bounding box of their geometry that defines
-        // the global bounds of the problem. The user input is the global id
-        // of this volume.
-        _data.global_bounding_volume_id =
-            localVolumeId( params["global_bounding_volume_id"] );
+    // Default constructor.
+    FacetGeometry() = default;
 
-        // Compute the bounding boxes of all the volumes.
-        _data.volume_bounding_boxes = Kokkos::View<float* [6], MemorySpace>(
-            Kokkos::ViewAllocateWithoutInitializing( "volume_bounding_boxes" ),
-            volume_ids.size() );
-        auto host_boxes = Kokkos::create_mirror_view(
-            Kokkos::HostSpace(), _data.volume_bounding_boxes );
-        for ( int v = 0; v < _data.numVolume(); ++v )
-        {
-            BoundingBoxReduce reducer( _data.volume_facets,
-                                       _data.volume_offsets, v );
-            float box[6];
-            Kokkos::parallel_reduce(
-                "Picasso::FacetGeometry::VolumeBoundingBox",
-                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
-                                                     _volume_facet_count[v] ),
-                reducer, box );
-            for ( int i = 0; i < 6; ++i )
-                host_boxes( v, i ) = box[i];
-        }
-        Kokkos::deep_copy( _data.volume_bounding_boxes, host_boxes );
+    /*!
+      \brief Create the geometry from an STL file. The file may be ASCII or
+      binary. Each solid must be named Volume, Body, or Surface followed by
+      its global id. In a binary file the solids are concatenated and each is
+      named in its header.
+      \param inputs Geometry settings. The "stl_format" may be "ascii",
+      "binary", or "auto" (default) to detect the format.
+      \param exec_space The execution space to use for parallel operations.
+    */
+    template <class ExecutionSpace>
+    FacetGeometry( const nlohmann::json& inputs,
+                   const ExecutionSpace& exec_space )
+    {
+        Kokkos::Profiling::pushRegion( "Picasso::FacetGeoemtry::create" );
 
-        // Extract the global bounding box to the host.
-        auto global_box = Kokkos::subview(
-            host_boxes, _data.global_bounding_volume_id, Kokkos::ALL() );
-        for ( int i = 0; i < 6; ++i )
-            _global_bounding_box[i] = global_box( i );
+        // Get the geometry parameters.
+        auto params = inputs["geometry"];
+
+        // Read the stl file.
+        auto file_data =
+            STLReader::read( params["stl_file"], stlFormat( params ) );
+
+        // Create the geometry.
+        create( file_data, params, exec_space );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Create the geometry collectively. The STL file is read on the
+      first rank and broadcast to all other ranks in the communicator.
+      \param inputs Geometry settings.
+      \param comm The communicator over which to share the geometry.
+      \param exec_space The execution space to use for parallel operations.
+    */
+    template <class ExecutionSpace>
+    FacetGeometry( const nlohmann::json& inputs, MPI_Comm comm,
+                   const ExecutionSpace& exec_space )
+    {
+        Kokkos::Profiling::pushRegion( "Picasso::FacetGeoemtry::create" );
+
+        auto params = inputs["geometry"];
+        auto file_data = STLReader::readAndBroadcast( params["stl_file"], comm,
+                                                      stlFormat( params ) );
+        create( file_data, params, exec_space );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Create the geometry collectively and keep only the facets needed
+      for queries in a local box. The STL file is read on the first rank and
+      broadcast to all other ranks in the communicator. Volumes that don't
+      overlap the local box have no facets on this rank and surfaces only
+      have the facets overlapping the local box. Volume bounding boxes and
+      the global bounding box are computed before culling.
+      \param inputs Geometry settings.
+      \param comm The communicator over which to share the geometry.
+      \param local_box The region in which the geometry will be queried on
+      this rank (e.g. the local domain plus halo) as
+      (x_min,y_min,z_min,x_max,y_max,z_max).
+      \param exec_space The execution space to use for parallel operations.
+    */
+    template <class ExecutionSpace>
+    FacetGeometry( const nlohmann::json& inputs, MPI_Comm comm,
+                   const Kokkos::Array<double, 6>& local_box,
+                   const ExecutionSpace& exec_space )
+    {
+        Kokkos::Profiling::pushRegion( "Picasso::FacetGeoemtry::create" );
+
+        auto params = inputs["geometry"];
+        auto file_data = STLReader::readAndBroadcast( params["stl_file"], comm,
+                                                      stlFormat( params ) );
+        create( file_data, params, exec_space, &local_box );
 
         Kokkos::Profiling::popRegion();
     }
@@ -402,6 +793,243 @@ class FacetGeometry
     const FacetGeometryData<MemorySpace>& data() const { return _data; }
 
   private:
+    // Get the STL file format.
+    static std::string stlFormat( const nlohmann::json& params )
+    {
+        std::string stl_format = "auto";
+        if ( params.contains( "stl_format" ) )
+            stl_format = params["stl_format"];
+        return stl_format;
+    }
+
+    // Create the geometry from file data, optionally culled to a local box.
+    template <class ExecutionSpace>
+    void create( STLReader::FileData& file_data, const nlohmann::json& params,
+                 const ExecutionSpace&,
+                 const Kokkos::Array<double, 6>* local_box = nullptr )
+    {
+        // Compute the bounding boxes of all the volumes before culling.
+        int num_volume = file_data.volume_ids.size();
+        _data.volume_bounding_boxes = Kokkos::View<float* [6], MemorySpace>(
+            Kokkos::ViewAllocateWithoutInitializing( "volume_bounding_boxes" ),
+            num_volume );
+        auto host_boxes = Kokkos::create_mirror_view(
+            Kokkos::HostSpace(), _data.volume_bounding_boxes );
+        std::size_t offset = 0;
+        for ( int v = 0; v < num_volume; ++v )
+        {
+            float box[6];
+            std::size_t count = file_data.volume_facet_count[v];
+            STLReader::boundingBox( file_data.volume_facets, offset,
+                                    offset + count, box );
+            for ( int i = 0; i < 6; ++i )
+                host_boxes( v, i ) = box[i];
+            offset += count;
+        }
+        Kokkos::deep_copy( _data.volume_bounding_boxes, host_boxes );
+
+        // Get the volume id of the global bounding box. The user is required
+        // to make an axis-aligned bounding box of their geometry that defines
+        // the global bounds of the problem. The user input is the global id
+        // of this volume.
+        int global_id = params["global_bounding_volume_id"];
+        int global_bounding_volume_id = -1;
+        for ( int v = 0; v < num_volume; ++v )
+            if ( file_data.volume_ids[v] == global_id )
+                global_bounding_volume_id = v;
+        if ( global_bounding_volume_id < 0 )
+            throw std::runtime_error(
+                "Global bounding volume id not found in geometry" );
+        _data.global_bounding_volume_id = global_bounding_volume_id;
+
+        // Extract the global bounding box to the host.
+        for ( int i = 0; i < 6; ++i )
+            _global_bounding_box[i] =
+                host_boxes( _data.global_bounding_volume_id, i );
+
+        // Remove the facets not needed in the local box.
+        if ( local_box )
+            STLReader::cull( file_data, *local_box,
+                             _data.global_bounding_volume_id );
+
+        // Put volume data on device.
+        _volume_facet_count = file_data.volume_facet_count;
+        putFileDataOnDevice( file_data.volume_ids, _volume_facet_count,
+                             file_data.volume_facets, _volume_ids,
+                             _data.volume_facets, _data.volume_offsets );
+
+        // Put surface data on device.
+        _surface_facet_count = file_data.surface_facet_count;
+        putFileDataOnDevice( file_data.surface_ids, _surface_facet_count,
+                             file_data.surface_facets, _surface_ids,
+                             _data.surface_facets, _data.surface_offsets );
+
+        // Bin the volume facets.
+        int facets_per_bin = 4;
+        if ( params.contains( "facets_per_bin" ) )
+            facets_per_bin = params["facets_per_bin"];
+        if ( facets_per_bin < 1 )
+            throw std::runtime_error( "facets_per_bin must be positive" );
+        buildVolumeBins( file_data, facets_per_bin );
+    }
+
+    // Build a uniform grid of facet bins for each volume.
+    void buildVolumeBins( const STLReader::FileData& file_data,
+                          const int facets_per_bin )
+    {
+        int num_volume = file_data.volume_ids.size();
+        _data.volume_bin_boxes = Kokkos::View<float* [6], MemorySpace>(
+            Kokkos::ViewAllocateWithoutInitializing( "volume_bin_boxes" ),
+            num_volume );
+        _data.volume_bin_dims = Kokkos::View<int* [3], MemorySpace>(
+            Kokkos::ViewAllocateWithoutInitializing( "volume_bin_dims" ),
+            num_volume );
+        _data.volume_bin_offsets = Kokkos::View<int*, MemorySpace>(
+            Kokkos::ViewAllocateWithoutInitializing( "volume_bin_offsets" ),
+            num_volume + 1 );
+        auto host_bin_boxes = Kokkos::create_mirror_view(
+            Kokkos::HostSpace(), _data.volume_bin_boxes );
+        auto host_bin_dims = Kokkos::create_mirror_view(
+            Kokkos::HostSpace(), _data.volume_bin_dims );
+        auto host_volume_bin_offsets = Kokkos::create_mirror_view(
+            Kokkos::HostSpace(), _data.volume_bin_offsets );
+
+        // Size the bin grid of each volume so each bin has about the
+        // requested number of facets.
+        std::vector<float> cell_size( 3 * num_volume );
+        std::size_t facet_offset = 0;
+        host_volume_bin_offsets( 0 ) = 0;
+        for ( int v = 0; v < num_volume; ++v )
+        {
+            int num_facet = file_data.volume_facet_count[v];
+            float box[6];
+            STLReader::boundingBox( file_data.volume_facets, facet_offset,
+                                    facet_offset + num_facet, box );
+            facet_offset += num_facet;
+            if ( 0 == num_facet )
+                for ( int d = 0; d < 3; ++d )
+                {
+                    box[d] = 0.0;
+                    box[d + 3] = 0.0;
+                }
+
+            // Pad the box so facets on its boundary are inside a bin.
+            float extent = 0.0;
+            for ( int d = 0; d < 3; ++d )
+                extent = std::max( extent, box[d + 3] - box[d] );
+            float pad = 1.0e-4 * extent + FLT_MIN;
+            float volume = 1.0;
+            for ( int d = 0; d < 3; ++d )
+            {
+                box[d] -= pad;
+                box[d + 3] += pad;
+                volume *= box[d + 3] - box[d];
+            }
+
+            // A volume without facets, or one whose padded box volume
+            // underflows, uses the padded box as a single bin.
+            float num_bin = std::max( 1, num_facet / facets_per_bin );
+            float width = std::cbrt( volume / num_bin );
+            bool single_bin = ( 0 == num_facet ) || !( width > 0.0 );
+            int total_bin = 1;
+            for ( int d = 0; d < 3; ++d )
+            {
+                int n = 1;
+                if ( !single_bin )
+                    n = std::ceil( ( box[d + 3] - box[d] ) / width );
+                n = std::min( std::max( n, 1 ), 256 );
+                host_bin_dims( v, d ) = n;
+                cell_size[3 * v + d] = ( box[d + 3] - box[d] ) / n;
+                total_bin *= n;
+            }
+            for ( int i = 0; i < 6; ++i )
+                host_bin_boxes( v, i ) = box[i];
+            host_volume_bin_offsets( v + 1 ) =
+                host_volume_bin_offsets( v ) + total_bin;
+        }
+
+        // Get the range of bins overlapped by the bounding box of a facet.
+        auto bin_range = [&]( const int v, const std::size_t f, int min[3],
+                              int max[3] ) {
+            float box[6];
+            STLReader::boundingBox( file_data.volume_facets, f, f + 1, box );
+            for ( int d = 0; d < 3; ++d )
+            {
+                int n = host_bin_dims( v, d );
+                float h = cell_size[3 * v + d];
+                min[d] = std::floor( ( box[d] - host_bin_boxes( v, d ) ) / h );
+                max[d] =
+                    std::floor( ( box[d + 3] - host_bin_boxes( v, d ) ) / h );
+                min[d] = std::min( std::max( min[d], 0 ), n - 1 );
+                max[d] = std::min( std::max( max[d], 0 ), n - 1 );
+            }
+        };
+        auto bin_index = [&]( const int v, const int i, const int j,
+                              const int k ) {
+            return host_volume_bin_offsets( v ) +
+                   ( i * host_bin_dims( v, 1 ) + j ) * host_bin_dims( v, 2 ) +
+                   k;
+        };
+
+        // Count the facets in each bin and then fill the bins.
+        int num_bin = host_volume_bin_offsets( num_volume );
+        std::vector<int> offsets( num_bin + 1, 0 );
+        std::vector<int> bin_facets;
+        for ( int pass = 0; pass < 2; ++pass )
+        {
+            if ( 1 == pass )
+            {
+                for ( int b = 0; b < num_bin; ++b )
+                    offsets[b + 1] += offsets[b];
+                bin_facets.resize( offsets[num_bin] );
+            }
+            std::vector<int> fill( offsets.begin(), offsets.end() - 1 );
+            facet_offset = 0;
+            for ( int v = 0; v < num_volume; ++v )
+            {
+                int num_facet = file_data.volume_facet_count[v];
+                for ( int f = 0; f < num_facet; ++f )
+                {
+                    int min[3];
+                    int max[3];
+                    bin_range( v, facet_offset + f, min, max );
+                    for ( int i = min[0]; i <= max[0]; ++i )
+                        for ( int j = min[1]; j <= max[1]; ++j )
+                            for ( int k = min[2]; k <= max[2]; ++k )
+                            {
+                                int b = bin_index( v, i, j, k );
+                                if ( 0 == pass )
+                                    ++offsets[b + 1];
+                                else
+                                    bin_facets[fill[b]++] = f;
+                            }
+                }
+                facet_offset += num_facet;
+            }
+        }
+
+        // Copy to device.
+        Kokkos::deep_copy( _data.volume_bin_boxes, host_bin_boxes );
+        Kokkos::deep_copy( _data.volume_bin_dims, host_bin_dims );
+        Kokkos::deep_copy( _data.volume_bin_offsets, host_volume_bin_offsets );
+        _data.bin_offsets = Kokkos::View<int*, MemorySpace>(
+            Kokkos::ViewAllocateWithoutInitializing( "bin_offsets" ),
+            num_bin + 1 );
+        Kokkos::deep_copy(
+            _data.bin_offsets,
+            Kokkos::View<const int*, Kokkos::HostSpace,
+                         Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+                offsets.data(), offsets.size() ) );
+        _data.bin_facets = Kokkos::View<int*, MemorySpace>(
+            Kokkos::ViewAllocateWithoutInitializing( "bin_facets" ),
+            bin_facets.size() );
+        Kokkos::deep_copy(
+            _data.bin_facets,
+            Kokkos::View<const int*, Kokkos::HostSpace,
+                         Kokkos::MemoryTraits<Kokkos::Unmanaged>>(
+                bin_facets.data(), bin_facets.size() ) );
+    }
+
     // Put file data on device.
     void putFileDataOnDevice(
         const std::vector<int>& solid_ids,
@@ -560,40 +1188,514 @@ distanceToFacetPlane( const float x[3], const FacetView& facets, const int f )
 }
 
 //---------------------------------------------------------------------------//
-// Determine if a point is in a volume represented by a view of facets.
+// Dot product of two 3-vectors.
+KOKKOS_INLINE_FUNCTION
+float dot3( const float a[3], const float b[3] )
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+//---------------------------------------------------------------------------//
+// Compute the distance from a point to the closest point on a facet.
 template <class FacetView>
-KOKKOS_FUNCTION bool pointInVolume( const float x[3],
-                                    const FacetView& volume_facets )
+KOKKOS_FUNCTION float pointFacetDistance( const float x[3],
+                                          const FacetView& facets, const int f )
+{
+    float ab[3];
+    float ac[3];
+    float ap[3];
+    for ( int d = 0; d < 3; ++d )
+    {
+        ab[d] = facets( f, 1, d ) - facets( f, 0, d );
+        ac[d] = facets( f, 2, d ) - facets( f, 0, d );
+        ap[d] = x[d] - facets( f, 0, d );
+    }
+    // Find the closest point by checking the Voronoi regions of the facet
+    // vertices, edges, and face in turn.
+    float c[3];
+    float d1 = dot3( ab, ap );
+    float d2 = dot3( ac, ap );
+    float bp[3];
+    float cp[3];
+    for ( int d = 0; d < 3; ++d )
+    {
+        bp[d] = x[d] - facets( f, 1, d );
+        cp[d] = x[d] - facets( f, 2, d );
+    }
+    float d3 = dot3( ab, bp );
+    float d4 = dot3( ac, bp );
+    float d5 = dot3( ab, cp );
+    float d6 = dot3( ac, cp );
+    float va = d3 * d6 - d5 * d4;
+    float vb = d5 * d2 - d1 * d6;
+    float vc = d1 * d4 - d3 * d2;
+    if ( d1 <= 0.0 && d2 <= 0.0 )
+    {
+        for ( int d = 0; d < 3; ++d )
+            c[d] = facets( f, 0, d );
+    }
+    else if ( d3 >= 0.0 && d4 <= d3 )
+    {
+        for ( int d = 0; d < 3; ++d )
+            c[d] = facets( f, 1, d );
+    }
+    else if ( d6 >= 0.0 && d5 <= d6 )
+    {
+        for ( int d = 0; d < 3; ++d )
+            c[d] = facets( f, 2, d );
+    }
+    else if ( vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0 )
+    {
+        float v = d1 / ( d1 - d3 );
+        for ( int d = 0; d < 3; ++d )
+            c[d] = facets( f, 0, d ) + v * ab[d];
+    }
+    else if ( vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0 )
+    {
+        float w = d2 / ( d2 - d6 );
+        for ( int d = 0; d < 3; ++d )
+            c[d] = facets( f, 0, d ) + w * ac[d];
+    }
+    else if ( va <= 0.0 && ( d4 - d3 ) >= 0.0 && ( d5 - d6 ) >= 0.0 )
+    {
+        float w = ( d4 - d3 ) / ( ( d4 - d3 ) + ( d5 - d6 ) );
+        for ( int d = 0; d < 3; ++d )
+            c[d] = facets( f, 1, d ) +
+                   w * ( facets( f, 2, d ) - facets( f, 1, d ) );
+    }
+    else
+    {
+        float denom = 1.0 / ( va + vb + vc );
+        float v = vb * denom;
+        float w = vc * denom;
+        for ( int d = 0; d < 3; ++d )
+            c[d] = facets( f, 0, d ) + v * ab[d] + w * ac[d];
+    }
+
+    float r[3] = { x[0] - c[0], x[1] - c[1], x[2] - c[2] };
+    return Kokkos::sqrt( dot3( r, r ) );
+}
+
+//---------------------------------------------------------------------------//
+// Number of rays used to classify a point against a volume.
+constexpr int num_point_in_volume_ray = 3;
+
+// Relative tolerance below which a ray-facet intersection is considered too
+// close to a facet edge or vertex, or a point too close to a facet, for the
+// ray parity to be trusted.
+constexpr float point_in_volume_tolerance = 1.0e-5;
+
+//---------------------------------------------------------------------------//
+// Get the directions of the rays used for point-in-volume queries.
+template <class DeviceType>
+KOKKOS_FUNCTION void pointInVolumeRays( float r[num_point_in_volume_ray][3] )
 {
-    // The choice of ray direction is arbitrary so generate a random one. This
+    // The choice of ray direction is arbitrary so generate random ones. This
     // could potentially help with robustness as floating point noise may
     // avoid edge and vertex intersections which could lead to multiple
     // positive intersections and therefore an incorrect point-in-volume
     // determination. The facet geometry has no connectivity so it is
     // difficult to resolve multiple intersections without accumulating the
     // intersection points and checking for duplicates within some tolerance.
+    // Instead, rays with intersections near facet edges are discarded and the
+    // remaining rays vote.
     //
     // Note: Duan has indicated that doing tests with 3 different random rays
     // has been enough to be robust as one is likely to pass out of the 3 if
     // is a true intersection.
-    using rand_type =
-        Kokkos::Random_XorShift64<typename FacetView::device_type>;
+    using rand_type = Kokkos::Random_XorShift64<DeviceType>;
     rand_type rng( 0 );
-    float r[3] = { Kokkos::rand<rand_type, float>::draw( rng ),
-                   Kokkos::rand<rand_type, float>::draw( rng ),
-                   Kokkos::rand<rand_type, float>::draw( rng ) };
-    float r_mag_inv = 1.0 / sqrt( r[0] * r[0] + r[1] * r[1] + r[2] * r[2] );
+    for ( int n = 0; n < num_point_in_volume_ray; ++n )
+    {
+        for ( int d = 0; d < 3; ++d )
+        {
+            r[n][d] = Kokkos::rand<rand_type, float>::draw( rng );
+            if ( n > 0 )
+                r[n][d] = 2.0 * r[n][d] - 1.0;
+        }
+        float r_mag_inv = 1.0 / sqrt( r[n][0] * r[n][0] + r[n][1] * r[n][1] +
+                                      r[n][2] * r[n][2] );
+        for ( int d = 0; d < 3; ++d )
+            r[n][d] *= r_mag_inv;
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Fire a ray from point x along the unit direction r and classify its
+// intersection with a facet. Returns 1 if the ray crosses the facet, 0 if it
+// does not, and -1 if the intersection is ambiguous because it is within the
+// tolerance of a facet edge or the point is within the tolerance of the
+// facet. The distance along the ray to the facet plane is returned in t.
+template <class FacetView>
+KOKKOS_FUNCTION int rayFacetHit( const float x[3], const float r[3],
+                                 const FacetView& facets, const int f,
+                                 float& t )
+{
+    // Barycentric coordinates are left outside of the facet if the ray is
+    // parallel to it.
+    float y[3] = { -1.0, -1.0, -1.0 };
+    pointFacetProjection( x, r, facets, f, y );
+    t = y[2];
+
+    // Clear misses.
+    const float tol = point_in_volume_tolerance;
+    if ( y[0] < -tol || y[1] < -tol || y[0] + y[1] > 1.0 + tol )
+        return 0;
+
+    // Points on the facet.
+    float size = 0.0;
     for ( int d = 0; d < 3; ++d )
-        r[d] *= r_mag_inv;
+        size = Kokkos::fmax(
+            size, Kokkos::fmax( Kokkos::fabs( facets( f, 1, d ) -
+                                              facets( f, 0, d ) ),
+                                Kokkos::fabs( facets( f, 2, d ) -
+                                              facets( f, 0, d ) ) ) );
+    if ( Kokkos::fabs( t ) <= tol * size )
+        return -1;
 
-    // Fire rays through each facet and count intersections. If an
-    // odd number of intersections, the point is in the volume. This works for
-    // convex and non-convex volumes.
-    int count = 0;
+    // Intersections behind the point.
+    if ( t < 0.0 )
+        return 0;
+
+    // Intersections near an edge or vertex.
+    if ( y[0] <= tol || y[1] <= tol || y[0] + y[1] >= 1.0 - tol )
+        return -1;
+
+    return 1;
+}
+
+//---------------------------------------------------------------------------//
+// Compute the generalized winding number of a volume about a point. The
+// winding number is the sum of the solid angles of the facets as seen from
+// the point divided by 4 pi. It is +/-1 inside a closed volume, depending on
+// the facet orientation, and 0 outside and degrades gracefully for volumes
+// with small gaps or overlaps.
+template <class FacetView>
+KOKKOS_FUNCTION float windingNumber( const float x[3],
+                                     const FacetView& volume_facets )
+{
+    double omega = 0.0;
     for ( std::size_t f = 0; f < volume_facets.extent( 0 ); ++f )
-        if ( rayFacetIntersect( x, r, volume_facets, f ) )
-            ++count;
-    return ( 1 == count % 2 );
+    {
+        double a[3];
+        double b[3];
+        double c[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            a[d] = volume_facets( f, 0, d ) - x[d];
+            b[d] = volume_facets( f, 1, d ) - x[d];
+            c[d] = volume_facets( f, 2, d ) - x[d];
+        }
+        double la = Kokkos::sqrt( a[0] * a[0] + a[1] * a[1] + a[2] * a[2] );
+        double lb = Kokkos::sqrt( b[0] * b[0] + b[1] * b[1] + b[2] * b[2] );
+        double lc = Kokkos::sqrt( c[0] * c[0] + c[1] * c[1] + c[2] * c[2] );
+        double det = a[0] * ( b[1] * c[2] - b[2] * c[1] ) -
+                     a[1] * ( b[0] * c[2] - b[2] * c[0] ) +
+                     a[2] * ( b[0] * c[1] - b[1] * c[0] );
+        double ab = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        double ac = a[0] * c[0] + a[1] * c[1] + a[2] * c[2];
+        double bc = b[0] * c[0] + b[1] * c[1] + b[2] * c[2];
+        omega += 2.0 * Kokkos::atan2( det, la * lb * lc + ab * lc + ac * lb +
+                                               bc * la );
+    }
+    return omega / ( 4.0 * Kokkos::numbers::pi );
+}
+
+//---------------------------------------------------------------------------//
+// Decide if a point is inside a volume from the ray votes. Each ray that
+// returned an unambiguous parity has a vote. Returns 1 if inside, 0 if
+// outside, and -1 if there is no majority.
+KOKKOS_INLINE_FUNCTION
+int pointInVolumeVote( const int num_inside, const int num_outside )
+{
+    const int majority = num_point_in_volume_ray / 2 + 1;
+    if ( num_inside >= majority )
+        return 1;
+    if ( num_outside >= majority )
+        return 0;
+    return -1;
+}
+
+//---------------------------------------------------------------------------//
+// Count the intersections of a ray fired from point x along the unit
+// direction r with the facets of a volume. The ray is walked through the
+// facet bins of the volume and a facet intersection is only counted in the
+// bin containing it so facets in multiple bins are counted once. Returns -1
+// if an intersection is ambiguous.
+template <class MemorySpace>
+KOKKOS_FUNCTION int
+countVolumeIntersections( const float x[3], const float r[3],
+                          const FacetGeometryData<MemorySpace>& geom,
+                          const int volume_id )
+{
+    auto volume_facets = geom.volumeFacets( volume_id );
+    int first_bin = geom.volume_bin_offsets( volume_id );
+
+    // Clip the ray to the bin grid.
+    float t_min = 0.0;
+    float t_max = FLT_MAX;
+    float lo[3];
+    float h[3];
+    int n[3];
+    for ( int d = 0; d < 3; ++d )
+    {
+        lo[d] = geom.volume_bin_boxes( volume_id, d );
+        float hi = geom.volume_bin_boxes( volume_id, d + 3 );
+        n[d] = geom.volume_bin_dims( volume_id, d );
+        h[d] = ( hi - lo[d] ) / n[d];
+        if ( 0.0 == r[d] )
+        {
+            if ( x[d] < lo[d] || x[d] > hi )
+                return 0;
+        }
+        else
+        {
+            float t0 = ( lo[d] - x[d] ) / r[d];
+            float t1 = ( hi - x[d] ) / r[d];
+            t_min = Kokkos::fmax( t_min, Kokkos::fmin( t0, t1 ) );
+            t_max = Kokkos::fmin( t_max, Kokkos::fmax( t0, t1 ) );
+        }
+    }
+    if ( t_min > t_max )
+        return 0;
+
+    // Find the first bin and setup the walk.
+    int c[3];
+    int step[3];
+    float t_next[3];
+    float t_delta[3];
+    for ( int d = 0; d < 3; ++d )
+    {
+        c[d] = Kokkos::floor( ( x[d] + t_min * r[d] - lo[d] ) / h[d] );
+        c[d] = ( c[d] < 0 ) ? 0 : ( ( c[d] >= n[d] ) ? n[d] - 1 : c[d] );
+        if ( r[d] > 0.0 )
+        {
+            step[d] = 1;
+            t_next[d] = ( lo[d] + ( c[d] + 1 ) * h[d] - x[d] ) / r[d];
+            t_delta[d] = h[d] / r[d];
+        }
+        else if ( r[d] < 0.0 )
+        {
+            step[d] = -1;
+            t_next[d] = ( lo[d] + c[d] * h[d] - x[d] ) / r[d];
+            t_delta[d] = -h[d] / r[d];
+        }
+        else
+        {
+            step[d] = 0;
+            t_next[d] = FLT_MAX;
+            t_delta[d] = FLT_MAX;
+        }
+    }
+
+    // Walk the bins. Each bin owns the intersections in its interval of the
+    // ray and the last bin owns the rest of the ray.
+    int count = 0;
+    float t_enter = 0.0;
+    while ( true )
+    {
+        int a = ( t_next[0] < t_next[1] ) ? 0 : 1;
+        a = ( t_next[2] < t_next[a] ) ? 2 : a;
+        bool last = ( c[a] + step[a] < 0 || c[a] + step[a] >= n[a] );
+        float t_exit = last ? FLT_MAX : t_next[a];
+
+        int b = first_bin + ( c[0] * n[1] + c[1] ) * n[2] + c[2];
+        for ( int i = geom.bin_offsets( b ); i < geom.bin_offsets( b + 1 );
+              ++i )
+        {
+            float t;
+            int hit = rayFacetHit( x, r, volume_facets, geom.bin_facets( i ),
+                                   t );
+            if ( 0 != hit && t >= t_enter && t < t_exit )
+            {
+                if ( hit < 0 )
+                    return -1;
+                ++count;
+            }
+        }
+
+        if ( last )
+            break;
+        t_enter = t_exit;
+        c[a] += step[a];
+        t_next[a] += t_delta[a];
+    }
+
+    return count;
+}
+
+//---------------------------------------------------------------------------//
+// Find the facet of a volume closest to a point using the facet bins of the
+// volume. Bins are searched in rings of increasing distance from the point
+// until no closer facet can be found. Returns the index of the facet in the
+// volume facets or -1 if the volume has no facets.
+template <class MemorySpace>
+KOKKOS_FUNCTION int
+closestVolumeFacet( const float x[3],
+                    const FacetGeometryData<MemorySpace>& geom,
+                    const int volume_id, float& distance )
+{
+    auto volume_facets = geom.volumeFacets( volume_id );
+    int first_bin = geom.volume_bin_offsets( volume_id );
+
+    // Find the bin closest to the point.
+    int c[3];
+    int n[3];
+    float min_h = FLT_MAX;
+    for ( int d = 0; d < 3; ++d )
+    {
+        float lo = geom.volume_bin_boxes( volume_id, d );
+        n[d] = geom.volume_bin_dims( volume_id, d );
+        float h = ( geom.volume_bin_boxes( volume_id, d + 3 ) - lo ) / n[d];
+        min_h = Kokkos::fmin( min_h, h );
+        c[d] = Kokkos::floor( ( x[d] - lo ) / h );
+        c[d] = ( c[d] < 0 ) ? 0 : ( ( c[d] >= n[d] ) ? n[d] - 1 : c[d] );
+    }
+    int max_ring = n[0];
+    max_ring = ( n[1] > max_ring ) ? n[1] : max_ring;
+    max_ring = ( n[2] > max_ring ) ? n[2] : max_ring;
+
+    // Search the rings of bins. Bins in ring k are at least (k-1) bin widths
+    // from the point.
+    int closest = -1;
+    distance = FLT_MAX;
+    for ( int k = 0; k < max_ring; ++k )
+    {
+        if ( k > 0 && distance <= ( k - 1 ) * min_h )
+            break;
+        for ( int i = c[0] - k; i <= c[0] + k; ++i )
+            for ( int j = c[1] - k; j <= c[1] + k; ++j )
+                for ( int l = c[2] - k; l <= c[2] + k; ++l )
+                {
+                    if ( i < 0 || i >= n[0] || j < 0 || j >= n[1] || l < 0 ||
+                         l >= n[2] )
+                        continue;
+                    int ring = Kokkos::max( Kokkos::abs( i - c[0] ),
+                                            Kokkos::abs( j - c[1] ) );
+                    ring = Kokkos::max( ring, Kokkos::abs( l - c[2] ) );
+                    if ( ring != k )
+                        continue;
+
+                    int b = first_bin + ( i * n[1] + j ) * n[2] + l;
+                    for ( int m = geom.bin_offsets( b );
+                          m < geom.bin_offsets( b + 1 ); ++m )
+                    {
+                        int f = geom.bin_facets( m );
+                        float dist = pointFacetDistance( x, volume_facets, f );
+                        if ( dist < distance )
+                        {
+                            distance = dist;
+                            closest = f;
+                        }
+                    }
+                }
+    }
+
+    return closest;
+}
+
+//---------------------------------------------------------------------------//
+// Determine if a point is in a volume represented by a view of facets.
+template <class FacetView>
+KOKKOS_FUNCTION bool pointInVolume( const float x[3],
+                                    const FacetView& volume_facets )
+{
+    // Get the ray directions.
+    float r[num_point_in_volume_ray][3];
+    pointInVolumeRays<typename FacetView::device_type>( r );
+
+    // Fire the rays through each facet in a single pass and count
+    // intersections. If a ray has an odd number of intersections it votes
+    // for the point being in the volume. This works for convex and
+    // non-convex volumes. Rays with an ambiguous intersection are dropped and
+    // the pass stops once no majority is possible.
+    int count[num_point_in_volume_ray] = {};
+    bool valid[num_point_in_volume_ray];
+    for ( int n = 0; n < num_point_in_volume_ray; ++n )
+        valid[n] = true;
+    const int max_invalid =
+        num_point_in_volume_ray - ( num_point_in_volume_ray / 2 + 1 );
+    int num_invalid = 0;
+    for ( std::size_t f = 0;
+          f < volume_facets.extent( 0 ) && num_invalid <= max_invalid; ++f )
+    {
+        for ( int n = 0; n < num_point_in_volume_ray; ++n )
+        {
+            if ( valid[n] )
+            {
+                float t;
+                int hit = rayFacetHit( x, r[n], volume_facets, f, t );
+                if ( hit < 0 )
+                {
+                    valid[n] = false;
+                    ++num_invalid;
+                }
+                else
+                {
+                    count[n] += hit;
+                }
+            }
+        }
+    }
+
+    // Vote.
+    int num_inside = 0;
+    int num_outside = 0;
+    for ( int n = 0; n < num_point_in_volume_ray; ++n )
+    {
+        if ( valid[n] )
+        {
+            if ( count[n] % 2 )
+                ++num_inside;
+            else
+                ++num_outside;
+        }
+    }
+    int vote = pointInVolumeVote( num_inside, num_outside );
+    if ( vote >= 0 )
+        return vote;
+
+    // Fall back to the winding number for ambiguous points.
+    return Kokkos::fabs( windingNumber( x, volume_facets ) ) > 0.5;
+}
+
+//---------------------------------------------------------------------------//
+// Determine if a point is in a volume of a facet geometry using its facet
+// bins.
+template <class MemorySpace>
+KOKKOS_FUNCTION bool pointInVolume( const float x[3],
+                                    const FacetGeometryData<MemorySpace>& geom,
+                                    const int volume_id )
+{
+    if ( !geom.hasVolumeBins() )
+        return pointInVolume( x, geom.volumeFacets( volume_id ) );
+
+    // Get the ray directions.
+    float r[num_point_in_volume_ray][3];
+    pointInVolumeRays<
+        typename Kokkos::View<float* [4][3], MemorySpace>::device_type>( r );
+
+    // Walk the rays one at a time until the vote is decided.
+    int num_inside = 0;
+    int num_outside = 0;
+    for ( int n = 0; n < num_point_in_volume_ray; ++n )
+    {
+        int count = countVolumeIntersections( x, r[n], geom, volume_id );
+        if ( count >= 0 )
+        {
+            if ( count % 2 )
+                ++num_inside;
+            else
+                ++num_outside;
+        }
+        int vote = pointInVolumeVote( num_inside, num_outside );
+        if ( vote >= 0 )
+            return vote;
+    }
+
+    // Fall back to the winding number for ambiguous points.
+    return Kokkos::fabs( windingNumber( x, geom.volumeFacets( volume_id ) ) ) >
+           0.5;
 }
 
 //---------------------------------------------------------------------------//
@@ -630,9 +1732,9 @@ KOKKOS_FUNCTION int locatePoint( const float x[3],
                      geom.volume_bounding_boxes( v, 4 ) >= x[1] &&
                      geom.volume_bounding_boxes( v, 5 ) >= x[2] )
                 {
-                    // If in the bounding box, check against each volume
-                    // facet for point inclusion.
-                    if ( pointInVolume( x, geom.volumeFacets( v ) ) )
+                    // If in the bounding box, check against the volume
+                    // facets for point inclusion.
+                    if ( pointInVolume( x, geom, v ) )
                     {
                         return v;
                     }
@@ -0,0 +1,497 @@
+/****************************************************************************
+ * Copyright (c) 2021 by the Picasso authors                                *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Picasso library. Picasso is distributed under a *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef PICASSO_FACETVOXELIZATION_HPP
+#define PICASSO_FACETVOXELIZATION_HPP
+
+#include <Picasso_FacetGeometry.hpp>
+#include <Picasso_FieldManager.hpp>
+#include <Picasso_FieldTypes.hpp>
+#include <Picasso_Types.hpp>
+
+#include <Cabana_Grid.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cfloat>
+#include <stdexcept>
+
+namespace Picasso
+{
+//---------------------------------------------------------------------------//
+// Cell voxelization of the volumes of a facet geometry on a uniform mesh.
+//---------------------------------------------------------------------------//
+template <class MemorySpace>
+struct FacetVoxelData
+{
+    // Local id of the volume containing each local cell center including
+    // ghost cells. Cells in the implicit complement are -1 and cells outside
+    // of the global bounding volume are -2.
+    Kokkos::View<int****, Kokkos::LayoutRight, MemorySpace> volume_id;
+
+    // Cut cells. Non-zero if a cell may contain a volume boundary in which
+    // case points in the cell need an exact location test.
+    Kokkos::View<int***, MemorySpace> cut;
+
+    // Low corner of the local cells including ghost cells.
+    Kokkos::Array<double, 3> low_corner;
+
+    // Uniform cell size.
+    double cell_size;
+
+    // Number of local cells in each dimension including ghost cells.
+    Kokkos::Array<int, 3> num_cell;
+};
+
+//---------------------------------------------------------------------------//
+namespace FacetVoxelizationOps
+{
+//---------------------------------------------------------------------------//
+// Evaluate the edge function of the edge (a,b) at the point p in the y-z
+// plane. The point is symbolically perturbed so the sign is never zero and
+// the end points are ordered canonically so facets sharing the edge see
+// exactly opposite values. A scanline through a shared edge or vertex
+// therefore crosses exactly one of the facets sharing it.
+KOKKOS_INLINE_FUNCTION
+int perturbedEdgeSign( const double a[2], const double b[2], const double p[2],
+                       double& e )
+{
+    bool swap = ( b[0] < a[0] ) || ( b[0] == a[0] && b[1] < a[1] );
+    const double* u = swap ? b : a;
+    const double* w = swap ? a : b;
+    double dy = w[0] - u[0];
+    double dz = w[1] - u[1];
+    e = dy * ( p[1] - u[1] ) - dz * ( p[0] - u[0] );
+
+    // Perturb the point by (eps,eps^2) if it is on the edge line.
+    int sign;
+    if ( e != 0.0 )
+        sign = ( e > 0.0 ) ? 1 : -1;
+    else if ( dz != 0.0 )
+        sign = ( dz < 0.0 ) ? 1 : -1;
+    else
+        sign = ( dy > 0.0 ) ? 1 : -1;
+
+    if ( swap )
+    {
+        e = -e;
+        sign = -sign;
+    }
+    return sign;
+}
+
+//---------------------------------------------------------------------------//
+// Intersect the scanline through (y,z) parallel to the x axis with a facet.
+// If the line crosses the facet return true and the x coordinate of the
+// crossing.
+template <class FacetView>
+KOKKOS_FUNCTION bool scanlineFacetCrossing( const float y, const float z,
+                                            const FacetView& facets,
+                                            const int f, double& x )
+{
+    double p[2] = { y, z };
+    double v[3][2];
+    for ( int n = 0; n < 3; ++n )
+    {
+        v[n][0] = facets( f, n, 1 );
+        v[n][1] = facets( f, n, 2 );
+    }
+
+    // The line crosses the facet if the edge functions have the same sign.
+    double e[3];
+    int s0 = perturbedEdgeSign( v[1], v[2], p, e[0] );
+    int s1 = perturbedEdgeSign( v[2], v[0], p, e[1] );
+    int s2 = perturbedEdgeSign( v[0], v[1], p, e[2] );
+    if ( s0 != s1 || s1 != s2 )
+        return false;
+
+    // Facets parallel to the line are never crossed.
+    double area = e[0] + e[1] + e[2];
+    if ( 0.0 == area )
+        return false;
+
+    // The edge functions are the barycentric weights of the opposite
+    // vertices.
+    x = ( e[0] * facets( f, 0, 0 ) + e[1] * facets( f, 1, 0 ) +
+          e[2] * facets( f, 2, 0 ) ) /
+        area;
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+// Given a point determine the volume in the given facet geometry in which it
+// is located using the voxelization of the geometry. Points in cells cut by
+// a volume boundary or outside of the local cells are located exactly. If it
+// is in the implicit complement, return -1. If it is outside of the entire
+// domain, return -2.
+template <class MemorySpace>
+KOKKOS_FUNCTION int locatePoint( const float x[3],
+                                 const FacetGeometryData<MemorySpace>& geom,
+                                 const FacetVoxelData<MemorySpace>& voxels )
+{
+    int c[3];
+    for ( int d = 0; d < 3; ++d )
+    {
+        double t = ( x[d] - voxels.low_corner[d] ) / voxels.cell_size;
+        if ( !( t >= 0.0 && t < voxels.num_cell[d] ) )
+            return FacetGeometryOps::locatePoint( x, geom );
+        c[d] = t;
+    }
+
+    if ( voxels.cut( c[0], c[1], c[2] ) )
+        return FacetGeometryOps::locatePoint( x, geom );
+
+    return voxels.volume_id( c[0], c[1], c[2], 0 );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace FacetVoxelizationOps
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Select points located in a volume of a voxelized facet geometry. This
+  may be used as the count functor of the two-pass particle initialization so
+  that particles are only counted in a volume with a cheap cell lookup away
+  from the volume boundaries.
+*/
+template <class MemorySpace>
+struct FacetVolumeSelector
+{
+    FacetGeometryData<MemorySpace> geom;
+    FacetVoxelData<MemorySpace> voxels;
+    int volume;
+
+    KOKKOS_INLINE_FUNCTION
+    bool operator()( const double px[3] ) const
+    {
+        float x[3] = { float( px[0] ), float( px[1] ), float( px[2] ) };
+        return ( volume ==
+                 FacetVoxelizationOps::locatePoint( x, geom, voxels ) );
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a selector for the points located in a volume.
+
+  \param geom The facet geometry data.
+
+  \param voxels The voxelization of the geometry.
+
+  \param volume The local id of the volume.
+*/
+template <class MemorySpace>
+FacetVolumeSelector<MemorySpace>
+createFacetVolumeSelector( const FacetGeometryData<MemorySpace>& geom,
+                           const FacetVoxelData<MemorySpace>& voxels,
+                           const int volume )
+{
+    return FacetVolumeSelector<MemorySpace>{ geom, voxels, volume };
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Voxelize the volumes of a facet geometry onto the cells of a
+  uniform mesh. The volume containing each local cell center, including
+  ghost cells, is written to the cell volume id field of the field manager.
+  Each volume is filled by casting scanlines through the rows of cell
+  centers and toggling inside/outside at each facet crossing, using the
+  facet bins of the volume to find the facets along each scanline. Cells that
+  may contain a volume boundary are flagged so point location can fall back
+  to an exact test in those cells only. As with
+  FacetGeometryOps::locatePoint, a cell in more than one volume is assigned
+  the volume with the lowest local id.
+
+  \param exec_space The execution space to use for parallel kernels.
+
+  \param fm The field manager of the uniform mesh. The cell volume id field
+  is added if it does not exist.
+
+  \param geom The facet geometry data. The geometry must have facet bins.
+
+  \return The voxelization data used for point location.
+*/
+template <class ExecutionSpace, class Mesh>
+FacetVoxelData<typename Mesh::memory_space>
+voxelizeVolumes( const ExecutionSpace& exec_space, FieldManager<Mesh>& fm,
+                 const FacetGeometryData<typename Mesh::memory_space>& geom )
+{
+    Kokkos::Profiling::pushRegion( "Picasso::FacetVoxelization::voxelize" );
+
+    static_assert( is_uniform_mesh<Mesh>::value,
+                   "Facet voxelization requires a uniform mesh" );
+
+    if ( !geom.hasVolumeBins() )
+        throw std::runtime_error( "Voxelization requires facet bins" );
+
+    using memory_space = typename Mesh::memory_space;
+
+    // Add the volume id field.
+    fm.add( FieldLocation::Cell(), Field::VolumeId() );
+
+    // Get the local cells.
+    auto local_grid = fm.mesh()->localGrid();
+    auto local_mesh =
+        Cabana::Grid::createLocalMesh<Kokkos::HostSpace>( *local_grid );
+    auto cell_space = local_grid->indexSpace(
+        Cabana::Grid::Ghost(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+
+    FacetVoxelData<memory_space> voxels;
+    voxels.volume_id = fm.view( FieldLocation::Cell(), Field::VolumeId() );
+    voxels.cell_size = local_grid->globalGrid().globalMesh().cellSize( 0 );
+    for ( int d = 0; d < 3; ++d )
+    {
+        voxels.low_corner[d] = local_mesh.lowCorner( Cabana::Grid::Ghost(), d );
+        voxels.num_cell[d] = cell_space.extent( d );
+    }
+    voxels.cut = Kokkos::View<int***, memory_space>(
+        "voxel_cut", voxels.num_cell[0], voxels.num_cell[1],
+        voxels.num_cell[2] );
+
+    auto volume_id = voxels.volume_id;
+    auto cut = voxels.cut;
+    auto low_corner = voxels.low_corner;
+    double h = voxels.cell_size;
+    auto num_cell = voxels.num_cell;
+
+    // Host copies of the volume bounding boxes.
+    auto host_boxes = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), geom.volume_bounding_boxes );
+    auto host_offsets = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), geom.volume_offsets );
+    int gbv = geom.global_bounding_volume_id;
+    int num_volume = geom.numVolume();
+
+    // Initialize cells to the implicit complement if their center is in the
+    // global bounding box and outside the domain otherwise. Cells not fully
+    // inside the global bounding box are cut.
+    Kokkos::Array<float, 6> global_box;
+    for ( int i = 0; i < 6; ++i )
+        global_box[i] = host_boxes( gbv, i );
+    Kokkos::parallel_for(
+        "Picasso::FacetVoxelization::Initialize",
+        Cabana::Grid::createExecutionPolicy( cell_space, exec_space ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int c[3] = { i, j, k };
+            bool center_inside = true;
+            bool cell_inside = true;
+            for ( int d = 0; d < 3; ++d )
+            {
+                double lo = low_corner[d] + c[d] * h;
+                float center = lo + 0.5 * h;
+                center_inside = center_inside && global_box[d] <= center &&
+                                global_box[d + 3] >= center;
+                cell_inside = cell_inside && global_box[d] <= lo &&
+                              global_box[d + 3] >= lo + h;
+            }
+            volume_id( i, j, k, 0 ) = center_inside ? -1 : -2;
+            cut( i, j, k ) = !cell_inside;
+        } );
+
+    // Flag the cells overlapped by the bounding box of a volume facet as
+    // cut. Facets of the global bounding volume are only used for its
+    // bounding box.
+    auto volume_facets = geom.volume_facets;
+    int gbv_begin = ( 0 == gbv ) ? 0 : host_offsets( gbv - 1 );
+    int gbv_end = host_offsets( gbv );
+    Kokkos::parallel_for(
+        "Picasso::FacetVoxelization::CutCells",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                             volume_facets.extent( 0 ) ),
+        KOKKOS_LAMBDA( const int f ) {
+            if ( f >= gbv_begin && f < gbv_end )
+                return;
+            int min[3];
+            int max[3];
+            for ( int d = 0; d < 3; ++d )
+            {
+                float f_min = Kokkos::fmin(
+                    volume_facets( f, 0, d ),
+                    Kokkos::fmin( volume_facets( f, 1, d ),
+                                  volume_facets( f, 2, d ) ) );
+                float f_max = Kokkos::fmax(
+                    volume_facets( f, 0, d ),
+                    Kokkos::fmax( volume_facets( f, 1, d ),
+                                  volume_facets( f, 2, d ) ) );
+                min[d] = Kokkos::floor( ( f_min - low_corner[d] ) / h );
+                max[d] = Kokkos::floor( ( f_max - low_corner[d] ) / h );
+                min[d] = Kokkos::max( min[d], 0 );
+                max[d] = Kokkos::min( max[d], num_cell[d] - 1 );
+            }
+            for ( int i = min[0]; i <= max[0]; ++i )
+                for ( int j = min[1]; j <= max[1]; ++j )
+                    for ( int k = min[2]; k <= max[2]; ++k )
+                        Kokkos::atomic_store( &cut( i, j, k ), 1 );
+        } );
+
+    // Fill each volume along scanlines of cell centers in the x direction.
+    Kokkos::View<int***, memory_space> crossings(
+        "voxel_crossings", num_cell[0], num_cell[1], num_cell[2] );
+    Cabana::Grid::IndexSpace<2> line_space(
+        { cell_space.min( 1 ), cell_space.min( 2 ) },
+        { cell_space.max( 1 ), cell_space.max( 2 ) } );
+    for ( int v = 0; v < num_volume; ++v )
+    {
+        // Skip the global bounding volume and volumes that can't contain
+        // local cell centers.
+        if ( v == gbv )
+            continue;
+        bool overlaps = true;
+        for ( int d = 0; d < 3; ++d )
+            overlaps = overlaps &&
+                       host_boxes( v, d ) <=
+                           low_corner[d] + ( num_cell[d] - 0.5 ) * h &&
+                       host_boxes( v, d + 3 ) >= low_corner[d] + 0.5 * h;
+        if ( !overlaps )
+            continue;
+
+        // Count the facet crossings before each cell center. A crossing is
+        // assigned to the first cell with a center past it.
+        Kokkos::deep_copy( exec_space, crossings, 0 );
+        Kokkos::parallel_for(
+            "Picasso::FacetVoxelization::Scanline",
+            Cabana::Grid::createExecutionPolicy( line_space, exec_space ),
+            KOKKOS_LAMBDA( const int j, const int k ) {
+                float y = low_corner[1] + ( j + 0.5 ) * h;
+                float z = low_corner[2] + ( k + 0.5 ) * h;
+
+                // Find the column of bins containing the line.
+                int n[3];
+                float lo[3];
+                float bin_h[3];
+                for ( int d = 0; d < 3; ++d )
+                {
+                    lo[d] = geom.volume_bin_boxes( v, d );
+                    n[d] = geom.volume_bin_dims( v, d );
+                    bin_h[d] = ( geom.volume_bin_boxes( v, d + 3 ) - lo[d] ) /
+                               n[d];
+                }
+                if ( y < lo[1] || y > geom.volume_bin_boxes( v, 4 ) ||
+                     z < lo[2] || z > geom.volume_bin_boxes( v, 5 ) )
+                    return;
+                int bj = Kokkos::min( int( ( y - lo[1] ) / bin_h[1] ),
+                                      n[1] - 1 );
+                int bk = Kokkos::min( int( ( z - lo[2] ) / bin_h[2] ),
+                                      n[2] - 1 );
+
+                // Intersect the facets in the column. A crossing is only
+                // counted in the bin containing it so facets in multiple
+                // bins are counted once.
+                auto facets = geom.volumeFacets( v );
+                int first_bin = geom.volume_bin_offsets( v );
+                for ( int bi = 0; bi < n[0]; ++bi )
+                {
+                    int b = first_bin + ( bi * n[1] + bj ) * n[2] + bk;
+                    for ( int m = geom.bin_offsets( b );
+                          m < geom.bin_offsets( b + 1 ); ++m )
+                    {
+                        double x;
+                        if ( !FacetVoxelizationOps::scanlineFacetCrossing(
+                                 y, z, facets, geom.bin_facets( m ), x ) )
+                            continue;
+                        int owner = Kokkos::floor( ( x - lo[0] ) / bin_h[0] );
+                        owner =
+                            Kokkos::min( Kokkos::max( owner, 0 ), n[0] - 1 );
+                        if ( owner != bi )
+                            continue;
+                        int i = Kokkos::floor( ( x - low_corner[0] ) / h -
+                                               0.5 ) +
+                                1;
+                        i = Kokkos::max( i, 0 );
+                        if ( i < num_cell[0] )
+                            ++crossings( i, j, k );
+                    }
+                }
+            } );
+
+        // Cell centers after an odd number of crossings are in the volume.
+        Kokkos::parallel_for(
+            "Picasso::FacetVoxelization::Fill",
+            Cabana::Grid::createExecutionPolicy( line_space, exec_space ),
+            KOKKOS_LAMBDA( const int j, const int k ) {
+                int count = 0;
+                for ( int i = 0; i < num_cell[0]; ++i )
+                {
+                    count += crossings( i, j, k );
+                    if ( ( count % 2 ) && -1 == volume_id( i, j, k, 0 ) )
+                        volume_id( i, j, k, 0 ) = v;
+                }
+            } );
+    }
+
+    Kokkos::Profiling::popRegion();
+
+    return voxels;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Compute the signed distance from each local cell center, including
+  ghost cells, to the boundary of a volume and write it to the cell signed
+  distance field of the field manager. The distance is negative inside the
+  volume. The sign is taken from the voxelization so volumes are assumed to
+  not overlap.
+
+  \param exec_space The execution space to use for parallel kernels.
+
+  \param fm The field manager of the uniform mesh. The cell signed distance
+  field is added if it does not exist.
+
+  \param geom The facet geometry data. The geometry must have facet bins.
+
+  \param voxels The voxelization of the geometry on the mesh.
+
+  \param volume The local id of the volume.
+*/
+template <class ExecutionSpace, class Mesh>
+void voxelizeSignedDistance(
+    const ExecutionSpace& exec_space, FieldManager<Mesh>& fm,
+    const FacetGeometryData<typename Mesh::memory_space>& geom,
+    const FacetVoxelData<typename Mesh::memory_space>& voxels,
+    const int volume )
+{
+    Kokkos::Profiling::pushRegion(
+        "Picasso::FacetVoxelization::signedDistance" );
+
+    if ( !geom.hasVolumeBins() )
+        throw std::runtime_error( "Voxelization requires facet bins" );
+
+    fm.add( FieldLocation::Cell(), Field::SignedDistance() );
+    auto distance = fm.view( FieldLocation::Cell(), Field::SignedDistance() );
+
+    auto cell_space = fm.mesh()->localGrid()->indexSpace(
+        Cabana::Grid::Ghost(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+    Kokkos::parallel_for(
+        "Picasso::FacetVoxelization::SignedDistance",
+        Cabana::Grid::createExecutionPolicy( cell_space, exec_space ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            float x[3] = {
+                float( voxels.low_corner[0] + ( i + 0.5 ) * voxels.cell_size ),
+                float( voxels.low_corner[1] + ( j + 0.5 ) * voxels.cell_size ),
+                float( voxels.low_corner[2] +
+                       ( k + 0.5 ) * voxels.cell_size ) };
+            float d;
+            int f = FacetGeometryOps::closestVolumeFacet( x, geom, volume, d );
+            if ( f < 0 )
+                d = FLT_MAX;
+            distance( i, j, k, 0 ) =
+                ( volume == voxels.volume_id( i, j, k, 0 ) ) ? -d : d;
+        } );
+
+    Kokkos::Profiling::popRegion();
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Picasso
+
+#endif // end PICASSO_FACETVOXELIZATION_HPP
@@ -187,6 +187,10 @@ template <class T, int D0, int D1, int D2>
 struct Tensor3;
 template <class T, int D0, int D1, int D2, int D3>
 struct Tensor4;
+template <class T, int D>
+struct SymmetricMatrix;
+template <class T, int D>
+struct SymmetricTensor4;
 
 //---------------------------------------------------------------------------//
 // Scalar field.
@@ -254,6 +258,37 @@ struct Quaternion : VectorBase
     using matrix_type = Mat3<U>;
 };
 
+// Symmetric matrix and symmetric tensor4 fields store only their unique
+// components in packed order and are therefore laid out as vectors in
+// particle and grid storage.
+template <class T, int D>
+struct SymmetricMatrix : VectorBase
+{
+    using value_type = T;
+    static constexpr int rank = 1;
+    static constexpr int size = LinearAlgebra::SymmetricMatrix<T, D>::size;
+    static constexpr int dim0 = size;
+    using data_type = value_type[size];
+    using linear_algebra_type = LinearAlgebra::SymmetricMatrixView<T, D>;
+    template <class U>
+    using field_type = SymmetricMatrix<U, D>;
+    template <class U>
+    using matrix_type = LinearAlgebra::Matrix<U, D, D>;
+};
+
+template <class T, int D>
+struct SymmetricTensor4 : VectorBase
+{
+    using value_type = T;
+    static constexpr int rank = 1;
+    static constexpr int size = LinearAlgebra::SymmetricTensor4<T, D>::size;
+    static constexpr int dim0 = size;
+    using data_type = value_type[size];
+    using linear_algebra_type = LinearAlgebra::SymmetricTensor4View<T, D>;
+    template <class U>
+    using field_type = SymmetricTensor4<U, D>;
+};
+
 template <class T>
 struct is_vector_impl : std::is_base_of<VectorBase, T>
 {
@@ -936,6 +971,36 @@ struct LogicalPosition : Vector<double, NumSpaceDim>
     static std::string label() { return "logical_position"; }
 };
 
+// Curvilinear mesh transformation metrics cached at a fixed number of points
+// in each cell. The point count is part of the label so caches built with
+// different quadrature rules can coexist in a field manager.
+template <std::size_t NumSpaceDim, int NumPoint>
+struct Jacobian : Tensor3<double, NumPoint, NumSpaceDim, NumSpaceDim>
+{
+    static std::string label()
+    {
+        return "jacobian_" + std::to_string( NumPoint );
+    }
+};
+
+template <int NumPoint>
+struct JacobianDeterminant : Vector<double, NumPoint>
+{
+    static std::string label()
+    {
+        return "jacobian_determinant_" + std::to_string( NumPoint );
+    }
+};
+
+template <std::size_t NumSpaceDim, int NumPoint>
+struct InverseJacobian : Tensor3<double, NumPoint, NumSpaceDim, NumSpaceDim>
+{
+    static std::string label()
+    {
+        return "inverse_jacobian_" + std::to_string( NumPoint );
+    }
+};
+
 struct SignedDistance : Scalar<double>
 {
     static std::string label() { return "signed_distance"; }
@@ -12,6 +12,7 @@
 #ifndef PICASSO_MARCHINGCUBES_HPP
 #define PICASSO_MARCHINGCUBES_HPP
 
+#include <Picasso_StreamCompaction.hpp>
 #include <Picasso_Types.hpp>
 
 #include <Cabana_Grid.hpp>
@@ -20,8 +21,15 @@
 
 #include <mpi.h>
 
-#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace Picasso
 {
@@ -44,6 +52,43 @@ struct Data
     // Facets. Facets are only created for owned cells.
     Kokkos::View<double* [3][3], MemorySpace> facets;
 
+    // Active cells. Linear indices in the owned cell space of the cells with
+    // at least one facet in increasing order. The facets of the active cells
+    // are stored contiguously in this order.
+    Kokkos::View<int*, MemorySpace> active_cells;
+
+    // Number of active cells.
+    int num_active_cell;
+
+    // Cells whose vertex values changed in the last incremental update.
+    // Linear indices in the owned cell space in increasing order.
+    Kokkos::View<int*, MemorySpace> changed_cells;
+
+    // Number of cells changed in the last incremental update.
+    int num_changed_cell;
+
+    // Nodal signed distance values used to build the current facets. Empty
+    // until the first build.
+    Kokkos::View<double***, MemorySpace> node_distance;
+
+    // Indexed surface vertex id of each grid edge of the owned cells. Only
+    // valid for edges intersected by the surface.
+    Kokkos::View<int*, MemorySpace> edge_vertex_ids;
+
+    // Number of indexed surface vertices.
+    int num_vertex;
+
+    // Indexed surface vertices. One vertex per intersected grid edge of the
+    // owned cells.
+    Kokkos::View<float* [3], MemorySpace> vertices;
+
+    // Indexed surface unit vertex normals. Only computed if requested.
+    Kokkos::View<float* [3], MemorySpace> normals;
+
+    // Indexed surface triangles. Vertex ids of each facet in the same order
+    // as the facet data.
+    Kokkos::View<int* [3], MemorySpace> triangles;
+
     // Lookup table facet counts.
     Kokkos::Array<short, 256> lookup_counts;
 
@@ -68,7 +113,11 @@ struct Data
                 cell_space.extent( 0 ), cell_space.extent( 1 ),
                 cell_space.extent( 2 ) );
         Kokkos::deep_copy( cell_case_ids_and_offsets, 0 );
+
         num_facet = 0;
+        num_active_cell = 0;
+        num_changed_cell = 0;
+        num_vertex = 0;
         facets = Kokkos::View<double* [3][3], typename Mesh::memory_space>(
             Kokkos::ViewAllocateWithoutInitializing( "facets" ), 0 );
 
@@ -1108,6 +1157,216 @@ void computeEdges( const Kokkos::Array<double, 8>& vertex_data,
     edges[11][2] = 1.0;
 }
 
+//---------------------------------------------------------------------------//
+// Convert a linear index in a cell index space to a 3d cell index.
+template <class IndexSpace>
+KOKKOS_INLINE_FUNCTION void cellIndex( const IndexSpace& cell_space,
+                                       const int c, int& i, int& j, int& k )
+{
+    int ek = cell_space.extent( Dim::K );
+    int ej = cell_space.extent( Dim::J );
+    int ejk = ej * ek;
+    i = c / ejk;
+    j = ( c - i * ejk ) / ek;
+    k = c - i * ejk - j * ek;
+    i += cell_space.min( Dim::I );
+    j += cell_space.min( Dim::J );
+    k += cell_space.min( Dim::K );
+}
+
+//---------------------------------------------------------------------------//
+// Check if a value is in the first n entries of a sorted list.
+template <class ListView>
+KOKKOS_INLINE_FUNCTION bool sortedContains( const ListView& list, const int n,
+                                            const int value )
+{
+    int lo = 0;
+    int hi = n;
+    while ( lo < hi )
+    {
+        int mid = lo + ( hi - lo ) / 2;
+        if ( list( mid ) < value )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return ( lo < n && list( lo ) == value );
+}
+
+//---------------------------------------------------------------------------//
+// Fill the facets of a cell starting at the given offset.
+template <class MemorySpace, class SignedDistanceView, class LocalMesh,
+          class FacetView>
+KOKKOS_INLINE_FUNCTION void
+fillCellFacets( const Data<MemorySpace>& data,
+                const SignedDistanceView& distance_view,
+                const LocalMesh& local_mesh, const int i, const int j,
+                const int k, const int case_id, const int face_offset,
+                const FacetView& facets )
+{
+    int num_facet = data.lookup_counts[case_id];
+    if ( num_facet > 0 )
+    {
+        Kokkos::Array<double, 8> vertex_data;
+        vertexData( distance_view, i, j, k, vertex_data );
+        Kokkos::Array<int, 8> vertex_signs;
+        vertexSigns( vertex_data, vertex_signs );
+        Kokkos::Array<double, 6> vertex_locations;
+        vertexLocations( local_mesh, i, j, k, vertex_locations );
+        Kokkos::Array<Kokkos::Array<double, 3>, 12> edges;
+        computeEdges( vertex_data, vertex_signs, edges );
+        int case_offset = data.lookup_offsets[case_id];
+        int edge_id;
+        int face_id;
+        for ( int f = 0; f < num_facet; ++f )
+        {
+            face_id = f + face_offset;
+            for ( int n = 0; n < 3; ++n )
+            {
+                edge_id = data.lookup_nodes[case_offset + f][n];
+                for ( int d = 0; d < 3; ++d )
+                {
+                    facets( face_id, n, d ) =
+                        vertex_locations[d] +
+                        vertex_locations[d + 3] * edges[edge_id][d];
+                }
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Store the nodal signed distance used to build the facets.
+template <class ExecutionSpace, class SignedDistanceView, class MemorySpace>
+void storeNodeDistance( const ExecutionSpace& exec_space,
+                        const SignedDistanceView& distance_view,
+                        Data<MemorySpace>& data )
+{
+    if ( data.node_distance.extent( 0 ) != distance_view.extent( 0 ) ||
+         data.node_distance.extent( 1 ) != distance_view.extent( 1 ) ||
+         data.node_distance.extent( 2 ) != distance_view.extent( 2 ) )
+    {
+        data.node_distance = Kokkos::View<double***, MemorySpace>(
+            Kokkos::ViewAllocateWithoutInitializing( "node_distance" ),
+            distance_view.extent( 0 ), distance_view.extent( 1 ),
+            distance_view.extent( 2 ) );
+    }
+    Kokkos::deep_copy( exec_space, data.node_distance,
+                       Kokkos::subview( distance_view, Kokkos::ALL(),
+                                        Kokkos::ALL(), Kokkos::ALL(), 0 ) );
+}
+
+//---------------------------------------------------------------------------//
+// Get the grid edge of a cell edge. The edge is given by the offset of its
+// lower node from the lower node of the cell and its direction. Cell edges
+// are ordered as in computeEdges().
+KOKKOS_INLINE_FUNCTION
+void cellEdge( const int e, int& di, int& dj, int& dk, int& dir )
+{
+    const int edge_data[12][4] = {
+        // z edges
+        { 0, 0, 0, 2 },
+        { 0, 1, 0, 2 },
+        { 1, 0, 0, 2 },
+        { 1, 1, 0, 2 },
+        // y edges
+        { 0, 0, 0, 1 },
+        { 0, 0, 1, 1 },
+        { 1, 0, 0, 1 },
+        { 1, 0, 1, 1 },
+        // x edges
+        { 0, 0, 0, 0 },
+        { 0, 0, 1, 0 },
+        { 0, 1, 0, 0 },
+        { 0, 1, 1, 0 } };
+    di = edge_data[e][0];
+    dj = edge_data[e][1];
+    dk = edge_data[e][2];
+    dir = edge_data[e][3];
+}
+
+//---------------------------------------------------------------------------//
+// Compute the signed distance gradient at a node with central differences.
+template <class LocalMesh, class SignedDistanceView>
+KOKKOS_INLINE_FUNCTION void
+nodeGradient( const LocalMesh& local_mesh,
+              const SignedDistanceView& distance_view, const int i,
+              const int j, const int k, double gradient[3] )
+{
+    for ( int d = 0; d < 3; ++d )
+    {
+        int lo[3] = { i, j, k };
+        int hi[3] = { i, j, k };
+        --lo[d];
+        ++hi[d];
+        double x_lo[3];
+        double x_hi[3];
+        local_mesh.coordinates( Cabana::Grid::Node{}, lo, x_lo );
+        local_mesh.coordinates( Cabana::Grid::Node{}, hi, x_hi );
+        gradient[d] = ( distance_view( hi[0], hi[1], hi[2], 0 ) -
+                        distance_view( lo[0], lo[1], lo[2], 0 ) ) /
+                      ( x_hi[d] - x_lo[d] );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Compute the case id of every owned cell, compact the active cells, and
+// compute the facet offsets of the active cells.
+template <class ExecutionSpace, class SignedDistanceView, class IndexSpace,
+          class MemorySpace>
+void classifyCells( const ExecutionSpace& exec_space,
+                    const SignedDistanceView& distance_view,
+                    const IndexSpace& cell_space, Data<MemorySpace>& data )
+{
+    // Get the case id and number of facets for each cell.
+    data.num_facet = 0;
+    Cabana::Grid::grid_parallel_reduce(
+        "marching_cubes_facet_count", exec_space, cell_space,
+        KOKKOS_LAMBDA( const int i, const int j, const int k, int& result ) {
+            Kokkos::Array<double, 8> vertex_data;
+            vertexData( distance_view, i, j, k, vertex_data );
+            Kokkos::Array<int, 8> vertex_signs;
+            vertexSigns( vertex_data, vertex_signs );
+            int case_id = caseId( vertex_signs );
+            int num_facet = data.lookup_counts[case_id];
+            data.cell_case_ids_and_offsets( i, j, k, 0 ) = case_id;
+            data.cell_case_ids_and_offsets( i, j, k, 1 ) = num_facet;
+            result += num_facet;
+        },
+        data.num_facet );
+
+    // Compact the cells with facets.
+    if ( data.active_cells.extent( 0 ) < cell_space.size() )
+    {
+        Kokkos::realloc( data.active_cells, cell_space.size() );
+    }
+    data.num_active_cell = compactIndices(
+        "marching_cubes_active_cells", exec_space, 0, cell_space.size(),
+        KOKKOS_LAMBDA( const int c ) {
+            int i, j, k;
+            cellIndex( cell_space, c, i, j, k );
+            return ( data.cell_case_ids_and_offsets( i, j, k, 1 ) > 0 );
+        },
+        data.active_cells );
+
+    // Compute cell offsets into facet data via exclusive scan over the active
+    // cells.
+    Kokkos::parallel_scan(
+        "marching_cubes_facet_offset",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                             data.num_active_cell ),
+        KOKKOS_LAMBDA( const int a, int& update, const bool final_pass ) {
+            int i, j, k;
+            cellIndex( cell_space, data.active_cells( a ), i, j, k );
+            const int value = data.cell_case_ids_and_offsets( i, j, k, 1 );
+            if ( final_pass )
+            {
+                data.cell_case_ids_and_offsets( i, j, k, 1 ) = update;
+            }
+            update += value;
+        } );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Impl
@@ -1147,87 +1406,429 @@ void build( const ExecutionSpace& exec_space, const Mesh& mesh,
     auto cell_space = signed_distance.layout()->localGrid()->indexSpace(
         Cabana::Grid::Own{}, Cabana::Grid::Cell{}, Cabana::Grid::Local{} );
 
-    // Get the case id and number of facets for each cell.
-    data.num_facet = 0;
-    Cabana::Grid::grid_parallel_reduce(
-        "marching_cubes_facet_count", exec_space, cell_space,
-        KOKKOS_LAMBDA( const int i, const int j, const int k, int& result ) {
+    // Classify the cells and compute the facet offsets of the active cells.
+    Impl::classifyCells( exec_space, distance_view, cell_space, data );
+
+    // Allocate facet data if necessary.
+    if ( data.num_facet > static_cast<int>( data.facets.extent( 0 ) ) ||
+         reset_data_memory )
+    {
+        Kokkos::realloc( data.facets, data.num_facet );
+    }
+
+    // Fill facets.
+    auto local_mesh =
+        Cabana::Grid::createLocalMesh<MemorySpace>( *( mesh.localGrid() ) );
+    Kokkos::parallel_for(
+        "marching_cubes_fill_facets",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                             data.num_active_cell ),
+        KOKKOS_LAMBDA( const int a ) {
+            int i, j, k;
+            Impl::cellIndex( cell_space, data.active_cells( a ), i, j, k );
+            Impl::fillCellFacets(
+                data, distance_view, local_mesh, i, j, k,
+                data.cell_case_ids_and_offsets( i, j, k, 0 ),
+                data.cell_case_ids_and_offsets( i, j, k, 1 ), data.facets );
+        } );
+
+    // Store the distance used to build the facets for incremental updates.
+    Impl::storeNodeDistance( exec_space, distance_view, data );
+    data.num_changed_cell = 0;
+
+    Kokkos::Profiling::popRegion();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Incrementally update the marching cubes triangulation over the
+  owned cells. Only cells with a vertex value that has changed since the last
+  build or update are reclassified and refilled. If no changed cell has a
+  different number of facets the facets of the changed cells are updated in
+  place. Otherwise the facet offsets are recomputed over the active cells and
+  the facets of unchanged cells are copied to their new location. If there
+  is no previous build a full build is performed. This requires the signed
+  distance values to have been gathered.
+  \param exec_space The execution space to use for parallel operations.
+  \param signed_distance The signed distance array from which to build the
+  facets. This array must be on the nodes as this is a cell-based operation.
+  \param data The facet data from a previous build or update.
+*/
+template <class ExecutionSpace, class Mesh, class SignedDistanceArray,
+          class MemorySpace>
+void update( const ExecutionSpace& exec_space, const Mesh& mesh,
+             const SignedDistanceArray& signed_distance,
+             Data<MemorySpace>& data )
+{
+    static_assert( std::is_same<typename SignedDistanceArray::entity_type,
+                                Cabana::Grid::Node>::value,
+                   "Marching cubes facets may only be constructed from nodal "
+                   "distance fields" );
+
+    // Get a view of the signed distance data.
+    auto distance_view = signed_distance.view();
+
+    // Do a full build if there is no history for this distance field.
+    if ( data.node_distance.extent( 0 ) != distance_view.extent( 0 ) ||
+         data.node_distance.extent( 1 ) != distance_view.extent( 1 ) ||
+         data.node_distance.extent( 2 ) != distance_view.extent( 2 ) )
+    {
+        build( exec_space, mesh, signed_distance, data );
+        return;
+    }
+
+    Kokkos::Profiling::pushRegion( "Picasso::MarchingCubes::update" );
+
+    // Get the cell space we are working on.
+    auto cell_space = signed_distance.layout()->localGrid()->indexSpace(
+        Cabana::Grid::Own{}, Cabana::Grid::Cell{}, Cabana::Grid::Local{} );
+
+    // Find the cells with changed vertex values.
+    if ( data.changed_cells.extent( 0 ) < cell_space.size() )
+    {
+        Kokkos::realloc( data.changed_cells, cell_space.size() );
+    }
+    auto node_distance = data.node_distance;
+    data.num_changed_cell = compactIndices(
+        "marching_cubes_changed_cells", exec_space, 0, cell_space.size(),
+        KOKKOS_LAMBDA( const int c ) {
+            int i, j, k;
+            Impl::cellIndex( cell_space, c, i, j, k );
+            for ( int di = 0; di < 2; ++di )
+                for ( int dj = 0; dj < 2; ++dj )
+                    for ( int dk = 0; dk < 2; ++dk )
+                        if ( distance_view( i + di, j + dj, k + dk, 0 ) !=
+                             node_distance( i + di, j + dj, k + dk ) )
+                            return true;
+            return false;
+        },
+        data.changed_cells );
+
+    // Nothing to do if no cells changed.
+    int num_changed = data.num_changed_cell;
+    if ( 0 == num_changed )
+    {
+        Kokkos::Profiling::popRegion();
+        return;
+    }
+
+    // Reclassify the changed cells. Count the cells whose number of facets
+    // changed. Offsets are left unchanged.
+    int num_count_change = 0;
+    Kokkos::parallel_reduce(
+        "marching_cubes_reclassify",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_changed ),
+        KOKKOS_LAMBDA( const int n, int& result ) {
+            int i, j, k;
+            Impl::cellIndex( cell_space, data.changed_cells( n ), i, j, k );
             Kokkos::Array<double, 8> vertex_data;
             Impl::vertexData( distance_view, i, j, k, vertex_data );
             Kokkos::Array<int, 8> vertex_signs;
             Impl::vertexSigns( vertex_data, vertex_signs );
             int case_id = Impl::caseId( vertex_signs );
-            int num_facet = data.lookup_counts[case_id];
+            int old_case_id = data.cell_case_ids_and_offsets( i, j, k, 0 );
             data.cell_case_ids_and_offsets( i, j, k, 0 ) = case_id;
-            data.cell_case_ids_and_offsets( i, j, k, 1 ) = num_facet;
-            result += num_facet;
+            if ( data.lookup_counts[case_id] !=
+                 data.lookup_counts[old_case_id] )
+                ++result;
         },
-        data.num_facet );
+        num_count_change );
 
-    // Allocate facet data if necessary.
-    if ( data.num_facet > static_cast<int>( data.facets.extent( 0 ) ) ||
-         reset_data_memory )
+    auto local_mesh =
+        Cabana::Grid::createLocalMesh<MemorySpace>( *( mesh.localGrid() ) );
+
+    // If the number of facets in every cell is unchanged then the active
+    // cells and offsets are unchanged and we only need to refill the changed
+    // cells.
+    if ( 0 == num_count_change )
     {
-        Kokkos::realloc( data.facets, data.num_facet );
+        Kokkos::parallel_for(
+            "marching_cubes_refill_facets",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_changed ),
+            KOKKOS_LAMBDA( const int n ) {
+                int i, j, k;
+                Impl::cellIndex( cell_space, data.changed_cells( n ), i, j,
+                                 k );
+                Impl::fillCellFacets(
+                    data, distance_view, local_mesh, i, j, k,
+                    data.cell_case_ids_and_offsets( i, j, k, 0 ),
+                    data.cell_case_ids_and_offsets( i, j, k, 1 ),
+                    data.facets );
+            } );
     }
 
-    // Compute cell offsets into facet data via exclusive scan.
-    Kokkos::parallel_scan(
-        "marching_cubes_facet_offset",
-        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, cell_space.size() ),
-        KOKKOS_LAMBDA( const int c, int& update, const bool final_pass ) {
-            int ek = cell_space.extent( Dim::K );
-            int ej = cell_space.extent( Dim::J );
-            int ejk = ej * ek;
-            int i = c / ejk;
-            int j = ( c - i * ejk ) / ek;
-            int k = c - i * ejk - j * ek;
-            i += cell_space.min( Dim::I );
-            j += cell_space.min( Dim::J );
-            k += cell_space.min( Dim::K );
-            const int value = data.cell_case_ids_and_offsets( i, j, k, 1 );
-            if ( final_pass )
-            {
-                data.cell_case_ids_and_offsets( i, j, k, 1 ) = update;
-            }
-            update += value;
+    // Otherwise rebuild the active cell list and offsets.
+    else
+    {
+        // Compact the cells with facets.
+        data.num_active_cell = compactIndices(
+            "marching_cubes_active_cells", exec_space, 0, cell_space.size(),
+            KOKKOS_LAMBDA( const int c ) {
+                int i, j, k;
+                Impl::cellIndex( cell_space, c, i, j, k );
+                return ( data.lookup_counts[data.cell_case_ids_and_offsets(
+                             i, j, k, 0 )] > 0 );
+            },
+            data.active_cells );
+
+        // Compute the new offsets of the active cells.
+        Kokkos::View<int*, MemorySpace> new_offsets(
+            Kokkos::ViewAllocateWithoutInitializing( "new_offsets" ),
+            data.num_active_cell );
+        int num_facet = 0;
+        Kokkos::parallel_scan(
+            "marching_cubes_facet_offset",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 data.num_active_cell ),
+            KOKKOS_LAMBDA( const int a, int& update, const bool final_pass ) {
+                int i, j, k;
+                Impl::cellIndex( cell_space, data.active_cells( a ), i, j, k );
+                const int value =
+                    data.lookup_counts[data.cell_case_ids_and_offsets( i, j, k,
+                                                                       0 )];
+                if ( final_pass )
+                {
+                    new_offsets( a ) = update;
+                }
+                update += value;
+            },
+            num_facet );
+        data.num_facet = num_facet;
+
+        // Copy the facets of unchanged cells to their new location and fill
+        // the changed cells.
+        Kokkos::View<double* [3][3], MemorySpace> new_facets(
+            Kokkos::ViewAllocateWithoutInitializing( "facets" ),
+            std::max( static_cast<int>( data.facets.extent( 0 ) ),
+                      num_facet ) );
+        Kokkos::parallel_for(
+            "marching_cubes_move_facets",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 data.num_active_cell ),
+            KOKKOS_LAMBDA( const int a ) {
+                int c = data.active_cells( a );
+                int i, j, k;
+                Impl::cellIndex( cell_space, c, i, j, k );
+                int case_id = data.cell_case_ids_and_offsets( i, j, k, 0 );
+                int old_offset = data.cell_case_ids_and_offsets( i, j, k, 1 );
+                int new_offset = new_offsets( a );
+                if ( Impl::sortedContains( data.changed_cells, num_changed,
+                                           c ) )
+                {
+                    Impl::fillCellFacets( data, distance_view, local_mesh, i,
+                                          j, k, case_id, new_offset,
+                                          new_facets );
+                }
+                else
+                {
+                    int cell_num_facet = data.lookup_counts[case_id];
+                    for ( int f = 0; f < cell_num_facet; ++f )
+                        for ( int n = 0; n < 3; ++n )
+                            for ( int d = 0; d < 3; ++d )
+                                new_facets( new_offset + f, n, d ) =
+                                    data.facets( old_offset + f, n, d );
+                }
+                data.cell_case_ids_and_offsets( i, j, k, 1 ) = new_offset;
+            } );
+        data.facets = new_facets;
+    }
+
+    // Store the distance of the changed cells.
+    Kokkos::parallel_for(
+        "marching_cubes_store_distance",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_changed ),
+        KOKKOS_LAMBDA( const int n ) {
+            int i, j, k;
+            Impl::cellIndex( cell_space, data.changed_cells( n ), i, j, k );
+            for ( int di = 0; di < 2; ++di )
+                for ( int dj = 0; dj < 2; ++dj )
+                    for ( int dk = 0; dk < 2; ++dk )
+                        node_distance( i + di, j + dj, k + dk ) =
+                            distance_view( i + di, j + dj, k + dk, 0 );
         } );
 
-    // Fill facets.
+    Kokkos::Profiling::popRegion();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Build an indexed marching cubes triangulation over the owned cells.
+  Every grid edge of the owned cells is given a unique id and a single float
+  vertex is created for each edge intersected by the surface such that
+  facets sharing an edge share a vertex. Vertices on the boundary of the
+  owned cells are not shared between ranks. Triangles are stored in the same
+  order as the facets computed by build() but the facet data itself is not
+  filled. This requires the signed distance values to have been gathered.
+  \param exec_space The execution space to use for parallel operations.
+  \param signed_distance The signed distance array from which to build the
+  surface. This array must be on the nodes as this is a cell-based operation.
+  \param data The resulting vertex and triangle data.
+  \param compute_normals If true, compute unit vertex normals from the
+  signed distance gradient. This requires a halo of at least one node.
+*/
+template <class ExecutionSpace, class Mesh, class SignedDistanceArray,
+          class MemorySpace>
+void buildIndexed( const ExecutionSpace& exec_space, const Mesh& mesh,
+                   const SignedDistanceArray& signed_distance,
+                   Data<MemorySpace>& data, const bool compute_normals = false )
+{
+    Kokkos::Profiling::pushRegion( "Picasso::MarchingCubes::buildIndexed" );
+
+    static_assert( std::is_same<typename SignedDistanceArray::entity_type,
+                                Cabana::Grid::Node>::value,
+                   "Marching cubes facets may only be constructed from nodal "
+                   "distance fields" );
+
+    // Get a view of the signed distance data.
+    auto distance_view = signed_distance.view();
+
+    // Get the cell space we are working on.
+    auto cell_space = signed_distance.layout()->localGrid()->indexSpace(
+        Cabana::Grid::Own{}, Cabana::Grid::Cell{}, Cabana::Grid::Local{} );
+
+    // Classify the cells and compute the facet offsets of the active cells.
+    Impl::classifyCells( exec_space, distance_view, cell_space, data );
+
+    // The facet data is not filled so it can't be incrementally updated.
+    data.node_distance = Kokkos::View<double***, MemorySpace>();
+
+    // Grid edges are indexed by the lower node of the edge in the block of
+    // nodes of the owned cells and the edge direction.
+    int nx = cell_space.extent( Dim::I ) + 1;
+    int ny = cell_space.extent( Dim::J ) + 1;
+    int nz = cell_space.extent( Dim::K ) + 1;
+    int i0 = cell_space.min( Dim::I );
+    int j0 = cell_space.min( Dim::J );
+    int k0 = cell_space.min( Dim::K );
+    int num_edge = 3 * nx * ny * nz;
+    if ( static_cast<int>( data.edge_vertex_ids.extent( 0 ) ) < num_edge )
+    {
+        Kokkos::realloc( data.edge_vertex_ids, num_edge );
+    }
+
+    // Select the edges of the owned cells intersected by the surface.
+    auto intersected = KOKKOS_LAMBDA( const int e )
+    {
+        int dir = e % 3;
+        int n = e / 3;
+        int node[3] = { n / ( ny * nz ), ( n / nz ) % ny, n % nz };
+        int ext[3] = { nx, ny, nz };
+        if ( node[dir] + 1 >= ext[dir] )
+            return false;
+        node[0] += i0;
+        node[1] += j0;
+        node[2] += k0;
+        double phi_0 = distance_view( node[0], node[1], node[2], 0 );
+        ++node[dir];
+        double phi_1 = distance_view( node[0], node[1], node[2], 0 );
+        return ( ( phi_0 <= 0.0 ) != ( phi_1 <= 0.0 ) );
+    };
+
+    // Count the vertices and allocate.
+    int num_vertex = 0;
+    Kokkos::parallel_reduce(
+        "marching_cubes_vertex_count",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_edge ),
+        KOKKOS_LAMBDA( const int e, int& result ) {
+            if ( intersected( e ) )
+                ++result;
+        },
+        num_vertex );
+    data.num_vertex = num_vertex;
+    if ( num_vertex > static_cast<int>( data.vertices.extent( 0 ) ) )
+    {
+        Kokkos::realloc( data.vertices, num_vertex );
+    }
+    if ( compute_normals &&
+         num_vertex > static_cast<int>( data.normals.extent( 0 ) ) )
+    {
+        Kokkos::realloc( data.normals, num_vertex );
+    }
+    if ( data.num_facet > static_cast<int>( data.triangles.extent( 0 ) ) )
+    {
+        Kokkos::realloc( data.triangles, data.num_facet );
+    }
+
+    // Create a vertex on each intersected edge.
     auto local_mesh =
         Cabana::Grid::createLocalMesh<MemorySpace>( *( mesh.localGrid() ) );
-    Cabana::Grid::grid_parallel_for(
-        "marching_cubes_fill_facets", exec_space, cell_space,
-        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+    auto edge_vertex_ids = data.edge_vertex_ids;
+    auto vertices = data.vertices;
+    auto normals = data.normals;
+    streamCompact(
+        "marching_cubes_fill_vertices", exec_space, 0, num_edge, intersected,
+        KOKKOS_LAMBDA( const int e, const int v ) {
+            edge_vertex_ids( e ) = v;
+
+            // Get the edge nodes.
+            int dir = e % 3;
+            int n = e / 3;
+            int node_0[3] = { n / ( ny * nz ) + i0, ( n / nz ) % ny + j0,
+                              n % nz + k0 };
+            int node_1[3] = { node_0[0], node_0[1], node_0[2] };
+            ++node_1[dir];
+
+            // Interpolate the location of the zero crossing.
+            double phi_0 =
+                distance_view( node_0[0], node_0[1], node_0[2], 0 );
+            double phi_1 =
+                distance_view( node_1[0], node_1[1], node_1[2], 0 );
+            double w = phi_0 / ( phi_0 - phi_1 );
+            double x_0[3];
+            double x_1[3];
+            local_mesh.coordinates( Cabana::Grid::Node{}, node_0, x_0 );
+            local_mesh.coordinates( Cabana::Grid::Node{}, node_1, x_1 );
+            for ( int d = 0; d < 3; ++d )
+                vertices( v, d ) =
+                    static_cast<float>( x_0[d] + w * ( x_1[d] - x_0[d] ) );
+
+            // Interpolate the distance gradient.
+            if ( compute_normals )
+            {
+                double g_0[3];
+                double g_1[3];
+                Impl::nodeGradient( local_mesh, distance_view, node_0[0],
+                                    node_0[1], node_0[2], g_0 );
+                Impl::nodeGradient( local_mesh, distance_view, node_1[0],
+                                    node_1[1], node_1[2], g_1 );
+                double g[3];
+                double g_norm = 0.0;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    g[d] = g_0[d] + w * ( g_1[d] - g_0[d] );
+                    g_norm += g[d] * g[d];
+                }
+                g_norm = ( g_norm > 0.0 ) ? 1.0 / sqrt( g_norm ) : 0.0;
+                for ( int d = 0; d < 3; ++d )
+                    normals( v, d ) = static_cast<float>( g[d] * g_norm );
+            }
+        } );
+
+    // Create the triangles from the vertices of their edges.
+    auto triangles = data.triangles;
+    Kokkos::parallel_for(
+        "marching_cubes_fill_triangles",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                             data.num_active_cell ),
+        KOKKOS_LAMBDA( const int a ) {
+            int i, j, k;
+            Impl::cellIndex( cell_space, data.active_cells( a ), i, j, k );
             int case_id = data.cell_case_ids_and_offsets( i, j, k, 0 );
             int face_offset = data.cell_case_ids_and_offsets( i, j, k, 1 );
             int num_facet = data.lookup_counts[case_id];
-            if ( num_facet > 0 )
+            int case_offset = data.lookup_offsets[case_id];
+            int di, dj, dk, dir;
+            for ( int f = 0; f < num_facet; ++f )
             {
-                Kokkos::Array<double, 8> vertex_data;
-                Impl::vertexData( distance_view, i, j, k, vertex_data );
-                Kokkos::Array<int, 8> vertex_signs;
-                Impl::vertexSigns( vertex_data, vertex_signs );
-                Kokkos::Array<double, 6> vertex_locations;
-                Impl::vertexLocations( local_mesh, i, j, k, vertex_locations );
-                Kokkos::Array<Kokkos::Array<double, 3>, 12> edges;
-                Impl::computeEdges( vertex_data, vertex_signs, edges );
-                int case_offset = data.lookup_offsets[case_id];
-                int edge_id;
-                int face_id;
-                for ( int f = 0; f < num_facet; ++f )
+                for ( int n = 0; n < 3; ++n )
                 {
-                    face_id = f + face_offset;
-                    for ( int n = 0; n < 3; ++n )
-                    {
-                        edge_id = data.lookup_nodes[case_offset + f][n];
-                        for ( int d = 0; d < 3; ++d )
-                        {
-                            data.facets( face_id, n, d ) =
-                                vertex_locations[d] +
-                                vertex_locations[d + 3] * edges[edge_id][d];
-                        }
-                    }
+                    Impl::cellEdge( data.lookup_nodes[case_offset + f][n], di,
+                                    dj, dk, dir );
+                    int e = ( ( ( i - i0 + di ) * ny + ( j - j0 + dj ) ) * nz +
+                              ( k - k0 + dk ) ) *
+                                3 +
+                            dir;
+                    triangles( face_offset + f, n ) = edge_vertex_ids( e );
                 }
             }
         } );
@@ -1236,57 +1837,209 @@ void build( const ExecutionSpace& exec_space, const Mesh& mesh,
 }
 
 //---------------------------------------------------------------------------//
-// Write facet data to an STL ASCII file for visualization.
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Write a buffer from each rank to a file in rank order with collective
+// writes. Each rank writes at the exclusive scan of the buffer sizes. Buffers
+// are written in chunks so the MPI count fits in an int and every rank makes
+// the same number of collective calls. Any existing file is truncated.
+inline void writeParallel( MPI_Comm comm, const std::string& filename,
+                           const std::vector<char>& buffer )
+{
+    // Compute the file offset of this rank.
+    unsigned long long local_size = buffer.size();
+    unsigned long long offset = 0;
+    MPI_Exscan( &local_size, &offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+                comm );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    if ( 0 == comm_rank )
+        offset = 0;
+
+    // Compute the number of chunks written by the largest rank.
+    const unsigned long long chunk_size = 1ULL << 30;
+    unsigned long long num_chunk = ( local_size + chunk_size - 1 ) / chunk_size;
+    MPI_Allreduce( MPI_IN_PLACE, &num_chunk, 1, MPI_UNSIGNED_LONG_LONG,
+                   MPI_MAX, comm );
+
+    // Open and truncate the file.
+    MPI_File file;
+    if ( MPI_SUCCESS != MPI_File_open( comm, filename.c_str(),
+                                       MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                       MPI_INFO_NULL, &file ) )
+        throw std::runtime_error( "Unable to open file " + filename );
+    if ( MPI_SUCCESS != MPI_File_set_size( file, 0 ) )
+    {
+        MPI_File_close( &file );
+        throw std::runtime_error( "Unable to truncate file " + filename );
+    }
+
+    // Write. Ranks with less data write empty chunks.
+    int error = 0;
+    for ( unsigned long long c = 0; c < num_chunk; ++c )
+    {
+        unsigned long long begin = std::min( c * chunk_size, local_size );
+        unsigned long long count = std::min( chunk_size, local_size - begin );
+        MPI_Status status;
+        if ( MPI_SUCCESS !=
+             MPI_File_write_at_all(
+                 file, static_cast<MPI_Offset>( offset + begin ),
+                 buffer.data() + begin, static_cast<int>( count ), MPI_BYTE,
+                 &status ) )
+            error = 1;
+    }
+    MPI_File_close( &file );
+
+    // Fail on all ranks if any rank failed.
+    MPI_Allreduce( MPI_IN_PLACE, &error, 1, MPI_INT, MPI_MAX, comm );
+    if ( error )
+        throw std::runtime_error( "Unable to write file " + filename );
+}
+
+//---------------------------------------------------------------------------//
+// Compute the unit normal of a facet.
+template <class FacetView>
+void facetNormal( const FacetView& facets, const int f, float normal[3] )
+{
+    double ab[3];
+    double ac[3];
+    for ( int d = 0; d < 3; ++d )
+    {
+        ab[d] = facets( f, 1, d ) - facets( f, 0, d );
+        ac[d] = facets( f, 2, d ) - facets( f, 0, d );
+    }
+    double n[3] = { ab[1] * ac[2] - ab[2] * ac[1],
+                    ab[2] * ac[0] - ab[0] * ac[2],
+                    ab[0] * ac[1] - ab[1] * ac[0] };
+    double n_norm = std::sqrt( n[0] * n[0] + n[1] * n[1] + n[2] * n[2] );
+    for ( int d = 0; d < 3; ++d )
+        normal[d] =
+            ( n_norm > 0.0 ) ? static_cast<float>( n[d] / n_norm ) : 0.0f;
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+// Write facet data to an STL ASCII file for visualization. Each rank formats
+// its facets locally and all ranks write in rank order with a single
+// collective MPI-IO write.
 template <class MemorySpace>
 void writeDataToSTL( const Data<MemorySpace>& data, MPI_Comm comm,
                      const std::string& stl_filename )
 {
+    Kokkos::Profiling::pushRegion( "Picasso::MarchingCubes::writeDataToSTL" );
+
     // Move facets to the host.
     auto facets =
         Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{}, data.facets );
 
-    // Create the STL header.
-    std::ofstream file( stl_filename );
-    if ( !file.is_open() )
-        throw std::runtime_error( "Unable to open STL ASCII file" );
-
-    // Make a single surface.
-    file << "solid Surface 1" << std::endl;
-
-    // Add each rank's facets to the file. Do a simple parallel file I/O for
-    // now.
     int comm_rank;
     MPI_Comm_rank( comm, &comm_rank );
     int comm_size;
     MPI_Comm_size( comm, &comm_size );
-    for ( int r = 0; r < comm_size; ++r )
+
+    // Format the local facets.
+    std::ostringstream stream;
+
+    // Make a single surface.
+    if ( 0 == comm_rank )
+        stream << "solid Surface 1\n";
+
+    // Add each of the facets.
+    for ( int f = 0; f < data.num_facet; ++f )
     {
-        if ( r == comm_rank )
+        float normal[3];
+        Impl::facetNormal( facets, f, normal );
+        stream << "  facet normal " << normal[0] << " " << normal[1] << " "
+               << normal[2] << "\n";
+        stream << "    outer loop\n";
+        for ( int n = 0; n < 3; ++n )
         {
-            int num_facet = facets.extent( 0 );
-            for ( int f = 0; f < num_facet; ++f )
-            {
-                file << "  facet normal 0.000000e+00 0.000000e+00 0.000000e+00"
-                     << std::endl;
-                file << "    outer loop" << std::endl;
-                for ( int n = 0; n < 3; ++n )
-                {
-                    file << "      vertex " << facets( f, n, 0 ) << " "
-                         << facets( f, n, 1 ) << " " << facets( f, n, 2 )
-                         << std::endl;
-                }
-                file << "    endloop" << std::endl;
-                file << "  endfacet" << std::endl;
-            }
+            stream << "      vertex " << facets( f, n, 0 ) << " "
+                   << facets( f, n, 1 ) << " " << facets( f, n, 2 ) << "\n";
         }
-        MPI_Barrier( comm );
+        stream << "    endloop\n";
+        stream << "  endfacet\n";
     }
 
     // Finish the surface.
-    file << "endsolid Surface 1" << std::endl;
+    if ( comm_size - 1 == comm_rank )
+        stream << "endsolid Surface 1\n";
+
+    // Write the file.
+    auto text = stream.str();
+    Impl::writeParallel( comm, stl_filename,
+                         std::vector<char>( text.begin(), text.end() ) );
+
+    Kokkos::Profiling::popRegion();
+}
+
+//---------------------------------------------------------------------------//
+// Write facet data to a binary STL file for visualization. All ranks write
+// their facets in rank order with a single collective MPI-IO write. Values
+// are written in the byte order of the host which is expected to be little
+// endian by the STL format.
+template <class MemorySpace>
+void writeDataToBinarySTL( const Data<MemorySpace>& data, MPI_Comm comm,
+                           const std::string& stl_filename )
+{
+    Kokkos::Profiling::pushRegion(
+        "Picasso::MarchingCubes::writeDataToBinarySTL" );
+
+    // Move facets to the host.
+    auto facets =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{}, data.facets );
+
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    // Get the total number of facets.
+    unsigned long long local_num_facet = data.num_facet;
+    unsigned long long global_num_facet = 0;
+    MPI_Allreduce( &local_num_facet, &global_num_facet, 1,
+                   MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm );
+    if ( global_num_facet > std::numeric_limits<std::uint32_t>::max() )
+        throw std::runtime_error( "Too many facets for binary STL file" );
 
-    // Close the file.
-    file.close();
+    // Each facet is a normal and 3 vertices followed by an attribute count.
+    const std::size_t header_size = 84;
+    const std::size_t facet_size = 12 * sizeof( float ) + 2;
+    std::size_t buffer_size = data.num_facet * facet_size;
+    if ( 0 == comm_rank )
+        buffer_size += header_size;
+    std::vector<char> buffer( buffer_size, 0 );
+    char* pos = buffer.data();
+
+    // Write the header and facet count on the first rank.
+    if ( 0 == comm_rank )
+    {
+        std::string header = "Picasso marching cubes surface";
+        std::copy( header.begin(), header.end(), pos );
+        pos += 80;
+        std::uint32_t count = global_num_facet;
+        std::memcpy( pos, &count, sizeof( count ) );
+        pos += sizeof( count );
+    }
+
+    // Add each of the facets.
+    for ( int f = 0; f < data.num_facet; ++f )
+    {
+        float values[12];
+        Impl::facetNormal( facets, f, values );
+        for ( int n = 0; n < 3; ++n )
+            for ( int d = 0; d < 3; ++d )
+                values[3 + 3 * n + d] = static_cast<float>( facets( f, n, d ) );
+        std::memcpy( pos, values, sizeof( values ) );
+        pos += facet_size;
+    }
+
+    // Write the file.
+    Impl::writeParallel( comm, stl_filename, buffer );
+
+    Kokkos::Profiling::popRegion();
 }
 
 //---------------------------------------------------------------------------//
@@ -13,6 +13,7 @@
 #define PICASSO_PARTICLEINIT_HPP
 
 #include <Picasso_BatchedLinearAlgebra.hpp>
+#include <Picasso_StreamCompaction.hpp>
 #include <Picasso_Types.hpp>
 #include <Picasso_UniformMesh.hpp>
 
@@ -22,6 +23,13 @@
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Random.hpp>
 
+#include <mpi.h>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
 namespace Picasso
 {
 //---------------------------------------------------------------------------//
@@ -32,6 +40,12 @@ struct InitUniform
 struct InitRandom
 {
 };
+struct InitStratified
+{
+};
+struct InitHalton
+{
+};
 
 //---------------------------------------------------------------------------//
 // Filter out empty particles that weren't created.
@@ -54,42 +68,610 @@ void filterEmpties( const ExecutionSpace& exec_space,
         std::min( num_particles - previous_num_particles - local_num_create,
                   local_num_create ) );
 
-    Kokkos::parallel_scan(
-        "Picasso::ParticleInit::FindEmpty",
-        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, local_num_create ),
-        KOKKOS_LAMBDA( const int i, int& count, const bool final_pass ) {
-            if ( !particle_created( i ) )
-            {
-                if ( final_pass )
-                {
-                    indices( count ) = i + previous_num_particles;
-                }
-                ++count;
-            }
+    streamCompact(
+        "Picasso::ParticleInit::FindEmpty", exec_space, 0, local_num_create,
+        KOKKOS_LAMBDA( const int i ) { return !particle_created( i ); },
+        KOKKOS_LAMBDA( const int i, const int count ) {
+            indices( count ) = i + previous_num_particles;
         } );
 
     // Compact the list so the it only has real particles.
     int new_num_particles = previous_num_particles + local_num_create;
-    Kokkos::parallel_scan(
-        "Picasso::ParticleInit::RemoveEmpty",
-        Kokkos::RangePolicy<ExecutionSpace>( exec_space, new_num_particles,
-                                             num_particles ),
-        KOKKOS_LAMBDA( const int i, int& count, const bool final_pass ) {
-            if ( particle_created( i - previous_num_particles ) )
+    streamCompact(
+        "Picasso::ParticleInit::RemoveEmpty", exec_space, new_num_particles,
+        num_particles,
+        KOKKOS_LAMBDA( const int i ) {
+            return particle_created( i - previous_num_particles );
+        },
+        KOKKOS_LAMBDA( const int i, const int count ) {
+            particles.setTuple( indices( count ), particles.getTuple( i ) );
+        } );
+    particles.resize( new_num_particles );
+    if ( shrink_to_fit )
+        particles.shrinkToFit();
+}
+
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Candidate particle samplers. A sampler calls a functor with the index and
+// logical position of each candidate particle in a cell. Candidates are
+// always generated in the same order so multiple passes over a cell see the
+// same candidates.
+//---------------------------------------------------------------------------//
+// Uniform lattice of candidates in each cell.
+struct UniformCellSampler
+{
+    int particles_per_cell_dim;
+
+    KOKKOS_INLINE_FUNCTION
+    int particlesPerCell() const
+    {
+        return particles_per_cell_dim * particles_per_cell_dim *
+               particles_per_cell_dim;
+    }
+
+    template <class Functor>
+    KOKKOS_INLINE_FUNCTION void operator()( const int, const double low[3],
+                                            const double high[3],
+                                            const Functor& functor ) const
+    {
+        // Compute the particle spacing in each dimension.
+        double spacing[3];
+        for ( int d = 0; d < 3; ++d )
+            spacing[d] = ( high[d] - low[d] ) / particles_per_cell_dim;
+
+        double px[3];
+        for ( int ip = 0; ip < particles_per_cell_dim; ++ip )
+            for ( int jp = 0; jp < particles_per_cell_dim; ++jp )
+                for ( int kp = 0; kp < particles_per_cell_dim; ++kp )
+                {
+                    // Set the particle position in logical coordinates.
+                    px[Dim::I] = 0.5 * spacing[Dim::I] + ip * spacing[Dim::I] +
+                                 low[Dim::I];
+                    px[Dim::J] = 0.5 * spacing[Dim::J] + jp * spacing[Dim::J] +
+                                 low[Dim::J];
+                    px[Dim::K] = 0.5 * spacing[Dim::K] + kp * spacing[Dim::K] +
+                                 low[Dim::K];
+                    functor( ip + particles_per_cell_dim *
+                                      ( jp + particles_per_cell_dim * kp ),
+                             px );
+                }
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Random candidates in each cell.
+template <class ExecutionSpace>
+struct RandomCellSampler
+{
+    Kokkos::Random_XorShift64_Pool<ExecutionSpace> pool;
+    int particles_per_cell;
+
+    KOKKOS_INLINE_FUNCTION
+    int particlesPerCell() const { return particles_per_cell; }
+
+    template <class Functor>
+    KOKKOS_INLINE_FUNCTION void operator()( const int cell_id,
+                                            const double low[3],
+                                            const double high[3],
+                                            const Functor& functor ) const
+    {
+        // Random number generator. The state is not returned to the pool so
+        // every pass over the cell draws the same numbers.
+        auto rand = pool.get_state( cell_id );
+
+        double px[3];
+        for ( int p = 0; p < particles_per_cell; ++p )
+        {
+            // Select a random point in the cell for the particle location.
+            // These coordinates are logical.
+            for ( int d = 0; d < 3; ++d )
             {
-                if ( final_pass )
+                px[d] = Kokkos::rand<decltype( rand ), double>::draw(
+                    rand, low[d], high[d] );
+            }
+            functor( p, px );
+        }
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Global cell ids and counter-based random numbers. Samples drawn with these
+// depend only on the global cell and the sample index so they are the same
+// for any decomposition of the mesh.
+//---------------------------------------------------------------------------//
+// Map owned local cell ids to global cell ids.
+struct GlobalCellIndexer
+{
+    Kokkos::Array<long, 3> global_offset;
+    Kokkos::Array<long, 3> owned_extent;
+    Kokkos::Array<long, 3> global_extent;
+
+    KOKKOS_INLINE_FUNCTION
+    uint64_t operator()( const int cell_id ) const
+    {
+        long i = global_offset[Dim::I] + cell_id % owned_extent[Dim::I];
+        long j = global_offset[Dim::J] +
+                 ( cell_id / owned_extent[Dim::I] ) % owned_extent[Dim::J];
+        long k = global_offset[Dim::K] +
+                 cell_id / ( owned_extent[Dim::I] * owned_extent[Dim::J] );
+        return i + global_extent[Dim::I] * ( j + global_extent[Dim::J] * k );
+    }
+};
+
+// Mix the bits of a 64-bit counter (splitmix64 finalizer).
+KOKKOS_INLINE_FUNCTION
+uint64_t hashCounter( uint64_t x )
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = ( x ^ ( x >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    x = ( x ^ ( x >> 27 ) ) * 0x94d049bb133111ebULL;
+    return x ^ ( x >> 31 );
+}
+
+// Uniform random number in [0,1) for a sample of a global cell.
+KOKKOS_INLINE_FUNCTION
+double cellUniform( const uint64_t global_cell_id, const uint64_t sample )
+{
+    uint64_t h = hashCounter( hashCounter( global_cell_id ) ^ sample );
+    return ( h >> 11 ) * ( 1.0 / 9007199254740992.0 );
+}
+
+// Radical inverse of an index in the given base.
+KOKKOS_INLINE_FUNCTION
+double radicalInverse( uint64_t index, const int base )
+{
+    double inv_base = 1.0 / base;
+    double factor = inv_base;
+    double result = 0.0;
+    while ( index > 0 )
+    {
+        result += ( index % base ) * factor;
+        index /= base;
+        factor *= inv_base;
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+// Jittered-stratified candidates. Each cell is divided into a lattice of
+// strata and one candidate is placed at a random position in each stratum.
+struct StratifiedCellSampler
+{
+    GlobalCellIndexer global_cell;
+    int particles_per_cell_dim;
+
+    KOKKOS_INLINE_FUNCTION
+    int particlesPerCell() const
+    {
+        return particles_per_cell_dim * particles_per_cell_dim *
+               particles_per_cell_dim;
+    }
+
+    template <class Functor>
+    KOKKOS_INLINE_FUNCTION void operator()( const int cell_id,
+                                            const double low[3],
+                                            const double high[3],
+                                            const Functor& functor ) const
+    {
+        uint64_t global_cell_id = global_cell( cell_id );
+
+        // Compute the stratum size in each dimension.
+        double spacing[3];
+        for ( int d = 0; d < 3; ++d )
+            spacing[d] = ( high[d] - low[d] ) / particles_per_cell_dim;
+
+        double px[3];
+        for ( int ip = 0; ip < particles_per_cell_dim; ++ip )
+            for ( int jp = 0; jp < particles_per_cell_dim; ++jp )
+                for ( int kp = 0; kp < particles_per_cell_dim; ++kp )
                 {
-                    particles.setTuple( indices( count ),
-                                        particles.getTuple( i ) );
+                    int p = ip + particles_per_cell_dim *
+                                     ( jp + particles_per_cell_dim * kp );
+                    int stratum[3] = { ip, jp, kp };
+                    for ( int d = 0; d < 3; ++d )
+                        px[d] = low[d] +
+                                ( stratum[d] +
+                                  cellUniform( global_cell_id, 3 * p + d ) ) *
+                                    spacing[d];
+                    functor( p, px );
                 }
-                ++count;
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Low-discrepancy candidates from the Halton sequence in bases 2, 3, and 5.
+// The sequence is shifted by a random offset in each cell (Cranley-Patterson
+// rotation) so neighboring cells do not repeat the same pattern.
+struct HaltonCellSampler
+{
+    GlobalCellIndexer global_cell;
+    int particles_per_cell;
+
+    KOKKOS_INLINE_FUNCTION
+    int particlesPerCell() const { return particles_per_cell; }
+
+    template <class Functor>
+    KOKKOS_INLINE_FUNCTION void operator()( const int cell_id,
+                                            const double low[3],
+                                            const double high[3],
+                                            const Functor& functor ) const
+    {
+        uint64_t global_cell_id = global_cell( cell_id );
+
+        const int base[3] = { 2, 3, 5 };
+        double shift[3];
+        for ( int d = 0; d < 3; ++d )
+            shift[d] = cellUniform( global_cell_id, d );
+
+        double px[3];
+        for ( int p = 0; p < particles_per_cell; ++p )
+        {
+            for ( int d = 0; d < 3; ++d )
+            {
+                double u = radicalInverse( p + 1, base[d] ) + shift[d];
+                if ( u >= 1.0 )
+                    u -= 1.0;
+                px[d] = low[d] + u * ( high[d] - low[d] );
             }
-        } );
-    particles.resize( new_num_particles );
+            functor( p, px );
+        }
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Create the candidate sampler for an initialization type.
+template <class ExecutionSpace, class LocalGridType>
+UniformCellSampler createCellSampler( InitUniform, const ExecutionSpace&,
+                                      const int particles_per_cell_dim,
+                                      const LocalGridType& )
+{
+    return UniformCellSampler{ particles_per_cell_dim };
+}
+
+template <class ExecutionSpace, class LocalGridType>
+RandomCellSampler<ExecutionSpace>
+createCellSampler( InitRandom, const ExecutionSpace&,
+                   const int particles_per_cell,
+                   const LocalGridType& local_grid )
+{
+    // Get the global grid.
+    const auto& global_grid = local_grid.globalGrid();
+
+    // Get the local set of owned cell indices.
+    auto owned_cells = local_grid.indexSpace(
+        Cabana::Grid::Own(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+
+    // Create a random number generator.
+    uint64_t seed =
+        global_grid.blockId() + ( 19383747 % ( global_grid.blockId() + 1 ) );
+    RandomCellSampler<ExecutionSpace> sampler;
+    sampler.pool.init( seed, owned_cells.size() );
+    sampler.particles_per_cell = particles_per_cell;
+    return sampler;
+}
+
+// Create the global cell indexer of the owned cells of a local grid.
+template <class LocalGridType>
+GlobalCellIndexer createGlobalCellIndexer( const LocalGridType& local_grid )
+{
+    const auto& global_grid = local_grid.globalGrid();
+    auto owned_cells = local_grid.indexSpace(
+        Cabana::Grid::Own(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+    GlobalCellIndexer indexer;
+    for ( int d = 0; d < 3; ++d )
+    {
+        indexer.global_offset[d] = global_grid.globalOffset( d );
+        indexer.owned_extent[d] = owned_cells.extent( d );
+        indexer.global_extent[d] =
+            global_grid.globalNumEntity( Cabana::Grid::Cell(), d );
+    }
+    return indexer;
+}
+
+template <class ExecutionSpace, class LocalGridType>
+StratifiedCellSampler
+createCellSampler( InitStratified, const ExecutionSpace&,
+                   const int particles_per_cell_dim,
+                   const LocalGridType& local_grid )
+{
+    return StratifiedCellSampler{ createGlobalCellIndexer( local_grid ),
+                                  particles_per_cell_dim };
+}
+
+template <class ExecutionSpace, class LocalGridType>
+HaltonCellSampler createCellSampler( InitHalton, const ExecutionSpace&,
+                                     const int particles_per_cell,
+                                     const LocalGridType& local_grid )
+{
+    return HaltonCellSampler{ createGlobalCellIndexer( local_grid ),
+                              particles_per_cell };
+}
+
+//---------------------------------------------------------------------------//
+// Call a functor with the owned local cell id, the cell bounds, and the
+// particle volume for each owned cell. Cell ids are ordered with i varying
+// fastest.
+template <class LocalMeshType, class Sampler, class CellFunctor>
+KOKKOS_INLINE_FUNCTION void
+visitCell( const Cabana::Grid::IndexSpace<3>& owned_cells,
+           const LocalMeshType& local_mesh, const Sampler& sampler,
+           const int i, const int j, const int k, const CellFunctor& functor )
+{
+    // Compute the owned local cell id.
+    int i_own = i - owned_cells.min( Dim::I );
+    int j_own = j - owned_cells.min( Dim::J );
+    int k_own = k - owned_cells.min( Dim::K );
+    int cell_id = i_own + owned_cells.extent( Dim::I ) *
+                              ( j_own + k_own * owned_cells.extent( Dim::J ) );
+
+    // Get the coordinates of the low cell node.
+    int low_node[3] = { i, j, k };
+    double low_coords[3];
+    local_mesh.coordinates( Cabana::Grid::Node(), low_node, low_coords );
+
+    // Get the coordinates of the high cell node.
+    int high_node[3] = { i + 1, j + 1, k + 1 };
+    double high_coords[3];
+    local_mesh.coordinates( Cabana::Grid::Node(), high_node, high_coords );
+
+    // Particle volume.
+    // FIXME: this is incorrect for an adaptive mesh. We will need an
+    // overload which gets the nodes and computes the volume. We will
+    // still place particles uniformly in the logical space but we
+    // will then need to map them back to the reference space later.
+    double pv = local_mesh.measure( Cabana::Grid::Cell(), low_node ) /
+                sampler.particlesPerCell();
+
+    functor( cell_id, low_coords, high_coords, pv );
+}
+
+//---------------------------------------------------------------------------//
+// Create particles from every candidate of every owned cell in a single
+// pass. The owned cells are processed in slabs of whole k-planes of at most
+// the given number of cells (all owned cells if not positive). Space is
+// allocated for all candidates of a slab and the candidates that were not
+// created are filtered out before the next slab is processed.
+template <class ParticleListType, class Sampler, class InitFunctor,
+          class ExecutionSpace, class MeshType>
+void initializeParticles( const std::string& label,
+                          const ExecutionSpace& exec_space,
+                          const Sampler& sampler,
+                          const InitFunctor& create_functor,
+                          ParticleListType& particle_list,
+                          const MeshType& mesh, const bool shrink_to_fit,
+                          const int max_cells_per_chunk )
+{
+    // Memory space.
+    using memory_space = typename ParticleListType::memory_space;
+
+    // Particle type.
+    using particle_type = typename ParticleListType::particle_type;
+
+    // Get the local grid.
+    const auto& local_grid = *( mesh.localGrid() );
+
+    // Create a local mesh.
+    auto local_mesh = Cabana::Grid::createLocalMesh<memory_space>( local_grid );
+
+    // Get the local set of owned cell indices.
+    auto owned_cells = local_grid.indexSpace(
+        Cabana::Grid::Own(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+
+    // Get the particles.
+    auto& particles = particle_list.aosoa();
+
+    // Number of k-planes of cells in each slab.
+    int plane_size =
+        owned_cells.extent( Dim::I ) * owned_cells.extent( Dim::J );
+    int slab_planes = owned_cells.extent( Dim::K );
+    if ( max_cells_per_chunk > 0 && plane_size > 0 )
+        slab_planes = std::min(
+            slab_planes, std::max( 1, max_cells_per_chunk / plane_size ) );
+
+    // Creation status of the candidates of a slab.
+    int particles_per_cell = sampler.particlesPerCell();
+    auto particle_created = Kokkos::View<bool*, memory_space>(
+        Kokkos::ViewAllocateWithoutInitializing( "particle_created" ),
+        particles_per_cell * plane_size * slab_planes );
+
+    for ( long k_begin = owned_cells.min( Dim::K );
+          k_begin < owned_cells.max( Dim::K ); k_begin += slab_planes )
+    {
+        long k_end = std::min( k_begin + slab_planes,
+                               long( owned_cells.max( Dim::K ) ) );
+        Cabana::Grid::IndexSpace<3> slab_cells(
+            { owned_cells.min( Dim::I ), owned_cells.min( Dim::J ), k_begin },
+            { owned_cells.max( Dim::I ), owned_cells.max( Dim::J ), k_end } );
+        int first_cell = ( k_begin - owned_cells.min( Dim::K ) ) * plane_size;
+
+        // Allocate enough space for the case the particles consume the
+        // entire slab. Grow the capacity geometrically so appending slabs
+        // does not reallocate the list for every slab.
+        int num_particles = particles_per_cell * slab_cells.size();
+        int previous_num_particles = particles.size();
+        std::size_t new_size = previous_num_particles + num_particles;
+        if ( new_size > particles.capacity() &&
+             slab_cells.size() < owned_cells.size() )
+            particles.reserve(
+                std::max( new_size, 3 * particles.capacity() / 2 ) );
+        particles.resize( new_size );
+
+        // Initialize particles.
+        int local_num_create = 0;
+        Kokkos::parallel_reduce(
+            label,
+            Cabana::Grid::createExecutionPolicy( slab_cells, exec_space ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k,
+                           int& create_count ) {
+                visitCell(
+                    owned_cells, local_mesh, sampler, i, j, k,
+                    [&]( const int cell_id, const double low[3],
+                         const double high[3], const double pv ) {
+                        // Particle.
+                        particle_type particle;
+
+                        // Create particles.
+                        sampler(
+                            cell_id, low, high,
+                            [&]( const int p, const double px[3] ) {
+                                // Local particle id in the slab.
+                                int pid = ( cell_id - first_cell ) *
+                                              particles_per_cell +
+                                          p;
+
+                                // Create a new particle with the given
+                                // logical coordinates.
+                                particle_created( pid ) =
+                                    create_functor( px, pv, particle );
+
+                                // If we created a new particle insert it
+                                // into the list.
+                                if ( particle_created( pid ) )
+                                {
+                                    int new_pid = previous_num_particles + pid;
+                                    particles.setTuple( new_pid,
+                                                        particle.tuple() );
+                                    ++create_count;
+                                }
+                            } );
+                    } );
+            },
+            local_num_create );
+
+        // Filter empties.
+        filterEmpties( exec_space, local_num_create, previous_num_particles,
+                       particle_created, particles, false );
+    }
+
     if ( shrink_to_fit )
         particles.shrinkToFit();
 }
 
+//---------------------------------------------------------------------------//
+// Create particles in two passes. The first pass counts the candidates
+// accepted by the count functor in each cell and the second pass creates
+// them directly at their final position in the list.
+template <class ParticleListType, class Sampler, class CountFunctor,
+          class InitFunctor, class ExecutionSpace, class MeshType>
+void initializeCountedParticles( const std::string& label,
+                                 const ExecutionSpace& exec_space,
+                                 const Sampler& sampler,
+                                 const CountFunctor& count_functor,
+                                 const InitFunctor& create_functor,
+                                 ParticleListType& particle_list,
+                                 const MeshType& mesh )
+{
+    // Memory space.
+    using memory_space = typename ParticleListType::memory_space;
+
+    // Particle type.
+    using particle_type = typename ParticleListType::particle_type;
+
+    // Get the local grid.
+    const auto& local_grid = *( mesh.localGrid() );
+
+    // Create a local mesh.
+    auto local_mesh = Cabana::Grid::createLocalMesh<memory_space>( local_grid );
+
+    // Get the local set of owned cell indices.
+    auto owned_cells = local_grid.indexSpace(
+        Cabana::Grid::Own(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+
+    // Count the accepted candidates in each cell.
+    int num_cell = owned_cells.size();
+    Kokkos::View<int*, memory_space> cell_offsets(
+        Kokkos::ViewAllocateWithoutInitializing( "cell_offsets" ), num_cell );
+    Kokkos::parallel_for(
+        label + "::Count",
+        Cabana::Grid::createExecutionPolicy( owned_cells, exec_space ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            visitCell(
+                owned_cells, local_mesh, sampler, i, j, k,
+                [&]( const int cell_id, const double low[3],
+                     const double high[3], const double ) {
+                    int count = 0;
+                    sampler( cell_id, low, high,
+                             [&]( const int, const double px[3] ) {
+                                 if ( count_functor( px ) )
+                                     ++count;
+                             } );
+                    cell_offsets( cell_id ) = count;
+                } );
+        } );
+
+    // Compute the offset of the first particle in each cell.
+    int local_num_create = 0;
+    Kokkos::parallel_scan(
+        label + "::Offset",
+        Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_cell ),
+        KOKKOS_LAMBDA( const int c, int& offset, const bool final_pass ) {
+            int count = cell_offsets( c );
+            if ( final_pass )
+                cell_offsets( c ) = offset;
+            offset += count;
+        },
+        local_num_create );
+
+    // Allocate exactly the particles that will be created.
+    auto& particles = particle_list.aosoa();
+    int previous_num_particles = particles.size();
+    particles.resize( previous_num_particles + local_num_create );
+
+    // Create the accepted candidates. Track which of them were created in
+    // case the create functor rejects any.
+    Kokkos::View<bool*, memory_space> particle_created( "particle_created",
+                                                        local_num_create );
+    int num_created = 0;
+    Kokkos::parallel_reduce(
+        label + "::Create",
+        Cabana::Grid::createExecutionPolicy( owned_cells, exec_space ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k,
+                       int& create_count ) {
+            visitCell(
+                owned_cells, local_mesh, sampler, i, j, k,
+                [&]( const int cell_id, const double low[3],
+                     const double high[3], const double pv ) {
+                    particle_type particle;
+                    int pid = cell_offsets( cell_id );
+                    sampler( cell_id, low, high,
+                             [&]( const int, const double px[3] ) {
+                                 if ( count_functor( px ) )
+                                 {
+                                     if ( create_functor( px, pv, particle ) )
+                                     {
+                                         particles.setTuple(
+                                             previous_num_particles + pid,
+                                             particle.tuple() );
+                                         particle_created( pid ) = true;
+                                         ++create_count;
+                                     }
+                                     ++pid;
+                                 }
+                             } );
+                } );
+        },
+        num_created );
+
+    // If any candidates were rejected remove their slots so the list only
+    // has real particles. Then report the error on all ranks.
+    int rejected = ( num_created != local_num_create ) ? 1 : 0;
+    if ( rejected )
+        filterEmpties( exec_space, num_created, previous_num_particles,
+                       particle_created, particles, false );
+    MPI_Allreduce( MPI_IN_PLACE, &rejected, 1, MPI_INT, MPI_MAX,
+                   local_grid.globalGrid().comm() );
+    if ( rejected )
+        throw std::runtime_error( "Particle create functor rejected particles "
+                                  "accepted by the count functor" );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Impl
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Initialize a random number of particles in each cell given an
@@ -116,6 +698,15 @@ void filterEmpties( const ExecutionSpace& exec_space,
   created.
 
   \param mesh Picasso UniformMesh
+
+  \param shrink_to_fit Shrink the particle list capacity to its size.
+
+  \param max_cells_per_chunk If positive, the owned cells are initialized in
+  slabs of at most this many cells (but at least one k-plane of cells) and
+  the created particles of each slab are appended to the list. This bounds
+  the scratch memory needed for candidates to a slab rather than all owned
+  cells. Reserve the expected number of particles in the list beforehand to
+  also avoid reallocating it as slabs are appended.
 */
 template <class ParticleListType, class InitFunctor, class ExecutionSpace,
           class MeshType>
@@ -124,133 +715,142 @@ void initializeParticles( InitRandom, const ExecutionSpace& exec_space,
                           const InitFunctor& create_functor,
                           ParticleListType& particle_list,
                           std::shared_ptr<MeshType>& mesh,
-                          const bool shrink_to_fit = true )
+                          const bool shrink_to_fit = true,
+                          const int max_cells_per_chunk = 0 )
 {
     Kokkos::Profiling::pushRegion( "Picasso::initializeParticles::Random" );
 
-    // Memory space.
-    using memory_space = typename ParticleListType::memory_space;
+    auto sampler = Impl::createCellSampler(
+        InitRandom(), exec_space, particles_per_cell, *( mesh->localGrid() ) );
+    Impl::initializeParticles( "Picasso::ParticleInit::Random", exec_space,
+                               sampler, create_functor, particle_list, *mesh,
+                               shrink_to_fit, max_cells_per_chunk );
 
-    // Particle type.
-    using particle_type = typename ParticleListType::particle_type;
+    Kokkos::Profiling::popRegion();
+}
 
-    // Get the local grid.
-    const auto& local_grid = *( mesh->localGrid() );
+//---------------------------------------------------------------------------//
+/*!
+  \brief Initialize a uniform number of particles in each cell given an
+  initialization functor.
 
-    // Create a local mesh.
-    auto local_mesh = Cabana::Grid::createLocalMesh<memory_space>( local_grid );
+  \tparam ParticleListType The type of particle list to initialize.
 
-    // Get the global grid.
-    const auto& global_grid = local_grid.globalGrid();
+  \tparam InitFunctor Initialization functor type. See the documentation below
+  for the create_functor parameter on the signature of this functor.
 
-    // Get the local set of owned cell indices.
-    auto owned_cells = local_grid.indexSpace(
-        Cabana::Grid::Own(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+  \param Initialization type tag.
 
-    // Create a random number generator.
-    uint64_t seed =
-        global_grid.blockId() + ( 19383747 % ( global_grid.blockId() + 1 ) );
-    using rnd_type = Kokkos::Random_XorShift64_Pool<ExecutionSpace>;
-    rnd_type pool;
-    pool.init( seed, owned_cells.size() );
+  \param particles_per_cell_dim The number of particles to populate each cell
+  dimension with.
 
-    // Get the particles.
-    auto& particles = particle_list.aosoa();
+  \param create_functor A functor which populates a particle given the logical
+  position of a particle. This functor returns true if a particle was created
+  and false if it was not giving the signature:
 
-    // Allocate enough space for the case the particles consume the entire
-    // local grid.
-    int num_particles = particles_per_cell * owned_cells.size();
-    int previous_num_particles = particles.size();
-    particles.resize( previous_num_particles + num_particles );
+      bool createFunctor( const double px[3],
+                          typename ParticleAoSoA::tuple_type& particle );
 
-    // Creation status.
-    auto particle_created = Kokkos::View<bool*, ExecutionSpace>(
-        Kokkos::ViewAllocateWithoutInitializing( "particle_created" ),
-        num_particles );
+  \param particle_list The list of particles to populate. This will be filled
+  with particles and resized to a size equal to the number of particles
+  created.
 
-    // Initialize particles.
-    int local_num_create = 0;
-    Kokkos::parallel_reduce(
-        "Picasso::ParticleInit::Random",
-        Cabana::Grid::createExecutionPolicy( owned_cells, exec_space ),
-        KOKKOS_LAMBDA( const int i, const int j, const int k,
-                       int& create_count ) {
-            // Compute the owned local cell id.
-            int i_own = i - owned_cells.min( Dim::I );
-            int j_own = j - owned_cells.min( Dim::J );
-            int k_own = k - owned_cells.min( Dim::K );
-            int cell_id =
-                i_own + owned_cells.extent( Dim::I ) *
-                            ( j_own + k_own * owned_cells.extent( Dim::J ) );
-
-            // Get the coordinates of the low cell node.
-            int low_node[3] = { i, j, k };
-            double low_coords[3];
-            local_mesh.coordinates( Cabana::Grid::Node(), low_node,
-                                    low_coords );
-
-            // Get the coordinates of the high cell node.
-            int high_node[3] = { i + 1, j + 1, k + 1 };
-            double high_coords[3];
-            local_mesh.coordinates( Cabana::Grid::Node(), high_node,
-                                    high_coords );
-
-            // Random number generator.
-            auto rand = pool.get_state( cell_id );
+  \param mesh Picasso UniformMesh
 
-            // Particle coordinate.
-            double px[3];
+  \param shrink_to_fit Shrink the particle list capacity to its size.
 
-            // Particle volume.
-            // FIXME: this is incorrect for an adaptive mesh. We will need an
-            // overload which gets the nodes and computes the volume. We will
-            // still place particles uniformly in the logical space but we
-            // will then need to map them back to the reference space later.
-            double pv = local_mesh.measure( Cabana::Grid::Cell(), low_node ) /
-                        particles_per_cell;
+  \param max_cells_per_chunk If positive, the owned cells are initialized in
+  slabs of at most this many cells (but at least one k-plane of cells) and
+  the created particles of each slab are appended to the list. This bounds
+  the scratch memory needed for candidates to a slab rather than all owned
+  cells. Reserve the expected number of particles in the list beforehand to
+  also avoid reallocating it as slabs are appended.
+*/
+template <class ParticleListType, class InitFunctor, class ExecutionSpace,
+          class MeshType>
+void initializeParticles( InitUniform, const ExecutionSpace& exec_space,
+                          const int particles_per_cell_dim,
+                          const InitFunctor& create_functor,
+                          ParticleListType& particle_list,
+                          std::shared_ptr<MeshType>& mesh,
+                          const bool shrink_to_fit = true,
+                          const int max_cells_per_chunk = 0 )
+{
+    Kokkos::Profiling::pushRegion( "Picasso::initializeParticles::Uniform" );
 
-            // Particle.
-            particle_type particle;
+    auto sampler = Impl::createCellSampler( InitUniform(), exec_space,
+                                            particles_per_cell_dim,
+                                            *( mesh->localGrid() ) );
+    Impl::initializeParticles( "Picasso::ParticleInit::Uniform", exec_space,
+                               sampler, create_functor, particle_list, *mesh,
+                               shrink_to_fit, max_cells_per_chunk );
 
-            // Create particles.
-            for ( int p = 0; p < particles_per_cell; ++p )
-            {
-                // Local particle id.
-                int pid = cell_id * particles_per_cell + p;
+    Kokkos::Profiling::popRegion();
+}
 
-                // Select a random point in the cell for the particle
-                // location. These coordinates are logical.
-                for ( int d = 0; d < 3; ++d )
-                {
-                    px[d] = Kokkos::rand<decltype( rand ), double>::draw(
-                        rand, low_coords[d], high_coords[d] );
-                }
+//---------------------------------------------------------------------------//
+/*!
+  \brief Initialize particles in each cell with jittered-stratified sampling
+  given an initialization functor. Each cell is divided into a lattice of
+  strata and a candidate particle is placed at a random position in each
+  stratum. Positions depend only on the global cell index and are therefore
+  reproducible for any decomposition of the mesh.
 
-                // Create a new particle with the given logical coordinates.
-                particle_created( pid ) = create_functor( px, pv, particle );
+  \tparam ParticleListType The type of particle list to initialize.
 
-                // If we created a new particle insert it into the list.
-                if ( particle_created( pid ) )
-                {
-                    int new_pid = previous_num_particles + pid;
-                    particles.setTuple( new_pid, particle.tuple() );
-                    ++create_count;
-                }
-            }
-        },
-        local_num_create );
+  \tparam InitFunctor Initialization functor type. See the documentation below
+  for the create_functor parameter on the signature of this functor.
+
+  \param Initialization type tag.
+
+  \param particles_per_cell_dim The number of strata in each cell dimension.
+
+  \param create_functor A functor which populates a particle given the logical
+  position of a particle. This functor returns true if a particle was created
+  and false if it was not giving the signature:
+
+      bool createFunctor( const double px[3], const double pv,
+                          typename ParticleAoSoA::tuple_type& particle );
+
+  \param particle_list The list of particles to populate. This will be filled
+  with particles and resized to a size equal to the number of particles
+  created.
+
+  \param mesh Picasso UniformMesh
+
+  \param shrink_to_fit Shrink the particle list capacity to its size.
+
+  \param max_cells_per_chunk If positive, the owned cells are initialized in
+  slabs of at most this many cells (but at least one k-plane of cells).
+*/
+template <class ParticleListType, class InitFunctor, class ExecutionSpace,
+          class MeshType>
+void initializeParticles( InitStratified, const ExecutionSpace& exec_space,
+                          const int particles_per_cell_dim,
+                          const InitFunctor& create_functor,
+                          ParticleListType& particle_list,
+                          std::shared_ptr<MeshType>& mesh,
+                          const bool shrink_to_fit = true,
+                          const int max_cells_per_chunk = 0 )
+{
+    Kokkos::Profiling::pushRegion( "Picasso::initializeParticles::Stratified" );
 
-    // Filter empties.
-    filterEmpties( exec_space, local_num_create, previous_num_particles,
-                   particle_created, particles, shrink_to_fit );
+    auto sampler = Impl::createCellSampler( InitStratified(), exec_space,
+                                            particles_per_cell_dim,
+                                            *( mesh->localGrid() ) );
+    Impl::initializeParticles( "Picasso::ParticleInit::Stratified", exec_space,
+                               sampler, create_functor, particle_list, *mesh,
+                               shrink_to_fit, max_cells_per_chunk );
 
     Kokkos::Profiling::popRegion();
 }
 
 //---------------------------------------------------------------------------//
 /*!
-  \brief Initialize a uniform number of particles in each cell given an
-  initialization functor.
+  \brief Initialize particles in each cell with a low-discrepancy Halton
+  sequence given an initialization functor. The sequence is shifted by a
+  random offset in each cell. Positions depend only on the global cell index
+  and are therefore reproducible for any decomposition of the mesh.
 
   \tparam ParticleListType The type of particle list to initialize.
 
@@ -259,14 +859,13 @@ void initializeParticles( InitRandom, const ExecutionSpace& exec_space,
 
   \param Initialization type tag.
 
-  \param particles_per_cell_dim The number of particles to populate each cell
-  dimension with.
+  \param particles_per_cell The number of particles to sample each cell with.
 
   \param create_functor A functor which populates a particle given the logical
   position of a particle. This functor returns true if a particle was created
   and false if it was not giving the signature:
 
-      bool createFunctor( const double px[3],
+      bool createFunctor( const double px[3], const double pv,
                           typename ParticleAoSoA::tuple_type& particle );
 
   \param particle_list The list of particles to populate. This will be filled
@@ -274,137 +873,92 @@ void initializeParticles( InitRandom, const ExecutionSpace& exec_space,
   created.
 
   \param mesh Picasso UniformMesh
+
+  \param shrink_to_fit Shrink the particle list capacity to its size.
+
+  \param max_cells_per_chunk If positive, the owned cells are initialized in
+  slabs of at most this many cells (but at least one k-plane of cells).
 */
 template <class ParticleListType, class InitFunctor, class ExecutionSpace,
           class MeshType>
-void initializeParticles( InitUniform, const ExecutionSpace& exec_space,
-                          const int particles_per_cell_dim,
+void initializeParticles( InitHalton, const ExecutionSpace& exec_space,
+                          const int particles_per_cell,
                           const InitFunctor& create_functor,
                           ParticleListType& particle_list,
                           std::shared_ptr<MeshType>& mesh,
-                          const bool shrink_to_fit = true )
+                          const bool shrink_to_fit = true,
+                          const int max_cells_per_chunk = 0 )
 {
-    Kokkos::Profiling::pushRegion( "Picasso::initializeParticles::Uniform" );
+    Kokkos::Profiling::pushRegion( "Picasso::initializeParticles::Halton" );
 
-    // Memory space.
-    using memory_space = typename ParticleListType::memory_space;
+    auto sampler = Impl::createCellSampler(
+        InitHalton(), exec_space, particles_per_cell, *( mesh->localGrid() ) );
+    Impl::initializeParticles( "Picasso::ParticleInit::Halton", exec_space,
+                               sampler, create_functor, particle_list, *mesh,
+                               shrink_to_fit, max_cells_per_chunk );
 
-    // Particle type.
-    using particle_type = typename ParticleListType::particle_type;
+    Kokkos::Profiling::popRegion();
+}
 
-    // Get the local grid.
-    const auto& local_grid = *( mesh->localGrid() );
+//---------------------------------------------------------------------------//
+/*!
+  \brief Initialize particles in two passes with an exact allocation. The
+  candidate particles of each cell are first tested with a count functor to
+  count the particles that will be created in each cell. The particle list is
+  then resized once to its final size and the accepted particles are created
+  directly in place. No space is allocated for rejected candidates and no
+  compaction is needed afterwards.
 
-    // Create a local mesh.
-    auto local_mesh = Cabana::Grid::createLocalMesh<memory_space>( local_grid );
+  \tparam InitType The initialization type.
 
-    // Get the local set of owned cell indices.
-    auto owned_cells = local_grid.indexSpace(
-        Cabana::Grid::Own(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+  \tparam CountFunctor Count functor type. See the documentation below for
+  the count_functor parameter on the signature of this functor.
 
-    // Get the particles.
-    auto& particles = particle_list.aosoa();
+  \tparam InitFunctor Initialization functor type. See the documentation below
+  for the create_functor parameter on the signature of this functor.
 
-    // Allocate enough space for the case the particles consume the entire
-    // local grid.
-    int particles_per_cell = particles_per_cell_dim * particles_per_cell_dim *
-                             particles_per_cell_dim;
-    int num_particles = particles_per_cell * owned_cells.size();
-    int previous_num_particles = particles.size();
-    particles.resize( previous_num_particles + num_particles );
+  \param Initialization type tag.
 
-    // Creation status.
-    auto particle_created = Kokkos::View<bool*, memory_space>(
-        Kokkos::ViewAllocateWithoutInitializing( "particle_created" ),
-        num_particles );
+  \param particles_per_cell The particles per cell (InitRandom, InitHalton)
+  or per cell dimension (InitUniform, InitStratified) to sample each cell
+  with.
 
-    // Initialize particles.
-    int local_num_create = 0;
-    Kokkos::parallel_reduce(
-        "Picasso::ParticleInit::Uniform",
-        Cabana::Grid::createExecutionPolicy( owned_cells, exec_space ),
-        KOKKOS_LAMBDA( const int i, const int j, const int k,
-                       int& create_count ) {
-            // Compute the owned local cell id.
-            int i_own = i - owned_cells.min( Dim::I );
-            int j_own = j - owned_cells.min( Dim::J );
-            int k_own = k - owned_cells.min( Dim::K );
-            int cell_id =
-                i_own + owned_cells.extent( Dim::I ) *
-                            ( j_own + k_own * owned_cells.extent( Dim::J ) );
-
-            // Get the coordinates of the low cell node.
-            int low_node[3] = { i, j, k };
-            double low_coords[3];
-            local_mesh.coordinates( Cabana::Grid::Node(), low_node,
-                                    low_coords );
-
-            // Get the coordinates of the high cell node.
-            int high_node[3] = { i + 1, j + 1, k + 1 };
-            double high_coords[3];
-            local_mesh.coordinates( Cabana::Grid::Node(), high_node,
-                                    high_coords );
-
-            // Compute the particle spacing in each dimension.
-            double spacing[3] = { ( high_coords[Dim::I] - low_coords[Dim::I] ) /
-                                      particles_per_cell_dim,
-                                  ( high_coords[Dim::J] - low_coords[Dim::J] ) /
-                                      particles_per_cell_dim,
-                                  ( high_coords[Dim::K] - low_coords[Dim::K] ) /
-                                      particles_per_cell_dim };
+  \param count_functor A functor which returns true if a particle will be
+  created at the given logical position. This should be cheap to evaluate,
+  for example a lookup into a voxelized geometry, and gives the signature:
 
-            // Particle coordinate.
-            double px[3];
+      bool countFunctor( const double px[3] );
 
-            // Particle volume.
-            // FIXME: this is incorrect for an adaptive mesh. We will need an
-            // overload which gets the nodes and computes the volume. We will
-            // still place particles uniformly in the logical space but we
-            // will then need to map them back to the reference space
-            // later.
-            double pv = local_mesh.measure( Cabana::Grid::Cell(), low_node ) /
-                        particles_per_cell;
+  \param create_functor A functor which populates a particle given the logical
+  position of a particle. It is only called for positions accepted by the
+  count functor and must create a particle for all of them. If it rejects
+  any, the list keeps only the created particles and an exception is thrown
+  on all ranks. It has the signature:
 
-            // Particle.
-            particle_type particle;
+      bool createFunctor( const double px[3], const double pv,
+                          typename ParticleAoSoA::tuple_type& particle );
 
-            // Create particles.
-            for ( int ip = 0; ip < particles_per_cell_dim; ++ip )
-                for ( int jp = 0; jp < particles_per_cell_dim; ++jp )
-                    for ( int kp = 0; kp < particles_per_cell_dim; ++kp )
-                    {
-                        // Local particle id.
-                        int pid = cell_id * particles_per_cell + ip +
-                                  particles_per_cell_dim *
-                                      ( jp + particles_per_cell_dim * kp );
-
-                        // Set the particle position in logical coordinates.
-                        px[Dim::I] = 0.5 * spacing[Dim::I] +
-                                     ip * spacing[Dim::I] + low_coords[Dim::I];
-                        px[Dim::J] = 0.5 * spacing[Dim::J] +
-                                     jp * spacing[Dim::J] + low_coords[Dim::J];
-                        px[Dim::K] = 0.5 * spacing[Dim::K] +
-                                     kp * spacing[Dim::K] + low_coords[Dim::K];
-
-                        // Create a new particle with the given logical
-                        // coordinates.
-                        particle_created( pid ) =
-                            create_functor( px, pv, particle );
-
-                        // If we created a new particle insert it into the list.
-                        if ( particle_created( pid ) )
-                        {
-                            int new_pid = previous_num_particles + pid;
-                            particles.setTuple( new_pid, particle.tuple() );
-                            ++create_count;
-                        }
-                    }
-        },
-        local_num_create );
+  \param particle_list The list of particles to populate. Created particles
+  are appended to the list.
+
+  \param mesh Picasso UniformMesh
+*/
+template <class InitType, class ParticleListType, class CountFunctor,
+          class InitFunctor, class ExecutionSpace, class MeshType>
+void initializeParticles( InitType init_type, const ExecutionSpace& exec_space,
+                          const int particles_per_cell,
+                          const CountFunctor& count_functor,
+                          const InitFunctor& create_functor,
+                          ParticleListType& particle_list,
+                          std::shared_ptr<MeshType>& mesh )
+{
+    Kokkos::Profiling::pushRegion( "Picasso::initializeParticles::Counted" );
 
-    // Filter empties.
-    filterEmpties( exec_space, local_num_create, previous_num_particles,
-                   particle_created, particles, shrink_to_fit );
+    auto sampler = Impl::createCellSampler(
+        init_type, exec_space, particles_per_cell, *( mesh->localGrid() ) );
+    Impl::initializeCountedParticles( "Picasso::ParticleInit::Counted",
+                                      exec_space, sampler, count_functor,
+                                      create_functor, particle_list, *mesh );
 
     Kokkos::Profiling::popRegion();
 }
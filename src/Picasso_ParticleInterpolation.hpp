@@ -104,6 +104,97 @@ createSpline( Location, Order, const LocalMesh& local_mesh,
     return sd;
 }
 
+//---------------------------------------------------------------------------//
+// Curvilinear splines
+//---------------------------------------------------------------------------//
+// On curvilinear meshes the spline is evaluated in the reference frame of the
+// logical grid (which has unit cells) at the reference position of the
+// particle. The weights are the same in both frames while gradients are
+// taken to the physical frame with the inverse jacobian of the mapping at the
+// particle: grad_x(w) = J^-T grad_ref(w). The physical distance and cell size
+// members of the reference spline are in reference units.
+template <class SplineDataType>
+struct CurvilinearSplineData : SplineDataType
+{
+    using scalar_type = typename SplineDataType::scalar_type;
+    using reference_spline_type = SplineDataType;
+
+    // Inverse jacobian of the mapping at the particle.
+    LinearAlgebra::Matrix<scalar_type, 3, 3> jacobian_inv;
+};
+
+template <class>
+struct is_curvilinear_spline_impl : public std::false_type
+{
+};
+
+template <class SplineDataType>
+struct is_curvilinear_spline_impl<CurvilinearSplineData<SplineDataType>>
+    : public std::true_type
+{
+};
+
+template <class T>
+struct is_curvilinear_spline
+    : public is_curvilinear_spline_impl<typename std::remove_cv<T>::type>::type
+{
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a spline on a curvilinear mesh.
+
+  \param Location The location of the grid entities on which the spline is
+  defined.
+
+  \param Order Spline interpolation order.
+
+  \param local_mesh The local mesh of the logical grid.
+
+  \param reference_position The particle position in the reference frame.
+
+  \param jacobian_inv The inverse jacobian of the mapping at the particle,
+  either from the mapping or from cached metrics.
+
+  \param SplineMembers A list of the data members to be stored in the spline.
+
+  \return The created spline.
+*/
+template <class Location, class Order, class PositionVector, class LocalMesh,
+          class JacobianInverse, class... SplineMembers>
+KOKKOS_INLINE_FUNCTION auto
+createCurvilinearSpline( Location location, Order order,
+                         const LocalMesh& local_mesh,
+                         const PositionVector& reference_position,
+                         const JacobianInverse& jacobian_inv,
+                         SplineMembers... members )
+{
+    using spline_type = decltype( createSpline(
+        location, order, local_mesh, reference_position, members... ) );
+    CurvilinearSplineData<spline_type> sd;
+    static_cast<spline_type&>( sd ) = createSpline(
+        location, order, local_mesh, reference_position, members... );
+    sd.jacobian_inv = jacobian_inv;
+    return sd;
+}
+
+//---------------------------------------------------------------------------//
+// Reference frame gradient of the weight of a spline stencil entity.
+template <class SplineDataType>
+KOKKOS_INLINE_FUNCTION void
+referenceWeightGradient( const SplineDataType& sd, const int i, const int j,
+                         const int k,
+                         typename SplineDataType::scalar_type g[3] )
+{
+    static_assert( SplineDataType::has_weight_values &&
+                       SplineDataType::has_weight_physical_gradients,
+                   "Curvilinear gradients require SplineValue and "
+                   "SplineGradient" );
+    g[Dim::I] = sd.g[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k];
+    g[Dim::J] = sd.w[Dim::I][i] * sd.g[Dim::J][j] * sd.w[Dim::K][k];
+    g[Dim::K] = sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.g[Dim::K][k];
+}
+
 //---------------------------------------------------------------------------//
 // Spline Grid-to-Particle
 //---------------------------------------------------------------------------//
@@ -144,7 +235,9 @@ KOKKOS_INLINE_FUNCTION void value( const SplineDataType& sd,
 // constructing the spline data.
 template <class ViewType, class SplineDataType, class ResultVector,
           typename std::enable_if_t<
-              LinearAlgebra::is_vector<ResultVector>::value, int> = 0>
+              LinearAlgebra::is_vector<ResultVector>::value &&
+                  !is_curvilinear_spline<SplineDataType>::value,
+              int> = 0>
 KOKKOS_INLINE_FUNCTION void
 gradient( const SplineDataType& sd, const ViewType& view, ResultVector& result )
 {
@@ -164,7 +257,9 @@ gradient( const SplineDataType& sd, const ViewType& view, ResultVector& result )
 // constructing the spline data.
 template <class ViewType, class SplineDataType, class ResultMatrix,
           typename std::enable_if_t<
-              LinearAlgebra::is_matrix<ResultMatrix>::value, int> = 0>
+              LinearAlgebra::is_matrix<ResultMatrix>::value &&
+                  !is_curvilinear_spline<SplineDataType>::value,
+              int> = 0>
 KOKKOS_INLINE_FUNCTION void
 gradient( const SplineDataType& sd, const ViewType& view, ResultMatrix& result )
 {
@@ -183,13 +278,90 @@ gradient( const SplineDataType& sd, const ViewType& view, ResultMatrix& result )
 //---------------------------------------------------------------------------//
 // G2P vector divergence. Requires SplineValue and SplineGradient when
 // constructing the spline data.
-template <class ViewType, class SplineDataType, class Scalar>
+template <class ViewType, class SplineDataType, class Scalar,
+          typename std::enable_if_t<
+              !is_curvilinear_spline<SplineDataType>::value, int> = 0>
 KOKKOS_INLINE_FUNCTION void divergence( const SplineDataType& sd,
                                         const ViewType& view, Scalar& result )
 {
     Cabana::Grid::G2P::divergence( view, sd, result );
 }
 
+//---------------------------------------------------------------------------//
+// G2P scalar gradient on a curvilinear mesh. Requires SplineValue and
+// SplineGradient when constructing the spline data.
+template <class ViewType, class SplineDataType, class ResultVector,
+          typename std::enable_if_t<
+              LinearAlgebra::is_vector<ResultVector>::value &&
+                  is_curvilinear_spline<SplineDataType>::value,
+              int> = 0>
+KOKKOS_INLINE_FUNCTION void
+gradient( const SplineDataType& sd, const ViewType& view, ResultVector& result )
+{
+    using value_type = typename ResultVector::value_type;
+
+    // Accumulate the reference gradient and transform it once.
+    LinearAlgebra::Vector<value_type, 3> r_ref;
+    r_ref = 0.0;
+    value_type g[3];
+    for ( int i = 0; i < SplineDataType::num_knot; ++i )
+        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+            for ( int k = 0; k < SplineDataType::num_knot; ++k )
+            {
+                referenceWeightGradient( sd, i, j, k, g );
+                value_type u = view( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                                     sd.s[Dim::K][k], 0 );
+                for ( int d = 0; d < 3; ++d )
+                    r_ref( d ) += g[d] * u;
+            }
+    result = ~sd.jacobian_inv * r_ref;
+}
+
+//---------------------------------------------------------------------------//
+// G2P vector gradient on a curvilinear mesh. As with uniform meshes the
+// gradient index is first: result(a,b) = du_b/dx_a. Requires SplineValue
+// and SplineGradient when constructing the spline data.
+template <class ViewType, class SplineDataType, class ResultMatrix,
+          typename std::enable_if_t<
+              LinearAlgebra::is_matrix<ResultMatrix>::value &&
+                  is_curvilinear_spline<SplineDataType>::value,
+              int> = 0>
+KOKKOS_INLINE_FUNCTION void
+gradient( const SplineDataType& sd, const ViewType& view, ResultMatrix& result )
+{
+    using value_type = typename ResultMatrix::value_type;
+
+    LinearAlgebra::Matrix<value_type, 3, 3> r_ref;
+    r_ref = 0.0;
+    value_type g[3];
+    for ( int i = 0; i < SplineDataType::num_knot; ++i )
+        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+            for ( int k = 0; k < SplineDataType::num_knot; ++k )
+            {
+                referenceWeightGradient( sd, i, j, k, g );
+                for ( int a = 0; a < 3; ++a )
+                    for ( int b = 0; b < 3; ++b )
+                        r_ref( a, b ) +=
+                            g[a] * view( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                                         sd.s[Dim::K][k], b );
+            }
+    result = ~sd.jacobian_inv * r_ref;
+}
+
+//---------------------------------------------------------------------------//
+// G2P vector divergence on a curvilinear mesh. Requires SplineValue and
+// SplineGradient when constructing the spline data.
+template <class ViewType, class SplineDataType, class Scalar,
+          typename std::enable_if_t<
+              is_curvilinear_spline<SplineDataType>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION void divergence( const SplineDataType& sd,
+                                        const ViewType& view, Scalar& result )
+{
+    LinearAlgebra::Matrix<Scalar, 3, 3> grad;
+    gradient( sd, view, grad );
+    result = grad( 0, 0 ) + grad( 1, 1 ) + grad( 2, 2 );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace G2P
@@ -230,7 +402,9 @@ KOKKOS_INLINE_FUNCTION void value( const SplineDataType& sd,
 //---------------------------------------------------------------------------//
 // P2G scalar gradient. Requires SplineValue and SplineGradient when
 // constructing the spline data.
-template <class Scalar, class ScatterViewType, class SplineDataType>
+template <class Scalar, class ScatterViewType, class SplineDataType,
+          typename std::enable_if_t<
+              !is_curvilinear_spline<SplineDataType>::value, int> = 0>
 KOKKOS_INLINE_FUNCTION void gradient( const SplineDataType& sd,
                                       const Scalar& value,
                                       const ScatterViewType& view )
@@ -243,7 +417,9 @@ KOKKOS_INLINE_FUNCTION void gradient( const SplineDataType& sd,
 // constructing the spline data.
 template <class ValueVector, class ScatterViewType, class SplineDataType,
           typename std::enable_if_t<
-              LinearAlgebra::is_vector<ValueVector>::value, int> = 0>
+              LinearAlgebra::is_vector<ValueVector>::value &&
+                  !is_curvilinear_spline<SplineDataType>::value,
+              int> = 0>
 KOKKOS_INLINE_FUNCTION void divergence( const SplineDataType& sd,
                                         const ValueVector& value,
                                         const ScatterViewType& view )
@@ -260,7 +436,9 @@ KOKKOS_INLINE_FUNCTION void divergence( const SplineDataType& sd,
 // constructing the spline data.
 template <class ValueMatrix, class ScatterViewType, class SplineDataType,
           typename std::enable_if_t<
-              LinearAlgebra::is_matrix<ValueMatrix>::value, int> = 0>
+              LinearAlgebra::is_matrix<ValueMatrix>::value &&
+                  !is_curvilinear_spline<SplineDataType>::value,
+              int> = 0>
 KOKKOS_INLINE_FUNCTION void divergence( const SplineDataType& sd,
                                         const ValueMatrix& value,
                                         const ScatterViewType& view )
@@ -274,6 +452,104 @@ KOKKOS_INLINE_FUNCTION void divergence( const SplineDataType& sd,
     Cabana::Grid::P2G::divergence( v, sd, view );
 }
 
+//---------------------------------------------------------------------------//
+// P2G scalar gradient on a curvilinear mesh. Requires SplineValue and
+// SplineGradient when constructing the spline data.
+template <class Scalar, class ScatterViewType, class SplineDataType,
+          typename std::enable_if_t<
+              is_curvilinear_spline<SplineDataType>::value, int> = 0>
+KOKKOS_INLINE_FUNCTION void gradient( const SplineDataType& sd,
+                                      const Scalar& value,
+                                      const ScatterViewType& view )
+{
+    static_assert( Cabana::Grid::P2G::is_scatter_view<ScatterViewType>::value,
+                   "P2G requires a Kokkos::ScatterView" );
+    auto view_access = view.access();
+
+    using value_type = typename ScatterViewType::original_value_type;
+
+    // value * grad_x(w) = ( value * J^-1 )^T grad_ref(w).
+    LinearAlgebra::Matrix<value_type, 3, 3> c = value * sd.jacobian_inv;
+    value_type g[3];
+    for ( int i = 0; i < SplineDataType::num_knot; ++i )
+        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+            for ( int k = 0; k < SplineDataType::num_knot; ++k )
+            {
+                referenceWeightGradient( sd, i, j, k, g );
+                for ( int b = 0; b < 3; ++b )
+                    view_access( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                                 sd.s[Dim::K][k], b ) +=
+                        c( 0, b ) * g[0] + c( 1, b ) * g[1] + c( 2, b ) * g[2];
+            }
+}
+
+//---------------------------------------------------------------------------//
+// P2G vector divergence on a curvilinear mesh. Requires SplineValue and
+// SplineGradient when constructing the spline data.
+template <class ValueVector, class ScatterViewType, class SplineDataType,
+          typename std::enable_if_t<
+              LinearAlgebra::is_vector<ValueVector>::value &&
+                  is_curvilinear_spline<SplineDataType>::value,
+              int> = 0>
+KOKKOS_INLINE_FUNCTION void divergence( const SplineDataType& sd,
+                                        const ValueVector& value,
+                                        const ScatterViewType& view )
+{
+    static_assert( Cabana::Grid::P2G::is_scatter_view<ScatterViewType>::value,
+                   "P2G requires a Kokkos::ScatterView" );
+    auto view_access = view.access();
+
+    using value_type = typename ScatterViewType::original_value_type;
+
+    // value . grad_x(w) = ( J^-1 value ) . grad_ref(w).
+    LinearAlgebra::Vector<value_type, 3> v_ref = sd.jacobian_inv * value;
+    value_type g[3];
+    for ( int i = 0; i < SplineDataType::num_knot; ++i )
+        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+            for ( int k = 0; k < SplineDataType::num_knot; ++k )
+            {
+                referenceWeightGradient( sd, i, j, k, g );
+                view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
+                             0 ) +=
+                    v_ref( 0 ) * g[0] + v_ref( 1 ) * g[1] + v_ref( 2 ) * g[2];
+            }
+}
+
+//---------------------------------------------------------------------------//
+// P2G tensor divergence on a curvilinear mesh. As with uniform meshes the
+// divergence is taken over the first index. Requires SplineValue and
+// SplineGradient when constructing the spline data.
+template <class ValueMatrix, class ScatterViewType, class SplineDataType,
+          typename std::enable_if_t<
+              LinearAlgebra::is_matrix<ValueMatrix>::value &&
+                  is_curvilinear_spline<SplineDataType>::value,
+              int> = 0>
+KOKKOS_INLINE_FUNCTION void divergence( const SplineDataType& sd,
+                                        const ValueMatrix& value,
+                                        const ScatterViewType& view )
+{
+    static_assert( Cabana::Grid::P2G::is_scatter_view<ScatterViewType>::value,
+                   "P2G requires a Kokkos::ScatterView" );
+    auto view_access = view.access();
+
+    using value_type = typename ScatterViewType::original_value_type;
+
+    // sum_a value(a,b) dw/dx_a = sum_c ( J^-1 value )(c,b) dw/dref_c.
+    LinearAlgebra::Matrix<value_type, 3, 3> t_ref = sd.jacobian_inv * value;
+    value_type g[3];
+    for ( int i = 0; i < SplineDataType::num_knot; ++i )
+        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+            for ( int k = 0; k < SplineDataType::num_knot; ++k )
+            {
+                referenceWeightGradient( sd, i, j, k, g );
+                for ( int b = 0; b < 3; ++b )
+                    view_access( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                                 sd.s[Dim::K][k], b ) +=
+                        t_ref( 0, b ) * g[0] + t_ref( 1, b ) * g[1] +
+                        t_ref( 2, b ) * g[2];
+            }
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace P2G
@@ -14,6 +14,7 @@
 
 #include <Picasso_FieldManager.hpp>
 #include <Picasso_LevelSet.hpp>
+#include <Picasso_StreamCompaction.hpp>
 #include <Picasso_Types.hpp>
 
 #include <Cabana_Grid.hpp>
@@ -23,6 +24,9 @@
 #include <nlohmann/json.hpp>
 
 #include <cfloat>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 
 //---------------------------------------------------------------------------//
 // ArborX Data
@@ -67,7 +71,10 @@ struct ParticleLevelSetPredicateData
     size_type size;
     size_type i_size;
     size_type ij_size;
+    Kokkos::View<int*, memory_space> entity_ids;
+    bool use_entity_ids = false;
 
+    // Query all ghosted entities.
     template <class LocalGrid>
     ParticleLevelSetPredicateData( const LocalMesh& lm,
                                    const LocalGrid& local_grid )
@@ -80,10 +87,26 @@ struct ParticleLevelSetPredicateData
         ij_size = i_size * ghost_entities.extent( Dim::J );
     }
 
+    // Query only a subset of the ghosted entities. The first num_entity
+    // values of ids are the linear ghost entity indices to query.
+    template <class LocalGrid>
+    ParticleLevelSetPredicateData( const LocalMesh& lm,
+                                   const LocalGrid& local_grid,
+                                   const Kokkos::View<int*, memory_space>& ids,
+                                   const size_type num_entity )
+        : ParticleLevelSetPredicateData( lm, local_grid )
+    {
+        entity_ids = ids;
+        size = num_entity;
+        use_entity_ids = true;
+    }
+
     KOKKOS_FUNCTION void
     convertIndexTo3d( size_type i,
                       ParticleLevelSetPredicateStorage<size_type>& ijk ) const
     {
+        if ( use_entity_ids )
+            i = entity_ids( i );
         ijk.k = i / ij_size;
         size_type k_size = ijk.k * ij_size;
         ijk.j = ( i - k_size ) / i_size;
@@ -246,6 +269,16 @@ class ParticleLevelSet
       \brief Construct the level set with particles of a given color. If the
       input color is negative then all particles will be used in the level set
       regardless of color.
+
+      If "surface_only" is enabled in the particle level set inputs then the
+      distance estimate only uses particles near the interface and only
+      queries mesh entities in the narrow band of the previous signed
+      distance. Particles are considered near the interface if the previous
+      signed distance at their location is within the halo width plus
+      "surface_band_margin" cells (default 2) of zero. The previous signed
+      distance is the result of the last call to redistance() on the level
+      set; before the first redistance all particles and entities are used.
+
       \param inputs Level set settings.
       \param mesh The mesh over which to build the signed distance function.
       \param color The particle color over which to build the level set. Use
@@ -266,6 +299,20 @@ class ParticleLevelSet
         if ( params.contains( "particle_radius" ) )
             _radius = params["particle_radius"];
         _radius *= _dx;
+
+        // Surface particle mode.
+        _surface_only = false;
+        if ( params.contains( "surface_only" ) )
+            _surface_only = params["surface_only"];
+        _surface_band_margin = 2.0;
+        if ( params.contains( "surface_band_margin" ) )
+            _surface_band_margin = params["surface_band_margin"];
+
+        // Start with no history so the first estimate uses every particle
+        // and entity.
+        if ( _surface_only )
+            Cabana::Grid::ArrayOp::assign( *( _ls->getSignedDistance() ), 0.0,
+                                           Cabana::Grid::Ghost() );
     }
 
     Kokkos::View<const int*, memory_space> colorIndex() const
@@ -275,6 +322,13 @@ class ParticleLevelSet
 
     int colorCount() const { return _color_count; }
 
+    // Get the number of particles used in the last distance estimate. This is
+    // less than the color count when only surface particles are used.
+    int surfaceCount() const { return _surface_count; }
+
+    // Get the number of mesh entities queried in the last distance estimate.
+    int queryCount() const { return _query_count; }
+
     /*!
       \brief Update the set of particle indices for the color we are building
       the set for. This operation is needed any time the particle population
@@ -306,25 +360,16 @@ class ParticleLevelSet
         }
 
         // If the color is not negative then count how many particles have the
-        // color we want and compute the indices.
+        // color we want and compute the indices. The indices are compacted
+        // with a scan so they are in increasing order.
         else if ( _color >= 0 )
         {
-            Kokkos::View<int, memory_space> color_count( "color_count" );
             int color = _color;
-            auto color_ind = _color_indices;
-            Kokkos::parallel_for(
-                "Picasso::ParticleLevelSet::CountColor",
-                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
-                                                     c_p.size() ),
-                KOKKOS_LAMBDA( const int p ) {
-                    if ( color == c_p( p ) )
-                    {
-                        color_ind(
-                            Kokkos::atomic_fetch_add( &color_count(), 1 ) ) = p;
-                    }
-                } );
-            Kokkos::deep_copy( _color_count, color_count );
-            _color_indices = color_ind;
+            _color_count = compactIndices(
+                "Picasso::ParticleLevelSet::CountColor", exec_space, 0,
+                c_p.size(),
+                KOKKOS_LAMBDA( const int p ) { return color == c_p( p ); },
+                _color_indices );
         }
 
         // Otherwise a negative color means all particles are included in the
@@ -384,6 +429,16 @@ class ParticleLevelSet
             double min_dist = _dx * local_grid->haloCellWidth();
             Cabana::Grid::ArrayOp::assign( *distance_estimate, min_dist,
                                            Cabana::Grid::Ghost() );
+            _surface_count = 0;
+            _query_count = 0;
+        }
+
+        // If only using surface particles, restrict the tree and the queries
+        // to the narrow band of the previous signed distance.
+        else if ( _surface_only )
+        {
+            estimateSurfaceSignedDistance( exec_space, x_p, *local_grid,
+                                           local_mesh, estimate_view );
         }
 
         // Otherwise we have particles so build a tree from the particles of
@@ -424,6 +479,9 @@ class ParticleLevelSet
             // estimate. Dummy arguments are needed even though we don't care
             // about the output.
             bvh.query( exec_space, predicate_data, distance_callback );
+
+            _surface_count = _color_count;
+            _query_count = predicate_data.size;
         }
 
         // Do a reduction to get the minimum distance within the minimum halo
@@ -440,12 +498,132 @@ class ParticleLevelSet
     // Get the level set.
     std::shared_ptr<level_set> levelSet() const { return _ls; }
 
+    // Estimate the signed distance using only particles and mesh entities
+    // near the interface of the previous signed distance. This is public only
+    // so device lambdas may be used; call estimateSignedDistance() instead.
+    template <class ExecutionSpace, class ParticlePositions, class LocalGrid,
+              class LocalMesh, class EstimateView>
+    void estimateSurfaceSignedDistance( const ExecutionSpace& exec_space,
+                                        const ParticlePositions& x_p,
+                                        const LocalGrid& local_grid,
+                                        const LocalMesh& local_mesh,
+                                        const EstimateView& estimate_view )
+    {
+        // Previous signed distance. This has been gathered by the last
+        // redistance.
+        auto distance_view = _ls->getSignedDistance()->view();
+
+        // Entities farther than the halo width from the interface can't be
+        // resolved so only query inside of that band. Particles are kept if
+        // they are within a margin of the query band so the closest particle
+        // to every queried entity is in the tree.
+        double min_dist = _dx * local_grid.haloCellWidth();
+        double particle_band = min_dist + _surface_band_margin * _dx;
+
+        // Select the surface particles of the given color.
+        if ( _surface_indices.size() < _color_indices.size() )
+            _surface_indices = Kokkos::View<int*, memory_space>(
+                Kokkos::ViewAllocateWithoutInitializing( "surface_indices" ),
+                _color_indices.size() );
+        auto color_ind = _color_indices;
+        auto surface_ind = _surface_indices;
+        _surface_count = streamCompact(
+            "Picasso::ParticleLevelSet::SelectSurfaceParticles", exec_space, 0,
+            _color_count,
+            KOKKOS_LAMBDA( const int c ) {
+                auto p = color_ind( c );
+                double x[3] = { x_p( p, 0 ), x_p( p, 1 ), x_p( p, 2 ) };
+                Cabana::Grid::SplineData<
+                    double, 1, 3, entity_type,
+                    Cabana::Grid::SplineDataMemberTypes<
+                        Cabana::Grid::SplineWeightValues>>
+                    sd;
+                Cabana::Grid::evaluateSpline( local_mesh, x, sd );
+                double phi = 0.0;
+                Cabana::Grid::G2P::value( distance_view, sd, phi );
+                return ( Kokkos::fabs( phi ) < particle_band );
+            },
+            KOKKOS_LAMBDA( const int c, const int count ) {
+                surface_ind( count ) = color_ind( c );
+            } );
+
+        // Entities outside of the band keep the sign of the previous signed
+        // distance and are clamped to the halo width.
+        auto ghost_entities = local_grid.indexSpace(
+            Cabana::Grid::Ghost(), entity_type(), Cabana::Grid::Local() );
+        Kokkos::parallel_for(
+            "Picasso::ParticleLevelSet::ClampOutsideBand",
+            Cabana::Grid::createExecutionPolicy( ghost_entities, exec_space ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                estimate_view( i, j, k, 0 ) =
+                    ( distance_view( i, j, k, 0 ) < 0.0 ) ? -min_dist
+                                                          : min_dist;
+            } );
+
+        // If there are no surface particles there is nothing to query.
+        if ( 0 == _surface_count )
+        {
+            _query_count = 0;
+            return;
+        }
+
+        // Select the entities in the band.
+        ParticleLevelSetPredicateData<LocalMesh, entity_type> all_entities(
+            local_mesh, local_grid );
+        if ( static_cast<int>( _band_entities.size() ) < all_entities.size )
+            _band_entities = Kokkos::View<int*, memory_space>(
+                Kokkos::ViewAllocateWithoutInitializing( "band_entities" ),
+                all_entities.size );
+        _query_count = compactIndices(
+            "Picasso::ParticleLevelSet::SelectBandEntities", exec_space, 0,
+            all_entities.size,
+            KOKKOS_LAMBDA( const int e ) {
+                ParticleLevelSetPredicateStorage<int> ijk;
+                all_entities.convertIndexTo3d( e, ijk );
+                return ( Kokkos::fabs( distance_view( ijk.i, ijk.j, ijk.k,
+                                                      0 ) ) < min_dist );
+            },
+            _band_entities );
+
+        // Build the tree from the surface particles.
+        ParticleLevelSetPrimitiveData<ParticlePositions,
+                                      Kokkos::View<int*, memory_space>>
+            primitive_data;
+        primitive_data.x = x_p;
+        primitive_data.c = _surface_indices;
+        primitive_data.num_color = _surface_count;
+#if ARBORX_VERSION < 10799
+        ArborX::BVH<memory_space> bvh( exec_space, primitive_data );
+#else
+        ArborX::BoundingVolumeHierarchy bvh( exec_space, primitive_data );
+#endif
+
+        // Query the tree with the band entities.
+        ParticleLevelSetPredicateData<LocalMesh, entity_type> predicate_data(
+            local_mesh, local_grid, _band_entities, _query_count );
+#if ARBORX_VERSION < 10799
+        ParticleLevelSetCallback<ParticlePositions, EstimateView>
+            distance_callback{ primitive_data, estimate_view,
+                               static_cast<float>( _radius ) };
+#else
+        ParticleLevelSetCallback<EstimateView> distance_callback{
+            estimate_view, static_cast<float>( _radius ) };
+#endif
+        bvh.query( exec_space, predicate_data, distance_callback );
+    }
+
   private:
     int _color;
     double _radius;
     double _dx;
     Kokkos::View<int*, memory_space> _color_indices;
     int _color_count;
+    bool _surface_only;
+    double _surface_band_margin;
+    Kokkos::View<int*, memory_space> _surface_indices;
+    int _surface_count = 0;
+    Kokkos::View<int*, memory_space> _band_entities;
+    int _query_count = 0;
     std::shared_ptr<level_set> _ls;
 };
 
@@ -467,6 +645,393 @@ createParticleLevelSet( const nlohmann::json& inputs,
         inputs, mesh, color );
 }
 
+//---------------------------------------------------------------------------//
+// Multi-color particle level set. Composes a signed distance function for
+// each of a list of particle colors. The particles of all colors are grouped
+// by color with a single counting sort and the estimates of all colors share
+// a single halo reduction. Each color intentionally has its own tree: a
+// nearest particle query cannot be restricted to one color of a shared tree,
+// so the per-color trees are what give each color an exact nearest query.
+template <class MeshType, class SignedDistanceLocation>
+class MultiParticleLevelSet
+{
+  public:
+    using mesh_type = MeshType;
+    using memory_space = typename mesh_type::memory_space;
+    using location_type = SignedDistanceLocation;
+    using entity_type = typename location_type::entity_type;
+    using halo_type = Cabana::Grid::Halo<memory_space>;
+    using level_set = LevelSet<MeshType, SignedDistanceLocation>;
+    using array_type =
+        Cabana::Grid::Array<double, entity_type,
+                            Cabana::Grid::UniformMesh<double>, memory_space>;
+
+    /*!
+      \brief Construct a level set for each of the given particle colors.
+      \param inputs Level set settings.
+      \param mesh The mesh over which to build the signed distance functions.
+      \param colors The particle colors over which to build the level sets.
+      All colors must be non-negative and unique.
+    */
+    MultiParticleLevelSet( const nlohmann::json& inputs,
+                           const std::shared_ptr<MeshType>& mesh,
+                           const std::vector<int>& colors )
+        : _colors( colors )
+    {
+        if ( _colors.empty() )
+            throw std::runtime_error(
+                "MultiParticleLevelSet requires at least one color" );
+        for ( std::size_t n = 0; n < _colors.size(); ++n )
+        {
+            if ( _colors[n] < 0 )
+                throw std::runtime_error(
+                    "MultiParticleLevelSet colors must be non-negative" );
+            for ( std::size_t m = 0; m < n; ++m )
+                if ( _colors[m] == _colors[n] )
+                    throw std::runtime_error(
+                        "MultiParticleLevelSet colors must be unique" );
+        }
+
+        // Extract parameters.
+        const auto& params = inputs["particle_level_set"];
+
+        // Particles have an analytic spherical level set. Get the radius as a
+        // fraction of the cell size.
+        _dx = mesh->localGrid()->globalGrid().globalMesh().cellSize( 0 );
+        _radius = 0.5;
+        if ( params.contains( "particle_radius" ) )
+            _radius = params["particle_radius"];
+        _radius *= _dx;
+
+        // Create a level set for each color.
+        for ( std::size_t n = 0; n < _colors.size(); ++n )
+            _ls.push_back(
+                createLevelSet<SignedDistanceLocation>( inputs, mesh ) );
+
+        // Create the combined distance estimate with one component per color
+        // and a single halo for all of them.
+        auto layout = Cabana::Grid::createArrayLayout(
+            mesh->localGrid(), static_cast<int>( _colors.size() ),
+            entity_type() );
+        _distance_estimate = Cabana::Grid::createArray<double, memory_space>(
+            "multi_distance_estimate", layout );
+        _halo = Cabana::Grid::createHalo( Cabana::Grid::NodeHaloPattern<3>(),
+                                          -1, *_distance_estimate );
+
+        // Copy the colors to the device for sorting the particles.
+        _color_view = Kokkos::View<int*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "colors" ),
+            _colors.size() );
+        auto color_host = Kokkos::create_mirror_view( _color_view );
+        for ( std::size_t n = 0; n < _colors.size(); ++n )
+            color_host( n ) = _colors[n];
+        Kokkos::deep_copy( _color_view, color_host );
+
+        // There are no particles of any color until the colors are updated.
+        _color_offsets.assign( _colors.size() + 1, 0 );
+    }
+
+    // Get the number of colors.
+    int numColor() const { return _colors.size(); }
+
+    // Get the color of a given level set.
+    int color( const int n ) const { return _colors[n]; }
+
+    // Get the indices of the particles of all colors grouped by color.
+    Kokkos::View<const int*, memory_space> colorIndex() const
+    {
+        return _color_indices;
+    }
+
+    // Get the offset of the particles of a given color slot in the color
+    // indices.
+    int colorOffset( const int n ) const { return _color_offsets[n]; }
+
+    // Get the number of particles of all colors.
+    int colorCount() const { return _color_offsets.back(); }
+
+    // Get the number of particles of a given color slot.
+    int colorCount( const int n ) const
+    {
+        return _color_offsets[n + 1] - _color_offsets[n];
+    }
+
+    /*!
+      \brief Update the set of particle indices for all of the colors we are
+      building level sets for. This operation is needed any time the particle
+      population is updated (e.g. after a redistribution).
+      \param exec_space The execution space to use for parallel kernels.
+      \param c_p A view or slice containing the particle colors. The number
+      and order of particles with respect to these colors must remain
+      consistent in between calls to this function (e.g. in subsequent calls
+      to estimateSignedDistance()).
+    */
+    template <class ExecutionSpace, class ParticleColors>
+    void updateParticleColors( const ExecutionSpace& exec_space,
+                               const ParticleColors& c_p )
+    {
+        Kokkos::Profiling::pushRegion(
+            "Picasso::MultiParticleLevelSet::updateParticleColors" );
+
+        int num_particle = c_p.size();
+        int num_color = _colors.size();
+
+        // Initialize color indices.
+        _color_indices = Kokkos::View<int*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "color_indices" ),
+            num_particle );
+
+        // Group the particles by color with a counting sort. The particles
+        // are divided into fixed size chunks which are each processed in
+        // order by one thread so the indices of a color are in increasing
+        // order independent of the execution space and number of threads.
+        const int chunk_size = 1024;
+        int num_chunk = ( num_particle + chunk_size - 1 ) / chunk_size;
+        auto colors = _color_view;
+
+        // Count the particles of each color in each chunk. Counts are stored
+        // with the chunk index varying fastest.
+        Kokkos::View<int*, memory_space> counts( "color_counts",
+                                                 num_color * num_chunk );
+        Kokkos::parallel_for(
+            "Picasso::MultiParticleLevelSet::CountColor",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_chunk ),
+            KOKKOS_LAMBDA( const int b ) {
+                int end = Kokkos::min( ( b + 1 ) * chunk_size, num_particle );
+                for ( int p = b * chunk_size; p < end; ++p )
+                {
+                    int n = colorSlot( colors, c_p( p ) );
+                    if ( n >= 0 )
+                        ++counts( n * num_chunk + b );
+                }
+            } );
+
+        // Scan the counts to get the first position of each color in each
+        // chunk.
+        int num_selected = 0;
+        Kokkos::parallel_scan(
+            "Picasso::MultiParticleLevelSet::ScanColor",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 num_color * num_chunk ),
+            KOKKOS_LAMBDA( const int i, int& position, const bool final_pass ) {
+                int count = counts( i );
+                if ( final_pass )
+                    counts( i ) = position;
+                position += count;
+            },
+            num_selected );
+
+        // Get the offset of each color.
+        _color_offsets.assign( num_color + 1, 0 );
+        if ( num_chunk > 0 )
+        {
+            Kokkos::View<int*, memory_space> offsets(
+                Kokkos::ViewAllocateWithoutInitializing( "color_offsets" ),
+                num_color );
+            Kokkos::parallel_for(
+                "Picasso::MultiParticleLevelSet::ColorOffsets",
+                Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                     num_color ),
+                KOKKOS_LAMBDA( const int n ) {
+                    offsets( n ) = counts( n * num_chunk );
+                } );
+            auto offsets_host = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), offsets );
+            for ( int n = 0; n < num_color; ++n )
+                _color_offsets[n] = offsets_host( n );
+        }
+        _color_offsets[num_color] = num_selected;
+
+        // Write the indices of each chunk at the positions of its colors.
+        auto color_indices = _color_indices;
+        Kokkos::parallel_for(
+            "Picasso::MultiParticleLevelSet::SortColor",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_chunk ),
+            KOKKOS_LAMBDA( const int b ) {
+                int end = Kokkos::min( ( b + 1 ) * chunk_size, num_particle );
+                for ( int p = b * chunk_size; p < end; ++p )
+                {
+                    int n = colorSlot( colors, c_p( p ) );
+                    if ( n >= 0 )
+                        color_indices( counts( n * num_chunk + b )++ ) = p;
+                }
+            } );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Compute the signed distance function estimate of every color
+      from the current particle locations. Each color queries its own tree
+      for the closest particle of that color and all colors share a single
+      halo reduction. All the positive values will be correct but the
+      negative values will only have the correct sign until redistanced.
+      \param exec_space The execution space to use for parallel kernels.
+      \param x_p A view or slice of particle positions. If the grid is
+      adaptive these positions must be in the logical frame. The number and
+      order of particles with respect to these positions must be consistent
+      with the colors provided to the last call to updateParticleColors().
+    */
+    template <class ExecutionSpace, class ParticlePositions>
+    void estimateSignedDistance( const ExecutionSpace& exec_space,
+                                 const ParticlePositions& x_p )
+    {
+        Kokkos::Profiling::pushRegion(
+            "Picasso::MultiParticleLevelSet::estimateSignedDistance" );
+
+        // View of the combined distance estimate.
+        auto estimate_view = _distance_estimate->view();
+
+        // Local mesh.
+        auto local_grid = _distance_estimate->layout()->localGrid();
+        auto local_mesh =
+            Cabana::Grid::createLocalMesh<memory_space>( *local_grid );
+
+        // Start every color at the minimum halo width. This is the minimum
+        // distance to a particle surface we could have resolved that wouldn't
+        // show up in the min-reduce operation so entities without particles
+        // of a color within this distance keep it.
+        double min_dist = _dx * local_grid->haloCellWidth();
+        Cabana::Grid::ArrayOp::assign( *_distance_estimate, min_dist,
+                                       Cabana::Grid::Ghost() );
+
+        // Build a tree from the particles of each color and query it with
+        // the mesh entities to find the closest particle of that color.
+        ParticleLevelSetPredicateData<decltype( local_mesh ), entity_type>
+            predicate_data( local_mesh, *local_grid );
+        for ( std::size_t n = 0; n < _colors.size(); ++n )
+        {
+            // If we have no particles of this color on this rank the entities
+            // keep the minimum halo width.
+            if ( 0 == colorCount( n ) )
+                continue;
+
+            // Build the tree.
+            ParticleLevelSetPrimitiveData<ParticlePositions,
+                                          Kokkos::View<int*, memory_space>>
+                primitive_data;
+            primitive_data.x = x_p;
+            primitive_data.c = Kokkos::subview(
+                _color_indices,
+                Kokkos::make_pair( _color_offsets[n], _color_offsets[n + 1] ) );
+            primitive_data.num_color = colorCount( n );
+#if ARBORX_VERSION < 10799
+            ArborX::BVH<memory_space> bvh( exec_space, primitive_data );
+#else
+            ArborX::BoundingVolumeHierarchy bvh( exec_space, primitive_data );
+#endif
+
+            // Make the distance callback for the component of this color.
+            int s = n;
+            auto color_view =
+                Kokkos::subview( estimate_view, Kokkos::ALL(), Kokkos::ALL(),
+                                 Kokkos::ALL(), Kokkos::make_pair( s, s + 1 ) );
+#if ARBORX_VERSION < 10799
+            ParticleLevelSetCallback<ParticlePositions, decltype( color_view )>
+                distance_callback{ primitive_data, color_view,
+                                   static_cast<float>( _radius ) };
+#else
+            ParticleLevelSetCallback<decltype( color_view )> distance_callback{
+                color_view, static_cast<float>( _radius ) };
+#endif
+
+            // Query the particle tree with the mesh entities.
+            bvh.query( exec_space, predicate_data, distance_callback );
+        }
+
+        // Do a single reduction for all colors to get the minimum distance
+        // within the minimum halo width.
+        _halo->scatter( exec_space, Cabana::Grid::ScatterReduce::Min(),
+                        *_distance_estimate );
+
+        // Copy each color into its level set.
+        auto ghost_entities = local_grid->indexSpace(
+            Cabana::Grid::Ghost(), entity_type(), Cabana::Grid::Local() );
+        for ( std::size_t n = 0; n < _colors.size(); ++n )
+        {
+            auto ls_view = _ls[n]->getDistanceEstimate()->view();
+            int s = n;
+            Kokkos::parallel_for(
+                "Picasso::MultiParticleLevelSet::CopyEstimate",
+                Cabana::Grid::createExecutionPolicy( ghost_entities,
+                                                     exec_space ),
+                KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                    ls_view( i, j, k, 0 ) = estimate_view( i, j, k, s );
+                } );
+        }
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Redistance the level set of every color.
+      \param exec_space The execution space to use for parallel kernels.
+    */
+    template <class ExecutionSpace>
+    void redistance( const ExecutionSpace& exec_space )
+    {
+        for ( auto& ls : _ls )
+            ls->redistance( exec_space );
+    }
+
+    // Get the particle radius.
+    double particleRadius() const { return _radius; }
+
+    // Get the level set of a given color slot.
+    std::shared_ptr<level_set> levelSet( const int n ) const
+    {
+        return _ls[n];
+    }
+
+    // Get the combined distance estimate with one component per color.
+    std::shared_ptr<array_type> getDistanceEstimate() const
+    {
+        return _distance_estimate;
+    }
+
+  private:
+    // Get the slot of a particle color or -1 if it is not one of the colors.
+    template <class ColorView>
+    static KOKKOS_INLINE_FUNCTION int colorSlot( const ColorView& colors,
+                                                 const int color )
+    {
+        for ( std::size_t n = 0; n < colors.extent( 0 ); ++n )
+            if ( color == colors( n ) )
+                return n;
+        return -1;
+    }
+
+  private:
+    std::vector<int> _colors;
+    Kokkos::View<int*, memory_space> _color_view;
+    double _radius;
+    double _dx;
+    Kokkos::View<int*, memory_space> _color_indices;
+    std::vector<int> _color_offsets;
+    std::vector<std::shared_ptr<level_set>> _ls;
+    std::shared_ptr<array_type> _distance_estimate;
+    std::shared_ptr<halo_type> _halo;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a multi-color particle level set over particles of the given
+  colors.
+  \param inputs Level set settings.
+  \param mesh The mesh over which to build the signed distance functions.
+  \param colors The particle colors over which to build the level sets.
+*/
+template <class SignedDistanceLocation, class MeshType>
+std::shared_ptr<MultiParticleLevelSet<MeshType, SignedDistanceLocation>>
+createMultiParticleLevelSet( const nlohmann::json& inputs,
+                             const std::shared_ptr<MeshType>& mesh,
+                             const std::vector<int>& colors )
+{
+    return std::make_shared<
+        MultiParticleLevelSet<MeshType, SignedDistanceLocation>>( inputs, mesh,
+                                                                  colors );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Picasso
@@ -114,7 +114,9 @@ get( const ParticleType& particle, FieldTag tag )
 // and ParticleView)
 template <class ParticleType, class FieldTag>
 KOKKOS_FORCEINLINE_FUNCTION typename std::enable_if<
-    LinearAlgebra::is_matrix<typename FieldTag::linear_algebra_type>::value,
+    LinearAlgebra::is_matrix<typename FieldTag::linear_algebra_type>::value &&
+        !LinearAlgebra::is_symmetric_matrix<
+            typename FieldTag::linear_algebra_type>::value,
     typename FieldTag::linear_algebra_type>::type
 get( ParticleType& particle, FieldTag tag )
 {
@@ -126,7 +128,9 @@ get( ParticleType& particle, FieldTag tag )
 
 template <class ParticleType, class FieldTag>
 KOKKOS_FORCEINLINE_FUNCTION typename std::enable_if<
-    LinearAlgebra::is_matrix<typename FieldTag::linear_algebra_type>::value,
+    LinearAlgebra::is_matrix<typename FieldTag::linear_algebra_type>::value &&
+        !LinearAlgebra::is_symmetric_matrix<
+            typename FieldTag::linear_algebra_type>::value,
     const typename FieldTag::linear_algebra_type>::type
 get( const ParticleType& particle, FieldTag tag )
 {
@@ -137,6 +141,37 @@ get( const ParticleType& particle, FieldTag tag )
         ParticleType::vector_length );
 }
 
+//---------------------------------------------------------------------------//
+// Get a view of a particle member as a packed symmetric matrix or symmetric
+// tensor4. (Works for both Particle and ParticleView)
+template <class ParticleType, class FieldTag>
+KOKKOS_FORCEINLINE_FUNCTION typename std::enable_if<
+    LinearAlgebra::is_symmetric_matrix<
+        typename FieldTag::linear_algebra_type>::value ||
+        LinearAlgebra::is_symmetric_tensor4<
+            typename FieldTag::linear_algebra_type>::value,
+    typename FieldTag::linear_algebra_type>::type
+get( ParticleType& particle, FieldTag tag )
+{
+    return typename FieldTag::linear_algebra_type(
+        &( Cabana::get( particle, tag, 0 ) ), ParticleType::vector_length );
+}
+
+template <class ParticleType, class FieldTag>
+KOKKOS_FORCEINLINE_FUNCTION typename std::enable_if<
+    LinearAlgebra::is_symmetric_matrix<
+        typename FieldTag::linear_algebra_type>::value ||
+        LinearAlgebra::is_symmetric_tensor4<
+            typename FieldTag::linear_algebra_type>::value,
+    const typename FieldTag::linear_algebra_type>::type
+get( const ParticleType& particle, FieldTag tag )
+{
+    return typename FieldTag::linear_algebra_type(
+        const_cast<typename FieldTag::value_type*>(
+            &( Cabana::get( particle, tag, 0 ) ) ),
+        ParticleType::vector_length );
+}
+
 } // end namespace Picasso
 
 #endif // end PICASSO_PARTICLELIST_HPP
@@ -0,0 +1,450 @@
+/****************************************************************************
+ * Copyright (c) 2021 by the Picasso authors                                *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Picasso library. Picasso is distributed under a *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef PICASSO_PARTICLERESAMPLE_HPP
+#define PICASSO_PARTICLERESAMPLE_HPP
+
+#include <Picasso_FieldTypes.hpp>
+#include <Picasso_ParticleInit.hpp>
+#include <Picasso_Types.hpp>
+#include <Picasso_UniformMesh.hpp>
+
+#include <Cabana_Core.hpp>
+#include <Cabana_Grid.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <mpi.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace Picasso
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Particle resampler. Controls the number of particles per cell by
+  splitting the particles of under-populated cells and merging the particles
+  of over-populated cells.
+
+  Particles of a cell with fewer than the minimum number of particles are
+  each split into enough children to reach the minimum. Children are placed
+  symmetrically about the parent along one axis and share its mass and
+  volume equally. They keep the velocity and affine matrix of the parent.
+
+  Particles of a cell with more than the maximum number of particles are
+  merged in groups, in order of particle index, so that the cell has at most
+  the maximum. A merged particle is placed at the center of mass of its group
+  and gets the total mass, total volume, and mass-averaged velocity of the
+  group. Its affine matrix preserves the affine momentum of the group about
+  the new center of mass. All other particle fields of a merged particle are
+  taken from the first particle of the group.
+
+  Both operations conserve mass, volume, linear momentum, and the APIC affine
+  momentum of the particles in each cell. Only particles located in the local
+  owned cells are resampled. Split children may move into neighboring cells
+  so particles should be redistributed after resampling as after any other
+  particle update.
+
+  \tparam MeshType The uniform mesh type.
+
+  \tparam PositionTag The particle physical position field.
+
+  \tparam MassTag The particle mass field.
+
+  \tparam VolumeTag The particle volume field.
+
+  \tparam AffineVelocityTag The APIC particle velocity field. This is a 4x3
+  matrix with the particle velocity in the first row and the transpose of the
+  affine matrix in the remaining rows.
+*/
+template <class MeshType, class PositionTag, class MassTag, class VolumeTag,
+          class AffineVelocityTag>
+class ParticleResampler
+{
+  public:
+    using mesh_type = MeshType;
+    using memory_space = typename mesh_type::memory_space;
+
+    static_assert( is_uniform_mesh<MeshType>::value,
+                   "Particle resampling requires a uniform mesh" );
+
+    static_assert( 4 == AffineVelocityTag::dim0 &&
+                       3 == AffineVelocityTag::dim1,
+                   "Particle resampling requires a 4x3 APIC velocity" );
+
+    /*!
+      \brief Construct the resampler over the given mesh.
+      \param inputs Resampling settings.
+      \param mesh The mesh over which particles are counted.
+    */
+    ParticleResampler( const nlohmann::json& inputs,
+                       const std::shared_ptr<MeshType>& mesh )
+        : _mesh( mesh )
+    {
+        // Extract parameters.
+        const auto& params = inputs["particle_resample"];
+        _min_particles_per_cell = params["min_particles_per_cell"];
+        _max_particles_per_cell = params["max_particles_per_cell"];
+        if ( params.contains( "frequency" ) )
+            _frequency = params["frequency"];
+
+        // A split cell must not need merging and vice versa.
+        if ( _min_particles_per_cell < 1 ||
+             _max_particles_per_cell < 2 * _min_particles_per_cell )
+            throw std::runtime_error( "Particle resampling requires a "
+                                      "maximum of at least twice the minimum "
+                                      "particles per cell" );
+        if ( _frequency < 1 )
+            throw std::runtime_error(
+                "Particle resampling frequency must be positive" );
+    }
+
+    // Minimum number of particles per cell.
+    int minParticlesPerCell() const { return _min_particles_per_cell; }
+
+    // Maximum number of particles per cell.
+    int maxParticlesPerCell() const { return _max_particles_per_cell; }
+
+    // Number of steps between resampling.
+    int frequency() const { return _frequency; }
+
+    /*!
+      \brief Resample the particles if the given step is a multiple of the
+      resampling frequency.
+      \param exec_space The execution space to use for parallel kernels.
+      \param particle_list The particles to resample.
+      \param step The current time step.
+      \return True if the particles were resampled.
+    */
+    template <class ExecutionSpace, class ParticleListType>
+    bool apply( const ExecutionSpace& exec_space,
+                ParticleListType& particle_list, const int step ) const
+    {
+        if ( 0 != step % _frequency )
+            return false;
+        resample( exec_space, particle_list );
+        return true;
+    }
+
+    /*!
+      \brief Resample the particles.
+      \param exec_space The execution space to use for parallel kernels.
+      \param particle_list The particles to resample.
+    */
+    template <class ExecutionSpace, class ParticleListType>
+    void resample( const ExecutionSpace& exec_space,
+                   ParticleListType& particle_list ) const
+    {
+        Kokkos::Profiling::pushRegion( "Picasso::ParticleResampler::resample" );
+
+        auto& particles = particle_list.aosoa();
+        int num_particle = particles.size();
+
+        // Get the local owned cells.
+        const auto& local_grid = *( _mesh->localGrid() );
+        auto local_mesh =
+            Cabana::Grid::createLocalMesh<Kokkos::HostSpace>( local_grid );
+        auto owned_cells = local_grid.indexSpace(
+            Cabana::Grid::Own(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+        Kokkos::Array<double, 3> low_corner;
+        Kokkos::Array<long, 3> owned_min;
+        Kokkos::Array<long, 3> owned_extent;
+        for ( int d = 0; d < 3; ++d )
+        {
+            low_corner[d] = local_mesh.lowCorner( Cabana::Grid::Ghost(), d );
+            owned_min[d] = owned_cells.min( d );
+            owned_extent[d] = owned_cells.extent( d );
+        }
+        double dx = _mesh->cellSize();
+        int num_cell = owned_cells.size();
+        int min_ppc = _min_particles_per_cell;
+        int max_ppc = _max_particles_per_cell;
+
+        // Locate the owned cell of each particle and count the particles in
+        // each owned cell. Particles outside of the owned cells are not
+        // resampled.
+        auto x_p = particle_list.slice( PositionTag() );
+        Kokkos::View<int*, memory_space> particle_cell(
+            Kokkos::ViewAllocateWithoutInitializing( "particle_cell" ),
+            num_particle );
+        Kokkos::View<int*, memory_space> cell_count( "cell_count", num_cell );
+        Kokkos::parallel_for(
+            "Picasso::ParticleResampler::Count",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_particle ),
+            KOKKOS_LAMBDA( const int p ) {
+                long c[3];
+                bool owned = true;
+                for ( int d = 0; d < 3; ++d )
+                {
+                    c[d] = static_cast<long>(
+                               Kokkos::floor( ( x_p( p, d ) - low_corner[d] ) /
+                                              dx ) ) -
+                           owned_min[d];
+                    owned = owned && c[d] >= 0 && c[d] < owned_extent[d];
+                }
+                int cell = -1;
+                if ( owned )
+                {
+                    cell = c[Dim::I] +
+                           owned_extent[Dim::I] *
+                               ( c[Dim::J] + owned_extent[Dim::J] * c[Dim::K] );
+                    Kokkos::atomic_increment( &cell_count( cell ) );
+                }
+                particle_cell( p ) = cell;
+            } );
+
+        // Resampling factor of each cell. Positive values greater than one
+        // give the number of children of each particle of a split cell and
+        // negative values give the size of the merged groups of a merged
+        // cell.
+        Kokkos::View<int*, memory_space> cell_factor(
+            Kokkos::ViewAllocateWithoutInitializing( "cell_factor" ),
+            num_cell );
+        int num_resample_cell = 0;
+        Kokkos::parallel_reduce(
+            "Picasso::ParticleResampler::Factor",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_cell ),
+            KOKKOS_LAMBDA( const int c, int& result ) {
+                int count = cell_count( c );
+                int factor = 1;
+                if ( count > 0 && count < min_ppc )
+                    factor = ( min_ppc + count - 1 ) / count;
+                else if ( count > max_ppc )
+                    factor = -( ( count + max_ppc - 1 ) / max_ppc );
+                cell_factor( c ) = factor;
+                if ( 1 != factor )
+                    ++result;
+            },
+            num_resample_cell );
+        MPI_Allreduce( MPI_IN_PLACE, &num_resample_cell, 1, MPI_INT, MPI_SUM,
+                       local_grid.globalGrid().comm() );
+        if ( 0 == num_resample_cell )
+        {
+            Kokkos::Profiling::popRegion();
+            return;
+        }
+
+        // Compute the offset of the first child of each split particle.
+        Kokkos::View<int*, memory_space> child_offset(
+            Kokkos::ViewAllocateWithoutInitializing( "child_offset" ),
+            num_particle );
+        int num_child = 0;
+        Kokkos::parallel_scan(
+            "Picasso::ParticleResampler::ChildOffset",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_particle ),
+            KOKKOS_LAMBDA( const int p, int& offset, const bool final_pass ) {
+                int cell = particle_cell( p );
+                int factor = ( cell >= 0 ) ? cell_factor( cell ) : 1;
+                if ( final_pass )
+                    child_offset( p ) = offset;
+                if ( factor > 1 )
+                    offset += factor - 1;
+            },
+            num_child );
+
+        // Split particles. Children are appended to the list.
+        particles.resize( num_particle + num_child );
+        x_p = particle_list.slice( PositionTag() );
+        auto m_p = particle_list.slice( MassTag() );
+        auto v_p = particle_list.slice( VolumeTag() );
+        Kokkos::parallel_for(
+            "Picasso::ParticleResampler::Split",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_particle ),
+            KOKKOS_LAMBDA( const int p ) {
+                int cell = particle_cell( p );
+                int factor = ( cell >= 0 ) ? cell_factor( cell ) : 1;
+                if ( factor < 2 )
+                    return;
+
+                // Children are spaced evenly over the particle length scale
+                // along an axis which alternates between particles.
+                int axis = p % 3;
+                double spacing = Kokkos::cbrt( v_p( p ) ) / factor;
+                double mass = m_p( p ) / factor;
+                double volume = v_p( p ) / factor;
+                double x = x_p( p, axis );
+                for ( int n = 1; n < factor; ++n )
+                {
+                    int child = num_particle + child_offset( p ) + n - 1;
+                    particles.setTuple( child, particles.getTuple( p ) );
+                    x_p( child, axis ) =
+                        x + ( n - 0.5 * ( factor - 1 ) ) * spacing;
+                    m_p( child ) = mass;
+                    v_p( child ) = volume;
+                }
+                x_p( p, axis ) = x - 0.5 * ( factor - 1 ) * spacing;
+                m_p( p ) = mass;
+                v_p( p ) = volume;
+            } );
+
+        // Gather the particles of each merged cell.
+        Kokkos::View<int*, memory_space> cell_offset(
+            Kokkos::ViewAllocateWithoutInitializing( "cell_offset" ),
+            num_cell );
+        int num_merge_particle = 0;
+        Kokkos::parallel_scan(
+            "Picasso::ParticleResampler::MergeOffset",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_cell ),
+            KOKKOS_LAMBDA( const int c, int& offset, const bool final_pass ) {
+                int count = ( cell_factor( c ) < 0 ) ? cell_count( c ) : 0;
+                if ( final_pass )
+                    cell_offset( c ) = offset;
+                offset += count;
+            },
+            num_merge_particle );
+        Kokkos::View<int*, memory_space> merge_particles(
+            Kokkos::ViewAllocateWithoutInitializing( "merge_particles" ),
+            num_merge_particle );
+        Kokkos::deep_copy( cell_count, 0 );
+        Kokkos::parallel_for(
+            "Picasso::ParticleResampler::MergeGather",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_particle ),
+            KOKKOS_LAMBDA( const int p ) {
+                int cell = particle_cell( p );
+                if ( cell >= 0 && cell_factor( cell ) < 0 )
+                {
+                    int n = Kokkos::atomic_fetch_add( &cell_count( cell ), 1 );
+                    merge_particles( cell_offset( cell ) + n ) = p;
+                }
+            } );
+
+        // Merge groups of particles in each merged cell. The first particle
+        // of each group is replaced by the merged particle and the rest are
+        // removed.
+        Kokkos::View<bool*, memory_space> keep( "keep",
+                                                num_particle + num_child );
+        Kokkos::deep_copy( keep, true );
+        auto c_p = particle_list.slice( AffineVelocityTag() );
+        int num_removed = 0;
+        Kokkos::parallel_reduce(
+            "Picasso::ParticleResampler::Merge",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0, num_cell ),
+            KOKKOS_LAMBDA( const int c, int& removed ) {
+                int group_size = -cell_factor( c );
+                if ( group_size < 2 )
+                    return;
+
+                // Sort the cell particles by index so the groups do not
+                // depend on the order they were gathered in.
+                int begin = cell_offset( c );
+                int end = begin + cell_count( c );
+                for ( int n = begin + 1; n < end; ++n )
+                {
+                    int p = merge_particles( n );
+                    int m = n;
+                    for ( ; m > begin && merge_particles( m - 1 ) > p; --m )
+                        merge_particles( m ) = merge_particles( m - 1 );
+                    merge_particles( m ) = p;
+                }
+
+                for ( int g = begin; g < end; g += group_size )
+                {
+                    int g_end = Kokkos::min( g + group_size, end );
+
+                    // Total mass, volume, and momentum and the center of
+                    // mass of the group.
+                    double mass = 0.0;
+                    double volume = 0.0;
+                    double mx[3] = { 0.0, 0.0, 0.0 };
+                    double mv[3] = { 0.0, 0.0, 0.0 };
+                    for ( int n = g; n < g_end; ++n )
+                    {
+                        int p = merge_particles( n );
+                        mass += m_p( p );
+                        volume += v_p( p );
+                        for ( int d = 0; d < 3; ++d )
+                        {
+                            mx[d] += m_p( p ) * x_p( p, d );
+                            mv[d] += m_p( p ) * c_p( p, 0, d );
+                        }
+                    }
+                    if ( !( mass > 0.0 ) )
+                        continue;
+
+                    // Affine momentum of the group about its center of mass.
+                    double mb[3][3] = { { 0.0, 0.0, 0.0 },
+                                        { 0.0, 0.0, 0.0 },
+                                        { 0.0, 0.0, 0.0 } };
+                    for ( int n = g; n < g_end; ++n )
+                    {
+                        int p = merge_particles( n );
+                        for ( int a = 0; a < 3; ++a )
+                            for ( int d = 0; d < 3; ++d )
+                                mb[a][d] +=
+                                    m_p( p ) *
+                                    ( c_p( p, a + 1, d ) +
+                                      c_p( p, 0, d ) *
+                                          ( x_p( p, a ) - mx[a] / mass ) );
+                    }
+
+                    // Replace the first particle of the group with the merged
+                    // particle.
+                    int merged = merge_particles( g );
+                    m_p( merged ) = mass;
+                    v_p( merged ) = volume;
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        x_p( merged, d ) = mx[d] / mass;
+                        c_p( merged, 0, d ) = mv[d] / mass;
+                        for ( int a = 0; a < 3; ++a )
+                            c_p( merged, a + 1, d ) = mb[a][d] / mass;
+                    }
+                    for ( int n = g + 1; n < g_end; ++n )
+                    {
+                        keep( merge_particles( n ) ) = false;
+                        ++removed;
+                    }
+                }
+            },
+            num_removed );
+
+        // Remove the merged particles.
+        filterEmpties( exec_space, num_particle + num_child - num_removed, 0,
+                       keep, particles, false );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+  private:
+    std::shared_ptr<MeshType> _mesh;
+    int _min_particles_per_cell;
+    int _max_particles_per_cell;
+    int _frequency = 1;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a particle resampler.
+  \param inputs Resampling settings.
+  \param mesh The mesh over which particles are counted.
+*/
+template <class PositionTag, class MassTag, class VolumeTag,
+          class AffineVelocityTag, class MeshType>
+std::shared_ptr<ParticleResampler<MeshType, PositionTag, MassTag, VolumeTag,
+                                  AffineVelocityTag>>
+createParticleResampler( const nlohmann::json& inputs,
+                         const std::shared_ptr<MeshType>& mesh, PositionTag,
+                         MassTag, VolumeTag, AffineVelocityTag )
+{
+    return std::make_shared<ParticleResampler<MeshType, PositionTag, MassTag,
+                                              VolumeTag, AffineVelocityTag>>(
+        inputs, mesh );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Picasso
+
+#endif // end PICASSO_PARTICLERESAMPLE_HPP
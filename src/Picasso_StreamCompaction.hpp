@@ -0,0 +1,113 @@
+/****************************************************************************
+ * Copyright (c) 2021 by the Picasso authors                                *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Picasso library. Picasso is distributed under a *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef PICASSO_STREAMCOMPACTION_HPP
+#define PICASSO_STREAMCOMPACTION_HPP
+
+#include <Kokkos_Core.hpp>
+
+#include <string>
+
+namespace Picasso
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Stream compaction over an index range. Every index selected in the
+  range is passed to the output functor along with its position in the
+  compacted list. Positions are assigned by an exclusive scan and therefore
+  preserve the order of the indices in the range independent of the
+  execution space and number of threads.
+
+  \param label Kernel label.
+
+  \param exec_space The execution space to use for the scan.
+
+  \param begin The first index in the range.
+
+  \param end One past the last index in the range.
+
+  \param select_functor A functor returning true if an index is selected with
+  the signature:
+
+      bool select( const int i );
+
+  \param output_functor A functor called once for every selected index with
+  the signature:
+
+      void output( const int i, const int position );
+
+  \return The number of selected indices.
+*/
+template <class ExecutionSpace, class SelectFunctor, class OutputFunctor>
+int streamCompact( const std::string& label, const ExecutionSpace& exec_space,
+                   const int begin, const int end,
+                   const SelectFunctor& select_functor,
+                   const OutputFunctor& output_functor )
+{
+    int count = 0;
+    if ( end <= begin )
+        return count;
+
+    Kokkos::parallel_scan(
+        label, Kokkos::RangePolicy<ExecutionSpace>( exec_space, begin, end ),
+        KOKKOS_LAMBDA( const int i, int& position, const bool final_pass ) {
+            if ( select_functor( i ) )
+            {
+                if ( final_pass )
+                    output_functor( i, position );
+                ++position;
+            }
+        },
+        count );
+    return count;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Compact the selected indices of a range into a view in increasing
+  order.
+
+  \param label Kernel label.
+
+  \param exec_space The execution space to use for the scan.
+
+  \param begin The first index in the range.
+
+  \param end One past the last index in the range.
+
+  \param select_functor A functor returning true if an index is selected with
+  the signature:
+
+      bool select( const int i );
+
+  \param indices The compacted indices. Must be at least as large as the
+  number of selected indices.
+
+  \return The number of selected indices.
+*/
+template <class ExecutionSpace, class SelectFunctor, class IndexView>
+int compactIndices( const std::string& label, const ExecutionSpace& exec_space,
+                    const int begin, const int end,
+                    const SelectFunctor& select_functor,
+                    const IndexView& indices )
+{
+    return streamCompact(
+        label, exec_space, begin, end, select_functor,
+        KOKKOS_LAMBDA( const int i, const int position ) {
+            indices( position ) = i;
+        } );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Picasso
+
+#endif // end PICASSO_STREAMCOMPACTION_HPP
@@ -11,6 +11,8 @@
 
 #include <Picasso_APIC.hpp>
 #include <Picasso_BatchedLinearAlgebra.hpp>
+#include <Picasso_BilinearMeshMapping.hpp>
+#include <Picasso_CurvilinearMesh.hpp>
 #include <Picasso_FieldManager.hpp>
 #include <Picasso_InputParser.hpp>
 #include <Picasso_ParticleInterpolation.hpp>
@@ -841,6 +843,290 @@ void staggeredTest()
                    near_eps );
 }
 
+//---------------------------------------------------------------------------//
+// Curvilinear
+//---------------------------------------------------------------------------//
+// Transfer an affine node field u = A x + b on a distorted bilinear mesh. The
+// APIC round trip reproduces the nodal values for any spline order. Linear
+// splines in the reference frame also interpolate the field exactly in the
+// physical frame so the G2P gradient and divergence are exact, and the P2G
+// gradient and divergence are checked through their adjoint identities,
+// e.g. sum_i u_i . ( sum_p s_p grad w_ip ) = sum_p s_p div u(x_p).
+template <int Order>
+void curvilinearTest( const bool cached_metrics, const bool on_entity = false )
+{
+    // Test epsilon
+    double near_eps = 1.0e-10;
+
+    // Distorted mesh. With cached metrics the mesh is sheared instead so the
+    // jacobian is constant and the cell center metrics are exact.
+    Kokkos::Array<double, 6> global_box = { -5.0, -5.0, -5.0, 5.0, 5.0, 5.0 };
+    Kokkos::Array<bool, 3> periodic = { false, false, false };
+    UniformBilinearMeshGenerator<3> generator = { 0.5, global_box, periodic };
+    std::array<int, 3> ranks_per_dim = { 1, 1, 1 };
+    auto manager = createBilinearMesh( TEST_MEMSPACE{}, generator, 2,
+                                       MPI_COMM_WORLD, ranks_per_dim );
+    auto mapping = manager->mesh()->mapping();
+    using mapping_type = decltype( mapping );
+    auto local_grid = manager->mesh()->localGrid();
+    auto local_mesh =
+        Cabana::Grid::createLocalMesh<TEST_EXECSPACE>( *local_grid );
+
+    auto x_view = manager->view( FieldLocation::Node{},
+                                 Field::PhysicalPosition<3>{} );
+    auto x_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{}, x_view );
+    for ( std::size_t i = 0; i < x_host.extent( 0 ); ++i )
+        for ( std::size_t j = 0; j < x_host.extent( 1 ); ++j )
+            for ( std::size_t k = 0; k < x_host.extent( 2 ); ++k )
+            {
+                double x[3];
+                for ( int d = 0; d < 3; ++d )
+                    x[d] = x_host( i, j, k, d );
+                for ( int d = 0; d < 3; ++d )
+                    x_host( i, j, k, d ) +=
+                        cached_metrics ? 0.1 * x[( d + 1 ) % 3]
+                                       : 0.1 * std::sin( x[( d + 1 ) % 3] );
+            }
+    Kokkos::deep_copy( x_view, x_host );
+    addMetricFields( CellCenterQuadrature<3>{}, TEST_EXECSPACE{}, *manager );
+    auto metrics = createCachedMetrics( CellCenterQuadrature<3>{}, *manager );
+
+    // Affine field.
+    LinearAlgebra::Matrix<double, 3, 3> A;
+    Vec3<double> b;
+    for ( int d = 0; d < 3; ++d )
+    {
+        b( d ) = 1.0 + d;
+        for ( int e = 0; e < 3; ++e )
+            A( d, e ) = 0.2 * ( d + 1.0 ) - 0.1 * e * e;
+    }
+    manager->add( FieldLocation::Node{}, Foo{} );
+    manager->add( FieldLocation::Node{}, Baz{} );
+    auto u_view = manager->view( FieldLocation::Node{}, Foo{} );
+    auto m_view = manager->view( FieldLocation::Node{}, Baz{} );
+    Cabana::Grid::grid_parallel_for(
+        "fill_node_field", TEST_EXECSPACE(),
+        local_grid->indexSpace( Cabana::Grid::Ghost(), Cabana::Grid::Node(),
+                                Cabana::Grid::Local() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            for ( int d = 0; d < 3; ++d )
+            {
+                u_view( i, j, k, d ) = b( d );
+                for ( int e = 0; e < 3; ++e )
+                    u_view( i, j, k, d ) += A( d, e ) * x_view( i, j, k, e );
+            }
+        } );
+    auto u_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), u_view );
+
+    // One particle in each owned cell. Particles may instead be placed on
+    // a node plane where the linear spline inertia tensor is singular.
+    auto owned_cells = local_grid->indexSpace(
+        Cabana::Grid::Own(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+    int num_particle = owned_cells.size();
+    Kokkos::View<double* [3], TEST_MEMSPACE> x_ref( "x_ref", num_particle );
+    Kokkos::parallel_for(
+        "init_particles",
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_particle ),
+        KOKKOS_LAMBDA( const int p ) {
+            int m = p;
+            for ( int d = 0; d < 3; ++d )
+            {
+                int cell = owned_cells.min( d ) + m % owned_cells.extent( d );
+                m /= owned_cells.extent( d );
+                x_ref( p, d ) =
+                    ( on_entity && 0 == d )
+                        ? mapping._global_offset[d] + cell
+                        : mapping._global_offset[d] + cell + 0.5 +
+                              0.4 * Kokkos::sin( p + 3.0 * d );
+            }
+        } );
+
+    // Create the spline of a particle.
+    auto create_spline = KOKKOS_LAMBDA( const int p )
+    {
+        Vec3<double> x = { x_ref( p, 0 ), x_ref( p, 1 ), x_ref( p, 2 ) };
+        LinearAlgebra::Matrix<double, 3, 3> jac;
+        LinearAlgebra::Matrix<double, 3, 3> jac_inv;
+        double jac_det;
+        if ( cached_metrics )
+            metrics.transformationMetrics( x, jac, jac_det, jac_inv );
+        else
+            CurvilinearMeshMapping<mapping_type>::transformationMetrics(
+                mapping, x, jac, jac_det, jac_inv );
+        return createCurvilinearSpline(
+            FieldLocation::Node(), InterpolationOrder<Order>(), local_mesh, x,
+            jac_inv, SplineValue(), SplineGradient() );
+    };
+
+    // Do G2P.
+    auto u_wrapper =
+        createViewWrapper( FieldLayout<FieldLocation::Node, Foo>(), u_view );
+    auto x_wrapper = createViewWrapper(
+        FieldLayout<FieldLocation::Node, Field::PhysicalPosition<3>>(),
+        x_view );
+    Kokkos::View<double* [4][3], TEST_MEMSPACE> c_p( "c_p", num_particle );
+    Kokkos::View<double* [3][3], TEST_MEMSPACE> grad_p( "grad_p",
+                                                        num_particle );
+    Kokkos::View<double*, TEST_MEMSPACE> div_p( "div_p", num_particle );
+    Kokkos::parallel_for(
+        "g2p", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_particle ),
+        KOKKOS_LAMBDA( const int p ) {
+            auto sd = create_spline( p );
+
+            LinearAlgebra::Matrix<double, 3, 3> grad;
+            G2P::gradient( sd, u_view, grad );
+            G2P::divergence( sd, u_view, div_p( p ) );
+
+            LinearAlgebra::Matrix<double, 4, 3> aff = 0.0;
+            APIC::g2p( u_wrapper, aff, sd, x_wrapper );
+
+            for ( int i = 0; i < 3; ++i )
+                for ( int j = 0; j < 3; ++j )
+                    grad_p( p, i, j ) = grad( i, j );
+            for ( int i = 0; i < 4; ++i )
+                for ( int j = 0; j < 3; ++j )
+                    c_p( p, i, j ) = aff( i, j );
+        } );
+
+    // Check the physical gradient and divergence.
+    if ( 1 == Order )
+    {
+        auto grad_host =
+            Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), grad_p );
+        auto div_host =
+            Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), div_p );
+        for ( int p = 0; p < num_particle; ++p )
+        {
+            for ( int i = 0; i < 3; ++i )
+                for ( int j = 0; j < 3; ++j )
+                    EXPECT_NEAR( grad_host( p, i, j ), A( j, i ), near_eps );
+            EXPECT_NEAR( div_host( p ), A( 0, 0 ) + A( 1, 1 ) + A( 2, 2 ),
+                         near_eps );
+        }
+    }
+
+    // Do APIC P2G.
+    Kokkos::View<double****, TEST_MEMSPACE> mu_view(
+        "mu", u_view.extent( 0 ), u_view.extent( 1 ), u_view.extent( 2 ), 3 );
+    Kokkos::deep_copy( m_view, 0.0 );
+    auto mu_sv = Kokkos::Experimental::create_scatter_view( mu_view );
+    auto m_sv = Kokkos::Experimental::create_scatter_view( m_view );
+    Kokkos::parallel_for(
+        "p2g", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_particle ),
+        KOKKOS_LAMBDA( const int p ) {
+            auto sd = create_spline( p );
+
+            LinearAlgebra::Matrix<double, 4, 3> aff;
+            for ( int i = 0; i < 4; ++i )
+                for ( int j = 0; j < 3; ++j )
+                    aff( i, j ) = c_p( p, i, j );
+
+            APIC::p2g( 0.3 + 0.1 * p, aff, m_sv, mu_sv, sd, x_wrapper );
+        } );
+    Kokkos::Experimental::contribute( mu_view, mu_sv );
+    Kokkos::Experimental::contribute( m_view, m_sv );
+
+    // Every node reached by a particle recovers the affine field.
+    auto mu_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), mu_view );
+    auto m_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), m_view );
+    int num_node = 0;
+    for ( std::size_t i = 0; i < m_host.extent( 0 ); ++i )
+        for ( std::size_t j = 0; j < m_host.extent( 1 ); ++j )
+            for ( std::size_t k = 0; k < m_host.extent( 2 ); ++k )
+            {
+                if ( m_host( i, j, k, 0 ) <= 0.0 )
+                    continue;
+                ++num_node;
+                for ( int d = 0; d < 3; ++d )
+                    EXPECT_NEAR( mu_host( i, j, k, d ) / m_host( i, j, k, 0 ),
+                                 u_host( i, j, k, d ), near_eps );
+            }
+    EXPECT_GT( num_node, 0 );
+
+    // The P2G adjoint identities require exact interpolation of the affine
+    // field.
+    if ( 1 != Order )
+        return;
+
+    // Scatter a scalar gradient, a vector divergence, and a tensor
+    // divergence.
+    Kokkos::View<double****, TEST_MEMSPACE> grad_view(
+        "grad", u_view.extent( 0 ), u_view.extent( 1 ), u_view.extent( 2 ),
+        3 );
+    Kokkos::View<double****, TEST_MEMSPACE> div_view(
+        "div", u_view.extent( 0 ), u_view.extent( 1 ), u_view.extent( 2 ), 1 );
+    Kokkos::View<double****, TEST_MEMSPACE> tdiv_view(
+        "tdiv", u_view.extent( 0 ), u_view.extent( 1 ), u_view.extent( 2 ),
+        3 );
+    auto grad_sv = Kokkos::Experimental::create_scatter_view( grad_view );
+    auto div_sv = Kokkos::Experimental::create_scatter_view( div_view );
+    auto tdiv_sv = Kokkos::Experimental::create_scatter_view( tdiv_view );
+    Kokkos::parallel_for(
+        "p2g_gradient", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_particle ),
+        KOKKOS_LAMBDA( const int p ) {
+            auto sd = create_spline( p );
+
+            double s = 1.0 + 0.1 * ( p % 7 );
+            Vec3<double> v;
+            Mat3<double> t;
+            for ( int i = 0; i < 3; ++i )
+            {
+                v( i ) = Kokkos::sin( p + i );
+                for ( int j = 0; j < 3; ++j )
+                    t( i, j ) = Kokkos::cos( p + 3.0 * i + j );
+            }
+
+            P2G::gradient( sd, s, grad_sv );
+            P2G::divergence( sd, v, div_sv );
+            P2G::divergence( sd, t, tdiv_sv );
+        } );
+    Kokkos::Experimental::contribute( grad_view, grad_sv );
+    Kokkos::Experimental::contribute( div_view, div_sv );
+    Kokkos::Experimental::contribute( tdiv_view, tdiv_sv );
+
+    // Particle side of the identities. The scalar field for the vector
+    // divergence is the first component of u.
+    double expected[3] = { 0.0, 0.0, 0.0 };
+    for ( int p = 0; p < num_particle; ++p )
+    {
+        double s = 1.0 + 0.1 * ( p % 7 );
+        expected[0] += s * ( A( 0, 0 ) + A( 1, 1 ) + A( 2, 2 ) );
+        for ( int i = 0; i < 3; ++i )
+        {
+            expected[1] += std::sin( p + i ) * A( 0, i );
+            for ( int j = 0; j < 3; ++j )
+                expected[2] += std::cos( p + 3.0 * i + j ) * A( j, i );
+        }
+    }
+
+    // Grid side of the identities.
+    auto grad_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), grad_view );
+    auto div_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), div_view );
+    auto tdiv_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), tdiv_view );
+    double result[3] = { 0.0, 0.0, 0.0 };
+    for ( std::size_t i = 0; i < u_host.extent( 0 ); ++i )
+        for ( std::size_t j = 0; j < u_host.extent( 1 ); ++j )
+            for ( std::size_t k = 0; k < u_host.extent( 2 ); ++k )
+            {
+                result[1] += div_host( i, j, k, 0 ) * u_host( i, j, k, 0 );
+                for ( int d = 0; d < 3; ++d )
+                {
+                    result[0] += grad_host( i, j, k, d ) * u_host( i, j, k, d );
+                    result[2] += tdiv_host( i, j, k, d ) * u_host( i, j, k, d );
+                }
+            }
+    for ( int n = 0; n < 3; ++n )
+        EXPECT_NEAR( result[n], expected[n],
+                     1.0e-10 * ( 1.0 + std::abs( expected[n] ) ) );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -927,6 +1213,24 @@ TEST( TEST_CATEGORY, cubic_staggered_test )
     staggeredTest<FieldLocation::Edge<Dim::K>, 3>();
 }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, curvilinear_test )
+{
+    // serial test only.
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    if ( comm_size > 1 )
+        return;
+
+    // test
+    curvilinearTest<1>( false );
+    curvilinearTest<2>( false );
+    curvilinearTest<1>( true );
+    curvilinearTest<2>( true );
+    curvilinearTest<1>( false, true );
+    curvilinearTest<2>( false, true );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
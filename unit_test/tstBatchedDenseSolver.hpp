@@ -0,0 +1,116 @@
+/****************************************************************************
+ * Copyright (c) 2021 by the Picasso authors                                *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Picasso library. Picasso is distributed under a *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Picasso_BatchedDenseSolver.hpp>
+#include <Picasso_BatchedLinearAlgebra.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace Picasso;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Solve a set of symmetric positive definite systems with a known solution.
+template <int N, class Factorization>
+void batchedDenseSolverTest( const bool team )
+{
+    // Use a number of systems which does not fill the last batch.
+    constexpr int num_rhs = 2;
+    constexpr int width = 8;
+    int num_system = 37;
+    BatchedDenseSystems<double, N, num_rhs, width, TEST_MEMSPACE> systems(
+        "systems", num_system );
+    EXPECT_EQ( systems.numSystem(), num_system );
+    EXPECT_EQ( systems.numBatch(), 5 );
+    EXPECT_EQ( systems.numLane( 4 ), 5 );
+
+    // Assemble A = M * ~M + N * I and B = A * X.
+    Kokkos::parallel_for(
+        "assemble", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_system ),
+        KOKKOS_LAMBDA( const int n ) {
+            LinearAlgebra::Matrix<double, N, N> m;
+            LinearAlgebra::Matrix<double, N, num_rhs> x;
+            for ( int i = 0; i < N; ++i )
+            {
+                for ( int j = 0; j < N; ++j )
+                    m( i, j ) = Kokkos::sin( n + 3.0 * i + 7.0 * j );
+                for ( int k = 0; k < num_rhs; ++k )
+                    x( i, k ) = Kokkos::cos( n + i + 2.0 * k );
+            }
+            auto a = systems.matrix( n );
+            a = m * ~m;
+            for ( int i = 0; i < N; ++i )
+                a( i, i ) += N;
+            auto b = systems.rhs( n );
+            b = a * x;
+        } );
+
+    // Factor and solve.
+    if ( team )
+    {
+        systems.teamFactor( TEST_EXECSPACE(), Factorization() );
+        systems.teamSolve( TEST_EXECSPACE(), Factorization() );
+    }
+    else
+    {
+        systems.factor( TEST_EXECSPACE(), Factorization() );
+        systems.solve( TEST_EXECSPACE(), Factorization() );
+    }
+
+    // Check the solutions. Lanes past the last system are not written.
+    auto b_host = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                       systems.rhsView() );
+    for ( int n = 0; n < systems.numBatch() * width; ++n )
+        for ( int i = 0; i < N; ++i )
+            for ( int k = 0; k < num_rhs; ++k )
+            {
+                double x = ( n < num_system ) ? std::cos( n + i + 2.0 * k )
+                                              : 0.0;
+                EXPECT_NEAR( b_host( n / width, i, k, n % width ), x,
+                             1.0e-12 );
+            }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, batchedDenseLU_test )
+{
+    batchedDenseSolverTest<4, DenseLU>( false );
+    batchedDenseSolverTest<8, DenseLU>( false );
+}
+
+TEST( TEST_CATEGORY, batchedDenseCholesky_test )
+{
+    batchedDenseSolverTest<4, DenseCholesky>( false );
+    batchedDenseSolverTest<8, DenseCholesky>( false );
+}
+
+TEST( TEST_CATEGORY, teamBatchedDenseLU_test )
+{
+    batchedDenseSolverTest<4, DenseLU>( true );
+    batchedDenseSolverTest<8, DenseLU>( true );
+}
+
+TEST( TEST_CATEGORY, teamBatchedDenseCholesky_test )
+{
+    batchedDenseSolverTest<4, DenseCholesky>( true );
+    batchedDenseSolverTest<8, DenseCholesky>( true );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -16,7 +16,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
 #include <random>
+#include <vector>
 
 using namespace Picasso;
 
@@ -1692,6 +1694,56 @@ void linearSolveTest()
         EXPECT_NEAR( x0( i ), x2( i ), eps );
 }
 
+//---------------------------------------------------------------------------//
+template <int N>
+void choleskyTest()
+{
+    // Symmetric positive definite matrix and two solutions.
+    LinearAlgebra::Matrix<double, N, N> M;
+    LinearAlgebra::Matrix<double, N, 2> x0;
+    std::default_random_engine engine( 2394 );
+    std::uniform_real_distribution<double> dist( -1.0, 1.0 );
+    for ( int i = 0; i < N; ++i )
+    {
+        for ( int j = 0; j < N; ++j )
+            M( i, j ) = dist( engine );
+        x0( i, 0 ) = dist( engine );
+        x0( i, 1 ) = dist( engine );
+    }
+    LinearAlgebra::Matrix<double, N, N> A = M * ~M;
+    for ( int i = 0; i < N; ++i )
+        A( i, i ) += 1.0;
+
+    // The factor is lower triangular and reproduces the matrix.
+    auto L = LinearAlgebra::Cholesky( A );
+    LinearAlgebra::Matrix<double, N, N> LLt = L * ~L;
+    for ( int i = 0; i < N; ++i )
+        for ( int j = 0; j < N; ++j )
+        {
+            if ( j > i )
+                EXPECT_EQ( L( i, j ), 0.0 );
+            EXPECT_NEAR( LLt( i, j ), A( i, j ), 1.0e-12 );
+        }
+
+    // Packed symmetric matrices give the same factor.
+    LinearAlgebra::SymmetricMatrix<double, N> A_s = A;
+    auto L_s = LinearAlgebra::Cholesky( A_s );
+    for ( int i = 0; i < N; ++i )
+        for ( int j = 0; j < N; ++j )
+            EXPECT_DOUBLE_EQ( L_s( i, j ), L( i, j ) );
+
+    // Factored solves with multiple right hand sides.
+    LinearAlgebra::Matrix<double, N, 2> b = A * x0;
+    auto x1 = LinearAlgebra::choleskySolve( L, b );
+    auto x2 = LinearAlgebra::luSolve( LinearAlgebra::LU( A ), b );
+    for ( int i = 0; i < N; ++i )
+        for ( int k = 0; k < 2; ++k )
+        {
+            EXPECT_NEAR( x1( i, k ), x0( i, k ), 1.0e-10 );
+            EXPECT_NEAR( x2( i, k ), x0( i, k ), 1.0e-10 );
+        }
+}
+
 //---------------------------------------------------------------------------//
 void matrixExponentialTest()
 {
@@ -1863,6 +1915,759 @@ void matrixSVDTest()
     EXPECT_FLOAT_EQ( A( 2, 2 ), A_0( 2, 2 ) );
 }
 
+//---------------------------------------------------------------------------//
+template <class Precision, class T>
+void svdPrecisionTest( const Kokkos::Array<double, 3>& sigma,
+                       const double tol )
+{
+    // Build A = U_0 * diag(sigma) * ~V_0 from two rotations.
+    LinearAlgebra::Quaternion<double> q_u = { 0.5377, 0.4711, -0.6110,
+                                              0.3402 };
+    LinearAlgebra::Quaternion<double> q_v = { 0.7217, -0.1806, 0.5412,
+                                              0.3907 };
+    double q_u_norm = 0.0;
+    double q_v_norm = 0.0;
+    for ( int d = 0; d < 4; ++d )
+    {
+        q_u_norm += q_u( d ) * q_u( d );
+        q_v_norm += q_v( d ) * q_v( d );
+    }
+    LinearAlgebra::Matrix<double, 3, 3> u_0( q_u / std::sqrt( q_u_norm ) );
+    LinearAlgebra::Matrix<double, 3, 3> v_0( q_v / std::sqrt( q_v_norm ) );
+    LinearAlgebra::Matrix<double, 3, 3> d_0 = 0.0;
+    for ( int i = 0; i < 3; ++i )
+        d_0( i, i ) = sigma[i];
+    LinearAlgebra::Matrix<double, 3, 3> a_0 = u_0 * d_0 * ~v_0;
+
+    LinearAlgebra::Matrix<T, 3, 3> a;
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+            a( i, j ) = static_cast<T>( a_0( i, j ) );
+
+    LinearAlgebra::Matrix<T, 3, 3> u, d, v;
+    LinearAlgebra::svd( Precision(), a, u, d, v );
+
+    // Singular values to relative accuracy.
+    for ( int i = 0; i < 3; ++i )
+        EXPECT_NEAR( std::abs( d( i, i ) ) / sigma[i], 1.0, tol );
+
+    LinearAlgebra::Matrix<T, 3, 3> a_1 = u * d * ~v;
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+            EXPECT_NEAR( a_1( i, j ), a( i, j ), tol * sigma[0] );
+}
+
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+// Compare batched linear solves and inverses against the scalar versions of
+// each lane. The views have the layout of a Cabana SoA member.
+template <int N>
+void batchSolveTest()
+{
+    constexpr int W = 4;
+    int size = 5;
+    Kokkos::View<double* [N][N][W], TEST_MEMSPACE> view_a( "a", size );
+    Kokkos::View<double* [N][W], TEST_MEMSPACE> view_x0( "x0", size );
+    Kokkos::View<double* [N][W], TEST_MEMSPACE> view_x1( "x1", size );
+    Kokkos::View<double* [N][W], TEST_MEMSPACE> view_x2( "x2", size );
+    Kokkos::View<double* [N][N][W], TEST_MEMSPACE> view_ainv( "ainv", size );
+    Kokkos::View<double* [N][N][W], TEST_MEMSPACE> view_ainv_s( "ainv_s",
+                                                                size );
+
+    Kokkos::Random_XorShift64_Pool<TEST_EXECSPACE> pool( 3923423 );
+    Kokkos::fill_random( view_a, pool, 1.0 );
+    Kokkos::fill_random( view_x0, pool, 1.0 );
+
+    Kokkos::parallel_for(
+        "test_la_batch_solve", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, size ),
+        KOKKOS_LAMBDA( const int s ) {
+            // Gather the batch.
+            LinearAlgebra::BatchMatrix<double, N, N, W> A;
+            LinearAlgebra::load(
+                A, LinearAlgebra::MatrixView<double, N, N>(
+                       &view_a( s, 0, 0, 0 ), N * W, W ) );
+            LinearAlgebra::BatchVector<double, N, W> x0;
+            LinearAlgebra::load( x0, LinearAlgebra::VectorView<double, N>(
+                                         &view_x0( s, 0, 0 ), W ) );
+
+            // Solve with a composite operator.
+            auto op = 0.75 * ( A + 0.5 * ~A );
+            auto b = op * x0;
+            LinearAlgebra::BatchVector<double, N, W> x1 = op ^ b;
+            LinearAlgebra::store( x1, LinearAlgebra::VectorView<double, N>(
+                                          &view_x1( s, 0, 0 ), W ) );
+
+            // Transpose solve. Only store the first lanes.
+            auto c = ~op * x0;
+            LinearAlgebra::BatchVector<double, N, W> x2 = ~op ^ c;
+            LinearAlgebra::store(
+                x2,
+                LinearAlgebra::VectorView<double, N>( &view_x2( s, 0, 0 ), W ),
+                W - 1 );
+
+            // Invert.
+            LinearAlgebra::store(
+                LinearAlgebra::inverse( A ),
+                LinearAlgebra::MatrixView<double, N, N>(
+                    &view_ainv( s, 0, 0, 0 ), N * W, W ) );
+
+            // Invert each lane with scalars.
+            for ( int l = 0; l < W; ++l )
+            {
+                LinearAlgebra::MatrixView<double, N, N> a_l(
+                    &view_a( s, 0, 0, l ), N * W, W );
+                LinearAlgebra::MatrixView<double, N, N> ainv_l(
+                    &view_ainv_s( s, 0, 0, l ), N * W, W );
+                ainv_l = LinearAlgebra::inverse( a_l );
+            }
+        } );
+
+    auto x0_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), view_x0 );
+    auto x1_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), view_x1 );
+    auto x2_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), view_x2 );
+    auto ainv_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), view_ainv );
+    auto ainv_s_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), view_ainv_s );
+
+    double eps = 1.0e-11;
+    for ( int s = 0; s < size; ++s )
+        for ( int l = 0; l < W; ++l )
+        {
+            for ( int i = 0; i < N; ++i )
+            {
+                EXPECT_NEAR( x0_host( s, i, l ), x1_host( s, i, l ), eps );
+                if ( l < W - 1 )
+                    EXPECT_NEAR( x0_host( s, i, l ), x2_host( s, i, l ), eps );
+                else
+                    EXPECT_EQ( x2_host( s, i, l ), 0.0 );
+                for ( int j = 0; j < N; ++j )
+                    EXPECT_DOUBLE_EQ( ainv_host( s, i, j, l ),
+                                      ainv_s_host( s, i, j, l ) );
+            }
+        }
+}
+
+//---------------------------------------------------------------------------//
+// Compare batched 3x3 decompositions and exponentials against the scalar
+// versions of each lane.
+void batchDecompositionTest()
+{
+    using Kokkos::ALL;
+
+    constexpr int W = 8;
+    int size = 3;
+    Kokkos::View<double* [3][3][W], TEST_MEMSPACE> view_a( "a", size );
+    Kokkos::View<double* [4][3][3][W], TEST_MEMSPACE> view_b( "b", size );
+    Kokkos::View<double* [4][3][3][W], TEST_MEMSPACE> view_b_s( "b_s", size );
+
+    Kokkos::Random_XorShift64_Pool<TEST_EXECSPACE> pool( 2093481 );
+    Kokkos::fill_random( view_a, pool, 1.0 );
+
+    Kokkos::parallel_for(
+        "test_la_batch_decomp", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, size ),
+        KOKKOS_LAMBDA( const int s ) {
+            // Shift the lanes so some of them need their singular values
+            // sorted.
+            for ( int l = 0; l < W; ++l )
+                for ( int d = 0; d < 3; ++d )
+                    view_a( s, d, ( d + l ) % 3, l ) += 2.0;
+
+            // Batched.
+            LinearAlgebra::BatchMatrix<double, 3, 3, W> A;
+            LinearAlgebra::load(
+                A, LinearAlgebra::MatrixView<double, 3, 3>(
+                       &view_a( s, 0, 0, 0 ), 3 * W, W ) );
+            LinearAlgebra::BatchMatrix<double, 3, 3, W> U, D, V;
+            LinearAlgebra::svd( A, U, D, V );
+            auto E = LinearAlgebra::exponential( A );
+
+            LinearAlgebra::BatchTensor3<double, 4, 3, 3, W> B;
+            B.matrix( 0, ALL(),
+                      ALL() ) = U;
+            B.matrix( 1, ALL(),
+                      ALL() ) = D;
+            B.matrix( 2, ALL(),
+                      ALL() ) = V;
+            B.matrix( 3, ALL(),
+                      ALL() ) = E;
+            LinearAlgebra::store(
+                B, LinearAlgebra::Tensor3View<double, 4, 3, 3>(
+                       &view_b( s, 0, 0, 0, 0 ), 9 * W, 3 * W, W ) );
+
+            // Scalar.
+            for ( int l = 0; l < W; ++l )
+            {
+                LinearAlgebra::MatrixView<double, 3, 3> a_l(
+                    &view_a( s, 0, 0, l ), 3 * W, W );
+                LinearAlgebra::Matrix<double, 3, 3> u, d, v;
+                LinearAlgebra::svd( a_l, u, d, v );
+                LinearAlgebra::Tensor3View<double, 4, 3, 3> b_l(
+                    &view_b_s( s, 0, 0, 0, l ), 9 * W, 3 * W, W );
+                b_l.matrix( 0, ALL(),
+                            ALL() ) = u;
+                b_l.matrix( 1, ALL(),
+                            ALL() ) = d;
+                b_l.matrix( 2, ALL(),
+                            ALL() ) = v;
+                b_l.matrix( 3, ALL(),
+                            ALL() ) =
+                    LinearAlgebra::exponential( a_l );
+            }
+        } );
+
+    auto a_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), view_a );
+    auto b_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), view_b );
+    auto b_s_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), view_b_s );
+
+    // The batch computes the same decomposition as the scalar version.
+    for ( int s = 0; s < size; ++s )
+        for ( int l = 0; l < W; ++l )
+            for ( int n = 0; n < 4; ++n )
+                for ( int i = 0; i < 3; ++i )
+                    for ( int j = 0; j < 3; ++j )
+                        EXPECT_NEAR( b_host( s, n, i, j, l ),
+                                     b_s_host( s, n, i, j, l ), 1.0e-12 );
+
+    // The decomposition recovers the matrix.
+    for ( int s = 0; s < size; ++s )
+        for ( int l = 0; l < W; ++l )
+        {
+            LinearAlgebra::MatrixView<double, 3, 3> a(
+                &a_host( s, 0, 0, l ), 3 * W, W );
+            LinearAlgebra::Tensor3View<double, 4, 3, 3> b(
+                &b_host( s, 0, 0, 0, l ), 9 * W, 3 * W, W );
+            auto u = b.matrix( 0, ALL(),
+                               ALL() );
+            auto d = b.matrix( 1, ALL(),
+                               ALL() );
+            auto v = b.matrix( 2, ALL(),
+                               ALL() );
+            LinearAlgebra::Matrix<double, 3, 3> a_0 = u * ( d * ~v );
+            for ( int i = 0; i < 3; ++i )
+                for ( int j = 0; j < 3; ++j )
+                    EXPECT_NEAR( a( i, j ), a_0( i, j ), 1.0e-10 );
+        }
+}
+
+//---------------------------------------------------------------------------//
+void batchTest()
+{
+    using batch_type = LinearAlgebra::Batch<double, 4>;
+
+    batch_type a = 2.0;
+    batch_type b;
+    for ( int l = 0; l < 4; ++l )
+        b[l] = l - 1.0;
+
+    // Lane-wise arithmetic and selection.
+    batch_type c = LinearAlgebra::select( b < a, a * b, 1.0 / a );
+    EXPECT_EQ( c[0], -2.0 );
+    EXPECT_EQ( c[1], 0.0 );
+    EXPECT_EQ( c[2], 2.0 );
+    EXPECT_EQ( c[3], 0.5 );
+    EXPECT_TRUE( LinearAlgebra::any( b == a ) );
+    EXPECT_FALSE( LinearAlgebra::all( b == a ) );
+
+    // Batched contraction of a tensor4.
+    LinearAlgebra::BatchTensor4<double, 3, 3, 3, 3, 4> t;
+    LinearAlgebra::Tensor4<double, 3, 3, 3, 3> t_0;
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+            for ( int k = 0; k < 3; ++k )
+                for ( int l = 0; l < 3; ++l )
+                {
+                    t_0( i, j, k, l ) = i + 2.0 * j - k * l;
+                    t( i, j, k, l ) = t_0( i, j, k, l ) * b;
+                }
+    LinearAlgebra::BatchMatrix<double, 3, 3, 4> m = b;
+    LinearAlgebra::Matrix<double, 3, 3> m_0 = 1.0;
+    auto tm = LinearAlgebra::contract( t, m );
+    auto tm_0 = LinearAlgebra::contract( t_0, m_0 );
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+            for ( int l = 0; l < 4; ++l )
+                EXPECT_DOUBLE_EQ( tm( i, j )[l], b[l] * b[l] * tm_0( i, j ) );
+}
+
+//---------------------------------------------------------------------------//
+template <int N>
+void symmetricMatrixTest()
+{
+    // Make a random symmetric positive definite matrix.
+    std::mt19937 gen( 3490 );
+    std::uniform_real_distribution<double> dist( -1.0, 1.0 );
+    LinearAlgebra::Matrix<double, N, N> a;
+    LinearAlgebra::Vector<double, N> x;
+    for ( int i = 0; i < N; ++i )
+    {
+        x( i ) = dist( gen );
+        for ( int j = 0; j < N; ++j )
+            a( i, j ) = dist( gen );
+    }
+    LinearAlgebra::Matrix<double, N, N> ident;
+    LinearAlgebra::identity( ident );
+    LinearAlgebra::Matrix<double, N, N> s_0 = a * ~a + ident;
+
+    // Only the unique components are stored.
+    LinearAlgebra::SymmetricMatrix<double, N> s = a * ~a + ident;
+    static_assert( LinearAlgebra::SymmetricMatrix<double, N>::size ==
+                       N * ( N + 1 ) / 2,
+                   "Symmetric matrix must be packed" );
+    static_assert( LinearAlgebra::is_matrix<decltype( s )>::value,
+                   "Symmetric matrix must be a matrix expression" );
+    for ( int i = 0; i < N; ++i )
+        for ( int j = 0; j < N; ++j )
+        {
+            EXPECT_DOUBLE_EQ( s( i, j ), s_0( i, j ) );
+            EXPECT_EQ( &s( i, j ), &s( j, i ) );
+            EXPECT_EQ( &s( i, j ),
+                       &s[LinearAlgebra::symmetricIndex<N>( i, j )] );
+        }
+
+    // Symmetric matrices participate in expressions and solves and
+    // produce the same results as the dense matrix.
+    LinearAlgebra::Vector<double, N> sx = s * x;
+    LinearAlgebra::Vector<double, N> sx_0 = s_0 * x;
+    LinearAlgebra::Vector<double, N> y = s ^ x;
+    LinearAlgebra::Vector<double, N> y_0 = s_0 ^ x;
+    LinearAlgebra::Matrix<double, N, N> sa = s * a - a;
+    LinearAlgebra::Matrix<double, N, N> sa_0 = s_0 * a - a;
+    LinearAlgebra::Matrix<double, N, N> z = s ^ a;
+    LinearAlgebra::Matrix<double, N, N> z_0 = s_0 ^ a;
+    LinearAlgebra::SymmetricMatrix<double, N> s_inv = inverse( s );
+    LinearAlgebra::Matrix<double, N, N> s_inv_0 = inverse( s_0 );
+    for ( int i = 0; i < N; ++i )
+    {
+        EXPECT_DOUBLE_EQ( sx( i ), sx_0( i ) );
+        EXPECT_NEAR( y( i ), y_0( i ), 1.0e-12 );
+        for ( int j = 0; j < N; ++j )
+        {
+            EXPECT_DOUBLE_EQ( sa( i, j ), sa_0( i, j ) );
+            EXPECT_NEAR( z( i, j ), z_0( i, j ), 1.0e-12 );
+            EXPECT_NEAR( s_inv( i, j ), s_inv_0( i, j ), 1.0e-12 );
+        }
+    }
+
+    // Wrap strided packed data as in a particle SoA.
+    constexpr int size = LinearAlgebra::SymmetricMatrix<double, N>::size;
+    double data[4 * size];
+    LinearAlgebra::SymmetricMatrixView<double, N> v( &data[1], 4 );
+    v = s;
+    v += s;
+    for ( int n = 0; n < size; ++n )
+        EXPECT_DOUBLE_EQ( data[1 + 4 * n], 2.0 * s[n] );
+    LinearAlgebra::Matrix<double, N, N> d = v - s;
+    for ( int i = 0; i < N; ++i )
+        for ( int j = 0; j < N; ++j )
+            EXPECT_DOUBLE_EQ( d( i, j ), s_0( i, j ) );
+}
+
+//---------------------------------------------------------------------------//
+void symmetricTensor4Test()
+{
+    // Isotropic elasticity tensor.
+    double lambda = 1.3;
+    double mu = 0.4;
+    LinearAlgebra::Tensor4<double, 3, 3, 3, 3> c_0;
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+            for ( int k = 0; k < 3; ++k )
+                for ( int l = 0; l < 3; ++l )
+                    c_0( i, j, k, l ) = lambda * ( i == j ) * ( k == l ) +
+                                        mu * ( ( i == k ) * ( j == l ) +
+                                               ( i == l ) * ( j == k ) ) +
+                                        0.1 * ( i + j ) * ( k + l );
+
+    LinearAlgebra::SymmetricTensor4<double, 3> c = c_0;
+    EXPECT_EQ( c.size, 21 );
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+            for ( int k = 0; k < 3; ++k )
+                for ( int l = 0; l < 3; ++l )
+                {
+                    EXPECT_DOUBLE_EQ( c( i, j, k, l ), c_0( i, j, k, l ) );
+                    EXPECT_EQ( &c( i, j, k, l ), &c( k, l, j, i ) );
+                }
+
+    // Contract with a symmetric strain.
+    LinearAlgebra::SymmetricMatrix<double, 3> e;
+    for ( int n = 0; n < 6; ++n )
+        e[n] = 0.01 * ( n + 1 );
+    LinearAlgebra::Matrix<double, 3, 3> e_0 = e;
+    LinearAlgebra::SymmetricMatrix<double, 3> sigma =
+        LinearAlgebra::contract( c, e );
+    auto sigma_0 = LinearAlgebra::contract( c_0, e_0 );
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+            EXPECT_DOUBLE_EQ( sigma( i, j ), sigma_0( i, j ) );
+
+    // Wrap strided packed data.
+    double data[2 * 21];
+    LinearAlgebra::SymmetricTensor4View<double, 3> v( data, 2 );
+    v = c;
+    for ( int n = 0; n < 21; ++n )
+        EXPECT_DOUBLE_EQ( data[2 * n], c[n] );
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+            for ( int k = 0; k < 3; ++k )
+                for ( int l = 0; l < 3; ++l )
+                    EXPECT_DOUBLE_EQ( v( i, j, k, l ), c_0( i, j, k, l ) );
+}
+
+//---------------------------------------------------------------------------//
+// Check A = U * diag(e) * ~U for a symmetric 3x3 eigendecomposition.
+template <class MatrixA, class VectorE, class MatrixU>
+void checkSymmetricEigendecomposition( const MatrixA& a, const VectorE& e,
+                                       const MatrixU& u )
+{
+    double scale = std::max( std::abs( e( 0 ) ), std::abs( e( 2 ) ) );
+    EXPECT_LE( e( 0 ), e( 1 ) );
+    EXPECT_LE( e( 1 ), e( 2 ) );
+    EXPECT_NEAR( !u, 1.0, 1.0e-12 );
+    LinearAlgebra::Matrix<double, 3, 3> utu = ~u * u;
+    LinearAlgebra::Matrix<double, 3, 3> d = 0.0;
+    for ( int i = 0; i < 3; ++i )
+        d( i, i ) = e( i );
+    LinearAlgebra::Matrix<double, 3, 3> a_0 = u * d * ~u;
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+        {
+            EXPECT_NEAR( utu( i, j ), ( i == j ) ? 1.0 : 0.0, 1.0e-12 );
+            EXPECT_NEAR( a_0( i, j ), a( i, j ), 1.0e-12 * scale );
+        }
+}
+
+//---------------------------------------------------------------------------//
+void symmetricEigendecompositionTest()
+{
+    // Closed-form eigenvalues.
+    LinearAlgebra::Matrix<double, 3, 3> a = {
+        { 2.0, -1.0, 0.0 }, { -1.0, 2.0, -1.0 }, { 0.0, -1.0, 2.0 } };
+    LinearAlgebra::Vector<double, 3> e;
+    LinearAlgebra::symmetricEigendecomposition( a, e );
+    EXPECT_DOUBLE_EQ( e( 0 ), 2.0 - std::sqrt( 2.0 ) );
+    EXPECT_DOUBLE_EQ( e( 1 ), 2.0 );
+    EXPECT_DOUBLE_EQ( e( 2 ), 2.0 + std::sqrt( 2.0 ) );
+
+    LinearAlgebra::Matrix<double, 3, 3> u;
+    LinearAlgebra::symmetricEigendecomposition( a, e, u );
+    checkSymmetricEigendecomposition( a, e, u );
+
+    // Random rotation.
+    std::mt19937 gen( 2947 );
+    std::uniform_real_distribution<double> dist( -1.0, 1.0 );
+    LinearAlgebra::Quaternion<double> q;
+    double q_norm = 0.0;
+    for ( int d = 0; d < 4; ++d )
+    {
+        q( d ) = dist( gen );
+        q_norm += q( d ) * q( d );
+    }
+    q = q / std::sqrt( q_norm );
+    LinearAlgebra::Matrix<double, 3, 3> r( q );
+
+    // Spectra with distinct, repeated, nearly repeated, and zero
+    // eigenvalues.
+    std::vector<LinearAlgebra::Vector<double, 3>> spectra = {
+        { -3.1, 0.7, 12.4 },        { 2.0, 2.0, 5.0 },
+        { -1.0, 4.0, 4.0 },         { 3.0, 3.0, 3.0 },
+        { 1.0, 1.0 + 1.0e-9, 4.0 }, { 0.0, 0.0, 0.0 },
+        { -7.5, 1.0e-3, 2.0e-3 } };
+    for ( auto& spectrum : spectra )
+    {
+        LinearAlgebra::Matrix<double, 3, 3> d = 0.0;
+        for ( int i = 0; i < 3; ++i )
+            d( i, i ) = spectrum( i );
+        LinearAlgebra::SymmetricMatrix<double, 3> s = r * d * ~r;
+        LinearAlgebra::symmetricEigendecomposition( s, e, u );
+        for ( int i = 0; i < 3; ++i )
+            EXPECT_NEAR( e( i ), spectrum( i ), 1.0e-13 * 12.4 );
+        checkSymmetricEigendecomposition( s, e, u );
+    }
+
+    // Random matrices.
+    for ( int n = 0; n < 100; ++n )
+    {
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = i; j < 3; ++j )
+            {
+                a( i, j ) = dist( gen );
+                a( j, i ) = a( i, j );
+            }
+        LinearAlgebra::symmetricEigendecomposition( a, e, u );
+        checkSymmetricEigendecomposition( a, e, u );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void batchEigendecompositionTest()
+{
+    // Mix lanes that need the Jacobi fallback with closed-form lanes.
+    constexpr int width = 4;
+    LinearAlgebra::BatchMatrix<double, 3, 3, width> a;
+    LinearAlgebra::Matrix<double, 3, 3> a_l[width] = {
+        { { 4.0, 1.0, -2.0 }, { 1.0, 2.0, 0.5 }, { -2.0, 0.5, -3.0 } },
+        { { 2.0, 0.0, 0.0 }, { 0.0, 2.0, 0.0 }, { 0.0, 0.0, 5.0 } },
+        { { 1.0, 2.0, 3.0 }, { 2.0, 4.0, 5.0 }, { 3.0, 5.0, 6.0 } },
+        { { 3.0, 0.0, 0.0 }, { 0.0, 3.0, 0.0 }, { 0.0, 0.0, 3.0 } } };
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+            for ( int l = 0; l < width; ++l )
+                a( i, j )[l] = a_l[l]( i, j );
+
+    LinearAlgebra::BatchVector<double, 3, width> e;
+    LinearAlgebra::BatchMatrix<double, 3, 3, width> u;
+    LinearAlgebra::symmetricEigendecomposition( a, e, u );
+
+    for ( int l = 0; l < width; ++l )
+    {
+        LinearAlgebra::Vector<double, 3> e_0;
+        LinearAlgebra::symmetricEigendecomposition( a_l[l], e_0 );
+        LinearAlgebra::Vector<double, 3> e_l;
+        LinearAlgebra::Matrix<double, 3, 3> u_l;
+        for ( int i = 0; i < 3; ++i )
+        {
+            e_l( i ) = e( i )[l];
+            for ( int j = 0; j < 3; ++j )
+                u_l( i, j ) = u( i, j )[l];
+        }
+        for ( int i = 0; i < 3; ++i )
+            EXPECT_NEAR( e_l( i ), e_0( i ), 1.0e-12 );
+        checkSymmetricEigendecomposition( a_l[l], e_l, u_l );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void symmetricFunctionTest()
+{
+    // Diagonal matrices.
+    LinearAlgebra::Matrix<double, 3, 3> d = 0.0;
+    d( 0, 0 ) = 0.25;
+    d( 1, 1 ) = 4.0;
+    d( 2, 2 ) = 9.0;
+    auto log_d = LinearAlgebra::symmetricLog( d );
+    auto sqrt_d = LinearAlgebra::symmetricSqrt( d );
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+        {
+            EXPECT_NEAR( log_d( i, j ),
+                         ( i == j ) ? std::log( d( i, i ) ) : 0.0, 1.0e-14 );
+            EXPECT_NEAR( sqrt_d( i, j ),
+                         ( i == j ) ? std::sqrt( d( i, i ) ) : 0.0, 1.0e-14 );
+        }
+
+    // Logarithm and square root of ~F * F.
+    LinearAlgebra::Matrix<double, 3, 3> f = {
+        { 1.2, 0.3, -0.1 }, { -0.2, 0.9, 0.4 }, { 0.1, 0.2, 1.5 } };
+    LinearAlgebra::SymmetricMatrix<double, 3> c = ~f * f;
+    LinearAlgebra::Matrix<double, 3, 3> exp_log_c =
+        LinearAlgebra::exponential( LinearAlgebra::symmetricLog( c ) );
+    auto sqrt_c = LinearAlgebra::symmetricSqrt( c );
+    LinearAlgebra::Matrix<double, 3, 3> sqrt_c2 = sqrt_c * sqrt_c;
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+        {
+            EXPECT_NEAR( exp_log_c( i, j ), c( i, j ), 1.0e-12 );
+            EXPECT_NEAR( sqrt_c2( i, j ), c( i, j ), 1.0e-12 );
+        }
+}
+
+//---------------------------------------------------------------------------//
+// Check F = R * S with R orthogonal and S symmetric positive definite.
+template <class MatrixF, class MatrixR, class MatrixS>
+void checkPolarDecomposition( const MatrixF& f, const MatrixR& r,
+                              const MatrixS& s )
+{
+    double f_det = !f;
+    EXPECT_NEAR( !r, ( f_det > 0.0 ) ? 1.0 : -1.0, 1.0e-12 );
+    LinearAlgebra::Matrix<double, 3, 3> rtr = ~r * r;
+    LinearAlgebra::Matrix<double, 3, 3> rs = r * s;
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+        {
+            EXPECT_NEAR( rtr( i, j ), ( i == j ) ? 1.0 : 0.0, 1.0e-12 );
+            EXPECT_NEAR( rs( i, j ), f( i, j ), 1.0e-12 * std::abs( f_det ) );
+            EXPECT_DOUBLE_EQ( s( i, j ), s( j, i ) );
+        }
+    LinearAlgebra::Vector<double, 3> e;
+    LinearAlgebra::symmetricEigendecomposition( s, e );
+    EXPECT_GT( e( 0 ), 0.0 );
+}
+
+//---------------------------------------------------------------------------//
+void polarDecompositionTest()
+{
+    // The stretch matches the square root of ~F * F.
+    LinearAlgebra::Matrix<double, 3, 3> f = {
+        { 1.2, 0.3, -0.1 }, { -0.2, 0.9, 0.4 }, { 0.1, 0.2, 1.5 } };
+    LinearAlgebra::Matrix<double, 3, 3> r;
+    LinearAlgebra::SymmetricMatrix<double, 3> s;
+    LinearAlgebra::polarDecomposition( f, r, s );
+    checkPolarDecomposition( f, r, s );
+    auto s_0 = LinearAlgebra::symmetricSqrt( ~f * f );
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+            EXPECT_NEAR( s( i, j ), s_0( i, j ), 1.0e-12 );
+
+    // A rotation has a unit stretch.
+    LinearAlgebra::Quaternion<double> q = { 0.5, 0.5, -0.5, 0.5 };
+    LinearAlgebra::Matrix<double, 3, 3> q_r( q );
+    LinearAlgebra::Matrix<double, 3, 3> s_r;
+    LinearAlgebra::polarDecomposition( q_r, r, s_r );
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+        {
+            EXPECT_NEAR( r( i, j ), q_r( i, j ), 1.0e-14 );
+            EXPECT_NEAR( s_r( i, j ), ( i == j ) ? 1.0 : 0.0, 1.0e-14 );
+        }
+
+    // Large stretches and reflections of strided data.
+    std::mt19937 gen( 9374 );
+    std::uniform_real_distribution<double> dist( -1.0, 1.0 );
+    double data[18];
+    LinearAlgebra::MatrixView<double, 3, 3> f_v( data, 6, 2 );
+    for ( int n = 0; n < 50; ++n )
+    {
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 3; ++j )
+                f_v( i, j ) = dist( gen );
+        f_v( n % 3, n % 3 ) *= 100.0;
+        LinearAlgebra::polarDecomposition( f_v, r, s );
+        checkPolarDecomposition( f_v, r, s );
+    }
+
+    // Batched.
+    constexpr int width = 4;
+    LinearAlgebra::BatchMatrix<double, 3, 3, width> f_b;
+    LinearAlgebra::Matrix<double, 3, 3> f_l[width];
+    for ( int l = 0; l < width; ++l )
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 3; ++j )
+            {
+                f_l[l]( i, j ) = ( i == j ) * ( l + 1.0 ) + dist( gen );
+                f_b( i, j )[l] = f_l[l]( i, j );
+            }
+    LinearAlgebra::BatchMatrix<double, 3, 3, width> r_b;
+    LinearAlgebra::SymmetricMatrix<LinearAlgebra::Batch<double, width>, 3> s_b;
+    LinearAlgebra::polarDecomposition( f_b, r_b, s_b );
+    for ( int l = 0; l < width; ++l )
+    {
+        LinearAlgebra::polarDecomposition( f_l[l], r, s );
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 3; ++j )
+            {
+                EXPECT_NEAR( r_b( i, j )[l], r( i, j ), 1.0e-14 );
+                EXPECT_NEAR( s_b( i, j )[l], s( i, j ), 1.0e-13 );
+            }
+    }
+}
+
+//---------------------------------------------------------------------------//
+void fusedTest()
+{
+    std::mt19937 gen( 2931 );
+    std::uniform_real_distribution<double> dist( -1.0, 1.0 );
+    LinearAlgebra::Matrix<double, 4, 3> b;
+    LinearAlgebra::Matrix<double, 3, 3> a;
+    LinearAlgebra::Vector<double, 3> x;
+    for ( int i = 0; i < 3; ++i )
+    {
+        x( i ) = dist( gen );
+        for ( int j = 0; j < 3; ++j )
+            a( i, j ) = dist( gen );
+        for ( int j = 0; j < 4; ++j )
+            b( j, i ) = dist( gen );
+    }
+    double s = 0.7;
+
+    // Scaled matrix-vector product into a strided vector.
+    double y_data[8];
+    LinearAlgebra::VectorView<double, 4> y( y_data, 2 );
+    LinearAlgebra::fusedAssign( y, s * LinearAlgebra::fuse( b ) * x );
+    LinearAlgebra::Vector<double, 4> y_0 = s * b * x;
+    for ( int i = 0; i < 4; ++i )
+        EXPECT_DOUBLE_EQ( y( i ), y_0( i ) );
+
+    using mat_vec_type = decltype( s * LinearAlgebra::fuse( b ) * x );
+    static_assert( LinearAlgebra::FusedCost<mat_vec_type>::flops == 32, "" );
+    static_assert( LinearAlgebra::FusedCost<mat_vec_type>::temporaries == 0,
+                   "" );
+    static_assert( LinearAlgebra::FusedCost<mat_vec_type>::eager_flops == 32,
+                   "" );
+    static_assert(
+        LinearAlgebra::FusedCost<mat_vec_type>::eager_temporaries == 16, "" );
+
+    // Products of products, transposes, and sums into a strided matrix. The
+    // nested product is recomputed for every element.
+    double c_data[24];
+    LinearAlgebra::MatrixView<double, 4, 3> c( c_data, 6, 2 );
+    LinearAlgebra::fusedAssign( c, LinearAlgebra::fuse( b ) * a * ~a -
+                                       2.0 * LinearAlgebra::fuse( b ) );
+    LinearAlgebra::Matrix<double, 4, 3> c_0 = b * a * ~a - 2.0 * b;
+    for ( int i = 0; i < 4; ++i )
+        for ( int j = 0; j < 3; ++j )
+            EXPECT_NEAR( c( i, j ), c_0( i, j ), 1.0e-14 );
+
+    using nested_type = decltype( LinearAlgebra::fuse( b ) * a * ~a -
+                                  2.0 * LinearAlgebra::fuse( b ) );
+    static_assert( LinearAlgebra::FusedCost<nested_type>::flops == 264, "" );
+    static_assert( LinearAlgebra::FusedCost<nested_type>::eager_flops == 144,
+                   "" );
+    static_assert(
+        LinearAlgebra::FusedCost<nested_type>::eager_temporaries == 33, "" );
+
+    // Expressions reading the destination are evaluated into a temporary.
+    std::uintptr_t lo;
+    std::uintptr_t hi;
+    LinearAlgebra::fusedAddressRange( y, lo, hi );
+    EXPECT_FALSE( ( s * LinearAlgebra::fuse( b ) * x ).aliases( lo, hi ) );
+    EXPECT_TRUE( ( s * LinearAlgebra::fuse( y ) ).aliases( lo, hi ) );
+
+    // Expressions known not to alias are evaluated directly.
+    LinearAlgebra::Vector<double, 4> y_n;
+    LinearAlgebra::fusedAssign( LinearAlgebra::NoAlias(), y_n,
+                                s * LinearAlgebra::fuse( b ) * x );
+    for ( int i = 0; i < 4; ++i )
+        EXPECT_DOUBLE_EQ( y_n( i ), y( i ) );
+
+    LinearAlgebra::Vector<double, 3> x_0 = a * x;
+    LinearAlgebra::fusedAssign( x, LinearAlgebra::fuse( a ) * x );
+    for ( int i = 0; i < 3; ++i )
+        EXPECT_DOUBLE_EQ( x( i ), x_0( i ) );
+
+    LinearAlgebra::Matrix<double, 3, 3> a_0 = ~a * a;
+    LinearAlgebra::MatrixView<double, 3, 3> a_t( a.data(), 1, 3 );
+    LinearAlgebra::fusedAssign( a, LinearAlgebra::fuse( a_t ) * a );
+    for ( int i = 0; i < 3; ++i )
+        for ( int j = 0; j < 3; ++j )
+            EXPECT_DOUBLE_EQ( a( i, j ), a_0( i, j ) );
+
+    // Batched.
+    constexpr int width = 4;
+    LinearAlgebra::BatchMatrix<double, 4, 3, width> b_b;
+    LinearAlgebra::BatchVector<double, 3, width> x_b;
+    for ( int l = 0; l < width; ++l )
+        for ( int i = 0; i < 3; ++i )
+        {
+            x_b( i )[l] = x( i ) + l;
+            for ( int j = 0; j < 4; ++j )
+                b_b( j, i )[l] = b( j, i ) * ( l + 1.0 );
+        }
+    LinearAlgebra::BatchVector<double, 4, width> y_b;
+    LinearAlgebra::fusedAssign( y_b, LinearAlgebra::fuse( b_b ) * x_b );
+    LinearAlgebra::BatchVector<double, 4, width> y_b0 = b_b * x_b;
+    for ( int l = 0; l < width; ++l )
+        for ( int i = 0; i < 4; ++i )
+            EXPECT_DOUBLE_EQ( y_b( i )[l], y_b0( i )[l] );
+}
+
 //---------------------------------------------------------------------------//
 /*
 void eigendecompositionTest()
@@ -2019,6 +2824,12 @@ TEST( TEST_CATEGORY, linearSolve_test )
     linearSolveTest<20>();
 }
 
+TEST( TEST_CATEGORY, cholesky_test )
+{
+    choleskyTest<3>();
+    choleskyTest<6>();
+}
+
 TEST( TEST_CATEGORY, kernelTest )
 {
     kernelTest<2>();
@@ -2032,6 +2843,58 @@ TEST( TEST_CATEGORY, matrixExponential_test ) { matrixExponentialTest(); }
 
 TEST( TEST_CATEGORY, matrixSVD_test ) { matrixSVDTest(); }
 
+TEST( TEST_CATEGORY, svdPrecision_test )
+{
+    // Well conditioned.
+    Kokkos::Array<double, 3> sigma = { 3.0, 2.0, 0.5 };
+    svdPrecisionTest<LinearAlgebra::SVDFast, float>( sigma, 1.0e-5 );
+    svdPrecisionTest<LinearAlgebra::SVDAccurate, float>( sigma, 1.0e-5 );
+    svdPrecisionTest<LinearAlgebra::SVDFast, double>( sigma, 1.0e-13 );
+
+    // Ill conditioned. The fast path only has about 1e-6 relative accuracy
+    // in the small singular values.
+    sigma = { 1.0, 1.0e-4, 1.0e-8 };
+    svdPrecisionTest<LinearAlgebra::SVDAccurate, double>( sigma, 1.0e-8 );
+}
+
+TEST( TEST_CATEGORY, batch_test ) { batchTest(); }
+
+TEST( TEST_CATEGORY, batchSolve_test )
+{
+    batchSolveTest<2>();
+    batchSolveTest<3>();
+    batchSolveTest<4>();
+    batchSolveTest<10>();
+}
+
+TEST( TEST_CATEGORY, batchDecomposition_test ) { batchDecompositionTest(); }
+
+TEST( TEST_CATEGORY, symmetricMatrix_test )
+{
+    symmetricMatrixTest<2>();
+    symmetricMatrixTest<3>();
+    symmetricMatrixTest<4>();
+    symmetricMatrixTest<6>();
+}
+
+TEST( TEST_CATEGORY, symmetricTensor4_test ) { symmetricTensor4Test(); }
+
+TEST( TEST_CATEGORY, symmetricEigendecomposition_test )
+{
+    symmetricEigendecompositionTest();
+}
+
+TEST( TEST_CATEGORY, batchEigendecomposition_test )
+{
+    batchEigendecompositionTest();
+}
+
+TEST( TEST_CATEGORY, symmetricFunction_test ) { symmetricFunctionTest(); }
+
+TEST( TEST_CATEGORY, polarDecomposition_test ) { polarDecompositionTest(); }
+
+TEST( TEST_CATEGORY, fused_test ) { fusedTest(); }
+
 // FIXME_KOKKOSKERNELS
 // TEST( TEST_CATEGORY, eigendecomposition_test ) { eigendecompositionTest(); }
 
@@ -358,6 +358,314 @@ void mappingTest2d()
         }
 }
 
+//---------------------------------------------------------------------------//
+template <class Quadrature>
+void metricFieldTest2d()
+{
+    // Periodic mesh so all halo cells are gathered.
+    Kokkos::Array<double, 4> global_box = { -10.0, -10.0, 10.0, 10.0 };
+    double cell_size = 0.5;
+    int halo_width = 1;
+    Kokkos::Array<bool, 2> periodic = { true, true };
+    std::array<int, 2> ranks_per_dim = { 1, 1 };
+    MPI_Comm_size( MPI_COMM_WORLD, &ranks_per_dim[0] );
+    UniformBilinearMeshGenerator<2> generator = { cell_size, global_box,
+                                                  periodic };
+    auto manager = createBilinearMesh( TEST_MEMSPACE{}, generator, halo_width,
+                                       MPI_COMM_WORLD, ranks_per_dim );
+
+    // Distort the nodes with a periodic perturbation so the metrics vary
+    // within and between cells.
+    auto coords = manager->view( FieldLocation::Node{},
+                                 Field::PhysicalPosition<2>{} );
+    auto coords_h =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{}, coords );
+    double pi = 4.0 * std::atan( 1.0 );
+    for ( std::size_t i = 0; i < coords_h.extent( 0 ); ++i )
+        for ( std::size_t j = 0; j < coords_h.extent( 1 ); ++j )
+        {
+            double x = coords_h( i, j, Dim::I );
+            double y = coords_h( i, j, Dim::J );
+            coords_h( i, j, Dim::I ) += 0.1 * std::sin( pi * y / 10.0 );
+            coords_h( i, j, Dim::J ) += 0.1 * std::sin( pi * x / 5.0 );
+        }
+    Kokkos::deep_copy( coords, coords_h );
+
+    // Cache the metrics.
+    addMetricFields( Quadrature{}, TEST_EXECSPACE{}, *manager );
+    auto metrics = createCachedMetrics( Quadrature{}, *manager );
+
+    // Compare to the mapping in all cells, including the gathered halo.
+    auto mapping = manager->mesh()->mapping();
+    using mapping_type = decltype( mapping );
+    auto local_grid = manager->mesh()->localGrid();
+    auto ghosted_cells = local_grid->indexSpace(
+        Cabana::Grid::Ghost(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+    auto offset_i =
+        local_grid->globalGrid().globalOffset( Dim::I ) - halo_width;
+    auto offset_j =
+        local_grid->globalGrid().globalOffset( Dim::J ) - halo_width;
+    Kokkos::View<double**, TEST_MEMSPACE> error(
+        "error", ghosted_cells.extent( Dim::I ),
+        ghosted_cells.extent( Dim::J ) );
+    Cabana::Grid::grid_parallel_for(
+        "check_metrics", TEST_EXECSPACE{}, ghosted_cells,
+        KOKKOS_LAMBDA( const int i, const int j ) {
+            LinearAlgebra::Vector<double, 2> x_ref;
+            LinearAlgebra::Matrix<double, 2, 2> jac;
+            LinearAlgebra::Matrix<double, 2, 2> jac_inv;
+            double jac_det;
+            Kokkos::Array<int, 2> cell = { i, j };
+            for ( int p = 0; p < Quadrature::num_point; ++p )
+            {
+                x_ref = { offset_i + i + Quadrature::coordinate( p, Dim::I ),
+                          offset_j + j + Quadrature::coordinate( p, Dim::J ) };
+                auto located = metrics.locateCell( x_ref );
+                CurvilinearMeshMapping<mapping_type>::transformationMetrics(
+                    mapping, x_ref, jac, jac_det, jac_inv );
+                auto jac_c = metrics.jacobian( located, p );
+                auto jac_inv_c = metrics.inverseJacobian( cell, p );
+                double e =
+                    Kokkos::abs( jac_det -
+                                 metrics.jacobianDeterminant( cell, p ) ) +
+                    Kokkos::abs( located[Dim::I] - i ) +
+                    Kokkos::abs( located[Dim::J] - j );
+                for ( int a = 0; a < 2; ++a )
+                    for ( int b = 0; b < 2; ++b )
+                        e += Kokkos::abs( jac( a, b ) - jac_c( a, b ) ) +
+                             Kokkos::abs( jac_inv( a, b ) -
+                                          jac_inv_c( a, b ) );
+                error( i, j ) += e;
+            }
+        } );
+    auto error_h =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{}, error );
+    for ( int i = 0; i < ghosted_cells.extent( Dim::I ); ++i )
+        for ( int j = 0; j < ghosted_cells.extent( Dim::J ); ++j )
+            EXPECT_LT( error_h( i, j ), 1.0e-12 );
+}
+
+//---------------------------------------------------------------------------//
+template <class Quadrature>
+void metricFieldTest3d()
+{
+    // Periodic mesh so all halo cells are gathered.
+    Kokkos::Array<double, 6> global_box = { -5.0, -5.0, -5.0, 5.0, 5.0, 5.0 };
+    double cell_size = 0.5;
+    int halo_width = 1;
+    Kokkos::Array<bool, 3> periodic = { true, true, true };
+    std::array<int, 3> ranks_per_dim = { 1, 1, 1 };
+    MPI_Comm_size( MPI_COMM_WORLD, &ranks_per_dim[0] );
+    UniformBilinearMeshGenerator<3> generator = { cell_size, global_box,
+                                                  periodic };
+    auto manager = createBilinearMesh( TEST_MEMSPACE{}, generator, halo_width,
+                                       MPI_COMM_WORLD, ranks_per_dim );
+
+    // Distort the nodes with a periodic perturbation so the metrics vary
+    // within and between cells.
+    auto coords = manager->view( FieldLocation::Node{},
+                                 Field::PhysicalPosition<3>{} );
+    auto coords_h =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{}, coords );
+    double pi = 4.0 * std::atan( 1.0 );
+    for ( std::size_t i = 0; i < coords_h.extent( 0 ); ++i )
+        for ( std::size_t j = 0; j < coords_h.extent( 1 ); ++j )
+            for ( std::size_t k = 0; k < coords_h.extent( 2 ); ++k )
+            {
+                double x = coords_h( i, j, k, Dim::I );
+                double y = coords_h( i, j, k, Dim::J );
+                double z = coords_h( i, j, k, Dim::K );
+                coords_h( i, j, k, Dim::I ) += 0.1 * std::sin( pi * y / 5.0 );
+                coords_h( i, j, k, Dim::J ) += 0.1 * std::sin( pi * z / 5.0 );
+                coords_h( i, j, k, Dim::K ) += 0.1 * std::sin( pi * x / 5.0 );
+            }
+    Kokkos::deep_copy( coords, coords_h );
+
+    // Cache the metrics.
+    addMetricFields( Quadrature{}, TEST_EXECSPACE{}, *manager );
+    auto metrics = createCachedMetrics( Quadrature{}, *manager );
+
+    // Compare to the mapping in all cells, including the gathered halo.
+    auto mapping = manager->mesh()->mapping();
+    using mapping_type = decltype( mapping );
+    auto local_grid = manager->mesh()->localGrid();
+    auto ghosted_cells = local_grid->indexSpace(
+        Cabana::Grid::Ghost(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+    Kokkos::Array<int, 3> offset;
+    for ( int d = 0; d < 3; ++d )
+        offset[d] = local_grid->globalGrid().globalOffset( d ) - halo_width;
+    Kokkos::View<double***, TEST_MEMSPACE> error(
+        "error", ghosted_cells.extent( Dim::I ),
+        ghosted_cells.extent( Dim::J ), ghosted_cells.extent( Dim::K ) );
+    Cabana::Grid::grid_parallel_for(
+        "check_metrics", TEST_EXECSPACE{}, ghosted_cells,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            LinearAlgebra::Vector<double, 3> x_ref;
+            LinearAlgebra::Matrix<double, 3, 3> jac;
+            LinearAlgebra::Matrix<double, 3, 3> jac_inv;
+            double jac_det;
+            Kokkos::Array<int, 3> cell = { i, j, k };
+            for ( int p = 0; p < Quadrature::num_point; ++p )
+            {
+                for ( int d = 0; d < 3; ++d )
+                    x_ref( d ) =
+                        offset[d] + cell[d] + Quadrature::coordinate( p, d );
+                auto located = metrics.locateCell( x_ref );
+                CurvilinearMeshMapping<mapping_type>::transformationMetrics(
+                    mapping, x_ref, jac, jac_det, jac_inv );
+                auto jac_c = metrics.jacobian( located, p );
+                auto jac_inv_c = metrics.inverseJacobian( cell, p );
+                double e = Kokkos::abs(
+                    jac_det - metrics.jacobianDeterminant( cell, p ) );
+                for ( int d = 0; d < 3; ++d )
+                    e += Kokkos::abs( located[d] - cell[d] );
+                for ( int a = 0; a < 3; ++a )
+                    for ( int b = 0; b < 3; ++b )
+                        e += Kokkos::abs( jac( a, b ) - jac_c( a, b ) ) +
+                             Kokkos::abs( jac_inv( a, b ) -
+                                          jac_inv_c( a, b ) );
+                error( i, j, k ) += e;
+            }
+        } );
+    auto error_h =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{}, error );
+    for ( int i = 0; i < ghosted_cells.extent( Dim::I ); ++i )
+        for ( int j = 0; j < ghosted_cells.extent( Dim::J ); ++j )
+            for ( int k = 0; k < ghosted_cells.extent( Dim::K ); ++k )
+                EXPECT_LT( error_h( i, j, k ), 1.0e-12 );
+}
+
+//---------------------------------------------------------------------------//
+// Perturb each node coordinate by a function of the next coordinate.
+template <class NodeView>
+std::enable_if_t<4 == NodeView::rank, void>
+distortRelocationNodes( const NodeView& coords_h )
+{
+    double pi = 4.0 * std::atan( 1.0 );
+    for ( std::size_t i = 0; i < coords_h.extent( 0 ); ++i )
+        for ( std::size_t j = 0; j < coords_h.extent( 1 ); ++j )
+            for ( std::size_t k = 0; k < coords_h.extent( 2 ); ++k )
+            {
+                double x = coords_h( i, j, k, Dim::I );
+                double y = coords_h( i, j, k, Dim::J );
+                double z = coords_h( i, j, k, Dim::K );
+                coords_h( i, j, k, Dim::I ) += 0.1 * std::sin( pi * y / 5.0 );
+                coords_h( i, j, k, Dim::J ) += 0.1 * std::sin( pi * z / 5.0 );
+                coords_h( i, j, k, Dim::K ) += 0.1 * std::sin( pi * x / 5.0 );
+            }
+}
+
+template <class NodeView>
+std::enable_if_t<3 == NodeView::rank, void>
+distortRelocationNodes( const NodeView& coords_h )
+{
+    double pi = 4.0 * std::atan( 1.0 );
+    for ( std::size_t i = 0; i < coords_h.extent( 0 ); ++i )
+        for ( std::size_t j = 0; j < coords_h.extent( 1 ); ++j )
+        {
+            double x = coords_h( i, j, Dim::I );
+            double y = coords_h( i, j, Dim::J );
+            coords_h( i, j, Dim::I ) += 0.1 * std::sin( pi * y / 5.0 );
+            coords_h( i, j, Dim::J ) += 0.1 * std::sin( pi * x / 5.0 );
+        }
+}
+
+//---------------------------------------------------------------------------//
+template <std::size_t NumSpaceDim>
+void relocationTest()
+{
+    // Periodic distorted mesh.
+    Kokkos::Array<double, 2 * NumSpaceDim> global_box;
+    Kokkos::Array<bool, NumSpaceDim> periodic;
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        global_box[d] = -5.0;
+        global_box[d + NumSpaceDim] = 5.0;
+        periodic[d] = true;
+    }
+    double cell_size = 0.5;
+    int halo_width = 2;
+    std::array<int, NumSpaceDim> ranks_per_dim;
+    ranks_per_dim.fill( 1 );
+    MPI_Comm_size( MPI_COMM_WORLD, &ranks_per_dim[0] );
+    UniformBilinearMeshGenerator<NumSpaceDim> generator = {
+        cell_size, global_box, periodic };
+    auto manager = createBilinearMesh( TEST_MEMSPACE{}, generator, halo_width,
+                                       MPI_COMM_WORLD, ranks_per_dim );
+
+    // Distort the nodes.
+    auto coords = manager->view( FieldLocation::Node{},
+                                 Field::PhysicalPosition<NumSpaceDim>{} );
+    auto coords_h =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{}, coords );
+    distortRelocationNodes( coords_h );
+    Kokkos::deep_copy( coords, coords_h );
+
+    // Put one particle in each owned cell and one far outside the mesh.
+    // Each particle starts from a stale guess a few cells away.
+    auto mapping = manager->mesh()->mapping();
+    using mapping_type = decltype( mapping );
+    auto owned_cells = manager->mesh()->localGrid()->indexSpace(
+        Cabana::Grid::Own(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+    int num_particle = owned_cells.size() + 1;
+    Kokkos::View<double* [NumSpaceDim], Kokkos::HostSpace> exact_h(
+        "exact", num_particle );
+    for ( int p = 0; p < num_particle - 1; ++p )
+    {
+        int m = p;
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        {
+            int cell = owned_cells.min( d ) + m % owned_cells.extent( d );
+            m /= owned_cells.extent( d );
+            exact_h( p, d ) = mapping._global_offset[d] + cell + 0.1 +
+                              0.8 * std::abs( std::sin( p + 3.0 * d ) );
+        }
+    }
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        exact_h( num_particle - 1, d ) = mapping._global_offset[d] + 2.5;
+    auto exact = Kokkos::create_mirror_view_and_copy( TEST_MEMSPACE{},
+                                                      exact_h );
+
+    Kokkos::View<double* [NumSpaceDim], TEST_MEMSPACE> x_p( "x_p",
+                                                            num_particle );
+    Kokkos::View<double* [NumSpaceDim], TEST_MEMSPACE> x_ref( "x_ref",
+                                                              num_particle );
+    Kokkos::View<int*, TEST_MEMSPACE> failed( "failed", num_particle );
+    Kokkos::parallel_for(
+        "init_particles",
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_particle ),
+        KOKKOS_LAMBDA( const int p ) {
+            LinearAlgebra::Vector<double, NumSpaceDim> ref;
+            LinearAlgebra::Vector<double, NumSpaceDim> phys;
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+                ref( d ) = exact( p, d );
+            CurvilinearMeshMapping<mapping_type>::mapToPhysicalFrame(
+                mapping, ref, phys );
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                x_p( p, d ) = ( p < num_particle - 1 ) ? phys( d ) : 1.0e3;
+                x_ref( p, d ) = exact( p, d ) + ( ( d % 2 ) ? 1.7 : -1.2 );
+            }
+        } );
+
+    // Relocate.
+    int num_failed =
+        relocateParticles( TEST_EXECSPACE{}, mapping, x_p, x_ref, failed );
+    EXPECT_EQ( num_failed, 1 );
+
+    auto x_ref_h =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{}, x_ref );
+    auto failed_h =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{}, failed );
+    for ( int p = 0; p < num_particle - 1; ++p )
+    {
+        EXPECT_EQ( failed_h( p ), 0 );
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            EXPECT_NEAR( x_ref_h( p, d ), exact_h( p, d ), 1.0e-10 );
+    }
+    EXPECT_EQ( failed_h( num_particle - 1 ), 1 );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -365,6 +673,24 @@ TEST( TEST_CATEGORY, mapping_test_3d ) { mappingTest3d(); }
 
 TEST( TEST_CATEGORY, mapping_test_2d ) { mappingTest2d(); }
 
+TEST( TEST_CATEGORY, metric_field_test_2d )
+{
+    metricFieldTest2d<CellCenterQuadrature<2>>();
+    metricFieldTest2d<GaussQuadrature<2>>();
+}
+
+TEST( TEST_CATEGORY, metric_field_test_3d )
+{
+    metricFieldTest3d<CellCenterQuadrature<3>>();
+    metricFieldTest3d<GaussQuadrature<3>>();
+}
+
+TEST( TEST_CATEGORY, relocation_test )
+{
+    relocationTest<2>();
+    relocationTest<3>();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -10,6 +10,8 @@
  ****************************************************************************/
 
 #include <Picasso_FacetGeometry.hpp>
+#include <Picasso_FacetVoxelization.hpp>
+#include <Picasso_FieldManager.hpp>
 #include <Picasso_InputParser.hpp>
 #include <Picasso_ParticleList.hpp>
 #include <Picasso_Types.hpp>
@@ -22,6 +24,13 @@
 #include <Kokkos_Core.hpp>
 
 #include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -463,6 +472,323 @@ void constructionTest()
     EXPECT_EQ( volume_id, -2 );
 }
 
+//---------------------------------------------------------------------------//
+// Write the solids of a facet view to a binary STL file.
+template <class FacetView>
+void writeBinarySolids( std::ofstream& file, const std::string& name,
+                        const std::unordered_map<int, int>& ids,
+                        const std::vector<int>& counts,
+                        const FacetView& facets )
+{
+    // Invert the global-to-local id map.
+    std::vector<int> global_ids( counts.size() );
+    for ( const auto& id : ids )
+        global_ids[id.second] = id.first;
+
+    int f = 0;
+    for ( std::size_t s = 0; s < counts.size(); ++s )
+    {
+        char header[80] = {};
+        std::string header_name =
+            "solid " + name + " " + std::to_string( global_ids[s] );
+        std::copy( header_name.begin(), header_name.end(), header );
+        file.write( header, 80 );
+        std::uint32_t count = counts[s];
+        file.write( reinterpret_cast<const char*>( &count ), 4 );
+        for ( int n = 0; n < counts[s]; ++n, ++f )
+        {
+            float values[12];
+            for ( int v = 0; v < 3; ++v )
+                values[v] = 0.0;
+            for ( int v = 0; v < 3; ++v )
+                for ( int d = 0; d < 3; ++d )
+                    values[3 + 3 * v + d] = facets( f, v, d );
+            file.write( reinterpret_cast<const char*>( values ), 48 );
+            std::uint16_t attribute = 0;
+            file.write( reinterpret_cast<const char*>( &attribute ), 2 );
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+void binaryConstructionTest()
+{
+    // Create the geometry from the ASCII test file.
+    auto inputs = parse( "facet_geometry_test.json" );
+    FacetGeometry<TEST_MEMSPACE> ascii_geometry( inputs, TEST_EXECSPACE() );
+    const auto& ascii_data = ascii_geometry.data();
+    auto ascii_volume_facets = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), ascii_data.volume_facets );
+    auto ascii_surface_facets = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), ascii_data.surface_facets );
+
+    // Write the same solids to a binary file.
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    std::string binary_filename =
+        "stl_reader_test_binary_" + std::to_string( comm_rank ) + ".stl";
+    {
+        std::ofstream file( binary_filename, std::ios::binary );
+        writeBinarySolids( file, "Volume", ascii_geometry._volume_ids,
+                           ascii_geometry._volume_facet_count,
+                           ascii_volume_facets );
+        writeBinarySolids( file, "Surface", ascii_geometry._surface_ids,
+                           ascii_geometry._surface_facet_count,
+                           ascii_surface_facets );
+    }
+
+    // Create the geometry from the binary file and compare.
+    inputs["geometry"]["stl_file"] = binary_filename;
+    FacetGeometry<TEST_MEMSPACE> binary_geometry( inputs, TEST_EXECSPACE() );
+    const auto& binary_data = binary_geometry.data();
+    EXPECT_EQ( binary_data.numVolume(), 3 );
+    EXPECT_EQ( binary_data.numSurface(), 13 );
+    EXPECT_EQ( binary_data.global_bounding_volume_id, 2 );
+    for ( int i = 0; i < 3; ++i )
+    {
+        EXPECT_EQ( binary_geometry.localVolumeId( i + 1 ), i );
+        EXPECT_EQ( binary_geometry.numVolumeFacet( i ),
+                   ascii_geometry.numVolumeFacet( i ) );
+    }
+    for ( int i = 0; i < 13; ++i )
+    {
+        EXPECT_EQ( binary_geometry.localSurfaceId( i + 1 ), i );
+        EXPECT_EQ( binary_geometry.numSurfaceFacet( i ),
+                   ascii_geometry.numSurfaceFacet( i ) );
+    }
+
+    auto binary_volume_facets = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), binary_data.volume_facets );
+    ASSERT_EQ( binary_volume_facets.extent( 0 ),
+               ascii_volume_facets.extent( 0 ) );
+    for ( std::size_t f = 0; f < binary_volume_facets.extent( 0 ); ++f )
+        for ( int v = 0; v < 4; ++v )
+            for ( int d = 0; d < 3; ++d )
+                EXPECT_EQ( binary_volume_facets( f, v, d ),
+                           ascii_volume_facets( f, v, d ) );
+
+    auto binary_surface_facets = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), binary_data.surface_facets );
+    ASSERT_EQ( binary_surface_facets.extent( 0 ),
+               ascii_surface_facets.extent( 0 ) );
+    for ( std::size_t f = 0; f < binary_surface_facets.extent( 0 ); ++f )
+        for ( int v = 0; v < 4; ++v )
+            for ( int d = 0; d < 3; ++d )
+                EXPECT_EQ( binary_surface_facets( f, v, d ),
+                           ascii_surface_facets( f, v, d ) );
+
+    auto ascii_box = ascii_geometry.globalBoundingBox();
+    auto binary_box = binary_geometry.globalBoundingBox();
+    for ( int d = 0; d < 6; ++d )
+        EXPECT_EQ( ascii_box[d], binary_box[d] );
+
+    // A truncated binary file is rejected.
+    {
+        std::ifstream file( binary_filename, std::ios::binary );
+        std::vector<char> data( ( std::istreambuf_iterator<char>( file ) ),
+                                std::istreambuf_iterator<char>() );
+        STLReader::FileData file_data;
+        EXPECT_THROW(
+            STLReader::readBinary( data.data(), data.size() - 30, file_data ),
+            std::runtime_error );
+    }
+}
+
+//---------------------------------------------------------------------------//
+void collectiveConstructionTest()
+{
+    // Create the geometry on each rank and collectively.
+    auto inputs = parse( "facet_geometry_test.json" );
+    FacetGeometry<TEST_MEMSPACE> geometry( inputs, TEST_EXECSPACE() );
+    FacetGeometry<TEST_MEMSPACE> collective_geometry( inputs, MPI_COMM_WORLD,
+                                                      TEST_EXECSPACE() );
+    for ( int i = 0; i < 3; ++i )
+        EXPECT_EQ( collective_geometry.numVolumeFacet( i ),
+                   geometry.numVolumeFacet( i ) );
+    for ( int i = 0; i < 13; ++i )
+        EXPECT_EQ( collective_geometry.numSurfaceFacet( i ),
+                   geometry.numSurfaceFacet( i ) );
+
+    // Create the geometry culled to a box around the origin. The cube does
+    // not overlap the box and has no facets. The sphere and the global
+    // bounding volume keep all of their facets.
+    Kokkos::Array<double, 6> local_box = { -2.0, -2.0, -2.0, 2.0, 2.0, 12.0 };
+    FacetGeometry<TEST_MEMSPACE> culled_geometry( inputs, MPI_COMM_WORLD,
+                                                  local_box, TEST_EXECSPACE() );
+    const auto& culled_data = culled_geometry.data();
+    EXPECT_EQ( culled_data.numVolume(), 3 );
+    EXPECT_EQ( culled_data.numSurface(), 13 );
+    EXPECT_EQ( culled_data.global_bounding_volume_id, 2 );
+    EXPECT_EQ( culled_geometry.numVolumeFacet( 0 ), 0 );
+    EXPECT_EQ( culled_geometry.numVolumeFacet( 1 ),
+               geometry.numVolumeFacet( 1 ) );
+    EXPECT_EQ( culled_geometry.numVolumeFacet( 2 ),
+               geometry.numVolumeFacet( 2 ) );
+
+    // The cube has no facets and is binned as a single empty bin which
+    // contains no points.
+    auto bin_dims = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), culled_data.volume_bin_dims );
+    auto bin_offsets = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), culled_data.volume_bin_offsets );
+    for ( int d = 0; d < 3; ++d )
+        EXPECT_EQ( bin_dims( 0, d ), 1 );
+    EXPECT_EQ( bin_offsets( 1 ) - bin_offsets( 0 ), 1 );
+    int in_cube = -1;
+    Kokkos::parallel_reduce(
+        "check_empty_volume", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 1 ),
+        KOKKOS_LAMBDA( const int, int& result ) {
+            float x[3] = { 0.0, 0.0, 0.0 };
+            result = FacetGeometryOps::pointInVolume( x, culled_data, 0 );
+        },
+        in_cube );
+    EXPECT_EQ( in_cube, 0 );
+
+    // Only part of the sphere surface overlaps the box.
+    int sphere_surface = culled_geometry.localSurfaceId( 7 );
+    EXPECT_TRUE( culled_geometry.numSurfaceFacet( sphere_surface ) > 0 );
+    EXPECT_TRUE( culled_geometry.numSurfaceFacet( sphere_surface ) <
+                 geometry.numSurfaceFacet( sphere_surface ) );
+
+    // The bounding boxes were computed before culling.
+    auto global_box = geometry.globalBoundingBox();
+    auto culled_box = culled_geometry.globalBoundingBox();
+    for ( int d = 0; d < 6; ++d )
+        EXPECT_EQ( global_box[d], culled_box[d] );
+
+    // Points in the box are located as before.
+    int volume_id = -100;
+    Kokkos::Array<float, 3> p1 = { 0.0, 0.0, 0.0 };
+    Kokkos::parallel_reduce(
+        "check_point_location", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 1 ),
+        KOKKOS_LAMBDA( const int, int& result ) {
+            result = FacetGeometryOps::locatePoint( p1.data(), culled_data );
+        },
+        volume_id );
+    EXPECT_EQ( volume_id, 1 );
+
+    volume_id = -100;
+    Kokkos::Array<float, 3> p2 = { 1.0, 1.0, 11.0 };
+    Kokkos::parallel_reduce(
+        "check_point_location", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 1 ),
+        KOKKOS_LAMBDA( const int, int& result ) {
+            result = FacetGeometryOps::locatePoint( p2.data(), culled_data );
+        },
+        volume_id );
+    EXPECT_EQ( volume_id, -1 );
+}
+
+//---------------------------------------------------------------------------//
+void binnedQueryTest()
+{
+    // Create the geometry with a few facets per bin so the sphere has many
+    // bins.
+    auto inputs = parse( "facet_geometry_test.json" );
+    inputs["geometry"]["facets_per_bin"] = 2;
+    FacetGeometry<TEST_MEMSPACE> geometry( inputs, TEST_EXECSPACE() );
+    const auto& geom_data = geometry.data();
+    EXPECT_TRUE( geom_data.hasVolumeBins() );
+
+    // Compare binned queries to queries over all facets on a lattice of
+    // points through the sphere and box.
+    int n = 20;
+    int num_point = n * n * n;
+    int sphere = geometry.localVolumeId( 2 );
+    int mismatch = 0;
+    Kokkos::parallel_reduce(
+        "check_binned_queries",
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p, int& result ) {
+            float x[3] = { -11.5f + 31.0f * ( p / ( n * n ) ) / n,
+                           -11.5f + 31.0f * ( ( p / n ) % n ) / n,
+                           -11.5f + 31.0f * ( p % n ) / n };
+
+            // Point in volume.
+            auto facets = geom_data.volumeFacets( sphere );
+            if ( FacetGeometryOps::pointInVolume( x, geom_data, sphere ) !=
+                 FacetGeometryOps::pointInVolume( x, facets ) )
+                ++result;
+
+            // Closest facet.
+            float distance;
+            int f = FacetGeometryOps::closestVolumeFacet( x, geom_data, sphere,
+                                                          distance );
+            float min_distance = FLT_MAX;
+            for ( std::size_t i = 0; i < facets.extent( 0 ); ++i )
+                min_distance = Kokkos::fmin(
+                    min_distance,
+                    FacetGeometryOps::pointFacetDistance( x, facets, i ) );
+            if ( f < 0 || distance != min_distance )
+                ++result;
+
+            // The closest facet of the sphere is about 10 from the origin.
+            float r = Kokkos::sqrt( x[0] * x[0] + x[1] * x[1] + x[2] * x[2] );
+            if ( Kokkos::fabs( distance - Kokkos::fabs( r - 10.0f ) ) > 0.5 )
+                ++result;
+        },
+        mismatch );
+    EXPECT_EQ( mismatch, 0 );
+}
+
+//---------------------------------------------------------------------------//
+void multiRayTest()
+{
+    auto inputs = parse( "facet_geometry_test.json" );
+    FacetGeometry<TEST_MEMSPACE> geometry( inputs, TEST_EXECSPACE() );
+    const auto& geom_data = geometry.data();
+    int box = geometry.localVolumeId( 1 );
+    int sphere = geometry.localVolumeId( 2 );
+
+    int error = 0;
+    Kokkos::parallel_reduce(
+        "check_multi_ray", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 1 ),
+        KOKKOS_LAMBDA( const int, int& result ) {
+            using device_type = typename TEST_MEMSPACE::device_type;
+            float r[FacetGeometryOps::num_point_in_volume_ray][3];
+            FacetGeometryOps::pointInVolumeRays<device_type>( r );
+            auto box_facets = geom_data.volumeFacets( box );
+
+            // Fire the first ray through a corner of the box from inside
+            // and outside the box. The other rays must decide the vote.
+            float x_in[3];
+            float x_out[3];
+            for ( int d = 0; d < 3; ++d )
+            {
+                x_in[d] = 17.0 - r[0][d];
+                x_out[d] = ( ( 2 == d ) ? 17.0 : 13.0 ) - r[0][d];
+            }
+            if ( -1 != FacetGeometryOps::countVolumeIntersections(
+                           x_in, r[0], geom_data, box ) )
+                ++result;
+            if ( -1 != FacetGeometryOps::countVolumeIntersections(
+                           x_out, r[0], geom_data, box ) )
+                ++result;
+            if ( !FacetGeometryOps::pointInVolume( x_in, box_facets ) )
+                ++result;
+            if ( !FacetGeometryOps::pointInVolume( x_in, geom_data, box ) )
+                ++result;
+            if ( FacetGeometryOps::pointInVolume( x_out, box_facets ) )
+                ++result;
+            if ( FacetGeometryOps::pointInVolume( x_out, geom_data, box ) )
+                ++result;
+
+            // The winding number is one in magnitude inside and zero
+            // outside.
+            auto sphere_facets = geom_data.volumeFacets( sphere );
+            float origin[3] = { 0.0, 0.0, 0.0 };
+            float outside[3] = { 15.0, 15.0, 15.0 };
+            if ( Kokkos::fabs( Kokkos::fabs( FacetGeometryOps::windingNumber(
+                                   origin, sphere_facets ) ) -
+                               1.0 ) > 1.0e-3 )
+                ++result;
+            if ( Kokkos::fabs( FacetGeometryOps::windingNumber(
+                     outside, sphere_facets ) ) > 1.0e-3 )
+                ++result;
+        },
+        error );
+    EXPECT_EQ( error, 0 );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -476,6 +802,21 @@ TEST( TEST_CATEGORY, ray_fire_test )
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, construction_test ) { constructionTest(); }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, binary_construction_test ) { binaryConstructionTest(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, collective_construction_test )
+{
+    collectiveConstructionTest();
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, binned_query_test ) { binnedQueryTest(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, multi_ray_test ) { multiRayTest(); }
+
 //---------------------------------------------------------------------------//
 template <class MemorySpace>
 struct LocateFunctor
@@ -535,6 +876,128 @@ void initExample()
 
 TEST( TEST_CATEGORY, init_example ) { initExample(); }
 
+//---------------------------------------------------------------------------//
+void voxelizationTest()
+{
+    // Make the mesh and geometry.
+    auto inputs = parse( "facet_init_example.json" );
+    Kokkos::Array<double, 6> global_box = { -12.0, -12.0, -12.0,
+                                            20.0,  20.0,  20.0 };
+    auto mesh = std::make_shared<UniformMesh<TEST_MEMSPACE>>(
+        inputs, global_box, 1, MPI_COMM_WORLD );
+    auto fm = createFieldManager( mesh );
+    FacetGeometry<TEST_MEMSPACE> geometry( inputs, TEST_EXECSPACE() );
+    const auto& geom_data = geometry.data();
+
+    // Voxelize the volumes.
+    auto voxels = voxelizeVolumes( TEST_EXECSPACE(), *fm, geom_data );
+    auto volume_id = fm->view( FieldLocation::Cell(), Field::VolumeId() );
+
+    // Every cell center should be in the same volume as given by the exact
+    // point location. Cell centers lie on the diagonals of the cube facets so
+    // this also checks scanlines through shared facet edges. Points in each
+    // cell should also be located the same with the voxelization.
+    auto cell_space = mesh->localGrid()->indexSpace(
+        Cabana::Grid::Ghost(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+    int mismatch = 0;
+    Kokkos::parallel_reduce(
+        "check_voxel_volume_id",
+        Cabana::Grid::createExecutionPolicy( cell_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k, int& result ) {
+            int c[3] = { i, j, k };
+            float x[3];
+            float y[3];
+            for ( int d = 0; d < 3; ++d )
+            {
+                x[d] = voxels.low_corner[d] + ( c[d] + 0.5 ) * voxels.cell_size;
+                y[d] = voxels.low_corner[d] + ( c[d] + 0.2 ) * voxels.cell_size;
+            }
+            if ( volume_id( i, j, k, 0 ) !=
+                 FacetGeometryOps::locatePoint( x, geom_data ) )
+                ++result;
+            if ( FacetVoxelizationOps::locatePoint( y, geom_data, voxels ) !=
+                 FacetGeometryOps::locatePoint( y, geom_data ) )
+                ++result;
+        },
+        mismatch );
+    EXPECT_EQ( mismatch, 0 );
+
+    // Only a fraction of the cells in the global box should be cut.
+    int num_cut = 0;
+    Kokkos::parallel_reduce(
+        "check_voxel_cut",
+        Cabana::Grid::createExecutionPolicy( cell_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k, int& result ) {
+            if ( voxels.cut( i, j, k ) )
+                ++result;
+        },
+        num_cut );
+    EXPECT_TRUE( num_cut < static_cast<int>( cell_space.size() ) / 2 );
+
+    // Check the signed distance to the sphere.
+    int sphere = geometry.localVolumeId( 2 );
+    voxelizeSignedDistance( TEST_EXECSPACE(), *fm, geom_data, voxels,
+                            sphere );
+    auto distance = fm->view( FieldLocation::Cell(), Field::SignedDistance() );
+    Kokkos::parallel_reduce(
+        "check_voxel_distance",
+        Cabana::Grid::createExecutionPolicy( cell_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k, int& result ) {
+            int c[3] = { i, j, k };
+            double r2 = 0.0;
+            for ( int d = 0; d < 3; ++d )
+            {
+                double x =
+                    voxels.low_corner[d] + ( c[d] + 0.5 ) * voxels.cell_size;
+                r2 += x * x;
+            }
+            if ( Kokkos::fabs( distance( i, j, k, 0 ) -
+                               ( Kokkos::sqrt( r2 ) - 10.0 ) ) > 0.5 )
+                ++result;
+        },
+        mismatch );
+    EXPECT_EQ( mismatch, 0 );
+
+    // Initialize particles in the sphere in two passes, counting them with
+    // the voxelization. The same particles should be created as in a single
+    // pass using exact point location.
+    Cabana::ParticleTraits<Field::PhysicalPosition<3>, Field::VolumeId> fields;
+    auto particles =
+        Cabana::Grid::createParticleList<TEST_MEMSPACE>( "particles", fields );
+    auto exact_particles = Cabana::Grid::createParticleList<TEST_MEMSPACE>(
+        "exact_particles", fields );
+    using particle_type = typename decltype( particles )::particle_type;
+    auto create_func = KOKKOS_LAMBDA( const double x[3], const double,
+                                      particle_type& p )
+    {
+        float xf[3] = { float( x[0] ), float( x[1] ), float( x[2] ) };
+        for ( int d = 0; d < 3; ++d )
+            Picasso::get( p, Field::PhysicalPosition<3>(), d ) = x[d];
+        int v = FacetGeometryOps::locatePoint( xf, geom_data );
+        Picasso::get( p, Field::VolumeId() ) = v;
+        return ( sphere == v );
+    };
+    auto selector = createFacetVolumeSelector( geom_data, voxels, sphere );
+    initializeParticles( InitUniform(), TEST_EXECSPACE(), 2, selector,
+                         create_func, particles, mesh );
+    initializeParticles( InitUniform(), TEST_EXECSPACE(), 2, create_func,
+                         exact_particles, mesh );
+    EXPECT_EQ( particles.size(), exact_particles.size() );
+
+    auto volume_slice = particles.slice( Field::VolumeId() );
+    Kokkos::parallel_reduce(
+        "check_counted_particles",
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, particles.size() ),
+        KOKKOS_LAMBDA( const int p, int& result ) {
+            if ( sphere != volume_slice( p ) )
+                ++result;
+        },
+        mismatch );
+    EXPECT_EQ( mismatch, 0 );
+}
+
+TEST( TEST_CATEGORY, voxelization_test ) { voxelizationTest(); }
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -21,6 +21,8 @@
 #include <Kokkos_Core.hpp>
 
 #include <cmath>
+#include <cstdint>
+#include <fstream>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -92,6 +94,28 @@ void runTest( const Phi0& phi_0, const std::string& stl_filename )
     // Output an stl file with the marching cubes mesh.
     MarchingCubes::writeDataToSTL( *mc_data, MPI_COMM_WORLD, stl_filename );
 
+    // Output a binary stl file and check its size.
+    std::string binary_filename = "binary_" + stl_filename;
+    MarchingCubes::writeDataToBinarySTL( *mc_data, MPI_COMM_WORLD,
+                                         binary_filename );
+    int global_num_facet = mc_data->num_facet;
+    MPI_Allreduce( MPI_IN_PLACE, &global_num_facet, 1, MPI_INT, MPI_SUM,
+                   MPI_COMM_WORLD );
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    if ( 0 == comm_rank )
+    {
+        std::ifstream file( binary_filename, std::ios::binary );
+        ASSERT_TRUE( file.is_open() );
+        file.seekg( 80 );
+        std::uint32_t count = 0;
+        file.read( reinterpret_cast<char*>( &count ), sizeof( count ) );
+        EXPECT_EQ( static_cast<int>( count ), global_num_facet );
+        file.seekg( 0, std::ios::end );
+        EXPECT_EQ( static_cast<long>( file.tellg() ),
+                   84l + 50l * global_num_facet );
+    }
+
     // Output a bov file with the level set.
     Cabana::Grid::Experimental::BovWriter::writeTimeStep( 0, 0.0, *distance );
 
@@ -163,9 +187,197 @@ void scaled_sphere_redistance()
     runTest( phi_0, "scaled_spehere_mc_mesh.stl" );
 }
 
+//---------------------------------------------------------------------------//
+// Set the analytic signed distance to a sphere on all nodes.
+template <class Mesh, class DistanceArray>
+void setSphere( const Mesh& mesh, DistanceArray& distance, const double cx,
+                const double r )
+{
+    auto distance_view = distance.view();
+    auto local_mesh =
+        Cabana::Grid::createLocalMesh<TEST_MEMSPACE>( *( mesh.localGrid() ) );
+    auto ghost_nodes = mesh.localGrid()->indexSpace(
+        Cabana::Grid::Ghost(), Cabana::Grid::Node(), Cabana::Grid::Local() );
+    Kokkos::parallel_for(
+        "sphere",
+        Cabana::Grid::createExecutionPolicy( ghost_nodes, TEST_EXECSPACE{} ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int entity_index[3] = { i, j, k };
+            double x[3];
+            local_mesh.coordinates( Cabana::Grid::Node(), entity_index, x );
+            double dx = cx - x[0];
+            double dy = 0.5 - x[1];
+            double dz = 0.5 - x[2];
+            distance_view( i, j, k, 0 ) =
+                sqrt( dx * dx + dy * dy + dz * dz ) - r;
+        } );
+}
+
+//---------------------------------------------------------------------------//
+// Scale the signed distance by a positive function of position. Node signs
+// and therefore the facet count of each cell are unchanged.
+template <class Mesh, class DistanceArray>
+void scaleDistance( const Mesh& mesh, DistanceArray& distance )
+{
+    auto distance_view = distance.view();
+    auto local_mesh =
+        Cabana::Grid::createLocalMesh<TEST_MEMSPACE>( *( mesh.localGrid() ) );
+    auto ghost_nodes = mesh.localGrid()->indexSpace(
+        Cabana::Grid::Ghost(), Cabana::Grid::Node(), Cabana::Grid::Local() );
+    Kokkos::parallel_for(
+        "scale",
+        Cabana::Grid::createExecutionPolicy( ghost_nodes, TEST_EXECSPACE{} ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int entity_index[3] = { i, j, k };
+            double x[3];
+            local_mesh.coordinates( Cabana::Grid::Node(), entity_index, x );
+            distance_view( i, j, k, 0 ) *= 1.0 + 0.5 * x[0];
+        } );
+}
+
+//---------------------------------------------------------------------------//
+// Compare an incrementally updated surface to a full build.
+template <class Mesh, class DistanceArray, class Data>
+void compareToBuild( const Mesh& mesh, const DistanceArray& distance,
+                     const Data& mc_data )
+{
+    auto full_data = MarchingCubes::createData( mesh );
+    MarchingCubes::build( TEST_EXECSPACE{}, mesh, distance, *full_data );
+    EXPECT_EQ( mc_data.num_facet, full_data->num_facet );
+    EXPECT_EQ( mc_data.num_active_cell, full_data->num_active_cell );
+
+    auto facets = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{},
+                                                       mc_data.facets );
+    auto full_facets = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, full_data->facets );
+    for ( int f = 0; f < full_data->num_facet; ++f )
+        for ( int n = 0; n < 3; ++n )
+            for ( int d = 0; d < 3; ++d )
+                EXPECT_DOUBLE_EQ( facets( f, n, d ), full_facets( f, n, d ) );
+}
+
+//---------------------------------------------------------------------------//
+void incrementalTest()
+{
+    // Global parameters.
+    Kokkos::Array<double, 6> global_box = { 0.0, 0.0, 0.0, 1.0, 1.0, 1.0 };
+
+    // Get inputs for mesh.
+    auto inputs = parse( "level_set_redistance_test.json" );
+
+    // Make mesh.
+    int minimum_halo_size = 4;
+    auto mesh = createUniformMesh( TEST_MEMSPACE{}, inputs, global_box,
+                                   minimum_halo_size, MPI_COMM_WORLD );
+
+    // Create a signed distance field.
+    auto distance = createArray( *mesh, FieldLocation::Node(),
+                                 Field::SignedDistance() );
+
+    // Build the initial surface.
+    setSphere( *mesh, *distance, 0.5, 0.25 );
+    auto mc_data = MarchingCubes::createData( *mesh );
+    MarchingCubes::build( TEST_EXECSPACE{}, *mesh, *distance, *mc_data );
+
+    // Nothing changes if the distance is unchanged.
+    MarchingCubes::update( TEST_EXECSPACE{}, *mesh, *distance, *mc_data );
+    EXPECT_EQ( mc_data->num_changed_cell, 0 );
+
+    // Move and grow the sphere and update incrementally.
+    setSphere( *mesh, *distance, 0.52, 0.3 );
+    MarchingCubes::update( TEST_EXECSPACE{}, *mesh, *distance, *mc_data );
+
+    // Compare to a full build.
+    compareToBuild( *mesh, *distance, *mc_data );
+
+    // Change the distance without changing any signs. The facets of the
+    // changed cells are rewritten in place.
+    int num_facet = mc_data->num_facet;
+    int num_active_cell = mc_data->num_active_cell;
+    scaleDistance( *mesh, *distance );
+    MarchingCubes::update( TEST_EXECSPACE{}, *mesh, *distance, *mc_data );
+    EXPECT_GT( mc_data->num_changed_cell, 0 );
+    EXPECT_EQ( mc_data->num_facet, num_facet );
+    EXPECT_EQ( mc_data->num_active_cell, num_active_cell );
+    compareToBuild( *mesh, *distance, *mc_data );
+}
+
+//---------------------------------------------------------------------------//
+void indexedTest()
+{
+    // Global parameters.
+    Kokkos::Array<double, 6> global_box = { 0.0, 0.0, 0.0, 1.0, 1.0, 1.0 };
+
+    // Get inputs for mesh.
+    auto inputs = parse( "level_set_redistance_test.json" );
+
+    // Make mesh.
+    int minimum_halo_size = 4;
+    auto mesh = createUniformMesh( TEST_MEMSPACE{}, inputs, global_box,
+                                   minimum_halo_size, MPI_COMM_WORLD );
+
+    // Create a sphere.
+    auto distance = createArray( *mesh, FieldLocation::Node(),
+                                 Field::SignedDistance() );
+    setSphere( *mesh, *distance, 0.5, 0.25 );
+
+    // Build the facets and the indexed surface.
+    auto mc_data = MarchingCubes::createData( *mesh );
+    MarchingCubes::build( TEST_EXECSPACE{}, *mesh, *distance, *mc_data );
+    auto indexed_data = MarchingCubes::createData( *mesh );
+    MarchingCubes::buildIndexed( TEST_EXECSPACE{}, *mesh, *distance,
+                                 *indexed_data, true );
+    EXPECT_EQ( mc_data->num_facet, indexed_data->num_facet );
+
+    // Vertices are shared between facets.
+    if ( indexed_data->num_facet > 0 )
+        EXPECT_LT( indexed_data->num_vertex, 3 * indexed_data->num_facet );
+
+    // The triangles are the facets.
+    auto facets = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace{},
+                                                       mc_data->facets );
+    auto triangles = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, indexed_data->triangles );
+    auto vertices = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, indexed_data->vertices );
+    auto normals = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace{}, indexed_data->normals );
+    for ( int f = 0; f < indexed_data->num_facet; ++f )
+        for ( int n = 0; n < 3; ++n )
+        {
+            int v = triangles( f, n );
+            EXPECT_GE( v, 0 );
+            EXPECT_LT( v, indexed_data->num_vertex );
+            for ( int d = 0; d < 3; ++d )
+                EXPECT_NEAR( vertices( v, d ), facets( f, n, d ), 1.0e-6 );
+        }
+
+    // The normals point out of the sphere.
+    for ( int v = 0; v < indexed_data->num_vertex; ++v )
+    {
+        double r[3];
+        double r_norm = 0.0;
+        double n_norm = 0.0;
+        double dot = 0.0;
+        for ( int d = 0; d < 3; ++d )
+        {
+            r[d] = vertices( v, d ) - 0.5;
+            r_norm += r[d] * r[d];
+            n_norm += normals( v, d ) * normals( v, d );
+            dot += r[d] * normals( v, d );
+        }
+        EXPECT_NEAR( n_norm, 1.0, 1.0e-5 );
+        EXPECT_GT( dot / std::sqrt( r_norm ), 0.95 );
+    }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, incremental_test ) { incrementalTest(); }
+
+TEST( TEST_CATEGORY, indexed_test ) { indexedTest(); }
+
 TEST( TEST_CATEGORY, sphere_redistance_good_guess_test )
 {
     sphere_redistance();
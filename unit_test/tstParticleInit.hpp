@@ -22,6 +22,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
 using namespace Picasso;
 
 namespace Test
@@ -31,6 +39,13 @@ int totalParticlesPerCell( InitUniform, int ppc ) { return ppc * ppc * ppc; }
 
 int totalParticlesPerCell( InitRandom, int ppc ) { return ppc; }
 
+int totalParticlesPerCell( InitStratified, int ppc )
+{
+    return ppc * ppc * ppc;
+}
+
+int totalParticlesPerCell( InitHalton, int ppc ) { return ppc; }
+
 //---------------------------------------------------------------------------//
 // Field tags.
 struct Foo : public Picasso::Field::Vector<double, 3>
@@ -46,7 +61,8 @@ struct Bar : public Picasso::Field::Scalar<double>
 //---------------------------------------------------------------------------//
 template <class InitType>
 void InitTest( InitType init_type, const int ppc, const int boundary = 1,
-               const int multiplier = 1 )
+               const int multiplier = 1, const bool count_first = false,
+               const int max_cells_per_chunk = 0 )
 {
     // Global bounding box.
     double cell_size = 0.23;
@@ -103,10 +119,26 @@ void InitTest( InitType init_type, const int ppc, const int boundary = 1,
         }
     };
 
+    // Particle count functor.
+    auto particle_count_func = KOKKOS_LAMBDA( const double x[3] )
+    {
+        return ( x[Dim::I] > box[0] && x[Dim::I] < box[1] &&
+                 x[Dim::J] > box[2] && x[Dim::J] < box[3] &&
+                 x[Dim::K] > box[4] && x[Dim::K] < box[5] );
+    };
+
     // Initialize particles (potentially multiple times).
     for ( int m = 0; m < multiplier; ++m )
-        Picasso::initializeParticles( init_type, TEST_EXECSPACE(), ppc,
-                                      particle_init_func, particles, mesh );
+    {
+        if ( count_first )
+            Picasso::initializeParticles(
+                init_type, TEST_EXECSPACE(), ppc, particle_count_func,
+                particle_init_func, particles, mesh );
+        else
+            Picasso::initializeParticles(
+                init_type, TEST_EXECSPACE(), ppc, particle_init_func, particles,
+                mesh, true, max_cells_per_chunk );
+    }
 
     // Check that we made particles.
     int num_p = particles.size();
@@ -149,6 +181,176 @@ void InitTest( InitType init_type, const int ppc, const int boundary = 1,
     }
 }
 
+//---------------------------------------------------------------------------//
+// Create the test mesh on the given communicator.
+auto createTestMesh( MPI_Comm comm )
+{
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 14, 17, 19 };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    Kokkos::Array<double, 6> global_box;
+    for ( int d = 0; d < 3; ++d )
+    {
+        global_box[d] = global_low_corner[d];
+        global_box[d + 3] =
+            global_low_corner[d] + cell_size * global_num_cell[d];
+    }
+    auto inputs = Picasso::parse( "particle_init_test.json" );
+    return std::make_shared<UniformMesh<TEST_MEMSPACE>>( inputs, global_box,
+                                                         0, comm );
+}
+
+//---------------------------------------------------------------------------//
+// Initialize particles in every cell of a mesh and get their positions.
+template <class InitType, class Mesh>
+std::vector<std::array<double, 3>>
+initPositions( InitType init_type, const int ppc,
+               std::shared_ptr<Mesh> mesh )
+{
+    Cabana::ParticleTraits<Foo, Bar> fields;
+    auto particles = Cabana::Grid::createParticleList<TEST_MEMSPACE>(
+        "test_particles", fields );
+    using particle_list_type = decltype( particles );
+    auto particle_init_func =
+        KOKKOS_LAMBDA( const double x[3], const double v,
+                       typename particle_list_type::particle_type& p )
+    {
+        for ( int d = 0; d < 3; ++d )
+            Picasso::get( p, Foo(), d ) = x[d];
+        Picasso::get( p, Bar() ) = v;
+        return true;
+    };
+    Picasso::initializeParticles( init_type, TEST_EXECSPACE(), ppc,
+                                  particle_init_func, particles, mesh );
+
+    auto host_particles = Cabana::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), particles.aosoa() );
+    auto px = Cabana::slice<0>( host_particles );
+    std::vector<std::array<double, 3>> positions( particles.size() );
+    for ( std::size_t p = 0; p < positions.size(); ++p )
+        for ( int d = 0; d < 3; ++d )
+            positions[p][d] = px( p, d );
+    return positions;
+}
+
+//---------------------------------------------------------------------------//
+// Check that the particles of each cell fall in distinct strata.
+void stratifiedStrataTest( const int ppc )
+{
+    auto mesh = createTestMesh( MPI_COMM_WORLD );
+    auto positions = initPositions( InitStratified(), ppc, mesh );
+    EXPECT_FALSE( positions.empty() );
+
+    const auto& global_mesh = mesh->localGrid()->globalGrid().globalMesh();
+    double cell_size = mesh->cellSize();
+    std::map<std::array<long, 3>, int> cell_count;
+    std::set<std::array<long, 6>> strata;
+    for ( const auto& x : positions )
+    {
+        std::array<long, 6> key;
+        for ( int d = 0; d < 3; ++d )
+        {
+            double c = ( x[d] - global_mesh.lowCorner( d ) ) / cell_size;
+            key[d] = static_cast<long>( std::floor( c ) );
+            key[d + 3] =
+                static_cast<long>( std::floor( ( c - key[d] ) * ppc ) );
+            EXPECT_GE( key[d + 3], 0 );
+            EXPECT_LT( key[d + 3], ppc );
+        }
+        EXPECT_TRUE( strata.insert( key ).second );
+        ++cell_count[{ key[0], key[1], key[2] }];
+    }
+    for ( const auto& c : cell_count )
+        EXPECT_EQ( c.second, ppc * ppc * ppc );
+}
+
+//---------------------------------------------------------------------------//
+// Check that Halton particles are the same for any decomposition by
+// comparing the particles of all ranks to those of a single rank.
+void haltonDecompositionTest( const int ppc )
+{
+    // Gather the particles created on all ranks.
+    auto local = initPositions( InitHalton(), ppc,
+                                createTestMesh( MPI_COMM_WORLD ) );
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    int num_local = 3 * local.size();
+    std::vector<int> counts( comm_size );
+    MPI_Allgather( &num_local, 1, MPI_INT, counts.data(), 1, MPI_INT,
+                   MPI_COMM_WORLD );
+    std::vector<int> displs( comm_size, 0 );
+    for ( int r = 1; r < comm_size; ++r )
+        displs[r] = displs[r - 1] + counts[r - 1];
+    std::vector<std::array<double, 3>> global(
+        ( displs.back() + counts.back() ) / 3 );
+    MPI_Allgatherv( local.data(), num_local, MPI_DOUBLE, global.data(),
+                    counts.data(), displs.data(), MPI_DOUBLE, MPI_COMM_WORLD );
+
+    // Create the particles of the whole mesh on this rank.
+    auto serial = initPositions( InitHalton(), ppc,
+                                 createTestMesh( MPI_COMM_SELF ) );
+
+    std::sort( global.begin(), global.end() );
+    std::sort( serial.begin(), serial.end() );
+    ASSERT_EQ( global.size(), serial.size() );
+    for ( std::size_t p = 0; p < serial.size(); ++p )
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_NEAR( global[p][d], serial[p][d], 1.0e-12 );
+}
+
+//---------------------------------------------------------------------------//
+// Check that particles rejected by the create functor after being counted are
+// removed from the list before the error is reported.
+void countedRejectTest()
+{
+    auto mesh = createTestMesh( MPI_COMM_WORLD );
+    Cabana::ParticleTraits<Foo, Bar> fields;
+    auto particles = Cabana::Grid::createParticleList<TEST_MEMSPACE>(
+        "test_particles", fields );
+    using particle_list_type = decltype( particles );
+
+    // Count every candidate but only create those in the upper half.
+    double x_mid = 1.2 + 0.23 * 7;
+    auto particle_count_func = KOKKOS_LAMBDA( const double[3] )
+    {
+        return true;
+    };
+    auto particle_init_func =
+        KOKKOS_LAMBDA( const double x[3], const double v,
+                       typename particle_list_type::particle_type& p )
+    {
+        if ( x[Dim::I] < x_mid )
+            return false;
+        for ( int d = 0; d < 3; ++d )
+            Picasso::get( p, Foo(), d ) = x[d];
+        Picasso::get( p, Bar() ) = v;
+        return true;
+    };
+    EXPECT_THROW( Picasso::initializeParticles(
+                      InitUniform(), TEST_EXECSPACE(), 2, particle_count_func,
+                      particle_init_func, particles, mesh ),
+                  std::runtime_error );
+
+    // Only the created particles remain.
+    auto expected = initPositions( InitUniform(), 2, mesh );
+    int num_expected = 0;
+    for ( const auto& x : expected )
+        if ( x[Dim::I] >= x_mid )
+            ++num_expected;
+    EXPECT_EQ( static_cast<int>( particles.size() ), num_expected );
+
+    double volume = mesh->cellSize() * mesh->cellSize() * mesh->cellSize() / 8;
+    auto host_particles = Cabana::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), particles.aosoa() );
+    auto px = Cabana::slice<0>( host_particles );
+    auto pv = Cabana::slice<1>( host_particles );
+    for ( std::size_t p = 0; p < host_particles.size(); ++p )
+    {
+        EXPECT_GE( px( p, Dim::I ), x_mid );
+        EXPECT_DOUBLE_EQ( pv( p ), volume );
+    }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -178,6 +380,37 @@ TEST( TEST_CATEGORY, multiple_random_init_test )
     InitTest( InitRandom(), 4, 4, 3 );
 }
 
+TEST( TEST_CATEGORY, stratified_init_test )
+{
+    InitTest( InitStratified(), 3 );
+    InitTest( InitStratified(), 2, 2, 2 );
+    stratifiedStrataTest( 3 );
+}
+
+TEST( TEST_CATEGORY, halton_init_test )
+{
+    InitTest( InitHalton(), 17 );
+    InitTest( InitHalton(), 9, 3, 3 );
+    haltonDecompositionTest( 5 );
+}
+
+TEST( TEST_CATEGORY, counted_init_test )
+{
+    InitTest( InitUniform(), 3, 1, 1, true );
+    InitTest( InitRandom(), 9, 3, 2, true );
+    InitTest( InitStratified(), 2, 1, 1, true );
+    InitTest( InitHalton(), 8, 2, 1, true );
+}
+
+TEST( TEST_CATEGORY, counted_reject_test ) { countedRejectTest(); }
+
+TEST( TEST_CATEGORY, chunked_init_test )
+{
+    // Chunks of less than a plane of cells and of several planes.
+    InitTest( InitUniform(), 2, 1, 2, false, 50 );
+    InitTest( InitRandom(), 9, 2, 1, false, 1000 );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -25,6 +25,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
 using namespace Picasso;
 
 namespace Test
@@ -191,9 +195,252 @@ void zalesaksTest( const std::string& filename )
     }
 }
 
+//---------------------------------------------------------------------------//
+// Two spherical blobs of radius 0.5 along the x axis with colors 3 and 7.
+KOKKOS_INLINE_FUNCTION double blobCenter( const int b, const int d )
+{
+    return ( 0 == d ) ? 0.9 + 1.4 * b : 1.6;
+}
+
+KOKKOS_INLINE_FUNCTION int blobColor( const int b ) { return 3 + 4 * b; }
+
+// Exact signed distance to a blob.
+KOKKOS_INLINE_FUNCTION double blobDistance( const int b, const double x[3] )
+{
+    double r2 = 0.0;
+    for ( int d = 0; d < 3; ++d )
+        r2 += ( x[d] - blobCenter( b, d ) ) * ( x[d] - blobCenter( b, d ) );
+    return Kokkos::sqrt( r2 ) - 0.5;
+}
+
+struct BlobFunctor
+{
+    template <class ParticleType>
+    KOKKOS_INLINE_FUNCTION bool operator()( const int, const double x[3],
+                                            const double,
+                                            ParticleType& p ) const
+    {
+        for ( int d = 0; d < 3; ++d )
+            Picasso::get( p, Field::PhysicalPosition<3>(), d ) = x[d];
+        for ( int b = 0; b < 2; ++b )
+            if ( blobDistance( b, x ) < 0.0 )
+            {
+                Picasso::get( p, Field::Color() ) = blobColor( b );
+                return true;
+            }
+        return false;
+    }
+};
+
+// Create the blob mesh and particles. The halo width is set by the inputs.
+template <class ParticleListType>
+auto createBlobs( const nlohmann::json& inputs, ParticleListType& particles )
+{
+    Kokkos::Array<double, 6> global_box = { 0.0, 0.0, 0.0, 3.2, 3.2, 3.2 };
+    auto mesh = std::make_shared<UniformMesh<TEST_MEMSPACE>>(
+        inputs, global_box, 2, MPI_COMM_WORLD );
+    Cabana::Grid::createParticles( Cabana::InitUniform(), TEST_EXECSPACE(),
+                                   BlobFunctor{}, particles, 2,
+                                   *( mesh->localGrid() ) );
+    return mesh;
+}
+
+// Check a signed distance estimate and the redistanced signed distance of a
+// blob on the owned nodes.
+template <class MeshType, class EstimateView, class DistanceView>
+void checkBlobDistance( const MeshType& mesh, const int b,
+                        const EstimateView& estimate, const int component,
+                        const DistanceView& distance )
+{
+    auto estimate_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), estimate );
+    auto distance_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), distance );
+    auto local_grid = mesh.localGrid();
+    auto local_mesh =
+        Cabana::Grid::createLocalMesh<Kokkos::HostSpace>( *local_grid );
+    double dx = local_grid->globalGrid().globalMesh().cellSize( 0 );
+    double min_dist = dx * local_grid->haloCellWidth();
+    auto owned_nodes = local_grid->indexSpace(
+        Cabana::Grid::Own(), Cabana::Grid::Node(), Cabana::Grid::Local() );
+    for ( int i = owned_nodes.min( 0 ); i < owned_nodes.max( 0 ); ++i )
+        for ( int j = owned_nodes.min( 1 ); j < owned_nodes.max( 1 ); ++j )
+            for ( int k = owned_nodes.min( 2 ); k < owned_nodes.max( 2 ); ++k )
+            {
+                int index[3] = { i, j, k };
+                double x[3];
+                local_mesh.coordinates( Cabana::Grid::Node(), index, x );
+                double phi = blobDistance( b, x );
+                double e = estimate_host( i, j, k, component );
+                double sd = distance_host( i, j, k, 0 );
+
+                // The estimate is accurate outside of the blob within the
+                // halo width and has the correct sign inside.
+                if ( phi > dx && phi < min_dist - dx )
+                    EXPECT_NEAR( e, phi, dx );
+                else if ( phi < -dx )
+                    EXPECT_LT( e, 0.0 );
+
+                // The signed distance has the correct sign away from the
+                // interface and is accurate near it.
+                if ( phi > dx )
+                    EXPECT_GT( sd, 0.0 );
+                else if ( phi < -dx )
+                    EXPECT_LT( sd, 0.0 );
+                if ( std::abs( phi ) < 2.0 * dx )
+                    EXPECT_NEAR( sd, phi, dx );
+            }
+}
+
+//---------------------------------------------------------------------------//
+void multiColorTest()
+{
+    auto inputs = parse( "particle_level_set_test.json" );
+    auto particles = Cabana::Grid::createParticleList<TEST_MEMSPACE>(
+        "particles",
+        Cabana::ParticleTraits<Field::PhysicalPosition<3>, Field::Color>() );
+    auto mesh = createBlobs( inputs, particles );
+
+    // Invalid color lists.
+    EXPECT_THROW( createMultiParticleLevelSet<FieldLocation::Node>(
+                      inputs, mesh, std::vector<int>{} ),
+                  std::runtime_error );
+    EXPECT_THROW( createMultiParticleLevelSet<FieldLocation::Node>(
+                      inputs, mesh, { 3, -1 } ),
+                  std::runtime_error );
+    EXPECT_THROW( createMultiParticleLevelSet<FieldLocation::Node>(
+                      inputs, mesh, { 3, 7, 3 } ),
+                  std::runtime_error );
+
+    // Build a level set for each blob.
+    auto level_set = createMultiParticleLevelSet<FieldLocation::Node>(
+        inputs, mesh, { blobColor( 0 ), blobColor( 1 ) } );
+    EXPECT_EQ( level_set->numColor(), 2 );
+    EXPECT_EQ( level_set->color( 0 ), blobColor( 0 ) );
+    EXPECT_EQ( level_set->color( 1 ), blobColor( 1 ) );
+    EXPECT_EQ( level_set->colorCount(), 0 );
+
+    auto c_p = particles.slice( Field::Color() );
+    level_set->updateParticleColors( TEST_EXECSPACE(), c_p );
+
+    // Every particle belongs to one of the colors and the indices are
+    // grouped by color.
+    auto c_host = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                       particles.aosoa() );
+    auto color_host = Cabana::slice<1>( c_host );
+    auto index_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), level_set->colorIndex() );
+    EXPECT_EQ( level_set->colorCount(), static_cast<int>( particles.size() ) );
+    EXPECT_EQ( level_set->colorCount( 0 ) + level_set->colorCount( 1 ),
+               level_set->colorCount() );
+    for ( int n = 0; n < 2; ++n )
+    {
+        int count = 0;
+        for ( std::size_t p = 0; p < color_host.size(); ++p )
+            if ( blobColor( n ) == color_host( p ) )
+                ++count;
+        EXPECT_EQ( level_set->colorCount( n ), count );
+        for ( int c = 0; c < level_set->colorCount( n ); ++c )
+            EXPECT_EQ(
+                color_host( index_host( level_set->colorOffset( n ) + c ) ),
+                blobColor( n ) );
+    }
+
+    // Compose and redistance the signed distance of each blob.
+    level_set->estimateSignedDistance(
+        TEST_EXECSPACE(), particles.slice( Field::PhysicalPosition<3>() ) );
+    level_set->redistance( TEST_EXECSPACE() );
+    for ( int n = 0; n < 2; ++n )
+        checkBlobDistance(
+            *mesh, n, level_set->getDistanceEstimate()->view(), n,
+            level_set->levelSet( n )->getSignedDistance()->view() );
+}
+
+//---------------------------------------------------------------------------//
+void surfaceOnlyTest()
+{
+    // Use a narrow band which excludes the particles in the middle of the
+    // blob.
+    auto inputs = parse( "particle_level_set_test.json" );
+    inputs["mesh"]["halo_cell_width"] = 2;
+    inputs["particle_level_set"]["surface_band_margin"] = 0.0;
+    auto particles = Cabana::Grid::createParticleList<TEST_MEMSPACE>(
+        "particles",
+        Cabana::ParticleTraits<Field::PhysicalPosition<3>, Field::Color>() );
+    auto mesh = createBlobs( inputs, particles );
+    auto x_p = particles.slice( Field::PhysicalPosition<3>() );
+    auto c_p = particles.slice( Field::Color() );
+
+    // Build the level set of the first blob with all particles and with
+    // only the surface particles. Two steps are taken so the surface mode
+    // has a previous signed distance to select the narrow band with.
+    auto full_ls =
+        createParticleLevelSet<FieldLocation::Node>( inputs, mesh, 3 );
+    inputs["particle_level_set"]["surface_only"] = true;
+    auto surface_ls =
+        createParticleLevelSet<FieldLocation::Node>( inputs, mesh, 3 );
+    for ( auto& ls : { full_ls, surface_ls } )
+    {
+        ls->updateParticleColors( TEST_EXECSPACE(), c_p );
+        for ( int step = 0; step < 2; ++step )
+        {
+            ls->estimateSignedDistance( TEST_EXECSPACE(), x_p );
+            ls->levelSet()->redistance( TEST_EXECSPACE() );
+        }
+    }
+
+    // The full level set uses every particle and entity.
+    EXPECT_EQ( full_ls->surfaceCount(), full_ls->colorCount() );
+    auto ghost_nodes = mesh->localGrid()->indexSpace(
+        Cabana::Grid::Ghost(), Cabana::Grid::Node(), Cabana::Grid::Local() );
+    EXPECT_EQ( full_ls->queryCount(), static_cast<int>( ghost_nodes.size() ) );
+
+    // The surface level set uses fewer particles and queries fewer entities
+    // over all ranks.
+    EXPECT_EQ( surface_ls->colorCount(), full_ls->colorCount() );
+    int counts[4] = { surface_ls->surfaceCount(), full_ls->surfaceCount(),
+                      surface_ls->queryCount(), full_ls->queryCount() };
+    MPI_Allreduce( MPI_IN_PLACE, counts, 4, MPI_INT, MPI_SUM,
+                   MPI_COMM_WORLD );
+    EXPECT_GT( counts[0], 0 );
+    EXPECT_LT( counts[0], counts[1] );
+    EXPECT_LT( counts[2], counts[3] );
+
+    // Both are accurate and agree near the interface.
+    for ( auto& ls : { full_ls, surface_ls } )
+        checkBlobDistance( *mesh, 0,
+                           ls->levelSet()->getDistanceEstimate()->view(), 0,
+                           ls->levelSet()->getSignedDistance()->view() );
+    auto full_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), full_ls->levelSet()->getSignedDistance()->view() );
+    auto surface_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(),
+        surface_ls->levelSet()->getSignedDistance()->view() );
+    auto local_mesh = Cabana::Grid::createLocalMesh<Kokkos::HostSpace>(
+        *( mesh->localGrid() ) );
+    double dx = mesh->cellSize();
+    auto owned_nodes = mesh->localGrid()->indexSpace(
+        Cabana::Grid::Own(), Cabana::Grid::Node(), Cabana::Grid::Local() );
+    for ( int i = owned_nodes.min( 0 ); i < owned_nodes.max( 0 ); ++i )
+        for ( int j = owned_nodes.min( 1 ); j < owned_nodes.max( 1 ); ++j )
+            for ( int k = owned_nodes.min( 2 ); k < owned_nodes.max( 2 ); ++k )
+            {
+                int index[3] = { i, j, k };
+                double x[3];
+                local_mesh.coordinates( Cabana::Grid::Node(), index, x );
+                if ( std::abs( blobDistance( 0, x ) ) < 2.0 * dx )
+                    EXPECT_NEAR( surface_host( i, j, k, 0 ),
+                                 full_host( i, j, k, 0 ), 0.5 * dx );
+            }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, surface_only_test ) { surfaceOnlyTest(); }
+
+TEST( TEST_CATEGORY, multi_color_test ) { multiColorTest(); }
+
 // TEST( TEST_CATEGORY, zalesaks_disk_test )
 // {
 //     zalesaksTest( "particle_level_set_zalesaks_disk.json" );
@@ -35,6 +35,11 @@ struct Bar : Field::Matrix<double, 3, 3>
     static std::string label() { return "bar"; }
 };
 
+struct Baz : Field::SymmetricMatrix<double, 3>
+{
+    static std::string label() { return "baz"; }
+};
+
 //---------------------------------------------------------------------------//
 void linearAlgebraTest()
 {
@@ -49,7 +54,8 @@ void linearAlgebraTest()
         inputs, global_box, minimum_halo_size, MPI_COMM_WORLD );
 
     // Make a particle list.
-    Cabana::ParticleTraits<Field::LogicalPosition<3>, Foo, Field::Color, Bar>
+    Cabana::ParticleTraits<Field::LogicalPosition<3>, Foo, Field::Color, Bar,
+                           Baz>
         fields;
     auto particles = Cabana::Grid::createParticleList<TEST_MEMSPACE>(
         "test_particles", fields );
@@ -65,17 +71,20 @@ void linearAlgebraTest()
     auto pm = particles.slice( Foo() );
     auto pc = particles.slice( Field::Color() );
     auto pf = particles.slice( Bar() );
+    auto ps = particles.slice( Baz() );
 
     Cabana::deep_copy( px, 1.23 );
     Cabana::deep_copy( pm, 3.3 );
     Cabana::deep_copy( pc, 5 );
     Cabana::deep_copy( pf, -1.2 );
+    Cabana::deep_copy( ps, 0.7 );
 
     // Check the slices.
     EXPECT_EQ( px.label(), "logical_position" );
     EXPECT_EQ( pm.label(), "foo" );
     EXPECT_EQ( pc.label(), "color" );
     EXPECT_EQ( pf.label(), "bar" );
+    EXPECT_EQ( ps.label(), "baz" );
 
     // Check deep copy.
     auto aosoa_host =
@@ -84,6 +93,7 @@ void linearAlgebraTest()
     auto pm_h = Cabana::slice<1>( aosoa_host );
     auto pc_h = Cabana::slice<2>( aosoa_host );
     auto pf_h = Cabana::slice<3>( aosoa_host );
+    auto ps_h = Cabana::slice<4>( aosoa_host );
     for ( std::size_t p = 0; p < num_p; ++p )
     {
         for ( int d = 0; d < 3; ++d )
@@ -96,6 +106,10 @@ void linearAlgebraTest()
         for ( int i = 0; i < 3; ++i )
             for ( int j = 0; j < 3; ++j )
                 EXPECT_DOUBLE_EQ( pf_h( p, i, j ), -1.2 );
+
+        // Only the 6 unique symmetric components are stored.
+        for ( int n = 0; n < 6; ++n )
+            EXPECT_DOUBLE_EQ( ps_h( p, n ), 0.7 );
     }
 
     // Locally modify.
@@ -116,6 +130,11 @@ void linearAlgebraTest()
             for ( int i = 0; i < 3; ++i )
                 for ( int j = 0; j < 3; ++j )
                     pf_m( i, j ) += p + i + j;
+
+            auto ps_m = Picasso::get( particle, Baz() );
+            for ( int i = 0; i < 3; ++i )
+                for ( int j = i; j < 3; ++j )
+                    ps_m( i, j ) += p + i + j;
         } );
 
     // Check the modification.
@@ -132,6 +151,12 @@ void linearAlgebraTest()
         for ( int i = 0; i < 3; ++i )
             for ( int j = 0; j < 3; ++j )
                 EXPECT_DOUBLE_EQ( pf_h( p, i, j ), -1.2 + p + i + j );
+
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 3; ++j )
+                EXPECT_DOUBLE_EQ(
+                    ps_h( p, LinearAlgebra::symmetricIndex<3>( i, j ) ),
+                    0.7 + p + i + j );
     }
 }
 
@@ -0,0 +1,191 @@
+/****************************************************************************
+ * Copyright (c) 2021 by the Picasso authors                                *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Picasso library. Picasso is distributed under a *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Picasso_FieldTypes.hpp>
+#include <Picasso_InputParser.hpp>
+#include <Picasso_ParticleInit.hpp>
+#include <Picasso_ParticleList.hpp>
+#include <Picasso_ParticleResample.hpp>
+#include <Picasso_Types.hpp>
+#include <Picasso_UniformMesh.hpp>
+
+#include <Cabana_Core.hpp>
+#include <Cabana_Grid.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace Picasso;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+// Field tags.
+struct Mass : Field::Scalar<double>
+{
+    static std::string label() { return "mass"; }
+};
+
+struct Volume : Field::Scalar<double>
+{
+    static std::string label() { return "volume"; }
+};
+
+struct Velocity : Field::Matrix<double, 4, 3>
+{
+    static std::string label() { return "velocity"; }
+};
+
+//---------------------------------------------------------------------------//
+// Global conserved quantities: mass, volume, center of mass, momentum, and
+// affine momentum about the origin.
+template <class ParticleListType>
+std::vector<double> conservedQuantities( const ParticleListType& particles )
+{
+    auto host_particles = Cabana::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), particles.aosoa() );
+    auto x_p = Cabana::slice<0>( host_particles );
+    auto m_p = Cabana::slice<1>( host_particles );
+    auto v_p = Cabana::slice<2>( host_particles );
+    auto c_p = Cabana::slice<3>( host_particles );
+
+    std::vector<double> result( 17, 0.0 );
+    for ( std::size_t p = 0; p < host_particles.size(); ++p )
+    {
+        result[0] += m_p( p );
+        result[1] += v_p( p );
+        for ( int d = 0; d < 3; ++d )
+        {
+            result[2 + d] += m_p( p ) * x_p( p, d );
+            result[5 + d] += m_p( p ) * c_p( p, 0, d );
+            for ( int a = 0; a < 3; ++a )
+                result[8 + 3 * a + d] +=
+                    m_p( p ) *
+                    ( c_p( p, a + 1, d ) + c_p( p, 0, d ) * x_p( p, a ) );
+        }
+    }
+    MPI_Allreduce( MPI_IN_PLACE, result.data(), result.size(), MPI_DOUBLE,
+                   MPI_SUM, MPI_COMM_WORLD );
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+// Initialize particles in either the lower or upper half of the domain in x.
+struct InitFunctor
+{
+    bool upper;
+
+    template <class ParticleType>
+    KOKKOS_INLINE_FUNCTION bool operator()( const double x[3], const double pv,
+                                            ParticleType& p ) const
+    {
+        if ( ( x[Dim::I] > 1.0 ) != upper )
+            return false;
+        for ( int d = 0; d < 3; ++d )
+        {
+            Picasso::get( p, Field::PhysicalPosition<3>(), d ) = x[d];
+            Picasso::get( p, Velocity(), 0, d ) =
+                ( d + 1.0 ) * x[d] - x[( d + 1 ) % 3];
+            for ( int a = 0; a < 3; ++a )
+                Picasso::get( p, Velocity(), a + 1, d ) =
+                    0.1 * ( d + 1.0 ) * ( a - 1.0 ) + x[a];
+        }
+        Picasso::get( p, Mass() ) = ( 1.0 + x[Dim::J] ) * pv;
+        Picasso::get( p, Volume() ) = pv;
+        return true;
+    }
+};
+
+//---------------------------------------------------------------------------//
+void resampleTest()
+{
+    // Make the mesh.
+    auto inputs = parse( "particle_resample_test.json" );
+    Kokkos::Array<double, 6> global_box = { 0.0, 0.0, 0.0, 2.0, 2.0, 2.0 };
+    auto mesh = std::make_shared<UniformMesh<TEST_MEMSPACE>>(
+        inputs, global_box, 0, MPI_COMM_WORLD );
+
+    // Make particles with one particle per cell in the lower half of the
+    // domain and 27 particles per cell in the upper half.
+    Cabana::ParticleTraits<Field::PhysicalPosition<3>, Mass, Volume, Velocity>
+        fields;
+    auto particles = Cabana::Grid::createParticleList<TEST_MEMSPACE>(
+        "particles", fields );
+    initializeParticles( InitUniform(), TEST_EXECSPACE(), 1,
+                         InitFunctor{ false }, particles, mesh );
+    initializeParticles( InitUniform(), TEST_EXECSPACE(), 3,
+                         InitFunctor{ true }, particles, mesh );
+
+    auto before = conservedQuantities( particles );
+
+    // Resample the particles. This is only done every other step.
+    auto resampler = createParticleResampler(
+        inputs, mesh, Field::PhysicalPosition<3>(), Mass(), Volume(),
+        Velocity() );
+    EXPECT_EQ( resampler->minParticlesPerCell(), 4 );
+    EXPECT_EQ( resampler->maxParticlesPerCell(), 16 );
+    EXPECT_FALSE( resampler->apply( TEST_EXECSPACE(), particles, 1 ) );
+    EXPECT_TRUE( resampler->apply( TEST_EXECSPACE(), particles, 2 ) );
+
+    // Check conservation.
+    auto after = conservedQuantities( particles );
+    for ( std::size_t n = 0; n < before.size(); ++n )
+        EXPECT_NEAR( before[n], after[n],
+                     1.0e-10 * ( 1.0 + std::abs( before[n] ) ) );
+
+    // Split cells should have 4 particles and merged cells 14.
+    auto host_particles = Cabana::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), particles.aosoa() );
+    auto x_p = Cabana::slice<0>( host_particles );
+    auto owned_cells = mesh->localGrid()->indexSpace(
+        Cabana::Grid::Own(), Cabana::Grid::Cell(), Cabana::Grid::Local() );
+    auto local_mesh =
+        Cabana::Grid::createLocalMesh<Kokkos::HostSpace>( *mesh->localGrid() );
+    Kokkos::View<int***, Kokkos::HostSpace> count(
+        "count", owned_cells.extent( Dim::I ), owned_cells.extent( Dim::J ),
+        owned_cells.extent( Dim::K ) );
+    for ( std::size_t p = 0; p < host_particles.size(); ++p )
+    {
+        int c[3];
+        for ( int d = 0; d < 3; ++d )
+            c[d] = std::floor( ( x_p( p, d ) -
+                                 local_mesh.lowCorner( Cabana::Grid::Own(),
+                                                       d ) ) /
+                               mesh->cellSize() );
+        ++count( c[Dim::I], c[Dim::J], c[Dim::K] );
+    }
+    double low_x = local_mesh.lowCorner( Cabana::Grid::Own(), Dim::I );
+    for ( int i = 0; i < owned_cells.extent( Dim::I ); ++i )
+        for ( int j = 0; j < owned_cells.extent( Dim::J ); ++j )
+            for ( int k = 0; k < owned_cells.extent( Dim::K ); ++k )
+            {
+                double x = low_x + ( i + 0.5 ) * mesh->cellSize();
+                EXPECT_EQ( count( i, j, k ), ( x > 1.0 ) ? 14 : 4 );
+            }
+
+    // A second resampling should not change the particles.
+    std::size_t num_p = particles.size();
+    EXPECT_TRUE( resampler->apply( TEST_EXECSPACE(), particles, 4 ) );
+    EXPECT_EQ( num_p, particles.size() );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, resample_test ) { resampleTest(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,76 @@
+/****************************************************************************
+ * Copyright (c) 2021 by the Picasso authors                                *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Picasso library. Picasso is distributed under a *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Picasso_StreamCompaction.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace Picasso;
+
+namespace Test
+{
+//---------------------------------------------------------------------------//
+void compactIndicesTest()
+{
+    // Select every third index.
+    int num_index = 1000;
+    Kokkos::View<int*, TEST_MEMSPACE> indices( "indices", num_index );
+    int count = compactIndices(
+        "compact_indices", TEST_EXECSPACE(), 0, num_index,
+        KOKKOS_LAMBDA( const int i ) { return ( 0 == i % 3 ); }, indices );
+    EXPECT_EQ( count, 334 );
+
+    // The indices should be in increasing order.
+    auto indices_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), indices );
+    for ( int n = 0; n < count; ++n )
+        EXPECT_EQ( indices_host( n ), 3 * n );
+
+    // Nothing is selected in an empty range.
+    count = compactIndices(
+        "compact_empty", TEST_EXECSPACE(), 10, 10,
+        KOKKOS_LAMBDA( const int ) { return true; }, indices );
+    EXPECT_EQ( count, 0 );
+}
+
+//---------------------------------------------------------------------------//
+void streamCompactTest()
+{
+    // Compact values from an offset range.
+    int begin = 100;
+    int end = 600;
+    Kokkos::View<int*, TEST_MEMSPACE> values( "values", end - begin );
+    int count = streamCompact(
+        "stream_compact", TEST_EXECSPACE(), begin, end,
+        KOKKOS_LAMBDA( const int i ) { return ( 1 == i % 2 ); },
+        KOKKOS_LAMBDA( const int i, const int position ) {
+            values( position ) = 2 * i;
+        } );
+    EXPECT_EQ( count, 250 );
+
+    auto values_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), values );
+    for ( int n = 0; n < count; ++n )
+        EXPECT_EQ( values_host( n ), 2 * ( begin + 2 * n + 1 ) );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, compact_indices_test ) { compactIndicesTest(); }
+
+TEST( TEST_CATEGORY, stream_compact_test ) { streamCompactTest(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test